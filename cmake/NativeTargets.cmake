@@ -47,6 +47,11 @@ if(Qt6Core_FOUND AND NOT DISABLE_COMPANION)
     COMMAND ${CMAKE_CURRENT_BINARY_DIR}/gtests-companion
     DEPENDS gtests-companion
   )
+  add_custom_target(bench-companion
+    COMMAND ${CMAKE_CURRENT_BINARY_DIR}/gtests-companion-bench
+            --gtest_output=json:${CMAKE_CURRENT_BINARY_DIR}/bench-companion.json
+    DEPENDS gtests-companion-bench
+  )
   add_custom_target(gtests
     DEPENDS gtests-radio gtests-companion
   )
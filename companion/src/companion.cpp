@@ -42,6 +42,7 @@
 #include "translations.h"
 #include "helpers.h"
 #include "boardfactories.h"
+#include "yaml_modeldiff.h"
 
 #ifdef __APPLE__
 #include <QProxyStyle>
@@ -128,12 +129,99 @@ void printHelpText()
   printf(tmpl, "--export",   QCoreApplication::translate("Companion", "Save application settings to file...").toUtf8().constData());
   printf(tmpl, "--import",   QCoreApplication::translate("Companion", "Load application settings from file or previous version...").toUtf8().constData());
   printf(tmpl, "--defaults", QCoreApplication::translate("Companion", "Reset ALL application settings to default and remove radio profiles...").toUtf8().constData());
+  printf(tmpl, "--compare <file1> <file2>", QCoreApplication::translate("Companion", "Print the differences between the models of two files and exit.").toUtf8().constData());
   printf(tmpl, "--quit  ",   QCoreApplication::translate("Companion", "Exit before settings initialization and application startup.").toUtf8().constData());
   printf(tmpl, "--version",  QCoreApplication::translate("Companion", "Print version number and exit.").toUtf8().constData());
   printf(tmpl, "--help|-h",  QCoreApplication::translate("Companion", "Print this help text.").toUtf8().constData());
   fflush(stdout);
 }
 
+static bool loadCompareFile(const QString & filename, RadioData & radioData)
+{
+  Storage storage(filename);
+  if (!storage.load(radioData)) {
+    fprintf(stderr, "%s\n", storage.error().toUtf8().constData());
+    return false;
+  }
+  return true;
+}
+
+static QString compareModelName(const ModelData & model)
+{
+  return QString("%1 (%2)").arg(model.name.toQString()).arg(model.filename.toQString());
+}
+
+// Same exit status as diff: 0 when identical, 1 when different, 2 on errors
+int compareModelFiles(const QString & fromFile, const QString & toFile)
+{
+  RadioData from, to;
+  if (!loadCompareFile(fromFile, from) || !loadCompareFile(toFile, to))
+    return 2;
+
+  QList<const ModelData *> fromModels, toModels;
+  for (const auto & model : from.models) {
+    if (!model.isEmpty())
+      fromModels.append(&model);
+  }
+  for (const auto & model : to.models) {
+    if (!model.isEmpty())
+      toModels.append(&model);
+  }
+
+  // models are paired by file name, unless each file holds a single model
+  QList<QPair<const ModelData *, const ModelData *>> pairs;
+  if (fromModels.size() == 1 && toModels.size() == 1) {
+    pairs.append(qMakePair(fromModels.first(), toModels.first()));
+  }
+  else {
+    for (auto a : fromModels) {
+      const ModelData * match = nullptr;
+      for (auto b : toModels) {
+        if (a->filename.str() == b->filename.str()) {
+          match = b;
+          break;
+        }
+      }
+      pairs.append(qMakePair(a, match));
+    }
+    for (auto b : toModels) {
+      bool found = false;
+      for (const auto & pair : pairs)
+        found |= pair.second == b;
+      if (!found)
+        pairs.append(qMakePair(nullptr, b));
+    }
+  }
+
+  int differences = 0;
+  for (const auto & pair : pairs) {
+    if (!pair.second) {
+      printf("%s: %s\n", compareModelName(*pair.first).toUtf8().constData(),
+             QCoreApplication::translate("Companion", "only in %1").arg(fromFile).toUtf8().constData());
+      differences++;
+      continue;
+    }
+    if (!pair.first) {
+      printf("%s: %s\n", compareModelName(*pair.second).toUtf8().constData(),
+             QCoreApplication::translate("Companion", "only in %1").arg(toFile).toUtf8().constData());
+      differences++;
+      continue;
+    }
+
+    const ModelChanges changes = diffModels(*pair.first, *pair.second);
+    if (changes.isEmpty())
+      continue;
+
+    printf("%s:\n", compareModelName(*pair.second).toUtf8().constData());
+    for (const auto & change : changes)
+      printf("  %s\n", change.description().toUtf8().constData());
+    differences += changes.size();
+  }
+
+  fflush(stdout);
+  return differences ? 1 : 0;
+}
+
 int main(int argc, char *argv[])
 {
   QApplication app(argc, argv);
@@ -254,6 +342,15 @@ int main(int argc, char *argv[])
 
   Firmware::setCurrentVariant(Firmware::getFirmwareForId(g.profile[g.id()].fwType()));
 
+  int compareIdx = args.indexOf("--compare");
+  if (compareIdx >= 0) {
+    if (compareIdx + 2 >= args.size()) {
+      printHelpText();
+      exit(2);
+    }
+    exit(compareModelFiles(args.at(compareIdx + 1), args.at(compareIdx + 2)));
+  }
+
   MainWindow *mainWin = new MainWindow();
   mainWin->show();
 
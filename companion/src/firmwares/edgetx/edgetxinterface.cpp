@@ -28,6 +28,7 @@
 #include "yaml_generalsettings.h"
 #include "yaml_modeldata.h"
 #include "labelvalidator.h"
+#include "version.h"
 
 #include <QMessageBox>
 
@@ -130,10 +131,32 @@ bool loadLabelsListFromYaml(RadioData::ModelLabels& labels,
 }
 
 
+ModelYamlDocument::ModelYamlDocument() = default;
+ModelYamlDocument::~ModelYamlDocument() = default;
+
+void ModelYamlDocument::parse(const QByteArray& data)
+{
+  node = std::make_unique<YAML::Node>(loadYamlFromByteArray(data));
+}
+
+void ModelYamlDocument::clear()
+{
+  node.reset();
+}
+
 bool loadModelFromYaml(ModelData& model, const QByteArray& data)
 {
-    YAML::Node node = loadYamlFromByteArray(data);
-    node >> model;
+  ModelYamlDocument document;
+  document.parse(data);
+  return loadModelFromYaml(model, document);
+}
+
+bool loadModelFromYaml(ModelData& model, const ModelYamlDocument& document)
+{
+  if (!document.node)
+    return false;
+
+  *document.node >> model;
 
   return true;
 }
@@ -189,6 +212,11 @@ bool writeLabelsListToYaml(const RadioData &radioData, QByteArray& data)
   return true;
 }
 
+void prepareModelsYamlWrite()
+{
+  modelSettingsVersion = SemanticVersion(VERSION);
+}
+
 bool writeModelToYaml(const ModelData& model, QByteArray& data)
 {
   YAML::Node node;
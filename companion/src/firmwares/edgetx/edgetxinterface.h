@@ -24,10 +24,15 @@
 #include "radiodata.h"
 #include <QByteArray>
 
+#include <memory>
 #include <string>
 #include <utility>
 #include <vector>
 
+namespace YAML {
+  class Node;
+}
+
 constexpr unsigned int CPN_CURRENT_SETTINGS_VERSION = { 221 };
 
 struct EtxModelMetadata {
@@ -43,11 +48,36 @@ bool loadLabelsListFromYaml(RadioData::ModelLabels& labels,
                             EtxModelfiles& modelFiles,
                             const QByteArray& data);
 
+// Model file parsed but not converted yet. Parsing only depends on the data
+// and can be done from any thread, whereas the conversion must be done from
+// the main thread (current firmware, settings version, warning dialogs).
+class ModelYamlDocument
+{
+  public:
+    ModelYamlDocument();
+    ~ModelYamlDocument();
+
+    // throws std::runtime_error on syntax errors
+    void parse(const QByteArray& data);
+    void clear();
+
+  private:
+    friend bool loadModelFromYaml(ModelData& model, const ModelYamlDocument& document);
+    std::unique_ptr<YAML::Node> node;
+};
+
 bool loadModelFromYaml(ModelData& model, const QByteArray& data);
+bool loadModelFromYaml(ModelData& model, const ModelYamlDocument& document);
 bool loadRadioSettingsFromYaml(GeneralSettings& settings, const QByteArray& data);
 
 bool writeLabelsListToYaml(const RadioData &radioData, QByteArray& data);
 
+// Sets the settings version shared with the decoders to the one models are
+// written with. Call it once, from the thread owning the models, before they
+// are encoded.
+void prepareModelsYamlWrite();
+// Only depends on the model and the current firmware, can be called from
+// any thread
 bool writeModelToYaml(const ModelData& model, QByteArray& data);
 bool writeRadioSettingsToYaml(const GeneralSettings& settings, QByteArray& data);
 
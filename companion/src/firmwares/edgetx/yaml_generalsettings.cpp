@@ -137,6 +137,12 @@ static const YamlLookupTable hatsModeLut = {
   {  GeneralSettings::HATSMODE_SWITCHABLE, "SWITCHABLE"  },
 };
 
+static const YamlLookupTable adcFilterLut = {
+  {  GeneralSettings::ADCFILTER_MMA, "MMA"  },
+  {  GeneralSettings::ADCFILTER_ONE_EURO, "ONE_EURO"  },
+  {  GeneralSettings::ADCFILTER_KALMAN, "KALMAN"  },
+};
+
 static const YamlLookupTable QMPageLut = {
   {  GeneralSettings::QM_NONE, "NONE" },
   {  GeneralSettings::QM_OPEN_QUICK_MENU, "OPEN_QUICK_MENU" },
@@ -286,6 +292,7 @@ Node convert<GeneralSettings>::encode(const GeneralSettings& rhs)
   node["bluetoothMode"] = bluetoothModeLut << rhs.bluetoothMode;
   node["countryCode"] = rhs.countryCode;
   node["noJitterFilter"] = (int)rhs.noJitterFilter;
+  node["adcFilter"] = adcFilterLut << rhs.adcFilter;
   node["disableRtcWarning"] = (int)rhs.rtcCheckDisable;  // TODO: verify
   node["audioMuteEnable"] = (int)rhs.muteIfNoSound;
   node["keysBacklight"] = (int)rhs.keysBacklight;
@@ -585,6 +592,7 @@ bool convert<GeneralSettings>::decode(const Node& node, GeneralSettings& rhs)
   node["countryCode"] >> rhs.countryCode;
   node["jitterFilter"] >> rhs.noJitterFilter;   // PR1363 : read old name and
   node["noJitterFilter"] >> rhs.noJitterFilter; // new, but don't write old
+  node["adcFilter"] >> adcFilterLut >> rhs.adcFilter;
   node["disableRtcWarning"] >> rhs.rtcCheckDisable;  // TODO: verify
   node["audioMuteEnable"] >> rhs.muteIfNoSound;
   node["keysBacklight"] >> rhs.keysBacklight;
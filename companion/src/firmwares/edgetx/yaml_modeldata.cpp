@@ -136,6 +136,9 @@ static const YamlLookupTable globalOnOffFilterLut = {
   {  0, "GLOBAL"  },
   {  1, "OFF"  },
   {  2, "ON"  },
+  {  3, "MMA"  },
+  {  4, "ONE_EURO"  },
+  {  5, "KALMAN"  },
 };
 
 static const YamlLookupTable usbJoystickIfModeLut = {
@@ -1026,8 +1029,6 @@ bool convert<CustomSwitchData>::decode(const Node& node, CustomSwitchData& rhs)
 
 Node convert<ModelData>::encode(const ModelData& rhs)
 {
-  modelSettingsVersion = SemanticVersion(VERSION);
-
   Node node;
   auto firmware = getCurrentFirmware();
   auto board = firmware->getBoard();
@@ -0,0 +1,335 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "yaml_modeldiff.h"
+#include "yaml_modeldata.h"
+
+#include <algorithm>
+#include <map>
+#include <set>
+#include <vector>
+
+// Leaf values of a node, by path ("flightModeData.1.trim[0].value")
+typedef std::map<std::string, std::string> FlatNode;
+
+static void flatten(const YAML::Node& node, const std::string& path,
+                    FlatNode& values)
+{
+  switch (node.Type()) {
+    case YAML::NodeType::Scalar:
+      values[path] = node.Scalar();
+      break;
+
+    case YAML::NodeType::Sequence:
+      for (size_t i = 0; i < node.size(); i++)
+        flatten(node[i], path + "[" + std::to_string(i) + "]", values);
+      break;
+
+    case YAML::NodeType::Map:
+      for (const auto& kv : node) {
+        const std::string& key = kv.first.Scalar();
+        flatten(kv.second, path.empty() ? key : path + "." + key, values);
+      }
+      break;
+
+    case YAML::NodeType::Null:
+      values[path] = "";
+      break;
+
+    default:
+      break;
+  }
+}
+
+static FlatNode flatten(const YAML::Node& node, const std::string& path = "")
+{
+  FlatNode values;
+  if (node)
+    flatten(node, path, values);
+  return values;
+}
+
+static QStringList compareValues(const FlatNode& from, const FlatNode& to)
+{
+  QStringList fields;
+  auto value = [](const std::string& v) { return QString::fromStdString(v); };
+
+  auto f = from.cbegin();
+  auto t = to.cbegin();
+  while (f != from.cend() || t != to.cend()) {
+    if (t == to.cend() || (f != from.cend() && f->first < t->first)) {
+      fields << QString("%1: %2 -> -").arg(value(f->first)).arg(value(f->second));
+      ++f;
+    } else if (f == from.cend() || t->first < f->first) {
+      fields << QString("%1: - -> %2").arg(value(t->first)).arg(value(t->second));
+      ++t;
+    } else {
+      if (f->second != t->second) {
+        fields << QString("%1: %2 -> %3")
+                      .arg(value(f->first))
+                      .arg(value(f->second))
+                      .arg(value(t->second));
+      }
+      ++f;
+      ++t;
+    }
+  }
+
+  return fields;
+}
+
+static ModelChange makeChange(ModelChange::Type type,
+                              ModelChange::Section section, int index,
+                              int fromLine = -1, int toLine = -1,
+                              const QStringList& fields = QStringList())
+{
+  ModelChange change;
+  change.type = type;
+  change.section = section;
+  change.index = index;
+  change.fromLine = fromLine;
+  change.toLine = toLine;
+  change.fields = fields;
+  return change;
+}
+
+// Lines of one channel: identical lines are matched in order (longest common
+// subsequence), the lines left between two matches are paired as changes and
+// the remaining ones are added or removed.
+static void diffLines(ModelChanges& changes, ModelChange::Section section,
+                      int channel, const std::vector<FlatNode>& from,
+                      const std::vector<FlatNode>& to)
+{
+  const size_t n = from.size();
+  const size_t m = to.size();
+
+  std::vector<std::vector<unsigned>> lcs(n + 1, std::vector<unsigned>(m + 1, 0));
+  for (size_t i = n; i-- > 0;) {
+    for (size_t j = m; j-- > 0;) {
+      lcs[i][j] = from[i] == to[j] ? lcs[i + 1][j + 1] + 1
+                                   : std::max(lcs[i + 1][j], lcs[i][j + 1]);
+    }
+  }
+
+  std::vector<size_t> removed, added;
+  auto flush = [&]() {
+    size_t paired = std::min(removed.size(), added.size());
+    for (size_t k = 0; k < paired; k++) {
+      changes << makeChange(ModelChange::Changed, section, channel, removed[k],
+                            added[k], compareValues(from[removed[k]], to[added[k]]));
+    }
+    for (size_t k = paired; k < removed.size(); k++)
+      changes << makeChange(ModelChange::Removed, section, channel, removed[k], -1);
+    for (size_t k = paired; k < added.size(); k++)
+      changes << makeChange(ModelChange::Added, section, channel, -1, added[k]);
+    removed.clear();
+    added.clear();
+  };
+
+  size_t i = 0, j = 0;
+  while (i < n || j < m) {
+    if (i < n && j < m && from[i] == to[j]) {
+      flush();
+      i++;
+      j++;
+    } else if (j < m && (i == n || lcs[i][j + 1] >= lcs[i + 1][j])) {
+      added.push_back(j++);
+    } else {
+      removed.push_back(i++);
+    }
+  }
+  flush();
+}
+
+// Inputs and mixes are stored as a list, each line giving its channel
+static void diffSequence(ModelChanges& changes, ModelChange::Section section,
+                         const YAML::Node& from, const YAML::Node& to,
+                         const char* channelKey)
+{
+  std::map<int, std::pair<std::vector<FlatNode>, std::vector<FlatNode>>> channels;
+
+  if (from && from.IsSequence()) {
+    for (const auto& line : from)
+      channels[line[channelKey].as<int>(-1)].first.push_back(flatten(line));
+  }
+
+  if (to && to.IsSequence()) {
+    for (const auto& line : to)
+      channels[line[channelKey].as<int>(-1)].second.push_back(flatten(line));
+  }
+
+  for (const auto& channel : channels) {
+    diffLines(changes, section, channel.first, channel.second.first,
+              channel.second.second);
+  }
+}
+
+// Logical switches and sensors are stored as a map, by number
+static void diffMap(ModelChanges& changes, ModelChange::Section section,
+                    const YAML::Node& from, const YAML::Node& to)
+{
+  std::map<int, FlatNode> fromItems, toItems;
+
+  if (from && from.IsMap()) {
+    for (const auto& kv : from)
+      fromItems[kv.first.as<int>(-1)] = flatten(kv.second);
+  }
+
+  if (to && to.IsMap()) {
+    for (const auto& kv : to)
+      toItems[kv.first.as<int>(-1)] = flatten(kv.second);
+  }
+
+  std::set<int> numbers;
+  for (const auto& item : fromItems)
+    numbers.insert(item.first);
+  for (const auto& item : toItems)
+    numbers.insert(item.first);
+
+  for (int number : numbers) {
+    auto a = fromItems.find(number);
+    auto b = toItems.find(number);
+
+    if (a == fromItems.end()) {
+      changes << makeChange(ModelChange::Added, section, number);
+    } else if (b == toItems.end()) {
+      changes << makeChange(ModelChange::Removed, section, number);
+    } else {
+      QStringList fields = compareValues(a->second, b->second);
+      if (!fields.isEmpty())
+        changes << makeChange(ModelChange::Changed, section, number, -1, -1, fields);
+    }
+  }
+}
+
+ModelChanges diffModelNodes(const YAML::Node& from, const YAML::Node& to)
+{
+  ModelChanges changes;
+
+  diffSequence(changes, ModelChange::Input, from["expoData"], to["expoData"], "chn");
+  diffSequence(changes, ModelChange::Mix, from["mixData"], to["mixData"], "destCh");
+  diffMap(changes, ModelChange::LogicalSwitch, from["logicalSw"], to["logicalSw"]);
+  diffMap(changes, ModelChange::Sensor, from["telemetrySensors"], to["telemetrySensors"]);
+
+  // everything else, by top level key
+  static const std::vector<std::string> sections = {
+      "expoData", "mixData", "logicalSw", "telemetrySensors"};
+
+  std::vector<std::string> keys;
+  for (const YAML::Node* node : {&from, &to}) {
+    if (!node->IsMap())
+      continue;
+    for (const auto& kv : *node) {
+      const std::string& key = kv.first.Scalar();
+      if (std::find(sections.begin(), sections.end(), key) == sections.end() &&
+          std::find(keys.begin(), keys.end(), key) == keys.end())
+        keys.push_back(key);
+    }
+  }
+
+  for (const auto& key : keys) {
+    const YAML::Node a = from[key];
+    const YAML::Node b = to[key];
+    QStringList fields = compareValues(flatten(a, key), flatten(b, key));
+    if (fields.isEmpty())
+      continue;
+
+    ModelChange change = makeChange(!a ? ModelChange::Added
+                                       : !b ? ModelChange::Removed
+                                            : ModelChange::Changed,
+                                    ModelChange::Other, -1, -1, -1, fields);
+    change.key = QString::fromStdString(key);
+    changes << change;
+  }
+
+  return changes;
+}
+
+ModelChanges diffModels(const ModelData& from, const ModelData& to)
+{
+  YAML::Node a, b;
+  a = from;
+  b = to;
+  return diffModelNodes(a, b);
+}
+
+// "2", or "2 -> 3" for a changed line which moved
+static QString lineText(int fromLine, int toLine)
+{
+  if (fromLine < 0)
+    return QString::number(toLine + 1);
+  if (toLine < 0 || toLine == fromLine)
+    return QString::number(fromLine + 1);
+  return QString("%1 -> %2").arg(fromLine + 1).arg(toLine + 1);
+}
+
+QString ModelChange::item() const
+{
+  switch (section) {
+    case Input:
+      return tr("Input I%1 line %2").arg(index + 1).arg(lineText(fromLine, toLine));
+    case Mix:
+      return tr("Mix CH%1 line %2").arg(index + 1).arg(lineText(fromLine, toLine));
+    case LogicalSwitch:
+      return tr("Logical switch L%1").arg(index + 1);
+    case Sensor:
+      return tr("Sensor %1").arg(index + 1);
+    default:
+      return key;
+  }
+}
+
+QString ModelChange::description() const
+{
+  QString text = QString("%1 %2").arg(item()).arg(typeName(type).toLower());
+  if (type == Changed && !fields.isEmpty())
+    text.append(": " % fields.join(", "));
+  return text;
+}
+
+QString ModelChange::typeName(Type type)
+{
+  switch (type) {
+    case Added:
+      return tr("Added");
+    case Removed:
+      return tr("Removed");
+    default:
+      return tr("Changed");
+  }
+}
+
+QString ModelChange::sectionName(Section section)
+{
+  switch (section) {
+    case Input:
+      return tr("Inputs");
+    case Mix:
+      return tr("Mixes");
+    case LogicalSwitch:
+      return tr("Logical Switches");
+    case Sensor:
+      return tr("Telemetry Sensors");
+    default:
+      return tr("Other");
+  }
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include "modeldata.h"
+
+#include <QCoreApplication>
+#include <QList>
+#include <QString>
+#include <QStringList>
+
+namespace YAML {
+class Node;
+}
+
+// One difference between two models, found by comparing their YAML trees.
+// Inputs and mixes are matched by channel then by line within the channel,
+// logical switches and sensors by number.
+struct ModelChange
+{
+  Q_DECLARE_TR_FUNCTIONS(ModelChange)
+
+ public:
+  enum Type {
+    Added,
+    Removed,
+    Changed
+  };
+
+  enum Section {
+    Input,
+    Mix,
+    LogicalSwitch,
+    Sensor,
+    Other
+  };
+
+  Type type;
+  Section section;
+  int index;           // input or output channel, logical switch or sensor (0 based), -1 for Other
+  int fromLine;        // line of the input or mix within its channel, in each
+  int toLine;          // model, -1 if not in that model or for other sections
+  QString key;         // top level key of the model, for Other
+  QStringList fields;  // "path: old -> new" for each differing value
+
+  QString item() const;
+  QString description() const;
+
+  static QString typeName(Type type);
+  static QString sectionName(Section section);
+};
+
+typedef QList<ModelChange> ModelChanges;
+
+ModelChanges diffModels(const ModelData& from, const ModelData& to);
+ModelChanges diffModelNodes(const YAML::Node& from, const YAML::Node& to);
@@ -724,6 +724,21 @@ QString GeneralSettings::hatsModeToString(int value)
   }
 }
 
+//  static
+QString GeneralSettings::adcFilterToString(int value)
+{
+  switch(value) {
+    case ADCFILTER_MMA:
+      return tr("MMA");
+    case ADCFILTER_ONE_EURO:
+      return tr("1-Euro");
+    case ADCFILTER_KALMAN:
+      return tr("Kalman");
+    default:
+      return CPN_STR_UNKNOWN_ITEM;
+  }
+}
+
 //  static
 AbstractStaticItemModel * GeneralSettings::hatsModeItemModel(bool radio_setup)
 {
@@ -202,6 +202,14 @@ class GeneralSettings {
       HATSMODE_COUNT
     };
 
+    // Match AdcFilter in radio/src/dataconstants.h
+    enum AdcFilter {
+      ADCFILTER_MMA,
+      ADCFILTER_ONE_EURO,
+      ADCFILTER_KALMAN,
+      ADCFILTER_COUNT
+    };
+
     enum PPMUnit {
       PPM_PERCENT_PREC0,
       PPM_PERCENT_PREC1,
@@ -358,6 +366,7 @@ class GeneralSettings {
     unsigned int rotarySteps;
     unsigned int countryCode;
     bool noJitterFilter;
+    unsigned int adcFilter;
     bool rtcCheckDisable;
     bool muteIfNoSound;
     bool keysBacklight;
@@ -497,6 +506,7 @@ class GeneralSettings {
     static FieldRange getTxCurrentCalibration();
     static QString uartSampleModeToString(int value);
     static QString hatsModeToString(int value);
+    static QString adcFilterToString(int value);
     static QString stickModeToString(int value);
     static QString templateSetupToString(int value, bool isBoardAir);
     static QString backlightModeToString(int value);
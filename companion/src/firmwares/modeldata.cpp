@@ -125,10 +125,130 @@ void ModelData::copy(const ModelData & src)
   usbJoystickCircularCut = src.usbJoystickCircularCut;
   memcpy(&usbJoystickCh[0], &src.usbJoystickCh[0], sizeof(usbJoystickCh[0]) * CPN_USBJ_MAX_JOYSTICK_CHANNELS);
   checklistData = src.checklistData;
+  yamlCache = src.yamlCache;
+  yamlCacheHash = src.yamlCacheHash;
   updRefList = nullptr;
   memset(&updRefInfo, 0, sizeof(updRefInfo));
 }
 
+template <class T>
+static void hashData(QCryptographicHash & hash, const T & data)
+{
+  hash.addData(QByteArray::fromRawData(reinterpret_cast<const char *>(&data), sizeof(data)));
+}
+
+static void hashData(QCryptographicHash & hash, const std::string & str)
+{
+  hashData(hash, str.size());
+  hash.addData(QByteArray::fromRawData(str.data(), str.size()));
+}
+
+static void hashData(QCryptographicHash & hash, const ZoneOptionValueTyped & option)
+{
+  hashData(hash, option.type);
+  hashData(hash, option.value.unsignedValue);
+  hashData(hash, option.value.signedValue);
+  hashData(hash, option.value.boolValue);
+  hashData(hash, option.value.stringValue);
+  hashData(hash, option.value.sourceValue.type);
+  hashData(hash, option.value.sourceValue.index);
+  hashData(hash, option.value.colorValue);
+}
+
+template <int N, int O>
+static void hashData(QCryptographicHash & hash, const WidgetsContainerPersistentData<N, O> & container)
+{
+  for (int i = 0; i < N; i++) {
+    hashData(hash, container.zones[i].widgetName);
+    for (int j = 0; j < MAX_WIDGET_OPTIONS; j++)
+      hashData(hash, container.zones[i].widgetData.options[j]);
+  }
+  for (int i = 0; i < O; i++)
+    hashData(hash, container.options[i]);
+}
+
+// Same fields as copy(). The plain data members are hashed with their
+// padding, which can only make an unchanged model look changed. A field
+// added to copy() but not here fails ModelDataHash.EveryCopiedByteChangesTheHash.
+void ModelData::hashContent(QCryptographicHash & hash) const
+{
+  hashData(hash, semver.str());
+  hashData(hash, name.str());
+  hashData(hash, filename.str());
+  hashData(hash, labels.str());
+  hashData(hash, timers);
+  hashData(hash, noGlobalFunctions);
+  hashData(hash, thrTrim);
+  hashData(hash, trimInc);
+  hashData(hash, trimsDisplay);
+  hashData(hash, disableThrottleWarning);
+  hashData(hash, enableCustomThrottleWarning);
+  hashData(hash, customThrottleWarningPosition);
+  hashData(hash, jitterFilter);
+  hashData(hash, beepANACenter);
+  hashData(hash, extendedLimits);
+  hashData(hash, extendedTrims);
+  hashData(hash, throttleReversed);
+  hashData(hash, checklistInteractive);
+  hashData(hash, flightModeData);
+  hashData(hash, mixData);
+  hashData(hash, limitData);
+  hashData(hash, inputNames);
+  hashData(hash, expoData);
+  hashData(hash, curves);
+  hashData(hash, logicalSw);
+  hashData(hash, customFn);
+  hashData(hash, swashRingData);
+  hashData(hash, thrTraceSrc);
+  hashData(hash, switchWarningStates);
+  hashData(hash, thrTrimSwitch);
+  hashData(hash, potsWarningMode);
+  hashData(hash, potsWarnEnabled);
+  hashData(hash, potsWarnPosition);
+  hashData(hash, displayChecklist);
+  hashData(hash, gvarData);
+  hashData(hash, mavlink);
+  hashData(hash, telemetryProtocol);
+  hashData(hash, frsky);
+  hashData(hash, rssiSource);
+  hashData(hash, rssiAlarms);
+  hashData(hash, showInstanceIds);
+  hashData(hash, bitmap);
+  hashData(hash, trainerMode);
+  hashData(hash, moduleData);
+  hashData(hash, scriptData);
+  hashData(hash, sensorData);
+  hashData(hash, toplcdTimer);
+  for (int i = 0; i < MAX_CUSTOM_SCREENS; i++) {
+    hashData(hash, customScreens.customScreenData[i].layoutId);
+    hashData(hash, customScreens.customScreenData[i].layoutPersistentData);
+  }
+  hashData(hash, topBarData);
+  hashData(hash, topbarWidgetWidth);
+  hashData(hash, view);
+  hashData(hash, registrationId);
+  hashData(hash, hatsMode);
+  hashData(hash, radioThemesDisabled);
+  hashData(hash, radioGFDisabled);
+  hashData(hash, radioTrainerDisabled);
+  hashData(hash, modelHeliDisabled);
+  hashData(hash, modelFMDisabled);
+  hashData(hash, modelCurvesDisabled);
+  hashData(hash, modelGVDisabled);
+  hashData(hash, modelLSDisabled);
+  hashData(hash, modelSFDisabled);
+  hashData(hash, modelCustomScriptsDisabled);
+  hashData(hash, modelTelemetryDisabled);
+  hashData(hash, customSwitches);
+  hashData(hash, cfsGroupOn);
+  hashData(hash, usbJoystickExtMode);
+  hashData(hash, usbJoystickIfMode);
+  hashData(hash, usbJoystickCircularCut);
+  hashData(hash, usbJoystickCh);
+  hashData(hash, checklistData.size());
+  hash.addData(checklistData);
+}
+
 ExpoData * ModelData::insertInput(const int idx)
 {
   memmove(&expoData[idx + 1], &expoData[idx], (CPN_MAX_EXPOS - (idx + 1)) * sizeof(ExpoData));
@@ -350,6 +470,8 @@ void ModelData::clear()
     usbJoystickCh[i].clear();
 
   checklistData.clear();
+  yamlCache.clear();
+  yamlCacheHash.clear();
 
   if (updRefList)
     delete updRefList;
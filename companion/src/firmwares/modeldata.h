@@ -239,6 +239,11 @@ class ModelData {
 
     QByteArray checklistData;
 
+    // Companion only, YAML written by the last save and the hash of the
+    // content it was encoded from, see LabelsStorageFormat::write()
+    QByteArray yamlCache;
+    QByteArray yamlCacheHash;
+
     ModelData & operator=(const ModelData & src);
 
     void convert(RadioDataConversionState & cstate);
@@ -255,6 +260,8 @@ class ModelData {
 
     void clear();
     void copy(const ModelData & src);
+    // adds all the model settings, the Companion only flags excepted
+    void hashContent(QCryptographicHash & hash) const;
     bool isEmpty() const;
     void setDefaultInputs(const GeneralSettings & settings);
     void setDefaultMixes(const GeneralSettings & settings);
@@ -215,6 +215,14 @@ HardwarePanel::HardwarePanel(QWidget * parent, GeneralSettings & generalSettings
   AutoCheckBox *filterEnable = new AutoCheckBox(this);
   filterEnable->setField(generalSettings.noJitterFilter, this, true);
   params->append(filterEnable);
+
+  AutoComboBox *filterType = new AutoComboBox(this);
+  for (int i = 0; i < GeneralSettings::ADCFILTER_COUNT; i++)
+    filterType->addItem(GeneralSettings::adcFilterToString(i), i);
+  filterType->setField(generalSettings.adcFilter, this);
+  filterType->setEnabled(!generalSettings.noJitterFilter);
+  params->append(filterType);
+  connect(filterEnable, &QCheckBox::toggled, filterType, &QWidget::setEnabled);
   addParams();
 
   if (Boards::getCapability(board, Board::HasAudioMuteGPIO)) {
@@ -30,19 +30,81 @@
 #include <unistd.h>
 #endif
 
+// Log table contents, read from the log only for the visible cells
+class TelemetryLogModel : public QAbstractTableModel
+{
+  public:
+    explicit TelemetryLogModel(const TelemetryLog & logData, QObject * parent = nullptr) :
+      QAbstractTableModel(parent),
+      logData(logData),
+      cachedRow(-1)
+    {
+    }
+
+    void beginReset()
+    {
+      beginResetModel();
+      cachedRow = -1;
+      cachedCells.clear();
+    }
+
+    void endReset()
+    {
+      endResetModel();
+    }
+
+    int rowCount(const QModelIndex & parent = QModelIndex()) const override
+    {
+      return parent.isValid() ? 0 : logData.rowCount();
+    }
+
+    int columnCount(const QModelIndex & parent = QModelIndex()) const override
+    {
+      return parent.isValid() ? 0 : logData.columnCount();
+    }
+
+    QVariant data(const QModelIndex & index, int role = Qt::DisplayRole) const override
+    {
+      if (!index.isValid() || role != Qt::DisplayRole)
+        return QVariant();
+
+      // cells of a row are requested one after the other
+      if (index.row() != cachedRow) {
+        cachedRow = index.row();
+        cachedCells = logData.cells(cachedRow);
+      }
+      return cachedCells.value(index.column());
+    }
+
+    QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override
+    {
+      if (orientation == Qt::Horizontal && role == Qt::DisplayRole)
+        return logData.columnNames().value(section);
+      return QAbstractTableModel::headerData(section, orientation, role);
+    }
+
+  private:
+    const TelemetryLog & logData;
+    mutable int cachedRow;
+    mutable QStringList cachedCells;
+};
+
 LogsDialog::LogsDialog(QWidget *parent) :
   QDialog(parent, Qt::WindowTitleHint | Qt::WindowSystemMenuHint),
   ui(new Ui::LogsDialog),
   tracerMaxAlt(0),
   cursorA(0),
   cursorB(0),
-  cursorLine(0)
+  cursorLine(0),
+  graphsSorted(true)
 {
-  csvlog.clear();
-
   ui->setupUi(this);
   setWindowIcon(CompanionIcon("logs.png"));
 
+  logModel = new TelemetryLogModel(logData, this);
+  ui->logTable->setModel(logModel);
+  ui->logTable->setSelectionBehavior(QAbstractItemView::SelectRows);
+
   plotLock=false;
 
   colors.append(Qt::green);
@@ -116,6 +178,8 @@ LogsDialog::LogsDialog(QWidget *parent) :
   connect(ui->customPlot, &QCustomPlot::mousePress, this, &LogsDialog::mousePress);
   connect(ui->customPlot, &QCustomPlot::mouseWheel, this, &LogsDialog::mouseWheel);
 
+  // only the visible part of the graphs is given to the plot:
+  connect(axisRect->axis(QCPAxis::atBottom), static_cast<void(QCPAxis::*)(const QCPRange&)>(&QCPAxis::rangeChanged), this, &LogsDialog::xAxisChangeRange);
   // make left axes transfer its range to right axes:
   connect(axisRect->axis(QCPAxis::atLeft), static_cast<void(QCPAxis::*)(const QCPRange&)>(&QCPAxis::rangeChanged), this, &LogsDialog::yAxisChangeRanges);
   // connect some interaction slots:
@@ -123,7 +187,7 @@ LogsDialog::LogsDialog(QWidget *parent) :
   connect(ui->customPlot, &QCustomPlot::axisDoubleClick, this, &LogsDialog::axisLabelDoubleClick);
   connect(ui->customPlot, &QCustomPlot::legendDoubleClick, this, &LogsDialog::legendDoubleClick);
   connect(ui->FieldsTW, &QTableWidget::itemSelectionChanged, this, &LogsDialog::plotLogs);
-  connect(ui->logTable, &QTableWidget::itemSelectionChanged, this, &LogsDialog::plotLogs);
+  connect(ui->logTable->selectionModel(), &QItemSelectionModel::selectionChanged, this, &LogsDialog::plotLogs);
   connect(ui->Reset_PB, &QPushButton::clicked, this, [this]() {
     ui->ZoomX_ChkB->setChecked(false);
     ui->ZoomY_ChkB->setChecked(false);
@@ -255,21 +319,29 @@ void LogsDialog::selectionChanged()
   }
 }
 
-QList<QStringList> LogsDialog::filterGePoints(const QList<QStringList> & input)
+QVector<int> LogsDialog::getSelectedRows() const
+{
+  QVector<int> rows;
+  for (const QItemSelectionRange & range : ui->logTable->selectionModel()->selection()) {
+    for (int row = range.top(); row <= range.bottom(); row++) {
+      rows.append(row);
+    }
+  }
+  std::sort(rows.begin(), rows.end());
+  rows.erase(std::unique(rows.begin(), rows.end()), rows.end());
+  return rows;
+}
+
+QList<QStringList> LogsDialog::filterGePoints()
 {
   QList<QStringList> result;
 
-  int n = input.count();
-  if (n == 0) {
+  if (logData.isEmpty()) {
     return result;
   }
 
-  int gpscol = 0;
-  for (int i=1; i<input.at(0).count(); i++) {
-    if (input.at(0).at(i) == "GPS") {
-      gpscol=i;
-    }
-  }
+  // first column is the timestamp (MSecsSinceEpoch)
+  int gpscol = logData.columnNames().lastIndexOf("GPS") + 1;
   if (gpscol == 0) {
     QMessageBox::critical(this, tr("Error: no GPS data found"),
       tr("The column containing GPS coordinates must be named \"GPS\".\n\n\
@@ -277,42 +349,43 @@ The columns for altitude \"GAlt\" and for speed \"GSpd\" are optional"));
     return result;
   }
 
-  result.append(input.at(0));
-  bool rangeSelected = ui->logTable->selectionModel()->selectedRows().length() > 0;
+  result.append(QStringList("MSecsSinceEpoch") << logData.columnNames());
+  QVector<int> selectedRows = getSelectedRows();
+  bool rangeSelected = !selectedRows.isEmpty();
+  int n = rangeSelected ? selectedRows.count() : logData.rowCount();
 
   GpsGlitchFilter glitchFilter;
   GpsLatLonFilter latLonFilter;
 
-  for (int i = 1; i < n; i++) {
-    if ((ui->logTable->item(i-1, 1)->isSelected() && rangeSelected) || !rangeSelected) {
-
-      GpsCoord coord = extractGpsCoordinates(input.at(i).at(gpscol));
+  for (int i = 0; i < n; i++) {
+    int row = rangeSelected ? selectedRows.at(i) : i;
+    QStringList record = QStringList(QString::number(logData.timestamp(row))) << logData.cells(row);
+    GpsCoord coord = extractGpsCoordinates(record.at(gpscol));
 
-      // glitch filter
-      if ( glitchFilter.isGlitch(coord) ) {
-        // qDebug() << "filterGePoints(): GPS glitch detected at" << i << coord.latitude << coord.longitude;
-        continue;
-      }
-
-      // lat long pair filter
-      if ( !latLonFilter.isValid(coord) ) {
-        // qDebug() << "filterGePoints(): Lat-Lon pair wrong, skipping at" << i << coord.latitude << coord.longitude;
-        continue;
-      }
+    // glitch filter
+    if ( glitchFilter.isGlitch(coord) ) {
+      // qDebug() << "filterGePoints(): GPS glitch detected at" << i << coord.latitude << coord.longitude;
+      continue;
+    }
 
-      // qDebug() << "point " << latitude << longitude;
-      result.append(input.at(i));
+    // lat long pair filter
+    if ( !latLonFilter.isValid(coord) ) {
+      // qDebug() << "filterGePoints(): Lat-Lon pair wrong, skipping at" << i << coord.latitude << coord.longitude;
+      continue;
     }
+
+    // qDebug() << "point " << latitude << longitude;
+    result.append(record);
   }
 
-  // qDebug() << "filterGePoints(): filtered from" << input.count() << "to " << result.count() << "points";
+  // qDebug() << "filterGePoints(): filtered from" << n << "to " << result.count() << "points";
   return result;
 }
 
 void LogsDialog::exportToGoogleEarth()
 {
   // filter data points
-  QList<QStringList> dataPoints = filterGePoints(csvlog);
+  QList<QStringList> dataPoints = filterGePoints();
   int n = dataPoints.count(); // number of points to export
   if (n == 0) return;
 
@@ -594,6 +667,7 @@ void LogsDialog::removeAllGraphs()
   axisRect->axis(QCPAxis::atRight, 1)->setVisible(false);
   axisRect->axis(QCPAxis::atRight, 1)->setSelectedParts(QCPAxis::spNone);
   axisRect->axis(QCPAxis::atBottom)->setSelectedParts(QCPAxis::spNone);
+  graphsCoords.clear();
   ui->customPlot->replot();
   tracerMaxAlt = 0;
   cursorA = 0;
@@ -612,50 +686,24 @@ void LogsDialog::fileOpen()
     //s1.report("Start");
 
     if (cvsFileParse()) {
+      const QStringList & names = logData.columnNames();
       ui->FieldsTW->clear();
-      ui->logTable->clear();
       ui->FieldsTW->setShowGrid(false);
       ui->FieldsTW->setContentsMargins(0, 0, 0, 0);
-      ui->FieldsTW->setRowCount(csvlog.at(0).count() - 2);
+      ui->FieldsTW->setRowCount(names.count() - 2);
       ui->FieldsTW->setColumnCount(1);
       ui->FieldsTW->setHorizontalHeaderLabels(QStringList(tr("Available fields")));
-      ui->logTable->setSelectionBehavior(QAbstractItemView::SelectRows);
 
-      for (int i = 3; i < csvlog.at(0).count(); i++) {
-        QTableWidgetItem* item= new QTableWidgetItem(csvlog.at(0).at(i));
-        ui->FieldsTW->setItem(i - 3, 0, item);
+      for (int i = 2; i < names.count(); i++) {
+        QTableWidgetItem* item= new QTableWidgetItem(names.at(i));
+        ui->FieldsTW->setItem(i - 2, 0, item);
       }
 
       ui->FieldsTW->resizeRowsToContents();
-      ui->logTable->setColumnCount(csvlog.at(0).count());
-      ui->logTable->setRowCount(csvlog.count() - 1);
-      ui->logTable->setHorizontalHeaderLabels(csvlog.at(0));
       //s1.report("Load fields");
 
-      QAbstractItemModel *model = ui->logTable->model();
-      for (int i = 1; i < csvlog.count(); i++) {
-        for (int j = 0; j < csvlog.at(0).count(); j++) {
-          model->setData(model->index(i - 1, j, QModelIndex()), csvlog.at(i).at(j));
-        }
-      }
-
-      //s1.report("Load data model");
-
-      ui->logTable->horizontalHeader()->setSectionResizeMode(QHeaderView::ResizeToContents);
-      QVarLengthArray<int> sizes;
-
-      for (int i = 0; i < ui->logTable->columnCount(); i++) {
-        sizes.append(ui->logTable->columnWidth(i));
-      }
-
-      ui->logTable->horizontalHeader()->setSectionResizeMode(QHeaderView::Interactive);
-
-      for (int i = 0; i < ui->logTable->columnCount(); i++) {
-        if (i == 0)
-          ui->logTable->setColumnHidden(i, true); // hide MSecsSinceEpoch column
-        else
-          ui->logTable->setColumnWidth(i, sizes.at(i));
-      }
+      // only a sample of the rows is used to size the columns
+      ui->logTable->resizeColumnsToContents();
 
       //s1.report("Adjust headers");
     }
@@ -667,40 +715,24 @@ void LogsDialog::saveSession()
   int index = ui->sessions_CB->currentIndex();
   // ignore index 0 is its all sessions combined
   if(index > 0) {
-    int n = csvlog.count();
-    QList<QStringList> sessionCsvLog;
-    // add CSV headers from first row of source file
-    sessionCsvLog.push_back(csvlog[0]);
-    // find session breaks
-    int currentSession = 0;
-    QDateTime lastvalue;
-    for (int i = 1; i < n; i++) {
-      QDateTime tmp = getRecordTimeStamp(i);
-      if (!lastvalue.isValid() || lastvalue.secsTo(tmp) > 60) {
-        currentSession++;
-      }
-      lastvalue = tmp;
-      if(currentSession == index) {
-        // add records to filtered list
-        sessionCsvLog.push_back(csvlog[i]);
-      }
-      else if (currentSession > index) {
-        break;
-      }
+    int first = ui->sessions_CB->itemData(index, Qt::UserRole).toInt();
+    int last = logData.rowCount();
+    if (index < ui->sessions_CB->count() - 1) {
+      last = ui->sessions_CB->itemData(index + 1, Qt::UserRole).toInt();
     }
-    // save the filtered records to a new file
+    // save the session records to a new file
     QString newFilename = logFilename;
     newFilename.append(QString("-Session%1.csv").arg(index));
     QString filename = QFileDialog::getSaveFileName(this, "Save log", newFilename, "CSV files (.csv);"); // getting the filename (full path)
     QFile data(filename);
     if(data.open(QFile::WriteOnly |QFile::Truncate)) {
       QTextStream output(&data);
-      int numRecords = sessionCsvLog.count();
-      for(int i = 0; i < numRecords; i++){
-        output << sessionCsvLog[i].join(",") << '\n';
+      // add CSV headers from first row of source file
+      output << logData.columnNames().join(",") << '\n';
+      for(int i = first; i < last; i++){
+        output << logData.line(i) << '\n';
       }
     }
-    sessionCsvLog.clear();
   }
 }
 
@@ -708,79 +740,28 @@ bool LogsDialog::cvsFileParse()
 {
   //Stopwatch s("Parse");
 
-  QFile file(ui->FileName_LE->text());
-  int errors=0;
-  int lines=-1;
+  // the fields of the previous log are not valid anymore
+  ui->FieldsTW->clear();
+
+  logModel->beginReset();
+  logFilename.clear();
+  bool loaded = logData.load(ui->FileName_LE->text());
+  logModel->endReset();
 
-  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) { // reading HEX TEXT file
+  if (!loaded) {
     return false;
   }
-  else {
-    csvlog.clear();
-    logFilename.clear();
-    QTextStream inputStream(&file);
-    QString buffer = file.readLine();
-
-    if (buffer.startsWith("Date,Time")) {
-      file.reset();
-    }
-    else {
-      return false;
-    }
-
-    int numfields=-1;
-    while (!file.atEnd()) {
-      QString line = file.readLine().trimmed();
-      QStringList columns = line.split(',');
-
-      if (numfields == -1) {
-        numfields=columns.count();
-      }
-
-      if (columns.count() == numfields) {
-        if (lines == -1) {
-          csvlog.append(QStringList("MSecsSinceEpoch") << columns);
-        } else {
-          // Qt v6.2 onwards QDateTime::fromString() is very slow
-          QStringList sDate = columns.at(0).split("-");
-          QStringList sTime = columns.at(1).split(":");
-          QStringList sSecs;
-
-          if (sTime.count() == 3) {
-            sSecs = sTime.at(2).split(".");
-
-            if (sSecs.count() == 1)
-              sSecs.append("0");
-          }
-
-          if (sDate.count() == 3 && sTime.count() == 3 && sSecs.count() == 2) {
-            QDate d(sDate.at(0).toInt(), sDate.at(1).toInt(), sDate.at(2).toInt());
-            QTime t(sTime.at(0).toInt(), sTime.at(1).toInt(), sSecs.at(0).toInt(), sSecs.at(1).toInt());
-            QDateTime dt(d, t);
-            //qDebug() << dt << dt.toString() << dt.toMSecsSinceEpoch() << QDateTime::fromMSecsSinceEpoch(dt.toMSecsSinceEpoch());
-            csvlog.append(QStringList(QString::number(dt.toMSecsSinceEpoch())) << columns);
-            //qDebug() << csvlog.at(csvlog.count() - 1);
-          } else {
-            errors++;
-          }
-        }
-      } else {
-        errors++;
-      }
-      lines++;
-    }
 
-    logFilename = QFileInfo(file.fileName()).baseName();
-  }
+  logFilename = QFileInfo(ui->FileName_LE->text()).baseName();
 
-  file.close();
-  if (errors > 1) {
-    QMessageBox::warning(this, CPN_STR_APP_NAME, tr("The selected logfile contains %1 invalid lines out of  %2 total lines").arg(errors).arg(lines));
+  if (logData.errors() > 1) {
+    QMessageBox::warning(this, CPN_STR_APP_NAME, tr("The selected logfile contains %1 invalid lines out of  %2 total lines").arg(logData.errors()).arg(logData.lines()));
   }
 
-  int n = csvlog.count();
-  if (n == 1) {
-    csvlog.clear();
+  if (logData.isEmpty()) {
+    logModel->beginReset();
+    logData.clear();
+    logModel->endReset();
     return false;
   }
 
@@ -800,10 +781,9 @@ struct FlightSession {
   QDateTime end;
 };
 
-QDateTime LogsDialog::getRecordTimeStamp(int index)
+QDateTime LogsDialog::getRecordTimeStamp(int row)
 {
-  //qDebug() << csvlog.at(index).at(0).toLongLong() << QDateTime::fromMSecsSinceEpoch(csvlog.at(index).at(0).toLongLong());
-  return QDateTime::fromMSecsSinceEpoch(csvlog.at(index).at(0).toLongLong());
+  return QDateTime::fromMSecsSinceEpoch(logData.timestamp(row));
 }
 
 QString LogsDialog::generateDuration(const QDateTime & start, const QDateTime & end)
@@ -825,21 +805,18 @@ void LogsDialog::setFlightSessions()
   ui->sessions_CB->clear();
   ui->SaveSession_PB->setEnabled(false);
 
-  int n = csvlog.count();
+  int n = logData.rowCount();
   // qDebug() << "records" << n;
 
-  // find session breaks
+  // find session breaks (first row of each session)
   QList<int> sessions;
-  QDateTime lastvalue;
-  for (int i = 1; i < n; i++) {
-    QDateTime tmp = getRecordTimeStamp(i);
-    if (!lastvalue.isValid() || lastvalue.secsTo(tmp) > 60) {
-      sessions.push_back(i-1);
-      // qDebug() << "session index" << i-1;
+  for (int i = 0; i < n; i++) {
+    if (i == 0 || logData.timestamp(i) / 1000 - logData.timestamp(i - 1) / 1000 > 60) {
+      sessions.push_back(i);
+      // qDebug() << "session index" << i;
     }
-    lastvalue = tmp;
   }
-  sessions.push_back(n-1);
+  sessions.push_back(n);
 
   //s.report("Breaks found");
 
@@ -848,14 +825,14 @@ void LogsDialog::setFlightSessions()
   int noSesions = sessions.size() - 1;
   QString label = QString("%1 ").arg(noSesions);
   label += tr(noSesions > 1 ? "sessions" : "session");
-  label += " <" + tr("time span ") + generateDuration(getRecordTimeStamp(1), getRecordTimeStamp(n - 1)) + ">";
+  label += " <" + tr("time span ") + generateDuration(getRecordTimeStamp(0), getRecordTimeStamp(n - 1)) + ">";
   ui->sessions_CB->addItem(label);
 
   // add individual sessions
   if (sessions.size() > 2) {
     for (int i = 1; i < sessions.size(); i++) {
-      QDateTime sessionStart = getRecordTimeStamp(sessions.at(i - 1) + 1);
-      QDateTime sessionEnd = getRecordTimeStamp(sessions.at(i));
+      QDateTime sessionStart = getRecordTimeStamp(sessions.at(i - 1));
+      QDateTime sessionEnd = getRecordTimeStamp(sessions.at(i) - 1);
       QString label = sessionStart.toString("HH:mm:ss") + " <" + tr("duration ") + generateDuration(sessionStart, sessionEnd) + ">";
       ui->sessions_CB->addItem(label, sessions.at(i - 1));
       // qDebug() << "added label" << label << sessions.at(i-1);
@@ -877,13 +854,13 @@ void LogsDialog::sessionsCurrentIndexChanged(int index)
     if (index < ui->sessions_CB->count() - 1) {
       bottom = ui->sessions_CB->itemData(index + 1, Qt::UserRole).toInt();
     } else {
-      bottom = ui->logTable->rowCount();
+      bottom = logModel->rowCount();
     }
 
     QModelIndex topLeft = ui->logTable->model()->index(
       ui->sessions_CB->itemData(index, Qt::UserRole).toInt(), 0 , QModelIndex());
     QModelIndex bottomRight = ui->logTable->model()->index(
-      bottom - 1, ui->logTable->columnCount() - 1, QModelIndex());
+      bottom - 1, logModel->columnCount() - 1, QModelIndex());
 
     QItemSelection selection(topLeft, bottomRight);
     ui->logTable->selectionModel()->select(selection, QItemSelectionModel::Select);
@@ -905,28 +882,19 @@ std::pair<double, double> LogsDialog::GetMinMaxY() const
   bool found = false;
 
   // determine selected rows in the log table
-  QModelIndexList sel = ui->logTable->selectionModel()->selectedRows();
-  bool hasSelection = !sel.isEmpty();
-  QVarLengthArray<int> selectedRows;
-
-  if (hasSelection) {
-    selectedRows.reserve(sel.size());
-    for (const QModelIndex &idx : sel) selectedRows.append(idx.row());
-  }
+  QVector<int> selectedRows = getSelectedRows();
+  bool hasSelection = !selectedRows.isEmpty();
 
   // iterate over selected fields and rows to compute global min/max Y
   for (QTableWidgetItem *fieldItem : ui->FieldsTW->selectedItems()) {
     const int col = fieldItem->row() + 2;  // Date and Time are first two columns
-    const int rows = hasSelection ? selectedRows.length() : ui->logTable->rowCount();
+    const QVector<double> & values = logData.values(col);
+    const int rows = hasSelection ? selectedRows.count() : values.count();
 
     for (int r = 0; r < rows; ++r) {
-      const int tableRow = hasSelection ? selectedRows.at(r) : r;
-      QTableWidgetItem *cell = ui->logTable->item(tableRow, col);
-      if (!cell) continue;
-
-      bool ok = false;
-      const double v = cell->text().toDouble(&ok);
-      if (!ok) continue;
+      const int row = hasSelection ? selectedRows.at(r) : r;
+      if (!logData.isNumeric(row, col)) continue;
+      const double v = values.at(row);
 
       if (!found) {
         minVal = maxVal = v;
@@ -954,67 +922,46 @@ void LogsDialog::plotLogs()
   //Stopwatch s("Plot");
   plotsCollection plots;
 
-  QModelIndexList selection = ui->logTable->selectionModel()->selectedRows();
-  int rowCount = selection.length();
-  bool hasLogSelection;
+  QVector<int> selectedRows = getSelectedRows();
+  bool hasLogSelection = !selectedRows.isEmpty();
+  int rowCount = hasLogSelection ? selectedRows.count() : logData.rowCount();
   bool useCommonAxes = ui->CommonAxes_ChkB->isChecked();
-  QVarLengthArray<int> selectedRows;
 
+  //s.report("Row count");
+
+  // time keys, shared by all plots
+  QVector<double> keys(rowCount);
+  for (int row = 0; row < rowCount; row++) {
+    keys[row] = logData.timestamp(hasLogSelection ? selectedRows.at(row) : row) / 1000.0;
+  }
+
+  graphsSorted = std::is_sorted(keys.begin(), keys.end());
   if (rowCount) {
-    hasLogSelection = true;
-    foreach (QModelIndex index, selection) {
-      selectedRows.append(index.row());
-    }
-    std::sort(selectedRows.begin(), selectedRows.end());
+    auto [minKey, maxKey] = std::minmax_element(keys.begin(), keys.end());
+    plots.min_x = *minKey;
+    plots.max_x = *maxKey;
   } else {
-    hasLogSelection = false;
-    rowCount = ui->logTable->rowCount();
+    plots.min_x = INVALID_MIN;
+    plots.max_x = 0;
   }
 
-  //s.report("Row count");
-
-  plots.min_x = INVALID_MIN;
-  plots.max_x = 0;
-
   foreach (QTableWidgetItem *plot, ui->FieldsTW->selectedItems()) {
     coords_t plotCoords;
-    int plotColumn = plot->row() + 3; // Epoch, Date and Time first
+    const QVector<double> & values = logData.values(plot->row() + 2); // Date and Time first
 
     plotCoords.min_y = INVALID_MIN;
     plotCoords.max_y = INVALID_MAX;
     plotCoords.yaxis = firstLeft;
     plotCoords.name = plot->text();
+    plotCoords.x = keys;
+    plotCoords.y.resize(rowCount);
 
     for (int row = 0; row < rowCount; row++) {
-      QTableWidgetItem *logValue;
-      double y;
-      double time;
-      QDateTime datetime;
-
-      if (hasLogSelection) {
-        logValue = ui->logTable->item(selectedRows.at(row), plotColumn);
-        datetime = QDateTime::fromMSecsSinceEpoch(ui->logTable->item(selectedRows.at(row), 0)->text().toLongLong());
-      } else {
-        logValue = ui->logTable->item(row, plotColumn);
-        datetime = QDateTime::fromMSecsSinceEpoch(ui->logTable->item(row, 0)->text().toLongLong());
-      }
-
-      y = logValue->text().toDouble();
-      plotCoords.y.push_back(y);
+      double y = values.at(hasLogSelection ? selectedRows.at(row) : row);
+      plotCoords.y[row] = y;
 
       if (plotCoords.min_y > y) plotCoords.min_y = y;
       if (plotCoords.max_y < y) plotCoords.max_y = y;
-
-      time = QCPAxisTickerDateTime::dateTimeToKey(datetime);
-
-      plotCoords.x.push_back(time);
-
-      if(plots.min_x == INVALID_MIN)
-        plots.min_x = time;
-      else
-        if (plots.min_x > time) plots.min_x = time;
-
-      if (plots.max_x < time) plots.max_x = time;
     }
 
     double range_inc = (plotCoords.max_y - plotCoords.min_y) / 100;
@@ -1111,6 +1058,7 @@ void LogsDialog::plotLogs()
   }
 
   removeAllGraphs();
+  graphsCoords = QVector<coords_t>(plots.coords.begin(), plots.coords.end());
 
   //s.report("Remove existing graphs");
 
@@ -1193,8 +1141,7 @@ void LogsDialog::plotLogs()
 
     //s.report("Legend");
 
-    ui->customPlot->graph(i)->setData(plots.coords.at(i).x,
-      plots.coords.at(i).y);
+    updateGraphData(i);
     pen.setColor(colors.at(i % colors.size()));
     ui->customPlot->graph(i)->setPen(pen);
 
@@ -1218,6 +1165,32 @@ void LogsDialog::plotLogs()
   //s.report("Refresh graph");
 }
 
+void LogsDialog::updateGraphData(int index)
+{
+  const coords_t & c = graphsCoords.at(index);
+
+  if (!graphsSorted) {
+    ui->customPlot->graph(index)->setData(c.x, c.y);
+    return;
+  }
+
+  // two points per pixel column are enough to draw the graph
+  const QCPRange range = axisRect->axis(QCPAxis::atBottom)->range();
+  QVector<double> x, y;
+  TelemetryLog::decimate(c.x, c.y, range.lower, range.upper, axisRect->width(), x, y);
+  ui->customPlot->graph(index)->setData(x, y, true);
+}
+
+void LogsDialog::xAxisChangeRange(QCPRange range)
+{
+  Q_UNUSED(range);
+
+  // graphs are created after the range is set
+  for (int i = 0; i < graphsCoords.count() && i < ui->customPlot->graphCount(); i++) {
+    updateGraphData(i);
+  }
+}
+
 void LogsDialog::yAxisChangeRanges(QCPRange range)
 {
   if (axisRect->axis(QCPAxis::atRight)->visible()) {
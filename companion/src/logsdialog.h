@@ -24,6 +24,7 @@
 #include <QtCore>
 #include <QDialog>
 #include "qcustomplot.h"
+#include "telemetrylog.h"
 
 #define INVALID_MIN 999999
 #define INVALID_MAX -999999
@@ -32,6 +33,8 @@ namespace Ui {
   class LogsDialog;
 }
 
+class TelemetryLogModel;
+
 class LogsDialog : public QDialog
 {
   Q_OBJECT
@@ -81,11 +84,13 @@ private slots:
   void saveSession();
   void sessionsCurrentIndexChanged(int index);
   void mapsButtonClicked();
+  void xAxisChangeRange(QCPRange range);
   void yAxisChangeRanges(QCPRange range);
   std::pair<double, double> GetMinMaxY() const;
 
 private:
-  QList<QStringList> csvlog;
+  TelemetryLog logData;
+  TelemetryLogModel *logModel;
   Ui::LogsDialog *ui;
   QCPAxisRect *axisRect;
   QCPLegend *rightLegend;
@@ -103,13 +108,19 @@ private:
   QCPItemTracer * cursorB;
   QCPItemStraightLine * cursorLine;
 
+  // Full resolution data of the graphs, decimated to the visible range
+  QVector<coords_t> graphsCoords;
+  bool graphsSorted;
+
   bool cvsFileParse();
-  QList<QStringList> filterGePoints(const QList<QStringList> & input);
+  QVector<int> getSelectedRows() const;
+  QList<QStringList> filterGePoints();
   void exportToGoogleEarth();
-  QDateTime getRecordTimeStamp(int index);
+  QDateTime getRecordTimeStamp(int row);
   QString generateDuration(const QDateTime & start, const QDateTime & end);
   void setFlightSessions();
 
+  void updateGraphData(int index);
   void addMaxAltitudeMarker(const coords_t & c, QCPGraph * graph);
   void countNumberOfThrows(const coords_t & c, QCPGraph * graph);
   void addCursor(QCPItemTracer ** cursor, QCPGraph * graph, const QColor & color);
@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "modelimagecache.h"
+
+#include <QCoreApplication>
+#include <QCryptographicHash>
+
+#define MODEL_IMAGE_THUMBNAIL_SIZE  QSize(40, 24)
+
+ModelImageCache::ModelImageCache(const QSize & size, int maxCost, QObject * parent):
+  QObject(parent),
+  size(size),
+  thumbnails(maxCost)
+{
+}
+
+ModelImageCache::~ModelImageCache()
+{
+  // the results still queued are dropped with this object
+  pool.clear();
+  pool.waitForDone();
+}
+
+ModelImageCache * ModelImageCache::instance()
+{
+  static ModelImageCache * cache = new ModelImageCache(MODEL_IMAGE_THUMBNAIL_SIZE, MODEL_IMAGE_CACHE_COST, qApp);
+  return cache;
+}
+
+QImage ModelImageCache::thumbnail(const QString & path)
+{
+  auto it = files.find(path);
+  if (it == files.end() || it->checked != generation) {
+    const QFileInfo info(path);
+    const qint64 size = info.isFile() ? info.size() : -1;
+    if (it == files.end() || it->size != size || it->modified != info.lastModified())
+      it = files.insert(path, { size, info.lastModified(), QByteArray(), generation });  // unknown or changed
+    else
+      it->checked = generation;
+  }
+
+  if (it->size < 0 || invalid.contains(it->hash))
+    return QImage();
+
+  if (!it->hash.isEmpty()) {
+    if (QImage * image = thumbnails.object(it->hash))
+      return *image;
+  }
+
+  // not read yet, or evicted
+  request(path, *it);
+  return QImage();
+}
+
+bool ModelImageCache::contains(const QString & path) const
+{
+  auto it = files.constFind(path);
+  return it != files.cend() && thumbnails.contains(it->hash);
+}
+
+void ModelImageCache::clear()
+{
+  files.clear();
+  thumbnails.clear();
+  invalid.clear();
+}
+
+void ModelImageCache::request(const QString & path, const FileEntry & entry)
+{
+  if (pending.contains(path))
+    return;
+
+  pending.insert(path);
+
+  pool.start([this, path, entry]() {
+    QFile file(path);
+    QByteArray data;
+    if (file.open(QIODevice::ReadOnly))
+      data = file.readAll();
+
+    FileEntry read = entry;
+    read.hash = QCryptographicHash::hash(data, QCryptographicHash::Sha1);
+    QMetaObject::invokeMethod(this, [this, path, read, data]() {
+      onFileRead(path, read, data);
+    }, Qt::QueuedConnection);
+  });
+}
+
+void ModelImageCache::onFileRead(const QString & path, const FileEntry & entry, const QByteArray & data)
+{
+  files.insert(path, entry);
+
+  if (data.isEmpty() || invalid.contains(entry.hash)) {
+    invalid.insert(entry.hash);
+    pending.remove(path);
+    return;
+  }
+
+  if (thumbnails.contains(entry.hash)) {
+    pending.remove(path);
+    emit thumbnailReady(path);
+    return;
+  }
+
+  // same contents already being decoded for another path
+  QStringList & paths = decoding[entry.hash];
+  paths.append(path);
+  if (paths.size() > 1)
+    return;
+
+  const QByteArray hash = entry.hash;
+  const QSize thumbnailSize = size;
+  pool.start([this, hash, data, thumbnailSize]() {
+    QImage image;
+    if (image.loadFromData(data))
+      image = image.scaled(thumbnailSize, Qt::KeepAspectRatio, Qt::SmoothTransformation);
+    QMetaObject::invokeMethod(this, [this, hash, image]() {
+      onDecoded(hash, image);
+    }, Qt::QueuedConnection);
+  });
+}
+
+void ModelImageCache::onDecoded(const QByteArray & hash, const QImage & image)
+{
+  decodes++;
+
+  if (image.isNull())
+    invalid.insert(hash);
+  else
+    thumbnails.insert(hash, new QImage(image), qMax(1, (int)(image.sizeInBytes() / 1024)));
+
+  for (const QString & path : decoding.take(hash)) {
+    pending.remove(path);
+    if (!image.isNull())
+      emit thumbnailReady(path);
+  }
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include <QtCore>
+#include <QImage>
+
+#define MODEL_IMAGE_CACHE_COST  8192  // KB
+
+// Thumbnails of the model images, for the model lists.
+//
+// An image file is read, hashed and decoded on a worker thread the first time
+// its thumbnail is asked for. Thumbnails are kept by hash of the file
+// contents, so that identical files (e.g. extracted again by a reload) are
+// only decoded once, and the least recently used ones are evicted when the
+// cache exceeds its cost.
+//
+// A file is only checked for changes (size, date) the first time it is asked
+// for after revalidate(), which the model lists call when they are reloaded,
+// so that painting them does not access the disk.
+class ModelImageCache : public QObject
+{
+    Q_OBJECT
+
+  public:
+    explicit ModelImageCache(const QSize & size, int maxCost = MODEL_IMAGE_CACHE_COST,
+                             QObject * parent = nullptr);
+    virtual ~ModelImageCache();
+
+    // Cache shared by the model lists
+    static ModelImageCache * instance();
+
+    QSize thumbnailSize() const { return size; }
+
+    // Null image until thumbnailReady() is emitted for this path
+    QImage thumbnail(const QString & path);
+    bool contains(const QString & path) const;
+
+    // Check the files again on their next thumbnail()
+    void revalidate() { generation++; }
+
+    // Cost of the thumbnails, in KB
+    void setMaxCost(int cost) { thumbnails.setMaxCost(cost); }
+    int maxCost() const { return thumbnails.maxCost(); }
+    int totalCost() const { return thumbnails.totalCost(); }
+
+    void clear();
+
+    // Images decoded so far
+    int decodeCount() const { return decodes; }
+
+  signals:
+    void thumbnailReady(const QString & path);
+
+  private:
+    struct FileEntry {
+      qint64 size;        // -1 if not a file
+      QDateTime modified;
+      QByteArray hash;    // empty until read
+      quint32 checked;    // generation of the last check
+    };
+
+    void request(const QString & path, const FileEntry & entry);
+    void onFileRead(const QString & path, const FileEntry & entry, const QByteArray & data);
+    void onDecoded(const QByteArray & hash, const QImage & image);
+
+    const QSize size;
+    QThreadPool pool;
+    QHash<QString, FileEntry> files;        // image hash of each path
+    quint32 generation = 0;
+    QCache<QByteArray, QImage> thumbnails;  // by image hash
+    QSet<QByteArray> invalid;               // images which cannot be decoded
+    QSet<QString> pending;                  // paths being read or decoded
+    QHash<QByteArray, QStringList> decoding;
+    int decodes = 0;
+};
@@ -21,6 +21,8 @@
 
 #include "modelslist.h"
 #include "edgetxinterface.h"
+#include "helpers.h"
+#include "modelimagecache.h"
 
 ModelListItem::ModelListItem(const QVector<QVariant> & itemData):
   itemData(itemData),
@@ -134,6 +136,7 @@ ModelsListModel::ModelsListModel(RadioData * radioData, QObject * parent):
   radioData(radioData)
 {
   hasLabels = getCurrentFirmware()->getCapability(Capability::HasModelLabels);
+  hasImages = getCurrentFirmware()->getCapability(Capability::HasModelImage);
   QVector<QVariant> labels;
   if (!hasLabels)
     labels << tr("Index");
@@ -151,6 +154,9 @@ ModelsListModel::ModelsListModel(RadioData * radioData, QObject * parent):
   refresh();
   //connect(this, &QAbstractItemModel::rowsAboutToBeRemoved, this, &ModelsListModel::onRowsAboutToBeRemoved);
   connect(this, &QAbstractItemModel::rowsRemoved, this, &ModelsListModel::onRowsRemoved);
+
+  if (hasImages)
+    connect(ModelImageCache::instance(), &ModelImageCache::thumbnailReady, this, &ModelsListModel::onThumbnailReady);
 }
 
 ModelsListModel::~ModelsListModel()
@@ -183,6 +189,17 @@ QVariant ModelsListModel::data(const QModelIndex & index, int role) const
     return font;
   }
 
+  // thumbnails are decoded in the background and shown once ready
+  if (role == Qt::DecorationRole && hasImages && item->isModel() && index.column() == (hasLabels ? 0 : 1)) {
+    const QString path = imagePath(item->getModelIndex());
+    if (!path.isEmpty()) {
+      const QImage image = ModelImageCache::instance()->thumbnail(path);
+      if (!image.isNull())
+        return image;
+    }
+    return QVariant();
+  }
+
   if (role == Qt::ForegroundRole && (item->getFlags() & ModelListItem::MarkedForCut)) {
     return QPalette().brush(QPalette::Disabled, QPalette::Text);
   }
@@ -478,6 +495,7 @@ void ModelsListModel::encodeModelsData(const QModelIndexList & indexes, QByteArr
   QDataStream out(data, QIODevice::WriteOnly);
   out << mdlCnt;
 
+  prepareModelsYamlWrite();
   foreach (const QModelIndex &index, indexes) {
     if (index.isValid() && index.column() == 0) {
       ModelData &modelData = radioData->models[getModelIndex(index)];
@@ -638,6 +656,34 @@ QModelIndex ModelsListModel::getIndexForModel(const int modelIndex, QModelIndex
   return QModelIndex();
 }
 
+QString ModelsListModel::imagePath(int modelIndex) const
+{
+  const ModelData & model = radioData->models[modelIndex];
+  if (model.isBitmapEmpty())
+    return QString();
+
+  const QString filename = model.getImageFilename();
+  auto it = imagePaths.constFind(filename);
+  if (it == imagePaths.cend())
+    it = imagePaths.insert(filename, Helpers::getImagePath(filename));
+
+  return it.value();
+}
+
+void ModelsListModel::onThumbnailReady(const QString & path)
+{
+  for (unsigned i = 0; i < radioData->models.size(); i++) {
+    if (imagePath(i) != path)
+      continue;
+
+    QModelIndex idx = getIndexForModel(i);
+    if (idx.isValid()) {
+      idx = idx.siblingAtColumn(hasLabels ? 0 : 1);
+      emit dataChanged(idx, idx, { Qt::DecorationRole });
+    }
+  }
+}
+
 int ModelsListModel::getModelIndex(const QModelIndex & index) const
 {
   return getItem(index)->getModelIndex();
@@ -698,6 +744,9 @@ void ModelsListModel::refresh()
   removeRows(0, rowCount());
   this->blockSignals(false);
 
+  imagePaths.clear();
+  ModelImageCache::instance()->revalidate();
+
   for (unsigned i = 0; i < radioData->models.size(); i++) {
     ModelData & model = radioData->models[i];
     int currentColumn = 0;
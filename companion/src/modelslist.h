@@ -152,15 +152,19 @@ class ModelsListModel : public QAbstractItemModel
   private slots:
     //void onRowsAboutToBeRemoved(const QModelIndex & parent, int first, int last);
     void onRowsRemoved(const QModelIndex & parent, int first, int last);
+    void onThumbnailReady(const QString & path);
 
   private:
     ModelListItem * getItem(const QModelIndex & index) const;
     bool isModelIdUnique(unsigned modelId, unsigned module, unsigned protocol);
+    QString imagePath(int modelIndex) const;
 
     ModelListItem * rootItem;
     RadioData * radioData;
     MimeHeaderData mimeHeaderData;
     bool hasLabels;
+    bool hasImages;
+    mutable QHash<QString, QString> imagePaths;  // by image file name, until refreshed
     QString filename;
 };
 
@@ -25,17 +25,22 @@
 #include "helpers.h"
 #include "modelslist.h"
 #include "styleeditdialog.h"
+#include "yaml_modeldiff.h"
 #include <QtPrintSupport/QPrinter>
 #include <QtPrintSupport/QPrintDialog>
 
 CompareDialog::CompareDialog(QWidget * parent, Firmware * firmware):
   QDialog(parent, Qt::Window),
   multimodelprinter(new MultiModelPrinter(firmware)),
-  ui(new Ui::CompareDialog)
+  ui(new Ui::CompareDialog),
+  detailsDirty(false),
+  detailsComplete(false)
 {
   ui->setupUi(this);
   setWindowIcon(CompanionIcon("compare.png"));
   setAcceptDrops(true);
+  ui->changesTree->header()->setSectionResizeMode(QHeaderView::ResizeToContents);
+  connect(multimodelprinter, &MultiModelPrinter::sectionsAdded, this, &CompareDialog::onDetailsSectionsAdded);
   if (!g.compareWinGeo().isEmpty()) {
     restoreGeometry(g.compareWinGeo());
   }
@@ -118,11 +123,7 @@ void CompareDialog::compare()
     delete child;
   }
 
-  multimodelprinter->clearModels();
-  ui->textEdit->clear();
-
   for (int i=0; i < modelsList.size(); ++i) {
-    multimodelprinter->setModel(i, &modelsList[i].model, &modelsList[i].gs);
     QString name(modelsList.at(i).model.name.toQString());
     if (name.isEmpty())
       name = tr("Unnamed Model %1").arg(i+1);
@@ -145,8 +146,91 @@ void CompareDialog::compare()
 
     ui->layout_modelNames->addWidget(hdr);
   }
-  if (modelsList.size())
+
+  updateChanges();
+
+  // the side by side document is only rendered when shown or printed
+  detailsDirty = true;
+  if (ui->tabWidget->currentWidget() == ui->tabDetails)
+    updateDetails();
+}
+
+void CompareDialog::updateChanges()
+{
+  ui->changesTree->clear();
+
+  if (modelsList.size() < 2)
+    return;
+
+  const ModelData & reference = modelsList.at(0).model;
+
+  for (int i = 1; i < modelsList.size(); ++i) {
+    const ModelData & model = modelsList.at(i).model;
+    QTreeWidgetItem * modelItem = new QTreeWidgetItem(ui->changesTree);
+    modelItem->setText(0, tr("%1 vs %2").arg(model.name.toQString()).arg(reference.name.toQString()));
+    modelItem->setFirstColumnSpanned(true);
+
+    const ModelChanges changes = diffModels(reference, model);
+    if (changes.isEmpty()) {
+      QTreeWidgetItem * item = new QTreeWidgetItem(modelItem);
+      item->setText(0, tr("No differences"));
+    }
+
+    QMap<int, QTreeWidgetItem *> sections;
+    for (const ModelChange & change : changes) {
+      QTreeWidgetItem * sectionItem = sections.value(change.section);
+      if (!sectionItem) {
+        sectionItem = new QTreeWidgetItem(modelItem);
+        sectionItem->setText(0, ModelChange::sectionName(change.section));
+        sectionItem->setFirstColumnSpanned(true);
+        sections.insert(change.section, sectionItem);
+      }
+
+      QTreeWidgetItem * item = new QTreeWidgetItem(sectionItem);
+      item->setText(0, change.item());
+      item->setText(1, ModelChange::typeName(change.type));
+      item->setText(2, change.fields.join(", "));
+      item->setToolTip(2, change.fields.join("\n"));
+    }
+  }
+
+  ui->changesTree->expandToDepth(1);
+}
+
+void CompareDialog::updateDetails(bool wait)
+{
+  if (detailsDirty) {
+    detailsDirty = false;
+    detailsComplete = false;
+    multimodelprinter->clearModels();
+    ui->textEdit->clear();
+
+    for (int i=0; i < modelsList.size(); ++i)
+      multimodelprinter->setModel(i, &modelsList[i].model, &modelsList[i].gs);
+
+    if (modelsList.size() && !wait)
+      multimodelprinter->printAsync(ui->textEdit->document());
+  }
+
+  if (wait && !detailsComplete && modelsList.size()) {
     ui->textEdit->setHtml(multimodelprinter->print(ui->textEdit->document()));
+    detailsComplete = true;
+  }
+}
+
+void CompareDialog::onDetailsSectionsAdded(const QString & sections, bool complete)
+{
+  // only the new sections are laid out, after the ones already shown
+  QTextCursor cursor(ui->textEdit->document());
+  cursor.movePosition(QTextCursor::End);
+  cursor.insertHtml(MultiModelPrinter::table(sections));
+  detailsComplete = complete;
+}
+
+void CompareDialog::on_tabWidget_currentChanged(int index)
+{
+  if (ui->tabWidget->widget(index) == ui->tabDetails)
+    updateDetails();
 }
 
 void CompareDialog::removeModel(int idx)
@@ -171,6 +255,7 @@ void CompareDialog::on_printButton_clicked()
   dialog->setWindowTitle(tr("Print Document"));
   if (dialog->exec() != QDialog::Accepted)
     return;
+  updateDetails(true);
   ui->textEdit->print(&printer);
 }
 
@@ -186,6 +271,7 @@ void CompareDialog::on_printFileButton_clicked()
     if (QFileInfo(filename).suffix().isEmpty())
       filename.append(".pdf");
     printer.setOutputFileName(filename);
+    updateDetails(true);
     ui->textEdit->print(&printer);
   }
 }
@@ -48,12 +48,16 @@ class CompareDialog : public QDialog
     QVector<GMData> modelsList;
     QMap<int, GMData> modelsMap;
     Ui::CompareDialog * ui;
+    bool detailsDirty;
+    bool detailsComplete;
 
   protected slots:
     void removeModelBtnClicked();
     void on_printButton_clicked();
     void on_printFileButton_clicked();
     void on_styleButton_clicked();
+    void on_tabWidget_currentChanged(int index);
+    void onDetailsSectionsAdded(const QString & sections, bool complete);
 
   protected:
     virtual void closeEvent(QCloseEvent * event);
@@ -63,6 +67,8 @@ class CompareDialog : public QDialog
     virtual void dropEvent(QDropEvent *event);
     bool handleMimeData(const QMimeData * mimeData);
     void compare();
+    void updateChanges();
+    void updateDetails(bool wait = false);
     void removeModel(int idx);
 };
 
@@ -653,15 +653,11 @@ QString ModelPrinter::printCurve(int idx)
   return QString("%1   %2").arg(curve.typeToString()).arg(curve.pointsToString());
 }
 
-QString ModelPrinter::createCurveImage(int idx, QTextDocument * document)
+QImage ModelPrinter::createCurveImage(int idx)
 {
   CurveImage image;
   image.drawCurve(model.curves[idx], colors[idx]);
-  QString filename = QString("mydata://curve-%1-%2.png").arg((uint64_t)this).arg(idx);
-  if (document)
-    document->addResource(QTextDocument::ImageResource, QUrl(filename), image.get());
-  // qDebug() << "ModelPrinter::createCurveImage()" << idx << filename;
-  return filename;
+  return image.get();
 }
 
 QString ModelPrinter::printGlobalVarUnit(int idx)
@@ -23,7 +23,39 @@
 #include "helpers_html.h"
 #include "multimodelprinter.h"
 #include "appdata.h"
+#include "edgetxinterface.h"
+#include "yaml_modeldata.h"
+
+#include <QCache>
+#include <QCryptographicHash>
+#include <QMutex>
 #include <algorithm>
+#include <map>
+#include <vector>
+
+#define FRAGMENTS_CACHE_SIZE  (32 * 1024 * 1024)  // bytes
+
+// Rendered sections of all the printers, by content hash
+static QCache<QByteArray, MultiModelPrinter::Fragment> fragmentsCache(FRAGMENTS_CACHE_SIZE);
+static QMutex fragmentsCacheMutex;
+
+// Copy of the models being printed, so that the dialog can change them while
+// the sections are rendered. Plain data only: each worker renders its section
+// from it with its own SectionRenderer.
+struct MultiModelPrinter::RenderJob
+{
+  Firmware * firmware;
+  GeneralSettings defaultSettings;
+  std::vector<ModelData> models;
+  std::vector<GeneralSettings> settings;
+
+  QList<Section> sections;
+  std::vector<QByteArray> keys;
+
+  QMutex mutex;
+  std::vector<Fragment> fragments;
+  std::vector<bool> ready;
+};
 
 MultiModelPrinter::MultiColumns::MultiColumns(int count):
   count(count),
@@ -225,31 +257,44 @@ void MultiModelPrinter::MultiColumns::appendFieldSeparator(const bool sep)
   COMPARE(what); \
   columns.appendFieldSeparator(sep);
 
-QString MultiModelPrinter::printTitle(const QString & label)
+QString MultiModelPrinter::SectionRenderer::printTitle(const QString & label)
 {
   return QString("<tr><td class=mpc-section-title colspan='%1'>").arg(modelPrinterMap.count()) + label + "</td></tr>";
 }
 
+MultiModelPrinter::SectionRenderer::SectionRenderer(const RenderJob & job):
+  firmware(job.firmware),
+  defaultSettings(job.defaultSettings)
+{
+  for (unsigned i = 0; i < job.models.size(); i++) {
+    QPair<const ModelData *, ModelPrinter *> pair(&job.models[i], new ModelPrinter(firmware, job.settings[i], job.models[i]));
+    modelPrinterMap.insert(i, pair);
+  }
+}
+
+MultiModelPrinter::SectionRenderer::~SectionRenderer()
+{
+  for (int i=0; i < modelPrinterMap.size(); i++)
+    delete modelPrinterMap.value(i).second;
+}
+
 MultiModelPrinter::MultiModelPrinter(Firmware * firmware):
-  firmware(firmware)
+  firmware(firmware),
+  generation(0),
+  nextSection(0),
+  rendered(0)
 {
 }
 
 MultiModelPrinter::~MultiModelPrinter()
 {
-  clearModels();
+  pool.clear();
+  pool.waitForDone();
 }
 
 void MultiModelPrinter::setModel(int idx, const ModelData * model, const GeneralSettings * generalSettings)
 {
-  if (modelPrinterMap.contains(idx) && modelPrinterMap.value(idx).second) {
-    // free existing model printer
-    delete modelPrinterMap.value(idx).second;
-    modelPrinterMap[idx].second = NULL;
-  }
-
-  QPair<const ModelData *, ModelPrinter *> pair(model, new ModelPrinter(firmware, *generalSettings, *model));
-  modelPrinterMap.insert(idx, pair);  // QMap.insert will replace any existing key
+  models.insert(idx, QPair<const ModelData *, const GeneralSettings *>(model, generalSettings));  // QMap.insert will replace any existing key
 }
 
 void MultiModelPrinter::setModel(int idx, const ModelData * model)
@@ -259,52 +304,247 @@ void MultiModelPrinter::setModel(int idx, const ModelData * model)
 
 void MultiModelPrinter::clearModels()
 {
-  for(int i=0; i < modelPrinterMap.size(); i++) {
-    if (modelPrinterMap.value(i).second)
-      delete modelPrinterMap.value(i).second;
+  models.clear();
+}
+
+QList<MultiModelPrinter::Section> MultiModelPrinter::sections() const
+{
+  QList<Section> list = { SECTION_SETUP, SECTION_CHECKLIST };
+  if (firmware->getCapability(Timers))
+    list << SECTION_TIMERS;
+  if (Boards::getCapability(firmware->getBoard(), Board::FunctionSwitches))
+    list << SECTION_FUNCTION_SWITCHES;
+  list << SECTION_MODULES;
+  if (firmware->getCapability(Heli))
+    list << SECTION_HELI;
+  if (firmware->getCapability(FlightModes))
+    list << SECTION_FLIGHT_MODES;
+  list << SECTION_INPUTS << SECTION_MIXERS << SECTION_OUTPUTS << SECTION_CURVES << SECTION_LOGICAL_SWITCHES;
+  if (firmware->getCapability(GlobalFunctions))
+    list << SECTION_GLOBAL_FUNCTIONS;
+  list << SECTION_SPECIAL_FUNCTIONS << SECTION_TELEMETRY << SECTION_SENSORS;
+  if (firmware->getCapability(TelemetryCustomScreens))
+    list << SECTION_TELEMETRY_SCREENS;
+  return list;
+}
+
+QString MultiModelPrinter::SectionRenderer::printSection(Section section, PrintImages & images)
+{
+  switch (section) {
+    case SECTION_SETUP:
+      return printSetup();
+    case SECTION_CHECKLIST:
+      return printChecklist();
+    case SECTION_TIMERS:
+      return printTimers();
+    case SECTION_FUNCTION_SWITCHES:
+      return printFunctionSwitches();
+    case SECTION_MODULES:
+      return printModules();
+    case SECTION_HELI:
+      return printHeliSetup();
+    case SECTION_FLIGHT_MODES:
+      return printFlightModes();
+    case SECTION_INPUTS:
+      return printInputs();
+    case SECTION_MIXERS:
+      return printMixers();
+    case SECTION_OUTPUTS:
+      return printOutputs();
+    case SECTION_CURVES:
+      return printCurves(images);
+    case SECTION_LOGICAL_SWITCHES:
+      return printLogicalSwitches();
+    case SECTION_GLOBAL_FUNCTIONS:
+      return printGlobalFunctions();
+    case SECTION_SPECIAL_FUNCTIONS:
+      return printSpecialFunctions();
+    case SECTION_TELEMETRY:
+      return printTelemetry();
+    case SECTION_SENSORS:
+      return printSensors();
+    case SECTION_TELEMETRY_SCREENS:
+      return printTelemetryScreens();
   }
-  modelPrinterMap.clear();
+  return QString();
 }
 
-QString MultiModelPrinter::print(QTextDocument * document)
+// Top level keys of the model YAML only printed by one section. The other
+// keys (names of inputs, channels, curves, sensors...) may appear anywhere.
+static const std::map<std::string, int> sectionKeys = {
+  { "expoData", MultiModelPrinter::SECTION_INPUTS },
+  { "mixData", MultiModelPrinter::SECTION_MIXERS },
+  { "points", MultiModelPrinter::SECTION_CURVES },
+  { "logicalSw", MultiModelPrinter::SECTION_LOGICAL_SWITCHES },
+  { "customFn", MultiModelPrinter::SECTION_SPECIAL_FUNCTIONS },
+  { "moduleData", MultiModelPrinter::SECTION_MODULES },
+  { "screenData", MultiModelPrinter::SECTION_TELEMETRY_SCREENS },
+};
+
+// Content of a model: the YAML of each section, and of everything else
+static QMap<int, QByteArray> modelContents(const ModelData & model, const GeneralSettings & settings)
+{
+  QMap<int, QByteArray> contents;
+  const int shared = -1;
+
+  YAML::Node node;
+  node = model;
+  for (const auto & kv : node) {
+    const std::string key = kv.first.Scalar();
+    auto it = sectionKeys.find(key);
+    QByteArray & data = contents[it != sectionKeys.end() ? it->second : shared];
+    data.append(key.c_str());
+    data.append(YAML::Dump(kv.second).c_str());
+  }
+
+  QByteArray settingsData;
+  writeRadioSettingsToYaml(settings, settingsData);
+  contents[shared].append(settingsData);
+  contents[shared].append(model.checklistData);
+  return contents;
+}
+
+void MultiModelPrinter::startRender(QTextDocument * document)
 {
-  if (document) document->clear();
-  Stylesheet css(MODEL_PRINT_CSS);
-  if (css.load(Stylesheet::StyleType::STYLE_TYPE_EFFECTIVE))
-    document->setDefaultStyleSheet(css.text());
-  QString str = "<table cellspacing='0' cellpadding='3' width='100%'>";   // attributes not settable via QT stylesheet
-  str.append(printSetup());
-  str.append(printChecklist());
-  if (firmware->getCapability(Timers)) {
-    str.append(printTimers());
+  pool.clear();
+  generation++;
+  nextSection = 0;
+  rendered = 0;
+  html.clear();
+
+  this->document = document;
+  if (document) {
+    document->clear();
+    Stylesheet css(MODEL_PRINT_CSS);
+    if (css.load(Stylesheet::StyleType::STYLE_TYPE_EFFECTIVE))
+      document->setDefaultStyleSheet(css.text());
   }
-  if (Boards::getCapability(firmware->getBoard(), Board::FunctionSwitches)) {
-    str.append(printFunctionSwitches());
+
+  job = std::make_shared<RenderJob>();
+  job->firmware = firmware;
+  job->defaultSettings = defaultSettings;
+  job->models.reserve(models.size());
+  job->settings.reserve(models.size());
+  for (int i = 0; i < models.size(); i++) {
+    job->models.push_back(*models.value(i).first);
+    job->settings.push_back(*models.value(i).second);
   }
 
-  str.append(printModules());
-  if (firmware->getCapability(Heli))
-    str.append(printHeliSetup());
-  if (firmware->getCapability(FlightModes))
-    str.append(printFlightModes());
-  str.append(printInputs());
-  str.append(printMixers());
-  str.append(printOutputs());
-  str.append(printCurves(document));
-  str.append(printLogicalSwitches());
-  if (firmware->getCapability(GlobalFunctions))
-    str.append(printGlobalFunctions());
-  str.append(printSpecialFunctions());
-  str.append(printTelemetry());
-  str.append(printSensors());
-  if (firmware->getCapability(TelemetryCustomScreens)) {
-    str.append(printTelemetryScreens());
-  }
-  str.append("</table>");
-  return str;
+  job->sections = sections();
+  job->fragments.resize(job->sections.size());
+  job->ready.resize(job->sections.size(), false);
+
+  std::vector<QMap<int, QByteArray>> contents;
+  for (unsigned i = 0; i < job->models.size(); i++)
+    contents.push_back(modelContents(job->models[i], job->settings[i]));
+
+  for (int idx = 0; idx < job->sections.size(); idx++) {
+    const Section section = job->sections.at(idx);
+
+    QCryptographicHash hash(QCryptographicHash::Sha1);
+    hash.addData(firmware->getId().toUtf8());
+    hash.addData(QByteArray::number(section));
+    for (const auto & content : contents) {
+      hash.addData(QCryptographicHash::hash(content.value(-1), QCryptographicHash::Sha1));
+      hash.addData(QCryptographicHash::hash(content.value(section), QCryptographicHash::Sha1));
+    }
+    job->keys.push_back(hash.result());
+
+    {
+      QMutexLocker locker(&fragmentsCacheMutex);
+      const Fragment * fragment = fragmentsCache.object(job->keys.back());
+      if (fragment) {
+        job->fragments[idx] = *fragment;
+        job->ready[idx] = true;
+        continue;
+      }
+    }
+
+    rendered++;
+    std::shared_ptr<RenderJob> renderJob = job;
+    const int renderGeneration = generation;
+    pool.start([this, renderJob, renderGeneration, idx, section]() {
+      // the model printers are created and deleted on this thread
+      SectionRenderer renderer(*renderJob);
+      Fragment fragment;
+      fragment.html = renderer.printSection(section, fragment.images);
+
+      qsizetype cost = fragment.html.size() * sizeof(QChar);
+      for (const auto & image : fragment.images)
+        cost += image.sizeInBytes();
+
+      {
+        QMutexLocker locker(&fragmentsCacheMutex);
+        fragmentsCache.insert(renderJob->keys[idx], new Fragment(fragment), cost);
+      }
+
+      {
+        QMutexLocker locker(&renderJob->mutex);
+        renderJob->fragments[idx] = fragment;
+        renderJob->ready[idx] = true;
+      }
+
+      QMetaObject::invokeMethod(this, [this, renderGeneration]() { collect(renderGeneration); },
+                                Qt::QueuedConnection);
+    });
+  }
+}
+
+// Sections are appended in order, as soon as all the previous ones are there
+bool MultiModelPrinter::appendReadySections(QString & added)
+{
+  const int first = nextSection;
+  QMutexLocker locker(&job->mutex);
+
+  while (nextSection < job->sections.size() && job->ready[nextSection]) {
+    const Fragment & fragment = job->fragments[nextSection];
+    if (document) {
+      for (auto it = fragment.images.cbegin(); it != fragment.images.cend(); ++it)
+        document->addResource(QTextDocument::ImageResource, QUrl(it.key()), it.value());
+    }
+    added.append(fragment.html);
+    nextSection++;
+  }
+
+  html.append(added);
+  return nextSection > first;
 }
 
-QString MultiModelPrinter::printSetup()
+void MultiModelPrinter::collect(int generation)
+{
+  QString added;
+  if (job && generation == this->generation && appendReadySections(added))
+    emit sectionsAdded(added, nextSection == job->sections.size());
+}
+
+QString MultiModelPrinter::print(QTextDocument * document)
+{
+  QString added;
+  startRender(document);
+  pool.waitForDone();
+  appendReadySections(added);
+  return table(html);
+}
+
+QString MultiModelPrinter::table(const QString & sections)
+{
+  // attributes not settable via QT stylesheet
+  return "<table cellspacing='0' cellpadding='3' width='100%'>" + sections + "</table>";
+}
+
+void MultiModelPrinter::printAsync(QTextDocument * document)
+{
+  startRender(document);
+  collect(generation);
+}
+
+void MultiModelPrinter::clearCache()
+{
+  QMutexLocker locker(&fragmentsCacheMutex);
+  fragmentsCache.clear();
+}
+
+QString MultiModelPrinter::SectionRenderer::printSetup()
 {
   QString str = printTitle(tr("General"));
 
@@ -325,7 +565,7 @@ QString MultiModelPrinter::printSetup()
   return str;
 }
 
-QString MultiModelPrinter::printTimers()
+QString MultiModelPrinter::SectionRenderer::printTimers()
 {
   QString str;
   MultiColumns columns(modelPrinterMap.size());
@@ -352,7 +592,7 @@ QString MultiModelPrinter::printTimers()
   return str;
 }
 
-QString MultiModelPrinter::printModules()
+QString MultiModelPrinter::SectionRenderer::printModules()
 {
   QString str = printTitle(tr("Modules"));
   MultiColumns columns(modelPrinterMap.size());
@@ -375,7 +615,7 @@ QString MultiModelPrinter::printModules()
   return str;
 }
 
-QString MultiModelPrinter::printHeliSetup()
+QString MultiModelPrinter::SectionRenderer::printHeliSetup()
 {
   bool heliEnabled = false;
   for (int k=0; k < modelPrinterMap.size(); k++) {
@@ -415,7 +655,7 @@ QString MultiModelPrinter::printHeliSetup()
   return str;
 }
 
-QString MultiModelPrinter::printFlightModes()
+QString MultiModelPrinter::SectionRenderer::printFlightModes()
 {
   QString str = printTitle(Boards::getCapability(getCurrentBoard(), Board::Air)
                                ? tr("Flight modes")
@@ -517,7 +757,7 @@ QString MultiModelPrinter::printFlightModes()
   return str;
 }
 
-QString MultiModelPrinter::printOutputs()
+QString MultiModelPrinter::SectionRenderer::printOutputs()
 {
   QString str = printTitle(tr("Outputs"));
   MultiColumns columns(modelPrinterMap.size());
@@ -560,7 +800,7 @@ QString MultiModelPrinter::printOutputs()
   return str;
 }
 
-QString MultiModelPrinter::printInputs()
+QString MultiModelPrinter::SectionRenderer::printInputs()
 {
   QString str = printTitle(tr("Inputs"));
   MultiColumns columns(modelPrinterMap.size());
@@ -590,7 +830,7 @@ QString MultiModelPrinter::printInputs()
   return str;
 }
 
-QString MultiModelPrinter::printMixers()
+QString MultiModelPrinter::SectionRenderer::printMixers()
 {
   QString str = printTitle(tr("Mixers"));
   MultiColumns columns(modelPrinterMap.size());
@@ -620,8 +860,12 @@ QString MultiModelPrinter::printMixers()
   return str;
 }
 
-QString MultiModelPrinter::printCurves(QTextDocument * document)
+QString MultiModelPrinter::SectionRenderer::printCurves(PrintImages & images)
 {
+  // unique urls, the images of cached sections are added to other documents
+  static QAtomicInt renderCount;
+  const int render = renderCount.fetchAndAddRelaxed(1);
+
   QString str;
   MultiColumns columns(modelPrinterMap.size());
   int count = 0;
@@ -644,8 +888,11 @@ QString MultiModelPrinter::printCurves(QTextDocument * document)
       columns.appendRowEnd();
       columns.appendRowStart("", 20);
       columns.appendCellStart();
-      for (int k=0; k < modelPrinterMap.size(); k++)
-        columns.append(k, QString("<br/><img src='%1' border='0' /><br/>").arg(modelPrinterMap.value(k).second->createCurveImage(i, document)));
+      for (int k=0; k < modelPrinterMap.size(); k++) {
+        const QString url = QString("mydata://curve-%1-%2-%3.png").arg(render).arg(k).arg(i);
+        images.insert(url, modelPrinterMap.value(k).second->createCurveImage(i));
+        columns.append(k, QString("<br/><img src='%1' border='0' /><br/>").arg(url));
+      }
       columns.appendCellEnd();
       columns.appendRowEnd();
     }
@@ -658,7 +905,7 @@ QString MultiModelPrinter::printCurves(QTextDocument * document)
   return str;
 }
 
-QString MultiModelPrinter::printLogicalSwitches()
+QString MultiModelPrinter::SectionRenderer::printLogicalSwitches()
 {
   QString str;
   MultiColumns columns(modelPrinterMap.size());
@@ -687,7 +934,7 @@ QString MultiModelPrinter::printLogicalSwitches()
   return str;
 }
 
-QString MultiModelPrinter::printSpecialFunctions()
+QString MultiModelPrinter::SectionRenderer::printSpecialFunctions()
 {
   QString str;
   MultiColumns columns(modelPrinterMap.size());
@@ -722,7 +969,7 @@ QString MultiModelPrinter::printSpecialFunctions()
   return str;
 }
 
-QString MultiModelPrinter::printTelemetry()
+QString MultiModelPrinter::SectionRenderer::printTelemetry()
 {
   QString str = printTitle(tr("Telemetry"));
   MultiColumns columns(modelPrinterMap.size());
@@ -783,7 +1030,7 @@ QString MultiModelPrinter::printTelemetry()
   return str;
 }
 
-QString MultiModelPrinter::printSensors()
+QString MultiModelPrinter::SectionRenderer::printSensors()
 {
   MultiColumns columns(modelPrinterMap.size());
   QString str;
@@ -817,7 +1064,7 @@ QString MultiModelPrinter::printSensors()
   return str;
 }
 
-QString MultiModelPrinter::printTelemetryScreens()
+QString MultiModelPrinter::SectionRenderer::printTelemetryScreens()
 {
   MultiColumns columns(modelPrinterMap.size());
   QString str;
@@ -849,7 +1096,7 @@ QString MultiModelPrinter::printTelemetryScreens()
   return str;
 }
 
-QString MultiModelPrinter::printGlobalFunctions()
+QString MultiModelPrinter::SectionRenderer::printGlobalFunctions()
 {
   QString str;
   QString txt;
@@ -891,7 +1138,7 @@ QString MultiModelPrinter::printGlobalFunctions()
   return str;
 }
 
-QString MultiModelPrinter::printChecklist()
+QString MultiModelPrinter::SectionRenderer::printChecklist()
 {
   QString str;
   MultiColumns columns(modelPrinterMap.size());
@@ -911,7 +1158,7 @@ QString MultiModelPrinter::printChecklist()
   return str;
 }
 
-QString MultiModelPrinter::printFunctionSwitches()
+QString MultiModelPrinter::SectionRenderer::printFunctionSwitches()
  {
    QString str;
    MultiColumns columns(modelPrinterMap.size());
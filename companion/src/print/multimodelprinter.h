@@ -22,25 +22,76 @@
 #ifndef _MULTIMODELPRINTER_H_
 #define _MULTIMODELPRINTER_H_
 
+#include <QCoreApplication>
 #include <QObject>
+#include <QPointer>
 #include <QTextDocument>
+#include <QThreadPool>
 #include "eeprominterface.h"
 #include "modelprinter.h"
 
+#include <memory>
+
+// Document resources (curve images) by url
+typedef QMap<QString, QImage> PrintImages;
+
 class MultiModelPrinter: public QObject
 {
   Q_OBJECT
 
   public:
+    enum Section {
+      SECTION_SETUP,
+      SECTION_CHECKLIST,
+      SECTION_TIMERS,
+      SECTION_FUNCTION_SWITCHES,
+      SECTION_MODULES,
+      SECTION_HELI,
+      SECTION_FLIGHT_MODES,
+      SECTION_INPUTS,
+      SECTION_MIXERS,
+      SECTION_OUTPUTS,
+      SECTION_CURVES,
+      SECTION_LOGICAL_SWITCHES,
+      SECTION_GLOBAL_FUNCTIONS,
+      SECTION_SPECIAL_FUNCTIONS,
+      SECTION_TELEMETRY,
+      SECTION_SENSORS,
+      SECTION_TELEMETRY_SCREENS,
+    };
+
+    struct Fragment {
+      QString html;
+      PrintImages images;
+    };
+
     MultiModelPrinter(Firmware * firmware);
     virtual ~MultiModelPrinter();
 
     void setModel(int idx, const ModelData * model, const GeneralSettings * generalSettings);
     void setModel(int idx, const ModelData * model);
     void clearModels();
+
+    // Sections are rendered on worker threads, and cached by content of the
+    // models. print() waits for all of them, printAsync() returns at once and
+    // emits sectionsAdded() each time the next sections are available.
     QString print(QTextDocument * document);
+    void printAsync(QTextDocument * document);
+
+    // sections rendered by the last print, the others came from the cache
+    int renderedSections() const { return rendered; }
+
+    // table holding the rows of the given sections
+    static QString table(const QString & sections);
+    static void clearCache();
+
+  signals:
+    // rows of the sections added since the previous signal
+    void sectionsAdded(const QString & sections, bool complete);
 
   protected:
+    struct RenderJob;
+
     class MultiColumns {
       public:
         MultiColumns(int count);
@@ -74,28 +125,57 @@ class MultiModelPrinter: public QObject
         QString * compareColumns;
     };
 
+    // Renders the sections of a render job. Created by the worker threads,
+    // so that the model printers live and die on the thread that uses them.
+    class SectionRenderer {
+      Q_DECLARE_TR_FUNCTIONS(MultiModelPrinter)
+
+      public:
+        SectionRenderer(const RenderJob & job);
+        ~SectionRenderer();
+        QString printSection(Section section, PrintImages & images);
+
+      private:
+        Firmware * firmware;
+        const GeneralSettings & defaultSettings;
+        QMap<int, QPair<const ModelData *, ModelPrinter *> > modelPrinterMap;
+
+        QString printTitle(const QString & label);
+        QString printSetup();
+        QString printModules();
+        QString printHeliSetup();
+        QString printFlightModes();
+        QString printOutputs();
+        QString printInputs();
+        QString printMixers();
+        QString printCurves(PrintImages & images);
+        QString printLogicalSwitches();
+        QString printSpecialFunctions();
+        QString printTelemetry();
+        QString printTimers();
+        QString printSensors();
+        QString printTelemetryScreens();
+        QString printGlobalFunctions();
+        QString printChecklist();
+        QString printFunctionSwitches();
+    };
+
     Firmware * firmware;
     GeneralSettings defaultSettings;
-    QMap<int, QPair<const ModelData *, ModelPrinter *> > modelPrinterMap;
-
-    QString printTitle(const QString & label);
-    QString printSetup();
-    QString printModules();
-    QString printHeliSetup();
-    QString printFlightModes();
-    QString printOutputs();
-    QString printInputs();
-    QString printMixers();
-    QString printCurves(QTextDocument * document);
-    QString printLogicalSwitches();
-    QString printSpecialFunctions();
-    QString printTelemetry();
-    QString printTimers();
-    QString printSensors();
-    QString printTelemetryScreens();
-    QString printGlobalFunctions();
-    QString printChecklist();
-    QString printFunctionSwitches();
+    QMap<int, QPair<const ModelData *, const GeneralSettings *> > models;
+
+    QThreadPool pool;
+    std::shared_ptr<RenderJob> job;
+    int generation;
+    int nextSection;
+    int rendered;
+    QString html;
+    QPointer<QTextDocument> document;
+
+    QList<Section> sections() const;
+    void startRender(QTextDocument * document);
+    bool appendReadySections(QString & added);
+    void collect(int generation);
 };
 
 #endif // _MULTIMODELPRINTER_H_
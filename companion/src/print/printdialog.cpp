@@ -33,23 +33,45 @@ PrintDialog::PrintDialog(QWidget *parent, Firmware * firmware, GeneralSettings &
   model(model),
   printfilename(filename),
   ui(new Ui::PrintDialog),
-  multiModelPrinter(firmware)
+  multiModelPrinter(firmware),
+  complete(false)
 {
   ui->setupUi(this);
   setWindowIcon(CompanionIcon("print.png"));
   setWindowTitle(model.name.toQString());
   multiModelPrinter.setModel(0, &model, &generalSettings);
-  ui->textEdit->setHtml(multiModelPrinter.print(ui->textEdit->document()));
+  connect(&multiModelPrinter, &MultiModelPrinter::sectionsAdded, this, &PrintDialog::onSectionsAdded);
   if (!printfilename.isEmpty()) {
+    waitForDocument();
     printToFile();
     QTimer::singleShot(0, this, SLOT(autoClose()));
   }
+  else {
+    multiModelPrinter.printAsync(ui->textEdit->document());
+  }
 }
 
 void PrintDialog::closeEvent(QCloseEvent *event)
 {
 }
 
+void PrintDialog::onSectionsAdded(const QString & sections, bool complete)
+{
+  // only the new sections are laid out, after the ones already shown
+  QTextCursor cursor(ui->textEdit->document());
+  cursor.movePosition(QTextCursor::End);
+  cursor.insertHtml(MultiModelPrinter::table(sections));
+  this->complete = complete;
+}
+
+void PrintDialog::waitForDocument()
+{
+  if (!complete) {
+    ui->textEdit->setHtml(multiModelPrinter.print(ui->textEdit->document()));
+    complete = true;
+  }
+}
+
 PrintDialog::~PrintDialog()
 {
   delete ui;
@@ -63,6 +85,7 @@ void PrintDialog::on_printButton_clicked()
   dialog->setWindowTitle(tr("Print Document"));
   if (dialog->exec() != QDialog::Accepted)
     return;
+  waitForDocument();
   ui->textEdit->print(&printer);
 }
 
@@ -73,6 +96,7 @@ void PrintDialog::on_printFileButton_clicked()
     return;
   if (! (fn.endsWith(".pdf", Qt::CaseInsensitive) || fn.endsWith(".htm", Qt::CaseInsensitive) || fn.endsWith(".html", Qt::CaseInsensitive)) )
     fn += ".pdf"; // default
+  waitForDocument();
   if (fn.endsWith(".pdf", Qt::CaseInsensitive)) {
     QPrinter printer;
     printer.setPageMargins(QMarginsF(10.0, 10.0, 10.0, 10.0), QPageLayout::Millimeter);
@@ -115,6 +139,8 @@ void PrintDialog::autoClose()
 void PrintDialog::on_styleButton_clicked()
 {
   StyleEditDialog *g = new StyleEditDialog(this, MODEL_PRINT_CSS);
-  if (g->exec() == QDialog::Accepted)
-    ui->textEdit->setHtml(multiModelPrinter.print(ui->textEdit->document()));
+  if (g->exec() == QDialog::Accepted) {
+    complete = false;
+    multiModelPrinter.printAsync(ui->textEdit->document());
+  }
 }
@@ -48,14 +48,17 @@ class PrintDialog : public QDialog
   protected:
     Ui::PrintDialog *ui;
     MultiModelPrinter multiModelPrinter;
+    bool complete;
 
     void printToFile();
+    void waitForDocument();
 
   private slots:
     void on_printButton_clicked();
     void on_printFileButton_clicked();
     void autoClose();
     void on_styleButton_clicked();
+    void onSectionsAdded(const QString & sections, bool complete);
 };
 
 #endif // _PRINTDIALOG_H_
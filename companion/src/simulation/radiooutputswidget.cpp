@@ -28,6 +28,7 @@
 #include "radiodata.h"
 #include "simulator.h"
 
+#include <QScreen>
 #include <QScrollBar>
 
 extern AppData g;  // ensure what "g" means
@@ -49,10 +50,11 @@ RadioOutputsWidget::RadioOutputsWidget(SimulatorInterface * simulator, Firmware
   connect(ui->channelsScroll->horizontalScrollBar(), &QScrollBar::sliderMoved, ui->mixersScroll->horizontalScrollBar(), &QScrollBar::setValue);
   connect(ui->mixersScroll->horizontalScrollBar(), &QScrollBar::sliderMoved, ui->channelsScroll->horizontalScrollBar(), &QScrollBar::setValue);
 
-  connect(m_simulator, &SimulatorInterface::channelOutValueChange, this, &RadioOutputsWidget::onChannelOutValueChange);
-  connect(m_simulator, &SimulatorInterface::channelMixValueChange, this, &RadioOutputsWidget::onChannelMixValueChange);
-  connect(m_simulator, &SimulatorInterface::virtualSwValueChange, this, &RadioOutputsWidget::onVirtSwValueChange);
-  connect(m_simulator, &SimulatorInterface::gVarValueChange, this, &RadioOutputsWidget::onGVarValueChange);
+  m_refreshTimer.setSingleShot(true);
+  m_refreshTimer.setTimerType(Qt::PreciseTimer);
+  connect(&m_refreshTimer, &QTimer::timeout, this, &RadioOutputsWidget::applyOutputs);
+
+  connect(m_simulator, &SimulatorInterface::outputsChange, this, &RadioOutputsWidget::onOutputsChange);
   connect(m_simulator, &SimulatorInterface::phaseChanged, this, &RadioOutputsWidget::onPhaseChanged);
 }
 
@@ -77,6 +79,10 @@ void RadioOutputsWidget::changeEvent(QEvent *e)
 
 void RadioOutputsWidget::start()
 {
+  // no more than one repaint per display refresh
+  qreal refreshRate = screen() ? screen()->refreshRate() : 0;
+  m_refreshTimer.setInterval(refreshRate > 0 ? qMax(1, qRound(1000 / refreshRate)) : 16);
+
   setupChannelsDisplay(false);
   setupChannelsDisplay(true);
   setupGVarsDisplay();
@@ -301,33 +307,55 @@ QWidget * RadioOutputsWidget::createLogicalSwitch(QWidget * parent, int switchNo
   return swtch;
 }
 
-void RadioOutputsWidget::onChannelOutValueChange(quint8 index, qint32 value, qint32 limit)
+void RadioOutputsWidget::onOutputsChange(const SimulatorInterface::OutputsFrame & frame)
 {
-  if (m_channelsMap.contains(index)) {
-    QPair<QLabel *, QSlider *> ch = m_channelsMap.value(index);
-    if (ch.second->maximum() != limit) {
-      ch.second->setMaximum(limit);
-      ch.second->setMinimum(-limit);
+  m_pendingOutputs.merge(frame);
+  if (!m_refreshTimer.isActive())
+    m_refreshTimer.start();
+}
+
+void RadioOutputsWidget::applyOutputs()
+{
+  const SimulatorInterface::OutputsFrame & frame = m_pendingOutputs;
+  const SimulatorInterface::TxOutputs & values = frame.values;
+
+  // all the changes are painted together once updates are enabled again
+  setUpdatesEnabled(false);
+
+  for (int i = 0; i < CPN_MAX_CHNOUT; i++) {
+    if ((frame.chansChanged & (1u << i)) && m_channelsMap.contains(i))
+      setChannelValue(m_channelsMap.value(i), values.chans[i], frame.limit);
+    if ((frame.mixesChanged & (1u << i)) && m_mixesMap.contains(i))
+      setChannelValue(m_mixesMap.value(i), values.ex_chans[i], frame.limit * 2);
+  }
+
+  for (int i = 0; i < CPN_MAX_LOGICAL_SWITCHES; i++) {
+    if (frame.vswChanged & ((quint64)1 << i))
+      setVirtSwValue(i, values.vsw[i]);
+  }
+
+  for (int fm = 0; fm < CPN_MAX_FLIGHT_MODES; fm++) {
+    for (int gv = 0; frame.gvarsChanged[fm] && gv < CPN_MAX_GVARS; gv++) {
+      if (frame.gvarsChanged[fm] & (1u << gv))
+        setGVarValue(gv, values.gvars[fm][gv]);
     }
-    ch.first->setText(QString("%1%").arg(calcRESXto100(value)));
-    ch.second->setValue(qMin(limit, qMax(-limit, value)));
   }
+
+  setUpdatesEnabled(true);
+  m_pendingOutputs.clearChanges();
 }
 
-void RadioOutputsWidget::onChannelMixValueChange(quint8 index, qint32 value, qint32 limit)
+void RadioOutputsWidget::setChannelValue(const QPair<QLabel *, QSlider *> & ch, qint32 value, qint32 limit)
 {
-  if (m_mixesMap.contains(index)) {
-    QPair<QLabel *, QSlider *> ch = m_mixesMap.value(index);
-    if (ch.second->maximum() != limit) {
-      ch.second->setMaximum(limit);
-      ch.second->setMinimum(-limit);
-    }
-    ch.first->setText(QString("%1%").arg(calcRESXto100(value)));
-    ch.second->setValue(qMin(limit, qMax(-limit, value)));
+  if (ch.second->maximum() != limit) {
+    ch.second->setMaximum(limit);
+    ch.second->setMinimum(-limit);
   }
+  ch.first->setText(QString("%1%").arg(calcRESXto100(value)));
+  ch.second->setValue(qMin(limit, qMax(-limit, value)));
 }
 
-void RadioOutputsWidget::onVirtSwValueChange(quint8 index, qint32 value)
+void RadioOutputsWidget::setVirtSwValue(int index, bool value)
 {
   if (!m_logicSwitchMap.contains(index))
     return;
@@ -337,12 +365,11 @@ void RadioOutputsWidget::onVirtSwValueChange(quint8 index, qint32 value)
   ls->setForegroundRole(value ? QPalette::BrightText : QPalette::WindowText);
   ls->setFrameShadow(value ? QFrame::Sunken : QFrame::Raised);
   QFont font = ls->font();
-  font.setBold((bool)value);
+  font.setBold(value);
   ls->setFont(font);
-  //qDebug() << index << value;
 }
 
-void RadioOutputsWidget::onGVarValueChange(quint8 index, qint32 value)
+void RadioOutputsWidget::setGVarValue(int index, qint32 value)
 {
   if (!m_globalVarsMap.contains(index))
     return;
@@ -357,7 +384,6 @@ void RadioOutputsWidget::onGVarValueChange(quint8 index, qint32 value)
     gvar.unit = gv.unit;
     lbl->setText(QString::number(gv.value * gvar.multiplierGet(), 'f', gv.prec) + gvar.unitToString());
   }
-  //qDebug() << index << value << gv.mode << gv.value << gv.prec << gv.unit;
 }
 
 void RadioOutputsWidget::onPhaseChanged(qint32 phase, const QString &)
@@ -56,11 +56,9 @@ class RadioOutputsWidget : public QWidget
   protected slots:
     void saveState();
     void restoreState();
-    void onChannelOutValueChange(quint8 index, qint32 value, qint32 limit);
-    void onChannelMixValueChange(quint8 index, qint32 value, qint32 limit);
-    void onVirtSwValueChange(quint8 index, qint32 value);
-    void onGVarValueChange(quint8 index, qint32 value);
+    void onOutputsChange(const SimulatorInterface::OutputsFrame & frame);
     void onPhaseChanged(qint32 phase, const QString &);
+    void applyOutputs();
 
   protected:
     void changeEvent(QEvent *e);
@@ -68,6 +66,9 @@ class RadioOutputsWidget : public QWidget
     void setupLsDisplay();
     void setupGVarsDisplay();
     QWidget * createLogicalSwitch(QWidget * parent, int switchNo);
+    void setChannelValue(const QPair<QLabel *, QSlider *> & ch, qint32 value, qint32 limit);
+    void setVirtSwValue(int index, bool value);
+    void setGVarValue(int index, qint32 value);
 
     SimulatorInterface * m_simulator;
     Firmware * m_firmware;
@@ -77,6 +78,10 @@ class RadioOutputsWidget : public QWidget
     QHash<int, QLabel *> m_logicSwitchMap;                  // m_logicSwitchMap[lsIndex] = QLabel*
     QHash<int, QHash<int, QLabel *> > m_globalVarsMap;      // m_globalVarsMap[gvarIndex][fmodeIndex] = QLabel*
 
+    // changes received since the last repaint, applied at most once per display refresh
+    SimulatorInterface::OutputsFrame m_pendingOutputs;
+    QTimer m_refreshTimer;
+
     int m_radioProfileId;
     int m_dataUpdateFreq;
 
@@ -56,7 +56,7 @@ void SimulatedGPS::setDateTime(QString dateTime)
   }
 }
 
-void SimulatedGPS::setLatLon(QString latLon)
+bool SimulatedGPS::parseLatLon(const QString & latLon, double & lat, double & lon)
 {
   QStringList coords = latLon.split(",");
   if (coords.length() < 2) {
@@ -67,7 +67,14 @@ void SimulatedGPS::setLatLon(QString latLon)
   if (coords.length() > 1) {
     lat = coords[0].simplified().toDouble();
     lon = coords[1].simplified().toDouble();
-  } else {
+    return true;
+  }
+  return false;
+}
+
+void SimulatedGPS::setLatLon(QString latLon)
+{
+  if (!parseLatLon(latLon, lat, lon)) {
     stop();
   }
 }
@@ -32,6 +32,9 @@ class SimulatedGPS : public QObject
   SimulatedGPS();
   ~SimulatedGPS();
 
+  // "lat,lon" or "lat lon" in degrees, false if not a position
+  static bool parseLatLon(const QString & latLon, double & lat, double & lon);
+
   QDateTime dt;
   double lat;
   double lon;
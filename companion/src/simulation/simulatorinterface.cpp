@@ -28,6 +28,88 @@
 #include <QDebug>
 #include <QLibraryInfo>
 
+static_assert(CPN_MAX_CHNOUT <= 32, "OutputsFrame: one bit per channel");
+static_assert(CPN_MAX_LOGICAL_SWITCHES <= 64, "OutputsFrame: one bit per logical switch");
+static_assert(CPN_MAX_GVARS <= 16, "OutputsFrame: one bit per GVar");
+
+void SimulatorInterface::OutputsFrame::clear()
+{
+  values.clear();
+  limit = 0;
+  clearChanges();
+}
+
+void SimulatorInterface::OutputsFrame::clearChanges()
+{
+  chansChanged = 0;
+  mixesChanged = 0;
+  vswChanged = 0;
+  memset(gvarsChanged, 0, sizeof(gvarsChanged));
+}
+
+bool SimulatorInterface::OutputsFrame::changed() const
+{
+  if (chansChanged || mixesChanged || vswChanged)
+    return true;
+  for (int fm = 0; fm < CPN_MAX_FLIGHT_MODES; fm++) {
+    if (gvarsChanged[fm])
+      return true;
+  }
+  return false;
+}
+
+void SimulatorInterface::OutputsFrame::merge(const OutputsFrame & next)
+{
+  values = next.values;
+  limit = next.limit;
+  chansChanged |= next.chansChanged;
+  mixesChanged |= next.mixesChanged;
+  vswChanged |= next.vswChanged;
+  for (int fm = 0; fm < CPN_MAX_FLIGHT_MODES; fm++)
+    gvarsChanged[fm] |= next.gvarsChanged[fm];
+}
+
+void SimulatorInterface::OutputsFrame::setChannel(int index, int16_t value, bool force)
+{
+  if (values.chans[index] != value || force) {
+    values.chans[index] = value;
+    chansChanged |= 1u << index;
+  }
+}
+
+void SimulatorInterface::OutputsFrame::setMix(int index, int16_t value, bool force)
+{
+  if (values.ex_chans[index] != value || force) {
+    values.ex_chans[index] = value;
+    mixesChanged |= 1u << index;
+  }
+}
+
+void SimulatorInterface::OutputsFrame::setVirtualSw(int index, bool value, bool force)
+{
+  if (values.vsw[index] != value || force) {
+    values.vsw[index] = value;
+    vswChanged |= (quint64)1 << index;
+  }
+}
+
+void SimulatorInterface::OutputsFrame::setGVar(int fmode, int index, qint32 value, bool force)
+{
+  if (values.gvars[fmode][index] != value || force) {
+    values.gvars[fmode][index] = value;
+    gvarsChanged[fmode] |= 1u << index;
+  }
+}
+
+void SimulatorInterface::publishOutputs(qint32 limit)
+{
+  if (m_outputs.changed()) {
+    m_outputs.limit = limit;
+    emit outputsChange(m_outputs);
+    m_outputs.clearChanges();
+  }
+}
+
 QMap<QString, SimulatorFactory *> SimulatorLoader::registeredSimulators;
 
 QStringList SimulatorLoader::getAvailableSimulators()
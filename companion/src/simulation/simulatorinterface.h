@@ -135,6 +135,30 @@ class SimulatorInterface : public QObject
       // bool beep;
     };
 
+    // Snapshot of the outputs shown by the outputs widget, published once per
+    // poll by outputsChange() with a bit set for each value that changed
+    struct OutputsFrame {
+      OutputsFrame() { clear(); }
+      void clear();
+      void clearChanges();
+      bool changed() const;
+      // take the values of a newer frame, keeping the changes of both
+      void merge(const OutputsFrame & next);
+
+      // store a value, flagged as changed if it differs or if forced
+      void setChannel(int index, int16_t value, bool force = false);
+      void setMix(int index, int16_t value, bool force = false);
+      void setVirtualSw(int index, bool value, bool force = false);
+      void setGVar(int fmode, int index, qint32 value, bool force = false);
+
+      TxOutputs values;
+      qint32 limit;                                 // channel outputs range, twice as large for mixes
+      quint32 chansChanged;                         // bit per channel
+      quint32 mixesChanged;                         // bit per channel
+      quint64 vswChanged;                           // bit per logical switch
+      quint16 gvarsChanged[CPN_MAX_FLIGHT_MODES];   // bit per GVar, for each flight mode
+    };
+
     virtual ~SimulatorInterface() {}
 
     virtual QString name() = 0;
@@ -178,13 +202,9 @@ class SimulatorInterface : public QObject
     void heartbeat(qint32 loops, qint64 timestamp);
     void lcdChange(bool backlightEnable);
     void phaseChanged(qint8 phase, const QString & name);
-    void channelOutValueChange(quint8 index, qint32 value, qint32 limit);
-    void channelMixValueChange(quint8 index, qint32 value, qint32 limit);
-    void virtualSwValueChange(quint8 index, qint32 value);
+    void outputsChange(const SimulatorInterface::OutputsFrame & frame);
     void trimValueChange(quint8 index, qint32 value);
     void trimRangeChange(quint8 index, qint32 min, qint16 max);
-    void gVarValueChange(quint8 index, qint32 value);
-    void outputValueChange(int type, quint8 index, qint32 value);
     void auxSerialSendData(const quint8 port_num, const QByteArray & data);
     void auxSerialSetEncoding(const quint8 port_num, const quint8 encoding);
     void auxSerialSetBaudrate(const quint8 port_num, const quint32 baudrate);
@@ -193,8 +213,16 @@ class SimulatorInterface : public QObject
     void txBatteryVoltageChanged(const int voltage);
     void hapticChanged(int intensity);
     void fsColorChange(quint8 index, qint32 color);
+
+  protected:
+    // emit outputsChange() if any output changed since the last poll
+    void publishOutputs(qint32 limit);
+
+    OutputsFrame m_outputs;
 };
 
+Q_DECLARE_METATYPE(SimulatorInterface::OutputsFrame)
+
 class SimulatorFactory {
 
   public:
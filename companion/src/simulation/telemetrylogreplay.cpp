@@ -0,0 +1,427 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "telemetrylogreplay.h"
+
+#include <QDebug>
+#include <QtMath>
+#include <algorithm>
+
+static QString convertFeetToMeters(QString input)
+{
+  double meters = input.toDouble() * 0.3048;
+  return QString::number(meters);
+}
+
+static QString convertFahrenheitToCelsius(QString input)
+{
+  double celsius = (input.toDouble() - 32.0) * 0.5556;
+  return QString::number(celsius);
+}
+
+static QString convertKnotsToKPH(QString input)
+{
+  double kph = input.toDouble() * 1.852;
+  return QString::number(kph);
+}
+
+static QString convertMilesPerHourToKPH(QString input)
+{
+  double kph = input.toDouble() * 1.60934;
+  return QString::number(kph);
+}
+
+static QString convertMetersPerSecondToKPH(QString input)
+{
+  double kph = input.toDouble() * 3.6;
+  return QString::number(kph);
+}
+
+static QString convertFeetPerSecondToKPH(QString input)
+{
+  double kph = input.toDouble() * 1.09728;
+  return QString::number(kph);
+}
+
+static QString convertDegreesToRadians(QString input)
+{
+  double rad = input.toDouble() * 0.0174533;
+  return QString::number(rad);
+}
+
+static QString convertRadiansToDegrees(QString input)
+{
+  double deg = input.toDouble() * 57.2958;
+  return QString::number(deg);
+}
+
+static QString convertWattToMilliwatt(QString input)
+{
+  double mw = input.toDouble() * 1000;
+  return QString::number(mw);
+}
+
+static QString convertFluidOuncesToMilliliters(QString input)
+{
+  double ml = input.toDouble() * 29.5735;
+  return QString::number(ml);
+}
+
+static QString convertDBMToMilliwatts(QString input)
+{
+  double dbm = input.toDouble();
+  double mw = qPow(10, dbm/10);
+  return QString::number(mw);
+}
+
+static struct unitConversion {
+  QString source;
+  QString destination;
+  QString (*converter)(QString);
+} conversions[] = {
+    {QString("ft"), QString("m"), convertFeetToMeters},
+    {QString("°F"), QString("°C"), convertFahrenheitToCelsius},
+    {QString("kts"), QString("kmh"), convertKnotsToKPH},
+    {QString("mph"), QString("kmh"), convertMilesPerHourToKPH},
+    {QString("m/s"), QString("kmh"), convertMetersPerSecondToKPH},
+    {QString("f/s"), QString("kmh"), convertFeetPerSecondToKPH},
+    {QString("°"), QString("rad"), convertDegreesToRadians},
+    {QString("rad"), QString("°"), convertRadiansToDegrees},
+    {QString("W"), QString("mW"), convertWattToMilliwatt},
+    {QString("fOz"), QString("ml"), convertFluidOuncesToMilliliters},
+    {QString("dBm"), QString("mW"), convertDBMToMilliwatts},
+    {NULL, NULL, NULL},
+  };
+
+QString TelemetryLogReplay::convertItemValue(const QString & sourceUnit, const QString & destUnit, const QString & value)
+{
+  if (sourceUnit == destUnit)
+    return value;
+
+  int i = 0;
+  while (!conversions[i].source.isNull()) {
+    if (conversions[i].source == sourceUnit && conversions[i].destination == destUnit) {
+      return ((conversions[i].converter)(value));
+    }
+    i++;
+  }
+  qDebug() << "TelemetryLogReplay: failed to convert " << sourceUnit << " to " << destUnit;
+  return value;
+}
+
+QString TelemetryLogReplay::unitFromColumnName(const QString & columnName)
+{
+  QStringList parts = columnName.split('(');
+  if (parts.count() == 1) {
+    return QString("");
+  }
+  parts = parts[1].split(')');
+  return parts[0];
+}
+
+QString TelemetryLogReplay::itemFromColumnName(const QString & columnName)
+{
+  QStringList parts = columnName.split('(');
+  return parts[0];
+}
+
+TelemetryLogReplay::TelemetryLogReplay(QObject * parent) :
+  QObject(parent),
+  nextFrame(0),
+  stopPosition(0),
+  clockPosition(0),
+  clockStart(0),
+  positionTime(0),
+  playSpeed(1),
+  playing(false),
+  looping(true)
+{
+  timer.setSingleShot(true);
+  timer.setTimerType(Qt::PreciseTimer);
+  connect(&timer, &QTimer::timeout, this, &TelemetryLogReplay::onTimer);
+  monotonic.start();
+}
+
+bool TelemetryLogReplay::load(const QString & path)
+{
+  clear();
+  if (!telemetryLog.load(path) || telemetryLog.isEmpty()) {
+    telemetryLog.clear();
+    return false;
+  }
+
+  // a log spanning midnight or edited by hand is replayed in file order
+  const qint64 first = telemetryLog.timestamp(0);
+  qint64 time = 0;
+  rowTimes.reserve(telemetryLog.rowCount());
+  for (int row = 0; row < telemetryLog.rowCount(); row++) {
+    time = qMax(time, telemetryLog.timestamp(row) - first);
+    rowTimes.append(time);
+  }
+  return true;
+}
+
+void TelemetryLogReplay::clear()
+{
+  clearFrames();
+  telemetryLog.clear();
+  rowTimes.clear();
+}
+
+void TelemetryLogReplay::clearFrames()
+{
+  stop();
+  frameList.clear();
+  nextFrame = 0;
+  stopPosition = 0;
+}
+
+bool TelemetryLogReplay::encode(TelemetryProvider * internal, TelemetryProvider * external)
+{
+  clearFrames();
+  if (telemetryLog.isEmpty() || (!internal && !external))
+    return false;
+
+  // what each column is for each provider, resolved once
+  struct Column {
+    int index;
+    QString item;
+    QString unit;
+    bool internal;
+    QString internalUnit;
+    bool external;
+    QString externalUnit;
+  };
+
+  QHash<QString, QString> * internalItems = internal ? internal->getSupportedLogItems() : nullptr;
+  QHash<QString, QString> * externalItems = external ? external->getSupportedLogItems() : nullptr;
+  QVector<Column> columns;
+  const QStringList & names = telemetryLog.columnNames();
+  for (int i = 2; i < names.count(); i++) {
+    Column column;
+    QString name = names.at(i).simplified();
+    column.index = i;
+    column.item = itemFromColumnName(name);
+    column.unit = unitFromColumnName(name);
+    column.internal = internalItems && internalItems->contains(column.item);
+    column.internalUnit = column.internal ? internalItems->value(column.item) : QString();
+    column.external = externalItems && externalItems->contains(column.item);
+    column.externalUnit = column.external ? externalItems->value(column.item) : QString();
+    if (column.internal || column.external)
+      columns.append(column);
+  }
+
+  QHash<QString, QString> internalValues, externalValues;
+  QList<TelemetryFrame> internalFrames, externalFrames;
+  QVector<Frame> rowFrames;
+  qint64 interval = 0;
+
+  for (int row = 0; row < telemetryLog.rowCount(); row++) {
+    const QStringList cells = telemetryLog.cells(row);
+
+    internalValues.clear();
+    externalValues.clear();
+    for (const Column & column : columns) {
+      QString value = cells.value(column.index).simplified();
+      if (value.isEmpty())
+        continue;
+      if (column.internal)
+        internalValues.insert(column.item, convertItemValue(column.unit, column.internalUnit, value));
+      if (column.external)
+        externalValues.insert(column.item, convertItemValue(column.unit, column.externalUnit, value));
+    }
+
+    internalFrames.clear();
+    externalFrames.clear();
+    if ((internal && !internal->encodeLogItems(internalValues, internalFrames)) ||
+        (external && !external->encodeLogItems(externalValues, externalFrames))) {
+      clearFrames();
+      return false;
+    }
+
+    // frames are spread up to the next record, as the receiver sends them
+    const qint64 time = rowTimes.at(row);
+    if (row + 1 < rowTimes.count())
+      interval = qMin<qint64>(rowTimes.at(row + 1) - time, TELEMETRY_REPLAY_MAX_SPREAD);
+
+    rowFrames.clear();
+    for (int i = 0; i < internalFrames.count(); i++)
+      rowFrames.append({time + interval * i / internalFrames.count(), false, internalFrames.at(i)});
+    for (int i = 0; i < externalFrames.count(); i++)
+      rowFrames.append({time + interval * i / externalFrames.count(), true, externalFrames.at(i)});
+    std::stable_sort(rowFrames.begin(), rowFrames.end(), [](const Frame & a, const Frame & b) {
+      return a.time < b.time;
+    });
+    frameList += rowFrames;
+  }
+
+  return !frameList.isEmpty();
+}
+
+qint64 TelemetryLogReplay::duration() const
+{
+  if (rowTimes.isEmpty())
+    return 0;
+  qint64 last = rowTimes.last();
+  if (!frameList.isEmpty())
+    last = qMax(last, frameList.last().time);
+  return last;
+}
+
+qint64 TelemetryLogReplay::position() const
+{
+  if (!playing)
+    return stopPosition;
+  return clockPosition + qint64((clockTime() - clockStart) * playSpeed / 1000000);
+}
+
+int TelemetryLogReplay::row(qint64 position) const
+{
+  int row = std::upper_bound(rowTimes.begin(), rowTimes.end(), position) - rowTimes.begin() - 1;
+  return qMax(0, row);
+}
+
+qint64 TelemetryLogReplay::rowPosition(int row) const
+{
+  return rowTimes.value(row);
+}
+
+void TelemetryLogReplay::play()
+{
+  if (playing || frameList.isEmpty())
+    return;
+
+  if (stopPosition >= duration())
+    stopPosition = 0;
+
+  playing = true;
+  positionTime = clockTime();
+  seek(stopPosition);
+}
+
+void TelemetryLogReplay::stop()
+{
+  if (!playing)
+    return;
+
+  stopPosition = qMin(position(), duration());
+  playing = false;
+  timer.stop();
+}
+
+void TelemetryLogReplay::seek(qint64 position)
+{
+  position = qBound<qint64>(0, position, duration());
+  nextFrame = std::lower_bound(frameList.begin(), frameList.end(), position, [](const Frame & frame, qint64 time) {
+    return frame.time < time;
+  }) - frameList.begin();
+
+  if (playing) {
+    restartClock(position);
+    scheduleNext(position);
+  }
+  else {
+    stopPosition = position;
+  }
+}
+
+void TelemetryLogReplay::setSpeed(double speed)
+{
+  speed = qBound(TELEMETRY_REPLAY_MIN_SPEED, speed, (double)TELEMETRY_REPLAY_MAX_SPEED);
+  if (playing) {
+    qint64 current = position();
+    playSpeed = speed;
+    restartClock(current);
+    scheduleNext(current);
+  }
+  else {
+    playSpeed = speed;
+  }
+}
+
+void TelemetryLogReplay::setLooping(bool enable)
+{
+  looping = enable;
+}
+
+qint64 TelemetryLogReplay::clockTime() const
+{
+  return monotonic.nsecsElapsed();
+}
+
+void TelemetryLogReplay::armTimer(qint64 delay)
+{
+  timer.start(delay);
+}
+
+void TelemetryLogReplay::restartClock(qint64 position)
+{
+  clockPosition = position;
+  clockStart = clockTime();
+}
+
+void TelemetryLogReplay::scheduleNext(qint64 position)
+{
+  if (nextFrame >= frameList.count()) {
+    armTimer(0);
+    return;
+  }
+  qint64 delay = (frameList.at(nextFrame).time - position) / playSpeed;
+  armTimer(qMax<qint64>(0, delay));
+}
+
+void TelemetryLogReplay::onTimer()
+{
+  if (!playing)
+    return;
+
+  // frames which are due, including any missed while the event loop was busy
+  qint64 now = position();
+  while (nextFrame < frameList.count() && frameList.at(nextFrame).time <= now) {
+    const Frame & frame = frameList.at(nextFrame++);
+    if (frame.external)
+      emit externalTelemetryDataChanged(frame.frame.first, frame.frame.second);
+    else
+      emit internalTelemetryDataChanged(frame.frame.first, frame.frame.second);
+  }
+
+  if (nextFrame >= frameList.count()) {
+    if (!looping || duration() == 0) {
+      playing = false;
+      stopPosition = duration();
+      emit positionChanged(stopPosition);
+      emit finished();
+      return;
+    }
+    now = 0;
+    nextFrame = 0;
+    restartClock(now);
+  }
+
+  const qint64 time = clockTime();
+  if (time - positionTime > qint64(TELEMETRY_REPLAY_POSITION_PERIOD) * 1000000) {
+    positionTime = time;
+    emit positionChanged(now);
+  }
+
+  scheduleNext(now);
+}
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include "telemetrylog.h"
+#include "telemetryprovider.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QTimer>
+#include <QVector>
+
+#define TELEMETRY_REPLAY_MIN_SPEED       0.2
+#define TELEMETRY_REPLAY_MAX_SPEED       50
+#define TELEMETRY_REPLAY_MAX_SPREAD      1000  // ms
+#define TELEMETRY_REPLAY_POSITION_PERIOD 100   // ms
+
+// Replay of a telemetry log into the simulator.
+//
+// The log is encoded once into the frames of the selected telemetry
+// providers, each stamped with its time in the log. Playback then only sends
+// the frames which are due, from a timer set to the next one, so that the
+// replay keeps the log timing at any speed without going through the widgets
+// of the providers.
+class TelemetryLogReplay : public QObject
+{
+  Q_OBJECT
+
+  public:
+    struct Frame {
+      qint64 time;        // ms from the first record
+      bool external;
+      TelemetryFrame frame;
+    };
+
+    explicit TelemetryLogReplay(QObject * parent = nullptr);
+
+    bool load(const QString & path);
+    void clear();
+    const TelemetryLog & log() const { return telemetryLog; }
+
+    // Encode the log for the selected providers (nullptr if none). Returns
+    // false if none is selected or one cannot encode log items
+    bool encode(TelemetryProvider * internal, TelemetryProvider * external);
+    // Providers changed: the log must be encoded again
+    void clearFrames();
+    bool isEncoded() const { return !frameList.isEmpty(); }
+    const QVector<Frame> & frames() const { return frameList; }
+
+    qint64 duration() const;
+    qint64 position() const;
+    // log record at a position, and position of a record
+    int row(qint64 position) const;
+    qint64 rowPosition(int row) const;
+
+    bool isPlaying() const { return playing; }
+    double speed() const { return playSpeed; }
+    bool isLooping() const { return looping; }
+
+    static QString itemFromColumnName(const QString & columnName);
+    static QString unitFromColumnName(const QString & columnName);
+    static QString convertItemValue(const QString & sourceUnit, const QString & destUnit, const QString & value);
+
+  public slots:
+    void play();
+    void stop();
+    void seek(qint64 position);
+    void setSpeed(double speed);
+    void setLooping(bool enable);
+
+  signals:
+    void internalTelemetryDataChanged(const quint8 protocol, const QByteArray data);
+    void externalTelemetryDataChanged(const quint8 protocol, const QByteArray data);
+    // while playing, at most every TELEMETRY_REPLAY_POSITION_PERIOD ms
+    void positionChanged(qint64 position);
+    void finished();
+
+  protected slots:
+    void onTimer();
+
+  protected:
+    // Monotonic time (ns) and timer of the playback, overridden by the tests
+    // to run the replay on a simulated clock
+    virtual qint64 clockTime() const;
+    virtual void armTimer(qint64 delay);
+
+    void restartClock(qint64 position);
+    void scheduleNext(qint64 position);
+
+    TelemetryLog telemetryLog;
+    QVector<qint64> rowTimes;   // ms from the first record, never decreasing
+    QVector<Frame> frameList;
+    int nextFrame;
+    qint64 stopPosition;        // position when stopped
+    qint64 clockPosition;       // position when the clock was started
+    qint64 clockStart;          // clockTime() when the clock was started
+    qint64 positionTime;        // clockTime() of the last positionChanged()
+    QElapsedTimer monotonic;
+    QTimer timer;
+    double playSpeed;
+    bool playing;
+    bool looping;
+};
@@ -23,6 +23,11 @@
 
 #include "simulatorinterface.h"
 #include <QHash>
+#include <QList>
+#include <QPair>
+
+// A telemetry frame as sent to the simulator: protocol and data
+typedef QPair<quint8, QByteArray> TelemetryFrame;
 
 class TelemetryProvider
 {
@@ -47,4 +52,14 @@ class TelemetryProvider
 
     // do the work every however often
     virtual void generateTelemetryFrame(SimulatorInterface * simulator) = 0;
+
+    // Encode the frames of one log record for the replay engine, without going
+    // through the UI. items are in the units of getSupportedLogItems(). Returns
+    // false if the provider can only be fed through loadItemFromLog()
+    virtual bool encodeLogItems(const QHash<QString, QString> & items, QList<TelemetryFrame> & frames)
+    {
+      Q_UNUSED(items);
+      Q_UNUSED(frames);
+      return false;
+    }
 };
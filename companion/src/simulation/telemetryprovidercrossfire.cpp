@@ -215,6 +215,76 @@ void TelemetryProviderCrossfire::generateTelemetryFrame(SimulatorInterface *simu
   }
 }
 
+bool TelemetryProviderCrossfire::encodeLogItems(const QHash<QString, QString> & items, QList<TelemetryFrame> & frames)
+{
+  // items missing from the record keep the values of the UI
+  auto value = [&](const char * item, double current) {
+    auto it = items.constFind(item);
+    return it == items.constEnd() ? current : it->toDouble();
+  };
+  auto contains = [&](std::initializer_list<const char *> names) {
+    for (const char * name : names) {
+      if (items.contains(name))
+        return true;
+    }
+    return false;
+  };
+
+  uint8_t buffer[CROSSFIRE_PACKET_SIZE];
+  auto append = [&]() {
+    frames.append(TelemetryFrame(SIMU_TELEMETRY_PROTOCOL_CROSSFIRE, QByteArray((char *)buffer, CROSSFIRE_PACKET_SIZE)));
+    memset(buffer, 0, sizeof(buffer));
+  };
+  memset(buffer, 0, sizeof(buffer));
+
+  // Always generate link stats
+  int tpwr = ui->input_tpwr->currentIndex();
+  if (items.contains("TPWR")) {
+    int index = ui->input_tpwr->findText(items.value("TPWR") + "mW");
+    if (index >= 0)
+      tpwr = index;
+  }
+  generateTelemetryLinkStatisticsFrame(buffer, value("1RSS", ui->input_1rss->value()), value("2RSS", ui->input_2rss->value()),
+                                       value("RQly", ui->input_rqly->value()), value("RSNR", ui->input_rsnr->value()),
+                                       value("ANT", ui->input_ant->value()), value("RFMD", ui->input_rfmd->value()),
+                                       dropdownToTPWRMap[tpwr], value("TRSS", ui->input_trss->value()),
+                                       value("TQly", ui->input_tqly->value()), value("TSNR", ui->input_tsnr->value()));
+  append();
+
+  if (ui->enabled_battery->isChecked() && contains({"RxBt", "Curr", "Capa", "Bat%"})) {
+    generateTelemetryBatterySensorFrame(buffer, value("RxBt", ui->input_rxbt->value()), value("Curr", ui->input_curr->value()),
+                                        value("Capa", ui->input_capa->value()), value("Bat%", ui->input_batpercent->value()));
+    append();
+  }
+
+  if (ui->enabled_gps->isChecked() && contains({"GPS", "GSpd", "Hdg", "Sats"})) {
+    double lat = gps.lat, lon = gps.lon;
+    if (items.contains("GPS"))
+      SimulatedGPS::parseLatLon(items.value("GPS"), lat, lon);
+    generateTelemetryGPSFrame(buffer, lat, lon, value("GSpd", gps.speedKMH), value("Hdg", gps.courseDegrees),
+                              value("Alt", gps.altitude), value("Sats", gps.satellites));
+    append();
+  }
+
+  if (ui->enabled_attitude->isChecked() && contains({"Ptch", "Roll", "Yaw"})) {
+    generateTelemetryAttitudeFrame(buffer, value("Ptch", ui->input_ptch->value()), value("Roll", ui->input_roll->value()),
+                                   value("Yaw", ui->input_yaw->value()));
+    append();
+  }
+
+  if (ui->enabled_flightcontroller->isChecked() && items.contains("FM")) {
+    generateTelemetryFlightModeFrame(buffer, QString(items.value("FM")).remove(QChar('"')));
+    append();
+  }
+
+  if (ui->enabled_barometer->isChecked() && contains({"Alt", "VSpd"})) {
+    generateTelemetryBarometerFrame(buffer, value("Alt", ui->input_alt->value()), value("VSpd", ui->input_vspd->value()));
+    append();
+  }
+
+  return true;
+}
+
 void TelemetryProviderCrossfire::generateTelemetryLinkStatisticsFrame(uint8_t *packet, uint8_t rss1, uint8_t rss2, uint8_t rqly, int8_t rsnr, uint8_t ant, uint8_t rfmd, uint8_t tpwr, uint8_t trss, uint8_t tqly, int8_t tsnr)
 {
   packet[0] = 0xc8; // SYNC
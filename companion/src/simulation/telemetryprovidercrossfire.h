@@ -44,6 +44,8 @@ class TelemetryProviderCrossfire : public QWidget, public TelemetryProvider
     explicit TelemetryProviderCrossfire(QWidget * parent);
     virtual ~TelemetryProviderCrossfire();
 
+    bool encodeLogItems(const QHash<QString, QString> & items, QList<TelemetryFrame> & frames) override;
+
   signals:
     void telemetryDataChanged(const quint8 protocol, const QByteArray data);
 
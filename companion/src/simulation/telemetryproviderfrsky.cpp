@@ -541,6 +541,30 @@ uint32_t TelemetryProviderFrSky::FlvssEmulator::setAllCells_GetNextPair(double c
   return cellData;
 }
 
+int TelemetryProviderFrSky::FlvssEmulator::encodeTotalVoltage(double totalVolts, uint32_t cellData[MAXCELLS / 2])
+{
+  if (totalVolts <= 0)
+    return 0;
+
+  if (totalVolts > 4.2) {
+    splitIntoCells(totalVolts);
+  }
+  else {
+    numCells = 1;
+    cellFloats[0] = totalVolts;
+    for (uint32_t i = 1; i < MAXCELLS; i++) {
+      cellFloats[i] = 0;
+    }
+  }
+  encodeAllCells();
+
+  cellData[0] = cellData1;
+  cellData[1] = cellData2;
+  cellData[2] = cellData3;
+  cellData[3] = cellData4;
+  return (numCells + 1) / 2;
+}
+
 uint32_t encodeLatLon(double latLon, bool isLat)
 {
   uint32_t data = (uint32_t)((latLon < 0 ? -latLon : latLon) * 60 * 10000) & 0x3FFFFFFF;
@@ -615,6 +639,97 @@ void TelemetryProviderFrSky::setDateTimeFromGPS(QDateTime dateTime)
   ui->gps_time->setText(dateTime.toString(format));
 }
 
+bool TelemetryProviderFrSky::encodeLogItems(const QHash<QString, QString> & items, QList<TelemetryFrame> & frames)
+{
+  uint8_t buffer[FRSKY_SPORT_PACKET_SIZE];
+  double value;
+
+  auto logValue = [&](const char * item) {
+    auto it = items.constFind(item);
+    if (it == items.constEnd())
+      return false;
+    value = it->toDouble();
+    return true;
+  };
+  auto append = [&](QLineEdit * instance, uint16_t appId, uint32_t data) {
+    bool ok;
+    uint8_t dataId = instance->text().toInt(&ok, 0);
+    if (ok && generateSportPacket(buffer, dataId, DATA_FRAME, appId, data))
+      frames.append(TelemetryFrame(SIMU_TELEMETRY_PROTOCOL_FRSKY_SPORT, QByteArray((char *)buffer, FRSKY_SPORT_PACKET_SIZE)));
+  };
+
+  if (logValue("RxBt"))
+    append(ui->rxbt_inst, BATT_ID, LIMIT<uint32_t>(0, value * 255.0 / ui->rxbt_ratio->value(), 0xFFFFFFFF));
+  if (logValue("RSSI"))
+    append(ui->rssi_inst, RSSI_ID, LIMIT<uint32_t>(0, value, 0xFF));
+  if (logValue("A1"))
+    append(ui->a1_inst, ADC1_ID, LIMIT<uint32_t>(0, value * 255.0 / ui->A1_ratio->value(), 0xFF));
+  if (logValue("A2"))
+    append(ui->a2_inst, ADC2_ID, LIMIT<uint32_t>(0, value * 255.0 / ui->A2_ratio->value(), 0xFF));
+  if (logValue("A3"))
+    append(ui->a3_inst, A3_FIRST_ID, LIMIT<int32_t>(-0x7FFFFFFF, value * 100.0, 0x7FFFFFFF));
+  if (logValue("A4"))
+    append(ui->a4_inst, A4_FIRST_ID, LIMIT<int32_t>(-0x7FFFFFFF, value * 100.0, 0x7FFFFFFF));
+  if (logValue("Tmp1"))
+    append(ui->t1_inst, T1_FIRST_ID, LIMIT<int32_t>(-0x7FFFFFFF, value, 0x7FFFFFFF));
+  if (logValue("Tmp2"))
+    append(ui->t2_inst, T2_FIRST_ID, LIMIT<int32_t>(-0x7FFFFFFF, value, 0x7FFFFFFF));
+  if (logValue("RPM"))
+    append(ui->rpm_inst, RPM_FIRST_ID, LIMIT<uint32_t>(0, value, 0x7FFFFFFF));
+  if (logValue("Fuel")) {
+    // Fuel(%) and Fuel(ml) are both logged as "Fuel", see loadItemFromLog()
+    append(ui->fuel_inst, FUEL_FIRST_ID, LIMIT<uint32_t>(0, value, 0xFFFF));
+    append(ui->fuel_qty_inst, FUEL_QTY_FIRST_ID, LIMIT<uint32_t>(0, value * 100.0, 0xFFFFFF));
+  }
+  if (logValue("VSpd"))
+    append(ui->vvspd_inst, VARIO_FIRST_ID, LIMIT<int32_t>(-0x7FFFFFFF, value * 100.0, 0x7FFFFFFF));
+  if (logValue("Alt"))
+    append(ui->valt_inst, ALT_FIRST_ID, LIMIT<int32_t>(-0x7FFFFFFF, value * 100.0, 0x7FFFFFFF));
+  if (logValue("VFAS"))
+    append(ui->fasv_inst, VFAS_FIRST_ID, LIMIT<uint32_t>(0, value * 100.0, 0xFFFFFFFF));
+  if (logValue("Curr"))
+    append(ui->fasc_inst, CURR_FIRST_ID, LIMIT<uint32_t>(0, value * 10.0, 0xFFFFFFFF));
+  if (logValue("Cels")) {
+    // only the total is logged
+    FlvssEmulator flvss;
+    uint32_t cellData[FlvssEmulator::MAXCELLS / 2];
+    int pairs = flvss.encodeTotalVoltage(value, cellData);
+    for (int i = 0; i < pairs; i++) {
+      append(ui->cells_inst, CELLS_FIRST_ID, cellData[i]);
+    }
+  }
+  if (logValue("ASpd"))
+    append(ui->aspd_inst, AIR_SPEED_FIRST_ID, LIMIT<uint32_t>(0, value * 5.39957, 0xFFFFFFFF));
+  if (logValue("GAlt"))
+    append(ui->gpsa_inst, GPS_ALT_FIRST_ID, (uint32_t)(value * 100));
+  if (logValue("GSpd"))
+    append(ui->gpss_inst, GPS_SPEED_FIRST_ID, value * 0.539957 * 1000);
+  if (logValue("Hdg"))
+    append(ui->gpsc_inst, GPS_COURS_FIRST_ID, value * 100);
+  if (items.contains("Date")) {
+    QDateTime dt = QDateTime::fromString(convertGPSDate(items.value("Date")), "dd-MM-yyyy hh:mm:ss");
+    if (dt.isValid()) {
+      append(ui->gpst_inst, GPS_TIME_DATE_FIRST_ID, encodeDateTime(dt.date().year() - 2000, dt.date().month(), dt.date().day(), true));
+      append(ui->gpst_inst, GPS_TIME_DATE_FIRST_ID, encodeDateTime(dt.time().hour(), dt.time().minute(), dt.time().second(), false));
+    }
+  }
+  if (items.contains("GPS")) {
+    double lat, lon;
+    if (SimulatedGPS::parseLatLon(items.value("GPS"), lat, lon)) {
+      append(ui->gpsll_inst, GPS_LONG_LATI_FIRST_ID, encodeLatLon(lat, true));
+      append(ui->gpsll_inst, GPS_LONG_LATI_FIRST_ID, encodeLatLon(lon, false));
+    }
+  }
+  if (logValue("AccX"))
+    append(ui->accx_inst, ACCX_FIRST_ID, LIMIT<int32_t>(-0x7FFFFFFF, value * 100.0, 0x7FFFFFFF));
+  if (logValue("AccY"))
+    append(ui->accy_inst, ACCY_FIRST_ID, LIMIT<int32_t>(-0x7FFFFFFF, value * 100.0, 0x7FFFFFFF));
+  if (logValue("AccZ"))
+    append(ui->accz_inst, ACCZ_FIRST_ID, LIMIT<int32_t>(-0x7FFFFFFF, value * 100.0, 0x7FFFFFFF));
+
+  return true;
+}
+
 void TelemetryProviderFrSky::on_saveTelemetryvalues_clicked()
 {
     QString fldr = g.backupDir().trimmed();
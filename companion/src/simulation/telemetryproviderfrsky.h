@@ -41,6 +41,8 @@ class TelemetryProviderFrSky : public QWidget, public TelemetryProvider
     explicit TelemetryProviderFrSky(QWidget * parent);
     virtual ~TelemetryProviderFrSky();
 
+    bool encodeLogItems(const QHash<QString, QString> & items, QList<TelemetryFrame> & frames) override;
+
   signals:
     void telemetryDataChanged(const quint8 protocol, const QByteArray data);
 
@@ -69,6 +71,8 @@ class TelemetryProviderFrSky : public QWidget, public TelemetryProvider
       public:
         static const uint32_t MAXCELLS = 8;
         uint32_t setAllCells_GetNextPair(double cellValues[MAXCELLS]);
+        // all the cell pairs of a total voltage, returns the number of pairs
+        int encodeTotalVoltage(double totalVolts, uint32_t cellData[MAXCELLS / 2]);
 
       private:
         void encodeAllCells();
@@ -28,6 +28,7 @@
 #include "telemetryproviderfrsky.h"
 #include "telemetryproviderfrskyhub.h"
 #include "telemetryprovidercrossfire.h"
+#include "telemetrylogreplay.h"
 
 #include <QRegularExpression>
 #include <stdint.h>
@@ -71,6 +72,10 @@ TelemetrySimulator::TelemetrySimulator(QWidget * parent, SimulatorInterface * si
   connect(ui->internalTelemetrySelector, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &TelemetrySimulator::onInternalTelemetrySelectorChanged);
   connect(ui->externalTelemetrySelector, QOverload<int>::of(&QComboBox::currentIndexChanged), this, &TelemetrySimulator::onExternalTelemetrySelectorChanged);
 
+  connect(&logReplay, &TelemetryLogReplay::internalTelemetryDataChanged, this, &TelemetrySimulator::internalTelemetryDataChanged);
+  connect(&logReplay, &TelemetryLogReplay::externalTelemetryDataChanged, this, &TelemetrySimulator::externalTelemetryDataChanged);
+  connect(&logReplay, &TelemetryLogReplay::positionChanged,              this, &TelemetrySimulator::onReplayPositionChanged);
+
   connect(this, &TelemetrySimulator::internalTelemetryDataChanged, simulator, &SimulatorInterface::sendInternalModuleTelemetry);
   connect(this, &TelemetrySimulator::externalTelemetryDataChanged, simulator, &SimulatorInterface::sendExternalModuleTelemetry);
 
@@ -121,9 +126,9 @@ void TelemetrySimulator::startTelemetry()
 
 void TelemetrySimulator::stopTelemetry()
 {
-  timer.stop();
-  m_logReplayEnable = logTimer.isActive();
+  m_logReplayEnable = logTimer.isActive() || logReplay.isPlaying();
   onStop();
+  timer.stop();
 
   if (!g.currentProfile().telemSimResetRssiOnStop())
     return;
@@ -206,6 +211,8 @@ void TelemetrySimulator::onInternalTelemetrySelectorChanged(int selectedIndex)
     delete internalProvider;
   }
   internalProvider = newTelemetryProviderFromDropdownChoice(selectedIndex, ui->internalScrollArea, false);
+  stopLogReplay();
+  logReplay.clearFrames();
 }
 
 void TelemetrySimulator::onExternalTelemetrySelectorChanged(int selectedIndex)
@@ -214,6 +221,8 @@ void TelemetrySimulator::onExternalTelemetrySelectorChanged(int selectedIndex)
     delete externalProvider;
   }
   externalProvider = newTelemetryProviderFromDropdownChoice(selectedIndex, ui->externalScrollArea, true);
+  stopLogReplay();
+  logReplay.clearFrames();
 }
 
 void TelemetrySimulator::onInternalTelemetryProviderDataChanged(const quint8 protocol, const QByteArray data)
@@ -249,15 +258,44 @@ void TelemetrySimulator::onPlay()
 {
   ui->Simulate->setChecked(true);
   if (logPlayback->isReady()) {
-    logTimer.start(logPlayback->logFrequency * 1000 / SPEEDS[ui->replayRate->value()]);
+    // the log is encoded once for the selected providers, then replayed at its own pace
+    if (!logReplay.isEncoded() && logReplay.log().rowCount() > 0)
+      logReplay.encode(internalProvider, externalProvider);
+    if (logReplay.isEncoded()) {
+      timer.stop();  // the provider frames would be interleaved with the log ones
+      logReplay.setSpeed(SPEEDS[ui->replayRate->value()]);
+      logReplay.seek(logReplay.rowPosition(logPlayback->record() - 1));
+      logReplay.play();
+    }
+    else {
+      logTimer.start(logPlayback->logFrequency * 1000 / SPEEDS[ui->replayRate->value()]);
+    }
     logPlayback->play();
   }
 }
 
+void TelemetrySimulator::stopLogReplay()
+{
+  logTimer.stop();
+  if (logReplay.isPlaying()) {
+    logReplay.stop();
+    logPlayback->setRecord(logReplay.row(logReplay.position()) + 1);
+    if (m_simuStarted)
+      timer.start();
+  }
+}
+
+void TelemetrySimulator::onReplayPositionChanged(qint64 position)
+{
+  // the position only, the provider widgets are updated when stopped
+  QSignalBlocker blocker(ui->positionIndicator);
+  logPlayback->setRecord(logReplay.row(position) + 1, false);
+}
+
 void TelemetrySimulator::onRewind()
 {
   if (logPlayback->isReady()) {
-    logTimer.stop();
+    stopLogReplay();
     logPlayback->rewind();
   }
 }
@@ -265,7 +303,7 @@ void TelemetrySimulator::onRewind()
 void TelemetrySimulator::onStepForward()
 {
   if (logPlayback->isReady()) {
-    logTimer.stop();
+    stopLogReplay();
     logPlayback->stepForward(true);
   }
 }
@@ -273,7 +311,7 @@ void TelemetrySimulator::onStepForward()
 void TelemetrySimulator::onStepBack()
 {
   if (logPlayback->isReady()) {
-    logTimer.stop();
+    stopLogReplay();
     logPlayback->stepBack();
   }
 }
@@ -281,13 +319,17 @@ void TelemetrySimulator::onStepBack()
 void TelemetrySimulator::onStop()
 {
   if (logPlayback->isReady()) {
-    logTimer.stop();
+    stopLogReplay();
     logPlayback->stop();
   }
 }
 
 void TelemetrySimulator::onPositionIndicatorChanged(int value)
 {
+  if (logReplay.isPlaying()) {
+    logReplay.seek(logReplay.duration() * value / 100);
+    return;
+  }
   if (logPlayback->isReady()) {
     logPlayback->updatePositionLabel(value);
     logPlayback->setUiDataValues();
@@ -296,8 +338,11 @@ void TelemetrySimulator::onPositionIndicatorChanged(int value)
 
 void TelemetrySimulator::onReplayRateChanged(int value)
 {
+  if (logReplay.isPlaying()) {
+    logReplay.setSpeed(SPEEDS[value]);
+  }
   if (logTimer.isActive()) {
-    logTimer.setInterval(logPlayback->logFrequency * 1000 / SPEEDS[ui->replayRate->value()]);
+    logTimer.setInterval(logPlayback->logFrequency * 1000 / SPEEDS[value]);
   }
 }
 
@@ -306,119 +351,27 @@ TelemetrySimulator::LogPlaybackController::LogPlaybackController(Ui::TelemetrySi
 {
   TelemetrySimulator::LogPlaybackController::sim = sim;
   TelemetrySimulator::LogPlaybackController::ui = ui;
+  telemetryLog = nullptr;
   stepping = false;
 }
 
-QString convertFeetToMeters(QString input)
-{
-  double meters = input.toDouble() * 0.3048;
-  return QString::number(meters);
-}
-
-QString convertFahrenheitToCelsius(QString input)
-{
-  double celsius = (input.toDouble() - 32.0) * 0.5556;
-  return QString::number(celsius);
-}
-
-QString convertKnotsToKPH(QString input)
-{
-  double kph = input.toDouble() * 1.852;
-  return QString::number(kph);
-}
-
-QString convertMilesPerHourToKPH(QString input)
-{
-  double kph = input.toDouble() * 1.60934;
-  return QString::number(kph);
-}
-
-QString convertMetersPerSecondToKPH(QString input)
-{
-  double kph = input.toDouble() * 3.6;
-  return QString::number(kph);
-}
-
-QString convertFeetPerSecondToKPH(QString input)
-{
-  double kph = input.toDouble() * 1.09728;
-  return QString::number(kph);
-}
-
-QString convertDegreesToRadians(QString input)
-{
-  double rad = input.toDouble() * 0.0174533;
-  return QString::number(rad);
-}
-
-QString convertRadiansToDegrees(QString input)
+int TelemetrySimulator::LogPlaybackController::recordCount() const
 {
-  double deg = input.toDouble() * 57.2958;
-  return QString::number(deg);
+  return telemetryLog ? telemetryLog->rowCount() + 1 : csvRecords.count();
 }
 
-QString convertWattToMilliwatt(QString input)
+QStringList TelemetrySimulator::LogPlaybackController::recordCells(int index) const
 {
-  double mw = input.toDouble() * 1000;
-  return QString::number(mw);
+  return telemetryLog ? telemetryLog->cells(index - 1) : csvRecords.value(index).split(',');
 }
 
-QString convertFluidOuncesToMilliliters(QString input)
+QDateTime TelemetrySimulator::LogPlaybackController::parseTransmitterTimestamp(const QStringList & rowParts)
 {
-  double ml = input.toDouble() * 29.5735;
-  return QString::number(ml);
-}
-
-QString convertDBMToMilliwatts(QString input)
-{
-  double dbm = input.toDouble();
-  double mw = qPow(10, dbm/10);
-  return QString::number(mw);
-}
-
-struct unitConversion {
-  QString source;
-  QString destination;
-  QString (*converter)(QString);
-} conversions[] = {
-    {QString("ft"), QString("m"), convertFeetToMeters},
-    {QString("°F"), QString("°C"), convertFahrenheitToCelsius},
-    {QString("kts"), QString("kmh"), convertKnotsToKPH},
-    {QString("mph"), QString("kmh"), convertMilesPerHourToKPH},
-    {QString("m/s"), QString("kmh"), convertMetersPerSecondToKPH},
-    {QString("f/s"), QString("kmh"), convertFeetPerSecondToKPH},
-    {QString("°"), QString("rad"), convertDegreesToRadians},
-    {QString("rad"), QString("°"), convertRadiansToDegrees},
-    {QString("W"), QString("mW"), convertWattToMilliwatt},
-    {QString("fOz"), QString("ml"), convertFluidOuncesToMilliliters},
-    {QString("dBm"), QString("mW"), convertDBMToMilliwatts},
-    {NULL, NULL, NULL},
-  };
-
-QString convertItemValue(QString sourceUnit, QString destUnit, QString value)
-{
-  if (sourceUnit == destUnit)
-    return value;
-
-  int i = 0;
-  while (!conversions[i].source.isNull()) {
-    if (conversions[i].source == sourceUnit && conversions[i].destination == destUnit) {
-      return ((conversions[i].converter)(value));
-    }
-    i++;
-  }
-  qDebug() << "TelemetrySimulator::LogPlaybackController: failed to convert " << sourceUnit << " to " << destUnit;
-  return value;
-}
-
-QDateTime TelemetrySimulator::LogPlaybackController::parseTransmitterTimestamp(QString row)
-{
-  QStringList rowParts = row.simplified().split(',');
   if (rowParts.size() < 2) {
     return QDateTime();
   }
-  QString datePart = rowParts[0];
-  QString timePart = rowParts[1];
+  QString datePart = rowParts[0].simplified();
+  QString timePart = rowParts[1].simplified();
   QDateTime result;
   QString format("yyyy-MM-dd hh:mm:ss.zzz"); // assume this format
   // hour can be 'missing'
@@ -437,9 +390,9 @@ void TelemetrySimulator::LogPlaybackController::calcLogFrequency()
   // Skip the first entry which contains the file open time
   logFrequency = 25.5; // default value
   QDateTime lastTime;
-  for (int i = 2; (i < 21) && (i < csvRecords.count()); i++)
+  for (int i = 2; (i < 21) && (i < recordCount()); i++)
   {
-    QDateTime logTime = parseTransmitterTimestamp(csvRecords[i]);
+    QDateTime logTime = parseTransmitterTimestamp(recordCells(i));
     // ugh - no timespan in this Qt version
     double timeDiff = (logTime.toMSecsSinceEpoch() - lastTime.toMSecsSinceEpoch()) / 1000.0;
     if ((timeDiff > 0.09) && (timeDiff < logFrequency)) {
@@ -451,14 +404,14 @@ void TelemetrySimulator::LogPlaybackController::calcLogFrequency()
 
 bool TelemetrySimulator::LogPlaybackController::isReady()
 {
-  return csvRecords.count() > 1;
+  return recordCount() > 1;
 }
 
-void TelemetrySimulator::LogPlaybackController::loadLogFile()
+QString TelemetrySimulator::LogPlaybackController::loadLogFile()
 {
   QString logFileNameAndPath = QFileDialog::getOpenFileName(NULL, tr("Log File"), g.logDir(), tr("LOG Files (*.csv)"));
   if (logFileNameAndPath.isEmpty())
-    return;
+    return QString();
 
   g.logDir(logFileNameAndPath);
 
@@ -474,20 +427,28 @@ void TelemetrySimulator::LogPlaybackController::loadLogFile()
 
   // clear existing data
   csvRecords.clear();
+  telemetryLog = nullptr;
 
-  QFile file(logFileNameAndPath);
-  if (!file.open(QIODevice::ReadOnly)) {
-    ui->logFileLabel->setText(tr("ERROR - invalid file"));
-    return;
+  // a radio log is parsed once, for the replay and for the records shown here
+  if (sim->logReplay.load(logFileNameAndPath)) {
+    telemetryLog = &sim->logReplay.log();
   }
-  while (!file.atEnd()) {
-    QByteArray line = file.readLine();
-    csvRecords.append(line.simplified());
+  else {
+    sim->logReplay.clear();  // not a radio log, played through the UI
+    QFile file(logFileNameAndPath);
+    if (!file.open(QIODevice::ReadOnly)) {
+      ui->logFileLabel->setText(tr("ERROR - invalid file"));
+      return QString();
+    }
+    while (!file.atEnd()) {
+      QByteArray line = file.readLine();
+      csvRecords.append(line.simplified());
+    }
+    file.close();
   }
-  file.close();
-  if (csvRecords.count() > 1) {
+  if (recordCount() > 1) {
     columnNames.clear();
-    QStringList keys = csvRecords[0].split(',');
+    QStringList keys = telemetryLog ? telemetryLog->columnNames() : csvRecords[0].split(',');
     // override the first two column names
     keys[0] = "LogDate";
     keys[1] = "LogTime";
@@ -506,7 +467,7 @@ void TelemetrySimulator::LogPlaybackController::loadLogFile()
   }
   ui->logFileLabel->setText(QFileInfo(logFileNameAndPath).fileName());
   rewind();
-  return;
+  return logFileNameAndPath;
 }
 
 void TelemetrySimulator::LogPlaybackController::play()
@@ -530,7 +491,7 @@ void TelemetrySimulator::LogPlaybackController::rewind()
 void TelemetrySimulator::LogPlaybackController::stepForward(bool focusOnStop)
 {
   stepping = true;
-  if (recordIndex < (csvRecords.count() - 1)) {
+  if (recordIndex < (recordCount() - 1)) {
     recordIndex++;
     if (focusOnStop) {
       ui->stop->setChecked(true);
@@ -544,6 +505,21 @@ void TelemetrySimulator::LogPlaybackController::stepForward(bool focusOnStop)
   stepping = false;
 }
 
+int TelemetrySimulator::LogPlaybackController::record() const
+{
+  return recordIndex;
+}
+
+void TelemetrySimulator::LogPlaybackController::setRecord(int index, bool updateValues)
+{
+  stepping = true;
+  recordIndex = qBound(1, index, recordCount() - 1);
+  updatePositionLabel(-1);
+  if (updateValues)
+    setUiDataValues();
+  stepping = false;
+}
+
 void TelemetrySimulator::LogPlaybackController::stepBack()
 {
   stepping = true;
@@ -559,41 +535,25 @@ void TelemetrySimulator::LogPlaybackController::stepBack()
 void TelemetrySimulator::LogPlaybackController::updatePositionLabel(int32_t percentage)
 {
   if ((percentage > 0) && (!stepping)) {
-    recordIndex = qFloor((double)csvRecords.count() / 100.0 * percentage);
+    recordIndex = qFloor((double)recordCount() / 100.0 * percentage);
     if (recordIndex == 0) {
       recordIndex = 1; // record 0 is column labels
     }
   }
   // format the transmitter date info
-  QDateTime transmitterTimestamp = parseTransmitterTimestamp(csvRecords[recordIndex]);
+  QDateTime transmitterTimestamp = parseTransmitterTimestamp(recordCells(recordIndex));
   QString format("yyyy-MM-dd hh:mm:ss.z");
-  ui->positionLabel->setText("Row " + QString::number(recordIndex) + " of " + QString::number(csvRecords.count() - 1)
+  ui->positionLabel->setText("Row " + QString::number(recordIndex) + " of " + QString::number(recordCount() - 1)
               + "\n" + transmitterTimestamp.toString(format));
   if (percentage < 0) { // did we step past a threshold?
-    uint32_t posPercent = (recordIndex / (double)(csvRecords.count() - 1)) * 100;
+    uint32_t posPercent = (recordIndex / (double)(recordCount() - 1)) * 100;
     ui->positionIndicator->setValue(posPercent);
   }
 }
 
-QString unitFromColumnName(QString columnName)
-{
-  QStringList parts = columnName.split('(');
-  if (parts.count() == 1) {
-    return QString("");
-  }
-  parts = parts[1].split(')');
-  return parts[0];
-}
-
-QString itemFromColumnName(QString columnName)
-{
-  QStringList parts = columnName.split('(');
-  return parts[0];
-}
-
 void TelemetrySimulator::LogPlaybackController::setUiDataValues()
 {
-  QStringList columnData = csvRecords[recordIndex].split(',');
+  QStringList columnData = recordCells(recordIndex);
 
   TelemetryProvider *internalProvider = sim->getInternalTelemetryProvider();
   TelemetryProvider *externalProvider = sim->getExternalTelemetryProvider();
@@ -605,22 +565,22 @@ void TelemetrySimulator::LogPlaybackController::setUiDataValues()
   if (externalProvider)
     externalSupportedItems = externalProvider->getSupportedLogItems();
 
-  for (int col = 0; col < columnData.count(); col++) {
+  for (int col = 0; col < columnData.count() && col < columnNames.count(); col++) {
     QString columnName = columnNames[col];
-    QString columnValue = columnData[col];
+    QString columnValue = columnData[col].simplified();
 
-    QString item = itemFromColumnName(columnName);
-    QString suppliedUnit = unitFromColumnName(columnName);
+    QString item = TelemetryLogReplay::itemFromColumnName(columnName);
+    QString suppliedUnit = TelemetryLogReplay::unitFromColumnName(columnName);
 
     if (internalSupportedItems && internalSupportedItems->contains(item)) {
       QString expectedUnit = internalSupportedItems->value(item);
 
-      internalProvider->loadItemFromLog(item, convertItemValue(suppliedUnit, expectedUnit, columnValue));
+      internalProvider->loadItemFromLog(item, TelemetryLogReplay::convertItemValue(suppliedUnit, expectedUnit, columnValue));
     }
     if (externalSupportedItems && externalSupportedItems->contains(item)) {
       QString expectedUnit = externalSupportedItems->value(item);
 
-      externalProvider->loadItemFromLog(item, convertItemValue(suppliedUnit, expectedUnit, columnValue));
+      externalProvider->loadItemFromLog(item, TelemetryLogReplay::convertItemValue(suppliedUnit, expectedUnit, columnValue));
     }
   }
 }
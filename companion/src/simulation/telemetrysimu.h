@@ -31,8 +31,9 @@
 
 #include "simulatorinterface.h"
 #include "telemetryprovider.h"
+#include "telemetrylogreplay.h"
 
-static double const SPEEDS[] = { 0.2, 0.4, 0.6, 0.8, 1, 2, 3, 4, 5 };
+static double const SPEEDS[] = { 0.2, 0.4, 0.6, 0.8, 1, 2, 3, 4, 5, 10, 20, 50 };
 template<class t> t LIMIT(t mi, t x, t ma) { return std::min(std::max(mi, x), ma); }
 
 namespace Ui {
@@ -70,6 +71,7 @@ class TelemetrySimulator : public QWidget
     void onStop();
     void onPositionIndicatorChanged(int value);
     void onReplayRateChanged(int value);
+    void onReplayPositionChanged(qint64 position);
     void onInternalTelemetrySelectorChanged(int selectedIndex);
     void onExternalTelemetrySelectorChanged(int selectedIndex);
     void onInternalTelemetryProviderDataChanged(const quint8 protocol, const QByteArray data);
@@ -78,12 +80,14 @@ class TelemetrySimulator : public QWidget
   TelemetryProvider * newTelemetryProviderFromDropdownChoice(int selectedIndex, QScrollArea * parent, bool isExternal);
     TelemetryProvider * getInternalTelemetryProvider();
     TelemetryProvider * getExternalTelemetryProvider();
+    void stopLogReplay();
 
   protected:
 
     Ui::TelemetrySimulator * ui;
     QTimer timer;
     QTimer logTimer;
+    TelemetryLogReplay logReplay;
     SimulatorInterface *simulator;
     bool m_simuStarted;
     bool m_logReplayEnable;
@@ -97,23 +101,29 @@ class TelemetrySimulator : public QWidget
       public:
       LogPlaybackController(Ui::TelemetrySimulator * ui, TelemetrySimulator * sim);
         bool isReady();
-        void loadLogFile();
+        QString loadLogFile();
         void play();
         void stop();
         void rewind();
         void stepForward(bool focusOnStop = false);
         void stepBack();
+        int record() const;
+        void setRecord(int index, bool updateValues = true);
         void updatePositionLabel(int32_t percentage);
         void setUiDataValues();
         double logFrequency; // in seconds
 
       private:
-        QDateTime parseTransmitterTimestamp(QString row);
+        QDateTime parseTransmitterTimestamp(const QStringList & rowParts);
         void calcLogFrequency();
+        // records of the log, the column names being record 0
+        int recordCount() const;
+        QStringList recordCells(int index) const;
 
         Ui::TelemetrySimulator * ui;
         TelemetrySimulator * sim;
-        QStringList csvRecords; // contents of the log file (one string per line);
+        const TelemetryLog * telemetryLog; // radio log, loaded by the replay
+        QStringList csvRecords; // contents of other log files (one string per line);
         QStringList columnNames;
         int32_t recordIndex;
         bool stepping;
@@ -485,6 +485,7 @@ void WasmSimulatorInterface::init()
   }
 
   m_lastOutputs.clear();
+  m_outputs.clear();
   m_resetOutputsData = true;
   m_lastHaptic = 0;
 
@@ -1084,11 +1085,7 @@ void WasmSimulatorInterface::checkOutputsChanged()
       uint8_t numCh = (uint8_t)argv[0];
       const int16_t * chans = (const int16_t *)nativePtr;
       for (uint8_t i = 0; i < numCh; i++) {
-        if (m_lastOutputs.chans[i] != chans[i] || m_resetOutputsData) {
-          emit channelOutValueChange(i, chans[i], limit);
-          emit outputValueChange(OUTPUT_SRC_CHAN_OUT, i, chans[i]);
-          m_lastOutputs.chans[i] = chans[i];
-        }
+        m_outputs.setChannel(i, chans[i], m_resetOutputsData);
       }
     }
   }
@@ -1100,11 +1097,7 @@ void WasmSimulatorInterface::checkOutputsChanged()
       uint8_t numCh = (uint8_t)argv[0];
       const int16_t * mix = (const int16_t *)nativePtr;
       for (uint8_t i = 0; i < numCh; i++) {
-        if (m_lastOutputs.ex_chans[i] != mix[i] || m_resetOutputsData) {
-          emit channelMixValueChange(i, mix[i], limit * 2);
-          emit outputValueChange(OUTPUT_SRC_CHAN_MIX, i, mix[i]);
-          m_lastOutputs.ex_chans[i] = mix[i];
-        }
+        m_outputs.setMix(i, mix[i], m_resetOutputsData);
       }
     }
   }
@@ -1116,12 +1109,7 @@ void WasmSimulatorInterface::checkOutputsChanged()
       uint8_t numLsw = (uint8_t)argv[0];
       const uint8_t * lsw = (const uint8_t *)nativePtr;
       for (uint8_t i = 0; i < numLsw; i++) {
-        bool val = lsw[i] != 0;
-        if (m_lastOutputs.vsw[i] != val || m_resetOutputsData) {
-          emit virtualSwValueChange(i, val ? 1 : 0);
-          emit outputValueChange(OUTPUT_SRC_VIRTUAL_SW, i, val ? 1 : 0);
-          m_lastOutputs.vsw[i] = val;
-        }
+        m_outputs.setVirtualSw(i, lsw[i] != 0, m_resetOutputsData);
       }
     }
   }
@@ -1132,7 +1120,6 @@ void WasmSimulatorInterface::checkOutputsChanged()
       tmpVal = wasmCall1(m_execEnv, m_fnGetTrimValue, i);
       if (m_lastOutputs.trims[i] != tmpVal || m_resetOutputsData) {
         emit trimValueChange(i, tmpVal);
-        emit outputValueChange(OUTPUT_SRC_TRIM_VALUE, i, tmpVal);
         m_lastOutputs.trims[i] = tmpVal;
       }
     }
@@ -1143,7 +1130,6 @@ void WasmSimulatorInterface::checkOutputsChanged()
     tmpVal = (int16_t)wasmCall0(m_execEnv, m_fnGetTrimRange);
     if (m_lastOutputs.trimRange != tmpVal || m_resetOutputsData) {
       emit trimRangeChange(Board::TRIM_AXIS_COUNT, -tmpVal, tmpVal);
-      emit outputValueChange(OUTPUT_SRC_TRIM_RANGE, Board::TRIM_AXIS_COUNT, tmpVal);
       m_lastOutputs.trimRange = tmpVal;
     }
   }
@@ -1153,7 +1139,6 @@ void WasmSimulatorInterface::checkOutputsChanged()
     int8_t phase = (int8_t)wasmCall0(m_execEnv, m_fnGetFlightMode);
     if (m_lastOutputs.phase != phase || m_resetOutputsData) {
       emit phaseChanged(phase, QString::number(phase));
-      emit outputValueChange(OUTPUT_SRC_PHASE, 0, (qint16)phase);
       m_lastOutputs.phase = phase;
     }
   }
@@ -1167,11 +1152,7 @@ void WasmSimulatorInterface::checkOutputsChanged()
     for (uint8_t gv = 0; gv < numGv; gv++) {
       for (uint8_t fm = 0; fm < numFm; fm++) {
         tmpVal = wasmCall2(m_execEnv, m_fnGetGVar, gv, fm);
-        if (m_lastOutputs.gvars[fm][gv] != tmpVal || m_resetOutputsData) {
-          m_lastOutputs.gvars[fm][gv] = tmpVal;
-          emit gVarValueChange(gv, tmpVal);
-          emit outputValueChange(OUTPUT_SRC_GVAR, gv, tmpVal);
-        }
+        m_outputs.setGVar(fm, gv, tmpVal, m_resetOutputsData);
       }
     }
   }
@@ -1191,6 +1172,9 @@ void WasmSimulatorInterface::checkOutputsChanged()
     }
   }
 
+  // Channels, mixes, logical switches and GVars go out in a single signal
+  publishOutputs(limit);
+
   m_resetOutputsData = false;
 }
 
@@ -23,6 +23,7 @@
 #include "helpers.h"
 
 #include <QFile>
+#include <QSaveFile>
 
 #define MZ_ALLOCATION_SIZE    (32*1024)
 
@@ -54,13 +55,18 @@ bool EtxFormat::write(RadioData & radioData)
 {
   // qDebug() << "Saving to archive" << filename;
 
+  // the archive being replaced provides the entries which did not change
+  openSourceArchive();
+
   memset(&zip_archive, 0, sizeof(zip_archive));
   if (!mz_zip_writer_init_heap(&zip_archive, 0, MZ_ALLOCATION_SIZE)) {
     fatalMsg(tr("Error initializing EdgeTX archive writer"));
+    closeSourceArchive();
     return false;
   }
 
   bool result = LabelsStorageFormat::write(radioData);
+  closeSourceArchive();
 
   if (result) {
     // finalize archive and get contents
@@ -69,13 +75,14 @@ bool EtxFormat::write(RadioData & radioData)
 
     if (mz_zip_writer_finalize_heap_archive(&zip_archive, (void **)&archiveContents, &archiveSize)) {
       // qDebug() << "Archive size" << archiveSize;
-      // write contents to file
-      QFile file(filename);
+      // write contents to a temporary file, renamed over the previous one
+      // only once complete
+      QSaveFile file(filename);
 
       if (file.open(QIODevice::WriteOnly)) {
         qint64 len = file.write(archiveContents, archiveSize);
 
-        if (len != (qint64)archiveSize) {
+        if (len != (qint64)archiveSize || !file.commit()) {
           fatalMsg(tr("Error writing file %1:\n%2.").arg(filename).arg(file.errorString()));
           result = false;
         }
@@ -139,9 +146,65 @@ bool EtxFormat::loadImageFile(const QString & filename, bool optional)
   return true;
 }
 
+void EtxFormat::openSourceArchive()
+{
+  memset(&source_archive, 0, sizeof(source_archive));
+  hasSource = false;
+
+  QFile file(filename);
+  if (!file.open(QFile::ReadOnly))
+    return;
+
+  sourceContents = file.readAll();
+  hasSource = mz_zip_reader_init_mem(&source_archive, sourceContents.data(), sourceContents.size(), 0);
+  if (!hasSource)
+    sourceContents.clear();
+}
+
+void EtxFormat::closeSourceArchive()
+{
+  if (hasSource)
+    mz_zip_reader_end(&source_archive);
+  hasSource = false;
+  sourceContents.clear();
+}
+
+bool EtxFormat::copySourceEntry(const QByteArray & data, const char * path)
+{
+  if (!hasSource)
+    return false;
+
+  int index = mz_zip_reader_locate_file(&source_archive, path, nullptr, 0);
+  mz_zip_archive_file_stat stat;
+  if (index < 0 || !mz_zip_reader_file_stat(&source_archive, index, &stat))
+    return false;
+
+  // cheap checks first, then the stored contents themselves
+  if (stat.m_uncomp_size != (mz_uint64)data.size() ||
+      stat.m_crc32 != mz_crc32(MZ_CRC32_INIT, (const mz_uint8 *)data.constData(), data.size()))
+    return false;
+
+  QByteArray stored(data.size(), Qt::Uninitialized);
+  if (data.size() > 0 && (!mz_zip_reader_extract_to_mem(&source_archive, index, stored.data(), stored.size(), 0) || stored != data))
+    return false;
+
+  // the compressed entry is copied as is, with its original headers
+  return mz_zip_writer_add_from_zip_reader(&zip_archive, &source_archive, index);
+}
+
+bool EtxFormat::addEntry(const QByteArray & data, const QString & path)
+{
+  const std::string name = path.toStdString();
+
+  if (copySourceEntry(data, name.c_str()))
+    return true;
+
+  return mz_zip_writer_add_mem(&zip_archive, name.c_str(), data.data(), data.size(), MZ_DEFAULT_LEVEL);
+}
+
 bool EtxFormat::writeFile(const QByteArray & filedata, const QString & filename)
 {
-  if (!mz_zip_writer_add_mem(&zip_archive, filename.toStdString().c_str(), filedata.data(), filedata.size(), MZ_DEFAULT_LEVEL)) {
+  if (!addEntry(filedata, filename)) {
     fatalMsg(tr("Error adding %1 to archive").arg(filename));
     return false;
   }
@@ -168,7 +231,7 @@ bool EtxFormat::writeImageFile(const QString & filename)
 
     QString destpath("IMAGES/" % filename);
 
-    if (!mz_zip_writer_add_mem(&zip_archive, destpath.toStdString().c_str(), ba.data(), ba.size(), MZ_DEFAULT_LEVEL)) {
+    if (!addEntry(ba, destpath)) {
       fatalMsg(tr("Error adding file: %1").arg(destpath));
       return false;
     }
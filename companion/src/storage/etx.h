@@ -47,5 +47,15 @@ class EtxFormat : public LabelsStorageFormat
     virtual bool getFileList(std::list<std::string>& filelist);
     virtual bool deleteFile(const QString & fileName) { return false; }
 
+    // Entries whose contents did not change since the archive was written
+    // are copied from it without being compressed again
+    void openSourceArchive();
+    void closeSourceArchive();
+    bool copySourceEntry(const QByteArray & data, const char * path);
+    bool addEntry(const QByteArray & data, const QString & path);
+
     mz_zip_archive zip_archive;
+    mz_zip_archive source_archive;
+    QByteArray sourceContents;
+    bool hasSource = false;
 };
@@ -24,7 +24,13 @@
 #include "firmwares/edgetx/edgetxinterface.h"
 #include "progressdialog.h"
 
+#include <QCryptographicHash>
+#include <QSemaphore>
+#include <QThreadPool>
+
+#include <memory>
 #include <regex>
+#include <vector>
 
 StorageType LabelsStorageFormat::probeFormat()
 {
@@ -118,12 +124,25 @@ bool LabelsStorageFormat::load(RadioData & radioData)
   // Save Sort Order
   radioData.sortOrder = sortOrder;
 
-  int modelIdx = 0;
-
   if (hasLabels)
     radioData.models.resize(modelFiles.size());
 
-  QList<QString> modelImages;
+  // Model files are read in order and parsed in parallel, then converted in
+  // order as soon as their parsing is done
+  struct ModelJob {
+    std::string filename;
+    QString path;
+    int modelIdx;
+    bool loaded = false;
+    QByteArray buffer;
+    ModelYamlDocument document;
+    QString error;
+    QSemaphore parsed;
+  };
+
+  std::vector<std::unique_ptr<ModelJob>> jobs;
+  QSet<int> usedSlots;
+  int modelIdx = 0;
 
   for (const auto& mc : modelFiles) {
     qDebug() << "Filename: " << mc.filename.c_str();
@@ -131,11 +150,12 @@ bool LabelsStorageFormat::load(RadioData & radioData)
     if (!hasLabels) {
       if (mc.modelIdx >= 0 && mc.modelIdx < (int)radioData.models.size()) {
         modelIdx = mc.modelIdx;
-        if (!radioData.models[modelIdx].isEmpty()) {
+        if (usedSlots.contains(modelIdx)) {
           statusMsg(tr("Warning: file %1 skipped as slot %2 already used")
                     .arg(mc.filename.c_str()).arg(mc.modelIdx + 1), QtWarningMsg);
           continue;
         }
+        usedSlots.insert(modelIdx);
       } else {
         statusMsg(tr("Warning: file %1 skipped as slot %2 not available")
                   .arg(mc.filename.c_str()).arg(mc.modelIdx + 1), QtWarningMsg);
@@ -143,21 +163,59 @@ bool LabelsStorageFormat::load(RadioData & radioData)
       }
     }
 
-    QByteArray modelBuffer;
-    QString filename = "MODELS/" + QString::fromStdString(mc.filename);
+    auto job = std::make_unique<ModelJob>();
+    job->filename = mc.filename;
+    job->path = "MODELS/" + QString::fromStdString(mc.filename);
+    job->modelIdx = modelIdx++;
+    jobs.push_back(std::move(job));
+  }
+
+  // destroyed before the jobs: waits for the ones still running
+  QThreadPool pool;
+  if (loadThreads > 0)
+    pool.setMaxThreadCount(loadThreads);
+
+  for (auto& job : jobs) {
+    if (!loadFile(job->buffer, job->path))
+      break;
+
+    job->loaded = true;
+    ModelJob * parseJob = job.get();
+    pool.start([parseJob]() {
+      try {
+        parseJob->document.parse(parseJob->buffer);
+      } catch(const std::exception& e) {
+        parseJob->error = QString(e.what());
+      }
+      parseJob->buffer.clear();
+      parseJob->parsed.release();
+    });
+  }
+
+  QList<QString> modelImages;
+
+  for (auto& job : jobs) {
+    const QString& filename = job->path;
 
-    if (!loadFile(modelBuffer, filename)) {
+    if (!job->loaded) {
       fatalMsg(tr("Cannot load %1").arg(filename));
       return false;
     }
 
+    job->parsed.acquire();
+
     // Please note:
     //  ModelData() use memset to clear everything to 0
     //
-    auto& model = radioData.models[modelIdx];
+    auto& model = radioData.models[job->modelIdx];
+
+    if (!job->error.isEmpty()) {
+      fatalMsg(tr("Cannot convert to yaml %1:\n%2").arg(filename).arg(job->error));
+      return false;
+    }
 
     try {
-      if (!loadModelFromYaml(model,modelBuffer)) {
+      if (!loadModelFromYaml(model, job->document)) {
         fatalMsg(tr("Cannot convert to yaml %1").arg(filename));
         return false;
       }
@@ -166,6 +224,8 @@ bool LabelsStorageFormat::load(RadioData & radioData)
       return false;
     }
 
+    job->document.clear();
+
     if (!loadChecklist(model))
       return false;
 
@@ -177,14 +237,13 @@ bool LabelsStorageFormat::load(RadioData & radioData)
       }
     }
 
-    model.modelIndex = modelIdx;
-    model.filename = mc.filename;
+    model.modelIndex = job->modelIdx;
+    model.filename = job->filename;
 
     if (hasLabels && model.filename == radioData.generalSettings.currModelFilename)
-      radioData.generalSettings.currModelIndex = modelIdx;
+      radioData.generalSettings.currModelIndex = job->modelIdx;
 
     model.used = true;
-    modelIdx++;
     progressSetValue(++steps);
     statusMsg(tr("Loaded: %1").arg(filename));
   }
@@ -305,12 +364,66 @@ bool LabelsStorageFormat::write(RadioData & radioData)
   progressSetValue(++steps);
   progressSetInfoAndMsg(tr("Writing models..."));
 
+  // Models are encoded in parallel, then written in order as soon as their
+  // encoding is done. The YAML of the previous save is reused as long as the
+  // model and the firmware did not change.
+  struct ModelJob {
+    ModelData * model;
+    QByteArray hash;
+    QByteArray data;
+    bool encoded = false;
+    QString error;
+    QSemaphore done;
+  };
+
+  std::vector<std::unique_ptr<ModelJob>> jobs;
+  const QByteArray firmwareId = getCurrentFirmware()->getId().toUtf8();
+
+  for (auto& model : radioData.models) {
+    if (model.isEmpty())
+      continue;
+
+    auto job = std::make_unique<ModelJob>();
+    job->model = &model;
+    jobs.push_back(std::move(job));
+  }
+
+  prepareModelsYamlWrite();
+
+  // destroyed before the jobs: waits for the ones still running
+  QThreadPool pool;
+  if (writeThreads > 0)
+    pool.setMaxThreadCount(writeThreads);
+
+  for (auto& job : jobs) {
+    ModelJob * encodeJob = job.get();
+    pool.start([encodeJob, firmwareId]() {
+      const ModelData & model = *encodeJob->model;
+      QCryptographicHash hash(QCryptographicHash::Md5);
+      hash.addData(firmwareId);
+      model.hashContent(hash);
+      encodeJob->hash = hash.result();
+
+      if (encodeJob->hash == model.yamlCacheHash) {
+        encodeJob->data = model.yamlCache;
+        encodeJob->encoded = true;
+      } else {
+        try {
+          encodeJob->encoded = writeModelToYaml(model, encodeJob->data);
+        } catch(const std::exception& e) {
+          encodeJob->error = QString(e.what());
+        }
+      }
+      encodeJob->done.release();
+    });
+  }
+
   EtxModelfiles modelFiles;
   QList<QString> modelImages;
 
-  for (const auto& model : radioData.models) {
-    if (model.isEmpty())
-      continue;
+  for (auto& job : jobs) {
+    job->done.acquire();
+    ModelData & model = *job->model;
 
     QString modelFilename;
 
@@ -322,12 +435,18 @@ bool LabelsStorageFormat::write(RadioData & radioData)
       modelFilename = QString("MODELS/model%1.yml").arg(model.modelIndex, 2, 10, QLatin1Char('0'));
     }
 
-    QByteArray modelData;
-    if (!writeModelToYaml(model, modelData)) {
-      fatalMsg(tr("Error converting model to yaml: %1").arg(model.name.toQString()));
+    if (!job->encoded) {
+      if (job->error.isEmpty())
+        fatalMsg(tr("Error converting model to yaml: %1").arg(model.name.toQString()));
+      else
+        fatalMsg(tr("Error converting model to yaml: %1:\n%2").arg(model.name.toQString()).arg(job->error));
       return false;
     }
 
+    const QByteArray & modelData = job->data;
+    model.yamlCache = modelData;
+    model.yamlCacheHash = job->hash;
+
     if (!writeFile(modelData, modelFilename)) {
       fatalMsg(tr("Error writing: %1").arg(QDir::toNativeSeparators(filename % "/" % modelFilename)));
       return false;
@@ -44,6 +44,11 @@ class LabelsStorageFormat : public StorageFormat
     virtual bool load(RadioData & radioData);
     virtual bool write(RadioData & radioData);
 
+    // Threads used to parse the model files, 0 for one per core
+    void setLoadThreads(int count) { loadThreads = count; }
+    // Threads used to encode the model files, 0 for one per core
+    void setWriteThreads(int count) { writeThreads = count; }
+
   protected:
     virtual bool loadFile(QByteArray & fileData, const QString & fileName, bool optional = false) = 0;
     virtual bool loadImageFile(const QString & fileName, bool optional = false) = 0;
@@ -57,4 +62,8 @@ class LabelsStorageFormat : public StorageFormat
     bool loadChecklist(ModelData &model);
     bool writeChecklist(const ModelData & model);
     bool loadRadioSettings(GeneralSettings & generalSettings);
+
+  private:
+    int loadThreads = 0;
+    int writeThreads = 0;
 };
@@ -127,6 +127,7 @@ bool YamlFormat::writeModel(const RadioData & radioData, const int modelIndex)
     return false;
 
   QByteArray modelData;
+  prepareModelsYamlWrite();
   writeModelToYaml(radioData.models[modelIndex], modelData);
 
   if (!writeFile(modelData))
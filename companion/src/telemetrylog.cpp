@@ -0,0 +1,389 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "telemetrylog.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <thread>
+
+// Below this number of lines per thread, parsing is not worth a thread
+#define LINES_PER_THREAD_MIN  4096
+
+struct TelemetryLog::Chunk
+{
+  int first;
+  int last;
+  QVector<qint64> timestamps;
+  QVector<qint64> offsets;
+  QVector<QVector<double>> columns;
+  QVector<QVector<int>> textRows;
+  int errors = 0;
+};
+
+static bool isBlank(char c)
+{
+  return c == ' ' || c == '\t' || c == '\r' || c == '\n';
+}
+
+static void trim(const char *& begin, const char *& end)
+{
+  while (begin < end && isBlank(*begin)) begin++;
+  while (end > begin && isBlank(end[-1])) end--;
+}
+
+static const char * lineEnd(const char * begin, const char * end)
+{
+  const char * eol = (const char *)memchr(begin, '\n', end - begin);
+  return eol ? eol : end;
+}
+
+// Unsigned integer made of the whole [begin, end) range
+static bool parseInt(const char * begin, const char * end, int & value)
+{
+  if (begin == end || end - begin > 9) return false;
+  value = 0;
+  for (; begin < end; begin++) {
+    if (*begin < '0' || *begin > '9') return false;
+    value = value * 10 + (*begin - '0');
+  }
+  return true;
+}
+
+// Locale independent equivalent of QString::toDouble(), false and 0 when
+// the cell is not a number. Exact for the values written by the radio (less
+// than 16 significant digits).
+static bool parseNumber(const char * p, const char * end, double & result)
+{
+  static const double powers[] = {
+    1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7, 1e8, 1e9, 1e10, 1e11,
+    1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+  };
+  const int maxPower = sizeof(powers) / sizeof(powers[0]) - 1;
+
+  trim(p, end);
+
+  bool negative = false;
+  if (p < end && (*p == '-' || *p == '+')) negative = (*p++ == '-');
+
+  quint64 mantissa = 0;
+  int exponent = 0;
+  int digits = 0;
+  for (; p < end && *p >= '0' && *p <= '9'; p++, digits++) {
+    if (mantissa < 100000000000000000ull)
+      mantissa = mantissa * 10 + (*p - '0');
+    else
+      exponent++;
+  }
+  if (p < end && *p == '.') {
+    for (p++; p < end && *p >= '0' && *p <= '9'; p++, digits++) {
+      if (mantissa < 100000000000000000ull) {
+        mantissa = mantissa * 10 + (*p - '0');
+        exponent--;
+      }
+    }
+  }
+  result = 0;
+  if (!digits) return false;
+
+  if (p < end && (*p == 'e' || *p == 'E')) {
+    p++;
+    bool negativeExponent = false;
+    if (p < end && (*p == '-' || *p == '+')) negativeExponent = (*p++ == '-');
+    const char * start = p;
+    while (p < end && *p >= '0' && *p <= '9') p++;
+    int value;
+    if (!parseInt(start, p, value)) return false;
+    exponent += negativeExponent ? -value : value;
+  }
+  if (p != end) return false;
+
+  double value = (double)mantissa;
+  if (exponent < 0)
+    value = (-exponent <= maxPower) ? value / powers[-exponent] : value * std::pow(10.0, exponent);
+  else if (exponent > 0)
+    value = (exponent <= maxPower) ? value * powers[exponent] : value * std::pow(10.0, exponent);
+  result = negative ? -value : value;
+  return true;
+}
+
+TelemetryLog::~TelemetryLog()
+{
+  clear();
+}
+
+void TelemetryLog::clear()
+{
+  if (file.isOpen()) file.close();  // also unmaps the file
+  buffer.clear();
+  data = nullptr;
+  size = 0;
+  header.clear();
+  timestamps.clear();
+  offsets.clear();
+  columns.clear();
+  textRows.clear();
+  errorCount = 0;
+  lineCount = 0;
+}
+
+bool TelemetryLog::load(const QString & path)
+{
+  clear();
+
+  file.setFileName(path);
+  if (!file.open(QIODevice::ReadOnly)) {
+    return false;
+  }
+
+  size = file.size();
+  uchar * mapped = size > 0 ? file.map(0, size) : nullptr;
+  data = (const char *)mapped;
+  if (!data) {
+    buffer = file.readAll();
+    data = buffer.constData();
+    size = buffer.size();
+  }
+
+  const char * end = data + size;
+  const char * headerBegin = data;
+  const char * headerEnd = lineEnd(data, end);
+  const char * next = headerEnd < end ? headerEnd + 1 : end;
+  trim(headerBegin, headerEnd);
+  if (!QByteArray::fromRawData(headerBegin, headerEnd - headerBegin).startsWith("Date,Time")) {
+    clear();
+    return false;
+  }
+  header = QString::fromUtf8(headerBegin, headerEnd - headerBegin).split(',');
+
+  // Start of each line, until parsed rows replace them
+  offsets.reserve(size / 64);
+  for (const char * p = next; p < end; p = next) {
+    const char * eol = lineEnd(p, end);
+    offsets.append(p - data);
+    next = eol < end ? eol + 1 : end;
+  }
+  lineCount = offsets.count();
+
+  int threads = std::max(1u, std::thread::hardware_concurrency());
+  threads = std::max(1, std::min(threads, lineCount / LINES_PER_THREAD_MIN));
+
+  QVector<Chunk> chunks(threads);
+  for (int i = 0; i < threads; i++) {
+    chunks[i].first = (qint64)lineCount * i / threads;
+    chunks[i].last = (qint64)lineCount * (i + 1) / threads;
+  }
+
+  std::vector<std::thread> workers;
+  for (int i = 1; i < threads; i++) {
+    workers.emplace_back(&TelemetryLog::parseLines, this, std::ref(chunks[i]));
+  }
+  parseLines(chunks[0]);
+  for (auto & worker : workers) {
+    worker.join();
+  }
+
+  int rows = 0;
+  for (const Chunk & chunk : chunks) {
+    rows += chunk.timestamps.count();
+    errorCount += chunk.errors;
+  }
+
+  offsets.clear();
+  offsets.reserve(rows);
+  timestamps.reserve(rows);
+  columns.resize(header.count());
+  textRows.resize(header.count());
+  for (int column = 2; column < columns.count(); column++) {
+    columns[column].reserve(rows);
+  }
+
+  for (Chunk & chunk : chunks) {
+    const int first = timestamps.count();
+    timestamps += chunk.timestamps;
+    offsets += chunk.offsets;
+    for (int column = 2; column < columns.count(); column++) {
+      columns[column] += chunk.columns.at(column);
+      for (int row : chunk.textRows.at(column))
+        textRows[column].append(first + row);
+    }
+    chunk = Chunk();
+  }
+
+  // The cells text is kept in memory, so that the file is not held while the
+  // log is shown
+  if (mapped) {
+    buffer = QByteArray(data, size);
+    file.unmap(mapped);
+    data = buffer.constData();
+  }
+  file.close();
+
+  return true;
+}
+
+void TelemetryLog::parseLines(Chunk & chunk) const
+{
+  const int count = header.count();
+  const char * end = data + size;
+
+  chunk.columns.resize(count);
+  chunk.textRows.resize(count);
+  for (int column = 2; column < count; column++) {
+    chunk.columns[column].reserve(chunk.last - chunk.first);
+  }
+
+  // Local time of the last hour decoded: conversions are only made when
+  // it changes, which also takes care of DST
+  int lastHour[4] = { -1, -1, -1, -1 };
+  qint64 hourStart = 0;
+
+  QVarLengthArray<const char *, 128> fields;
+  for (int i = chunk.first; i < chunk.last; i++) {
+    const char * begin = data + offsets.at(i);
+    const char * stop = lineEnd(begin, end);
+    trim(begin, stop);
+
+    fields.clear();
+    fields.append(begin);
+    for (const char * p = begin; p < stop; p++) {
+      if (*p == ',') fields.append(p + 1);
+    }
+    fields.append(stop + 1);
+
+    if (fields.count() - 1 != count) {
+      chunk.errors++;
+      continue;
+    }
+
+    // Date: YYYY-MM-DD, Time: HH:MM:SS[.mmm]
+    const char * date = fields[0];
+    const char * time = fields[1];
+    int year, month, day, hour, minute, second, msecs = 0;
+    bool valid = fields[1] - date == 11 && date[4] == '-' && date[7] == '-' &&
+                 parseInt(date, date + 4, year) && parseInt(date + 5, date + 7, month) &&
+                 parseInt(date + 8, date + 10, day);
+    const char * timeEnd = fields[2] - 1;
+    const char * dot = time + 8;
+    valid = valid && timeEnd - time >= 8 && time[2] == ':' && time[5] == ':' &&
+            parseInt(time, time + 2, hour) && parseInt(time + 3, time + 5, minute) &&
+            parseInt(time + 6, dot, second) &&
+            (dot == timeEnd || (*dot == '.' && parseInt(dot + 1, timeEnd, msecs)));
+
+    if (!valid) {
+      chunk.errors++;
+      continue;
+    }
+
+    if (hour != lastHour[3] || day != lastHour[2] || month != lastHour[1] || year != lastHour[0]) {
+      QDateTime dt(QDate(year, month, day), QTime(hour, 0));
+      lastHour[0] = year;
+      lastHour[1] = month;
+      lastHour[2] = day;
+      lastHour[3] = hour;
+      hourStart = dt.toMSecsSinceEpoch();
+    }
+
+    const int row = chunk.timestamps.count();
+    chunk.timestamps.append(hourStart + (minute * 60 + second) * 1000 + msecs);
+    chunk.offsets.append(offsets.at(i));
+    for (int column = 2; column < count; column++) {
+      double value;
+      if (!parseNumber(fields[column], fields[column + 1] - 1, value))
+        chunk.textRows[column].append(row);
+      chunk.columns[column].append(value);
+    }
+  }
+}
+
+bool TelemetryLog::isNumeric(int row, int column) const
+{
+  const QVector<int> & rows = textRows.at(column);
+  return !std::binary_search(rows.begin(), rows.end(), row);
+}
+
+QByteArray TelemetryLog::line(int row) const
+{
+  const char * begin = data + offsets.at(row);
+  const char * end = lineEnd(begin, data + size);
+  trim(begin, end);
+  return QByteArray(begin, end - begin);
+}
+
+QStringList TelemetryLog::cells(int row) const
+{
+  return QString::fromUtf8(line(row)).split(',');
+}
+
+QString TelemetryLog::cell(int row, int column) const
+{
+  return cells(row).value(column);
+}
+
+void TelemetryLog::decimate(const QVector<double> & x, const QVector<double> & y,
+                            double lower, double upper, int buckets,
+                            QVector<double> & outX, QVector<double> & outY)
+{
+  outX.clear();
+  outY.clear();
+
+  int first = std::lower_bound(x.begin(), x.end(), lower) - x.begin();
+  int last = std::upper_bound(x.begin(), x.end(), upper) - x.begin();
+  if (first > 0) first--;
+  if (last < x.count()) last++;
+
+  if (buckets < 1 || upper <= lower || last - first <= 2 * buckets + 2) {
+    outX = x.mid(first, last - first);
+    outY = y.mid(first, last - first);
+    return;
+  }
+
+  outX.reserve(2 * buckets + 2);
+  outY.reserve(2 * buckets + 2);
+
+  // first and last points are kept as they are
+  outX.append(x.at(first));
+  outY.append(y.at(first));
+
+  const double width = (upper - lower) / buckets;
+  int i = first + 1;
+  while (i < last - 1) {
+    double bucketEnd = lower + (std::floor((x.at(i) - lower) / width) + 1) * width;
+    int minIndex = i, maxIndex = i;
+    for (i++; i < last - 1 && x.at(i) < bucketEnd; i++) {
+      if (y.at(i) < y.at(minIndex)) minIndex = i;
+      if (y.at(i) > y.at(maxIndex)) maxIndex = i;
+    }
+    int a = std::min(minIndex, maxIndex);
+    int b = std::max(minIndex, maxIndex);
+    outX.append(x.at(a));
+    outY.append(y.at(a));
+    if (b != a) {
+      outX.append(x.at(b));
+      outY.append(y.at(b));
+    }
+  }
+
+  outX.append(x.at(last - 1));
+  outY.append(y.at(last - 1));
+}
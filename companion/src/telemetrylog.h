@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include <QtCore>
+
+// Telemetry log (CSV) recorded by the radio on the SD card.
+//
+// The file is memory mapped and parsed once, in parallel, into one numeric
+// column per field, then unmapped. The text of a cell is only extracted from
+// its line when it is needed (log table, exports).
+class TelemetryLog
+{
+  public:
+    TelemetryLog() = default;
+    ~TelemetryLog();
+
+    // Returns false if the file cannot be read or is not a telemetry log
+    bool load(const QString & path);
+    void clear();
+
+    bool isEmpty() const { return timestamps.isEmpty(); }
+    int rowCount() const { return timestamps.count(); }
+    // CSV columns, Date and Time included
+    int columnCount() const { return header.count(); }
+
+    // Lines which could not be decoded (header excluded)
+    int errors() const { return errorCount; }
+    int lines() const { return lineCount; }
+
+    const QStringList & columnNames() const { return header; }
+
+    qint64 timestamp(int row) const { return timestamps.at(row); }
+    // Numeric values of a field (column >= 2), 0 for non numeric cells
+    const QVector<double> & values(int column) const { return columns.at(column); }
+    // False for the cells which are not a number (empty, text)
+    bool isNumeric(int row, int column) const;
+
+    QByteArray line(int row) const;
+    QStringList cells(int row) const;
+    QString cell(int row, int column) const;
+
+    // Min/max decimation of a series sorted by x, limited to [lower, upper]:
+    // each of the 'buckets' slices keeps its lowest and highest points, so
+    // that peaks stay visible whatever the zoom level. The points just
+    // outside of the range are kept to draw the lines up to the edges.
+    static void decimate(const QVector<double> & x, const QVector<double> & y,
+                         double lower, double upper, int buckets,
+                         QVector<double> & outX, QVector<double> & outY);
+
+  private:
+    struct Chunk;
+
+    QFile file;
+    QByteArray buffer;        // text of the file once parsed
+    const char * data = nullptr;
+    qint64 size = 0;
+
+    QStringList header;
+    QVector<qint64> timestamps;
+    QVector<qint64> offsets;  // start of each row in data
+    QVector<QVector<double>> columns;
+    QVector<QVector<int>> textRows;  // sorted rows of the non numeric cells
+    int errorCount = 0;
+    int lineCount = 0;
+
+    void parseLines(Chunk & chunk) const;
+};
@@ -0,0 +1,82 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+// Model print benchmark: a busy model printed with an empty section cache
+// (cold) and printed again from the cached sections (warm).
+
+#include "gtests.h"
+
+#include <QElapsedTimer>
+
+#include "firmwares/eeprominterface.h"
+#include "print/multimodelprinter.h"
+#include "testhelpers.h"
+
+#define BENCH_RUNS  5
+
+namespace {
+
+class MultiModelPrinterBenchmark : public ::testing::Test
+{
+ protected:
+  ModelData model;
+  GeneralSettings settings;
+
+  void SetUp() override
+  {
+    ASSERT_NO_FATAL_FAILURE(TestHelpers::selectFirmware());
+    settings.init();
+    model.clear();
+    model.used = true;
+    model.name = "Printed";
+    TestHelpers::fillModel(model, 32);
+  }
+
+  QString print(MultiModelPrinter & printer)
+  {
+    printer.setModel(0, &model, &settings);
+    return printer.print(nullptr);
+  }
+};
+
+}  // namespace
+
+TEST_F(MultiModelPrinterBenchmark, Print)
+{
+  MultiModelPrinter printer(getCurrentFirmware());
+  QElapsedTimer timer;
+  qint64 cold = 0, warm = 0;
+
+  for (int i = 0; i < BENCH_RUNS; i++) {
+    MultiModelPrinter::clearCache();
+    timer.start();
+    print(printer);
+    cold += timer.nsecsElapsed();
+
+    timer.start();
+    print(printer);
+    warm += timer.nsecsElapsed();
+  }
+
+  TestHelpers::reportBenchmark("print_cold_us", cold / BENCH_RUNS);
+  TestHelpers::reportBenchmark("print_warm_us", warm / BENCH_RUNS);
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+
+// Storage performance benchmarks, built with the other benchmarks as
+// gtests-companion-bench and run by the bench-companion target. Synthetic
+// collections of N models with M mixes, logical switches and sensors each are
+// saved and loaded through the SD card and .etx formats, and each model is
+// encoded and decoded on its own.
+//
+// Every timing is printed and recorded as a test property (microseconds), so
+// that --gtest_output=json or xml gives machine-readable results. Timings are
+// only meaningful for a release build.
+
+#include "gtests.h"
+
+#include <QDir>
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+
+#include <functional>
+#include <memory>
+
+#include "firmwares/edgetx/edgetxinterface.h"
+#include "storage/etx.h"
+#include "storage/sdcard.h"
+#include "testhelpers.h"
+
+#define BENCH_RUNS  3
+
+namespace {
+
+struct Collection {
+  int models;
+  int items;  // mixes, logical switches and sensors per model
+};
+
+std::string collectionName(const Collection & collection)
+{
+  return std::to_string(collection.models) + "x" + std::to_string(collection.items);
+}
+
+std::string collectionParamName(const ::testing::TestParamInfo<Collection> & info)
+{
+  return collectionName(info.param);
+}
+
+typedef std::function<std::unique_ptr<LabelsStorageFormat>()> FormatFactory;
+
+class StorageBenchmark : public ::testing::TestWithParam<Collection>
+{
+ protected:
+  QTemporaryDir dir;
+  RadioData radioData;
+
+  void SetUp() override
+  {
+    ASSERT_NO_FATAL_FAILURE(TestHelpers::selectFirmware());
+    ASSERT_TRUE(dir.isValid());
+
+    const Collection & collection = GetParam();
+    TestHelpers::initRadioData(radioData, collection.models);
+    for (auto & model : radioData.models) {
+      TestHelpers::fillModel(model, collection.items);
+    }
+  }
+
+  // Cold saves start from a copy of the collection, without the YAML cached
+  // by the previous save, warm saves reuse it
+  void benchmarkFormat(const std::string & name, const FormatFactory & create)
+  {
+    QElapsedTimer timer;
+    qint64 saveCold = 0, saveWarm = 0, loadSequential = 0, loadParallel = 0;
+
+    for (int run = 0; run < BENCH_RUNS; run++) {
+      RadioData data = radioData;
+      timer.start();
+      ASSERT_TRUE(create()->write(data));
+      saveCold += timer.nsecsElapsed();
+
+      timer.start();
+      ASSERT_TRUE(create()->write(data));
+      saveWarm += timer.nsecsElapsed();
+
+      for (int threads : { 1, 0 }) {
+        RadioData loaded;
+        auto format = create();
+        format->setLoadThreads(threads);
+        timer.start();
+        ASSERT_TRUE(format->load(loaded));
+        (threads ? loadSequential : loadParallel) += timer.nsecsElapsed();
+        ASSERT_EQ(radioData.models.size(), loaded.models.size());
+      }
+    }
+
+    TestHelpers::reportBenchmark(name + "_save_cold_us", saveCold / BENCH_RUNS);
+    TestHelpers::reportBenchmark(name + "_save_warm_us", saveWarm / BENCH_RUNS);
+    TestHelpers::reportBenchmark(name + "_load_sequential_us", loadSequential / BENCH_RUNS);
+    TestHelpers::reportBenchmark(name + "_load_parallel_us", loadParallel / BENCH_RUNS);
+  }
+};
+
+}  // namespace
+
+TEST_P(StorageBenchmark, ModelYaml)
+{
+  QElapsedTimer timer;
+  qint64 encode = 0, decode = 0;
+
+  for (int run = 0; run < BENCH_RUNS; run++) {
+    for (const auto & model : radioData.models) {
+      QByteArray data;
+      timer.start();
+      ASSERT_TRUE(writeModelToYaml(model, data));
+      encode += timer.nsecsElapsed();
+
+      ModelData loaded;
+      timer.start();
+      ASSERT_TRUE(loadModelFromYaml(loaded, data));
+      decode += timer.nsecsElapsed();
+    }
+  }
+
+  const qint64 count = BENCH_RUNS * radioData.models.size();
+  TestHelpers::reportBenchmark("yaml_encode_us", encode / count);
+  TestHelpers::reportBenchmark("yaml_decode_us", decode / count);
+}
+
+TEST_P(StorageBenchmark, Sdcard)
+{
+  ASSERT_TRUE(QDir(dir.path()).mkpath("sdcard"));
+  const QString path = dir.filePath("sdcard");
+  benchmarkFormat("sdcard", [path]() { return std::make_unique<SdcardFormat>(path); });
+}
+
+TEST_P(StorageBenchmark, Etx)
+{
+  const QString path = dir.filePath("models.etx");
+  benchmarkFormat("etx", [path]() { return std::make_unique<EtxFormat>(path); });
+}
+
+INSTANTIATE_TEST_SUITE_P(Collections, StorageBenchmark,
+                         ::testing::Values(Collection{20, 8}, Collection{100, 32},
+                                           Collection{100, 64}),
+                         collectionParamName);
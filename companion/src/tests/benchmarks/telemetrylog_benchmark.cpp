@@ -0,0 +1,99 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+// Telemetry log loading benchmark: an hour long log as recorded by the radio
+// (10 Hz, 64 sensors) is loaded and decimated for the plot, and parsed with
+// the per line QString::split() the loader replaced, so that both timings are
+// reported side by side.
+
+#include "gtests.h"
+
+#include <QElapsedTimer>
+#include <QTemporaryDir>
+
+#include "telemetrylog.h"
+#include "testhelpers.h"
+
+#define BENCH_SENSORS   64
+#define BENCH_ROWS      (10 * 3600)  // one hour at 10 Hz
+
+namespace {
+
+class TelemetryLogBenchmark : public ::testing::Test
+{
+ protected:
+  QTemporaryDir dir;
+  QString path;
+
+  void SetUp() override
+  {
+    ASSERT_TRUE(dir.isValid());
+    path = dir.filePath("model-2024-03-05-101500.csv");
+  }
+};
+
+}  // namespace
+
+TEST_F(TelemetryLogBenchmark, LoadAndDecimate)
+{
+  ASSERT_NO_FATAL_FAILURE(TestHelpers::writeTelemetryLog(path, BENCH_ROWS, BENCH_SENSORS));
+
+  QElapsedTimer timer;
+  timer.start();
+  TelemetryLog log;
+  ASSERT_TRUE(log.load(path));
+  qint64 loadTime = timer.nsecsElapsed();
+  ASSERT_EQ(BENCH_ROWS, log.rowCount());
+
+  QVector<double> keys;
+  for (int row = 0; row < log.rowCount(); row++) {
+    keys.append(log.timestamp(row) / 1000.0);
+  }
+
+  timer.start();
+  QVector<double> x, y;
+  for (int sensor = 0; sensor < BENCH_SENSORS; sensor++) {
+    TelemetryLog::decimate(keys, log.values(sensor + 2), keys.first(), keys.last(), 1000, x, y);
+    ASSERT_LE(x.count(), 2 * 1000 + 2);
+  }
+  qint64 decimateTime = timer.nsecsElapsed();
+
+  // previous parsing: every cell kept as a QString
+  timer.start();
+  QFile file(path);
+  ASSERT_TRUE(file.open(QIODevice::ReadOnly | QIODevice::Text));
+  QList<QStringList> csvlog;
+  while (!file.atEnd()) {
+    csvlog.append(QString(file.readLine().trimmed()).split(','));
+  }
+  double sum = 0;
+  for (int row = 1; row < csvlog.count(); row++) {
+    sum += csvlog.at(row).at(2).toDouble();
+  }
+  qint64 splitTime = timer.nsecsElapsed();
+  EXPECT_EQ(BENCH_ROWS + 1, csvlog.count());
+  EXPECT_NE(0, sum);
+
+  TestHelpers::reportBenchmark("load_us", loadTime);
+  TestHelpers::reportBenchmark("decimate_us", decimateTime);
+  TestHelpers::reportBenchmark("split_us", splitTime);
+}
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+// Incremental .etx writing: the entries which did not change since the
+// previous save are copied from the archive being replaced, byte for byte.
+
+#include "gtests.h"
+
+#include <QDir>
+#include <QFile>
+#include <QMap>
+#include <QTemporaryDir>
+
+#include "firmwares/edgetx/edgetxinterface.h"
+#include "storage/etx.h"
+#include "testhelpers.h"
+
+#define TEST_MODELS  20
+
+namespace {
+
+struct RawEntry {
+  mz_uint32 crc32;
+  mz_uint64 compSize;
+  MZ_TIME_T time;
+  QByteArray compressed;
+};
+
+class EtxWrite : public ::testing::Test
+{
+ protected:
+  QTemporaryDir dir;
+  RadioData radioData;
+  QString path;
+
+  void SetUp() override
+  {
+    ASSERT_NO_FATAL_FAILURE(TestHelpers::selectFirmware());
+    ASSERT_TRUE(dir.isValid());
+    path = dir.filePath("models.etx");
+    TestHelpers::initRadioData(radioData, TEST_MODELS);
+  }
+
+  bool write()
+  {
+    EtxFormat format(path);
+    return format.write(radioData);
+  }
+
+  QByteArray contents()
+  {
+    QFile file(path);
+    if (!file.open(QIODevice::ReadOnly))
+      return QByteArray();
+    return file.readAll();
+  }
+
+  // compressed data and headers of each entry, as stored in the archive
+  QMap<QString, RawEntry> rawEntries()
+  {
+    QMap<QString, RawEntry> entries;
+    QByteArray data = contents();
+
+    mz_zip_archive archive;
+    memset(&archive, 0, sizeof(archive));
+    if (!mz_zip_reader_init_mem(&archive, data.data(), data.size(), 0))
+      return entries;
+
+    for (mz_uint i = 0; i < mz_zip_reader_get_num_files(&archive); i++) {
+      mz_zip_archive_file_stat stat;
+      if (!mz_zip_reader_file_stat(&archive, i, &stat))
+        continue;
+
+      RawEntry entry = {stat.m_crc32, stat.m_comp_size, stat.m_time, QByteArray()};
+      size_t size;
+      void * raw = mz_zip_reader_extract_to_heap(&archive, i, &size, MZ_ZIP_FLAG_COMPRESSED_DATA);
+      if (raw) {
+        entry.compressed = QByteArray((const char *)raw, size);
+        mz_free(raw);
+      }
+      entries.insert(stat.m_filename, entry);
+    }
+
+    mz_zip_reader_end(&archive);
+    return entries;
+  }
+};
+
+}  // namespace
+
+TEST_F(EtxWrite, UnchangedArchiveIsStable)
+{
+  ASSERT_TRUE(write());
+  QByteArray first = contents();
+  ASSERT_FALSE(first.isEmpty());
+
+  ASSERT_TRUE(write());
+  EXPECT_EQ(first, contents());
+}
+
+TEST_F(EtxWrite, OnlyChangedEntriesAreRewritten)
+{
+  ASSERT_TRUE(write());
+  QMap<QString, RawEntry> before = rawEntries();
+  ASSERT_EQ(TEST_MODELS + 2, before.size());  // radio settings and labels
+
+  radioData.models[7].timers[0].val = 1234;
+  ASSERT_TRUE(write());
+  QMap<QString, RawEntry> after = rawEntries();
+  ASSERT_EQ(before.size(), after.size());
+
+  const QString changed("MODELS/" + TestHelpers::modelFilename(7));
+  for (auto it = before.cbegin(); it != before.cend(); ++it) {
+    ASSERT_TRUE(after.contains(it.key())) << it.key().toStdString();
+    const RawEntry & a = it.value();
+    const RawEntry & b = after[it.key()];
+
+    if (it.key() == changed) {
+      EXPECT_NE(a.crc32, b.crc32);
+      continue;
+    }
+
+    EXPECT_EQ(a.crc32, b.crc32) << it.key().toStdString();
+    EXPECT_EQ(a.compSize, b.compSize) << it.key().toStdString();
+    EXPECT_EQ(a.time, b.time) << it.key().toStdString();
+    EXPECT_EQ(a.compressed, b.compressed) << it.key().toStdString();
+  }
+
+  // and the archive still loads with the new contents
+  RadioData loaded;
+  EtxFormat format(path);
+  ASSERT_TRUE(format.load(loaded));
+  ASSERT_EQ((size_t)TEST_MODELS, loaded.models.size());
+  EXPECT_EQ(1234u, loaded.models[7].timers[0].val);
+  EXPECT_EQ(70u, loaded.models[8].timers[0].val);
+}
+
+TEST_F(EtxWrite, NoTemporaryFileLeft)
+{
+  ASSERT_TRUE(write());
+  radioData.models[0].name = "Renamed";
+  ASSERT_TRUE(write());
+
+  EXPECT_EQ(QStringList({"models.etx"}), QDir(dir.path()).entryList(QDir::Files));
+}
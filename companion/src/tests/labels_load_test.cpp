@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+// Load equivalence of the parallel model files parsing: an SD card folder
+// loaded with a single parsing thread and with one thread per core must give
+// the same radio data and the same errors.
+
+#include "gtests.h"
+
+#include <QDir>
+#include <QFile>
+#include <QTemporaryDir>
+
+#include "firmwares/edgetx/edgetxinterface.h"
+#include "storage/sdcard.h"
+#include "testhelpers.h"
+
+#define TEST_MODELS  40
+
+namespace {
+
+class LabelsLoad : public ::testing::Test
+{
+ protected:
+  QTemporaryDir dir;
+
+  void SetUp() override
+  {
+    ASSERT_NO_FATAL_FAILURE(TestHelpers::selectFirmware());
+    ASSERT_TRUE(dir.isValid());
+    ASSERT_TRUE(QDir(dir.path()).mkpath("RADIO"));
+    ASSERT_TRUE(QDir(dir.path()).mkpath("MODELS"));
+
+    GeneralSettings settings;
+    settings.init();
+    QByteArray data;
+    ASSERT_TRUE(writeRadioSettingsToYaml(settings, data));
+    writeFile("RADIO/radio.yml", data);
+
+    for (int i = 0; i < TEST_MODELS; i++) {
+      ModelData model;
+      TestHelpers::initModel(model, i);
+      ASSERT_TRUE(writeModelToYaml(model, data));
+      writeFile("MODELS/" + TestHelpers::modelFilename(i), data);
+    }
+  }
+
+  void writeFile(const QString & path, const QByteArray & data)
+  {
+    QFile file(dir.filePath(path));
+    ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+    ASSERT_EQ(data.size(), file.write(data));
+  }
+
+  bool load(RadioData & radioData, int threads, QString & error)
+  {
+    SdcardFormat format(dir.path());
+    format.setLoadThreads(threads);
+    bool result = format.load(radioData);
+    error = format.error();
+    return result;
+  }
+};
+
+}  // namespace
+
+TEST_F(LabelsLoad, ParallelMatchesSequential)
+{
+  RadioData sequential, parallel;
+  QString sequentialError, parallelError;
+  ASSERT_TRUE(load(sequential, 1, sequentialError));
+  ASSERT_TRUE(load(parallel, 0, parallelError));
+
+  ASSERT_EQ((size_t)TEST_MODELS, sequential.models.size());
+  ASSERT_EQ(sequential.models.size(), parallel.models.size());
+
+  for (unsigned i = 0; i < sequential.models.size(); i++) {
+    const ModelData & a = sequential.models[i];
+    const ModelData & b = parallel.models[i];
+    EXPECT_EQ(a.filename.str(), b.filename.str());
+    EXPECT_EQ(a.modelIndex, b.modelIndex);
+    EXPECT_EQ(TestHelpers::modelName(i).toStdString(), b.name.str());
+    EXPECT_EQ((unsigned)i * 10, b.timers[0].val);
+
+    QByteArray yamlA, yamlB;
+    writeModelToYaml(a, yamlA);
+    writeModelToYaml(b, yamlB);
+    EXPECT_EQ(yamlA, yamlB) << "model " << i;
+  }
+
+  ASSERT_EQ(sequential.labels.size(), parallel.labels.size());
+  for (int i = 0; i < sequential.labels.size(); i++) {
+    EXPECT_EQ(sequential.labels.at(i).name, parallel.labels.at(i).name);
+  }
+  EXPECT_EQ(sequential.generalSettings.currModelIndex,
+            parallel.generalSettings.currModelIndex);
+}
+
+TEST_F(LabelsLoad, SameErrorOnInvalidModel)
+{
+  writeFile("MODELS/model07.yml", "header:\n  name: [unclosed\n");
+  writeFile("MODELS/model21.yml", "timers: {\n");
+
+  RadioData sequential, parallel;
+  QString sequentialError, parallelError;
+  EXPECT_FALSE(load(sequential, 1, sequentialError));
+  EXPECT_FALSE(load(parallel, 0, parallelError));
+
+  EXPECT_TRUE(sequentialError.contains("MODELS/model07.yml"));
+  EXPECT_EQ(sequentialError, parallelError);
+}
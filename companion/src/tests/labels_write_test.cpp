@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+
+// Parallel model files encoding on save: the files written with a single
+// encoding thread, with one thread per core and from the YAML cached by a
+// previous save must be the same, and must load back to the same files.
+
+#include "gtests.h"
+
+#include <QDir>
+#include <QFile>
+#include <QMap>
+#include <QTemporaryDir>
+
+#include "firmwares/edgetx/edgetxinterface.h"
+#include "storage/sdcard.h"
+#include "testhelpers.h"
+
+#define TEST_MODELS  40
+
+namespace {
+
+class LabelsWrite : public ::testing::Test
+{
+ protected:
+  QTemporaryDir dir;
+  RadioData radioData;
+
+  void SetUp() override
+  {
+    ASSERT_NO_FATAL_FAILURE(TestHelpers::selectFirmware());
+    ASSERT_TRUE(dir.isValid());
+    TestHelpers::initRadioData(radioData, TEST_MODELS);
+  }
+
+  QString path(const QString & name)
+  {
+    return dir.filePath(name);
+  }
+
+  bool write(RadioData & data, const QString & name, int threads)
+  {
+    if (!QDir(dir.path()).mkpath(name))
+      return false;
+
+    SdcardFormat format(path(name));
+    format.setWriteThreads(threads);
+    return format.write(data);
+  }
+
+  // contents of all the files written, by relative path
+  QMap<QString, QByteArray> files(const QString & name)
+  {
+    QMap<QString, QByteArray> result;
+    for (const QString & folder : { "RADIO", "MODELS" }) {
+      QDir folderDir(path(name) + "/" + folder);
+      for (const QString & file : folderDir.entryList(QDir::Files)) {
+        QFile f(folderDir.filePath(file));
+        if (f.open(QIODevice::ReadOnly))
+          result.insert(folder + "/" + file, f.readAll());
+      }
+    }
+    return result;
+  }
+};
+
+}  // namespace
+
+TEST_F(LabelsWrite, ParallelMatchesSequential)
+{
+  RadioData sequential = radioData;
+  RadioData parallel = radioData;
+  ASSERT_TRUE(write(sequential, "sequential", 1));
+  ASSERT_TRUE(write(parallel, "parallel", 0));
+
+  QMap<QString, QByteArray> a = files("sequential");
+  QMap<QString, QByteArray> b = files("parallel");
+  ASSERT_EQ(TEST_MODELS + 2, a.size());  // radio settings and labels
+  EXPECT_EQ(a, b);
+
+  for (int i = 0; i < TEST_MODELS; i++) {
+    QByteArray yaml;
+    ASSERT_TRUE(writeModelToYaml(radioData.models[i], yaml));
+    EXPECT_EQ(yaml, b.value("MODELS/" + TestHelpers::modelFilename(i))) << "model " << i;
+  }
+}
+
+TEST_F(LabelsWrite, UnchangedModelsAreNotEncodedAgain)
+{
+  ASSERT_TRUE(write(radioData, "sdcard", 0));
+  QMap<QString, QByteArray> before = files("sdcard");
+
+  std::vector<QByteArray> cached;
+  for (const auto & model : radioData.models) {
+    ASSERT_FALSE(model.yamlCache.isEmpty());
+    cached.push_back(model.yamlCache);
+  }
+
+  radioData.models[7].timers[0].val = 1234;
+  ASSERT_TRUE(write(radioData, "sdcard", 0));
+  QMap<QString, QByteArray> after = files("sdcard");
+  ASSERT_EQ(before.size(), after.size());
+
+  for (int i = 0; i < TEST_MODELS; i++) {
+    const ModelData & model = radioData.models[i];
+    const QString file = "MODELS/" + TestHelpers::modelFilename(i);
+    QByteArray yaml;
+    ASSERT_TRUE(writeModelToYaml(model, yaml));
+    EXPECT_EQ(yaml, after.value(file)) << "model " << i;
+
+    if (i == 7) {
+      EXPECT_FALSE(model.yamlCache.isSharedWith(cached[i]));
+      EXPECT_NE(before.value(file), after.value(file));
+    } else {
+      // the very same buffer: the YAML of the first save was reused
+      EXPECT_TRUE(model.yamlCache.isSharedWith(cached[i])) << "model " << i;
+      EXPECT_EQ(before.value(file), after.value(file)) << "model " << i;
+    }
+  }
+}
+
+TEST_F(LabelsWrite, RoundTripGivesTheSameFiles)
+{
+  ASSERT_TRUE(write(radioData, "first", 0));
+
+  RadioData loaded;
+  SdcardFormat format(path("first"));
+  ASSERT_TRUE(format.load(loaded));
+  ASSERT_EQ((size_t)TEST_MODELS, loaded.models.size());
+
+  // the labels and radio settings are rebuilt by the load, only the models
+  // are expected to be written back as they were
+  ASSERT_TRUE(write(loaded, "second", 0));
+  QMap<QString, QByteArray> first = files("first");
+  QMap<QString, QByteArray> second = files("second");
+  for (int i = 0; i < TEST_MODELS; i++) {
+    const QString file = "MODELS/" + TestHelpers::modelFilename(i);
+    ASSERT_TRUE(second.contains(file)) << file.toStdString();
+    EXPECT_EQ(first.value(file), second.value(file)) << file.toStdString();
+  }
+}
@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+// ModelData::hashContent() tells whether the YAML kept when the model was
+// loaded can be written again as is, so every value saved in the YAML must
+// change it. Each scalar of the YAML of a busy model is changed in turn:
+// whenever the model decoded from it is saved differently, its hash must
+// differ too. A field added to the model but not to the hash fails here.
+// A field copied by ModelData::copy() fails the byte by byte check below
+// even when it is not saved, or not set in this model.
+
+#include "gtests.h"
+
+#include <QCryptographicHash>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+#include <yaml-cpp/yaml.h>
+
+#include "firmwares/edgetx/edgetxinterface.h"
+#include "testhelpers.h"
+
+namespace {
+
+QByteArray contentHash(const ModelData & model)
+{
+  QCryptographicHash hash(QCryptographicHash::Md5);
+  model.hashContent(hash);
+  return hash.result();
+}
+
+struct Scalar {
+  std::string path;
+  YAML::Node node;
+};
+
+// Scalars of a YAML tree. Only the first entry of the lists and of the maps
+// by index is taken: the others are hashed with it, as the same array.
+void collectScalars(YAML::Node node, const std::string & path, std::vector<Scalar> & scalars)
+{
+  if (node.IsScalar()) {
+    scalars.push_back({path, node});
+  }
+  else if (node.IsSequence()) {
+    if (node.size() > 0)
+      collectScalars(node[0], path + "[0]", scalars);
+  }
+  else if (node.IsMap()) {
+    bool first = true;
+    for (auto it = node.begin(); it != node.end(); ++it) {
+      int index;
+      if (YAML::convert<int>::decode(it->first, index) && !first)
+        continue;
+      first = false;
+      collectScalars(it->second, path + "/" + it->first.Scalar(), scalars);
+    }
+  }
+}
+
+// Byte ranges of the plain data members, from the timers to the custom
+// screens and from the top bar widths to the checklist.
+std::vector<std::pair<size_t, size_t>> plainDataRanges(const ModelData & model)
+{
+  auto offset = [&](const void * member) {
+    return size_t(static_cast<const char *>(member) - reinterpret_cast<const char *>(&model));
+  };
+  return {{offset(&model.timers), offset(&model.customScreens)},
+          {offset(&model.topbarWidgetWidth), offset(&model.checklistData)}};
+}
+
+std::string changedScalar(const std::string & value)
+{
+  try {
+    size_t end;
+    long number = std::stol(value, &end);
+    if (end == value.size())
+      return std::to_string(number + 1);
+  }
+  catch (const std::exception &) {
+  }
+  return value + "1";
+}
+
+}  // namespace
+
+TEST(ModelDataHash, EverySavedValueChangesTheHash)
+{
+  ASSERT_NO_FATAL_FAILURE(TestHelpers::selectFirmware());
+
+  ModelData source;
+  TestHelpers::initModel(source, 1);
+  TestHelpers::fillModel(source, 8);
+  source.timers[0].mode = TimerData::TIMERMODE_ON;
+  source.limitData[0].min = -50;
+  source.flightModeData[1].fadeIn = 3;
+  source.gvarData[0].max = 100;
+  source.swashRingData.value = 10;
+
+  QByteArray yaml;
+  ASSERT_TRUE(writeModelToYaml(source, yaml));
+
+  // the reference is the decoded model, as the changed ones
+  ModelData model;
+  model.clear();
+  ASSERT_TRUE(loadModelFromYaml(model, yaml));
+  QByteArray reference;
+  ASSERT_TRUE(writeModelToYaml(model, reference));
+  const QByteArray referenceHash = contentHash(model);
+
+  YAML::Node root = YAML::Load(yaml.toStdString());
+  std::vector<Scalar> scalars;
+  collectScalars(root, "", scalars);
+  ASSERT_GT(scalars.size(), 50u);
+
+  int changes = 0;
+  for (Scalar & scalar : scalars) {
+    const std::string value = scalar.node.Scalar();
+    scalar.node = changedScalar(value);
+
+    std::stringstream changedYaml;
+    changedYaml << root;
+    ModelData changed;
+    changed.clear();
+    QByteArray saved;
+    bool loaded = false;
+    try {
+      loaded = loadModelFromYaml(changed, QByteArray::fromStdString(changedYaml.str())) &&
+               writeModelToYaml(changed, saved);
+    }
+    catch (const std::exception &) {
+      // not a valid value for this key
+    }
+    if (loaded && saved != reference) {
+      changes++;
+      EXPECT_NE(referenceHash, contentHash(changed))
+          << scalar.path << " is saved but not hashed (" << value << " -> "
+          << scalar.node.Scalar() << ")";
+    }
+
+    scalar.node = value;
+  }
+
+  EXPECT_GT(changes, 0);
+}
+
+TEST(ModelDataHash, EveryCopiedByteChangesTheHash)
+{
+  ASSERT_NO_FATAL_FAILURE(TestHelpers::selectFirmware());
+
+  ModelData model;
+  TestHelpers::initModel(model, 1);
+  TestHelpers::fillModel(model, 8);
+  char * bytes = reinterpret_cast<char *>(&model);
+  const auto ranges = plainDataRanges(model);
+
+  // Every byte is changed at once and copied over a model holding the
+  // original bytes: copy() assigns the members one by one, so the padding
+  // between them keeps the original bytes.
+  ModelData changed(model);
+  ModelData copied(model);
+  char * changedBytes = reinterpret_cast<char *>(&changed);
+  char * copiedBytes = reinterpret_cast<char *>(&copied);
+  for (const auto & range : ranges) {
+    for (size_t i = range.first; i < range.second; i++) {
+      changedBytes[i] = bytes[i] ^ 1;
+      copiedBytes[i] = bytes[i];
+    }
+  }
+  copied = changed;
+
+  const QByteArray referenceHash = contentHash(model);
+  int checked = 0;
+  int missed = 0;
+  size_t firstMissed = 0;
+  for (const auto & range : ranges) {
+    for (size_t i = range.first; i < range.second; i++) {
+      if (copiedBytes[i] == bytes[i])
+        continue;  // padding
+      checked++;
+      bytes[i] ^= 1;
+      if (contentHash(model) == referenceHash && missed++ == 0)
+        firstMissed = i;
+      bytes[i] ^= 1;
+    }
+  }
+
+  EXPECT_GT(checked, 0);
+  EXPECT_EQ(missed, 0) << missed << " bytes copied but not hashed, the first at offset "
+                       << firstMissed << " of ModelData";
+}
@@ -0,0 +1,242 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+// Structural model diff: crafted model pairs must give the expected typed
+// change list.
+
+#include "gtests.h"
+
+#include <cstring>
+
+#include "firmwares/edgetx/yaml_modeldiff.h"
+#include "firmwares/eeprominterface.h"
+
+namespace {
+
+class ModelDiff : public ::testing::Test
+{
+ protected:
+  ModelData from;
+  ModelData to;
+
+  void SetUp() override
+  {
+    Firmware::setCurrentVariant(Firmware::getFirmwareForFlavour("tx16s"));
+    ASSERT_NE(getCurrentFirmware(), nullptr);
+
+    from.clear();
+    from.used = true;
+    from.name = "Glider";
+    addInput(from, 0, 100);
+    addInput(from, 1, 100);
+    addMix(from, 0, 0, 100);
+    addMix(from, 0, 1, 50);
+    addMix(from, 2, 2, 100);
+    addLogicalSwitch(from, 0, 10);
+    addSensor(from, 0, "RSSI");
+    to = from;
+  }
+
+  static void addInput(ModelData & model, unsigned chn, int weight)
+  {
+    for (auto & expo : model.expoData) {
+      if (expo.isEmpty()) {
+        expo.clear();
+        expo.chn = chn;
+        expo.mode = INPUT_MODE_BOTH;
+        expo.srcRaw = RawSource(SOURCE_TYPE_INPUT, chn);
+        expo.weight = weight;
+        return;
+      }
+    }
+  }
+
+  // inserted before the first line of a following channel, like the editor
+  static void addMix(ModelData & model, unsigned channel, int input, int weight)
+  {
+    int idx = 0;
+    while (idx < CPN_MAX_MIXERS && !model.mixData[idx].isEmpty() &&
+           model.mixData[idx].destCh <= channel + 1)
+      idx++;
+    for (int i = CPN_MAX_MIXERS - 1; i > idx; i--)
+      model.mixData[i] = model.mixData[i - 1];
+
+    MixData & mix = model.mixData[idx];
+    mix.clear();
+    mix.destCh = channel + 1;
+    mix.srcRaw = RawSource(SOURCE_TYPE_VIRTUAL_INPUT, input);
+    mix.weight = weight;
+  }
+
+  static void addLogicalSwitch(ModelData & model, int idx, int value)
+  {
+    LogicalSwitchData & ls = model.logicalSw[idx];
+    ls.clear();
+    ls.func = LS_FN_VPOS;
+    ls.val1 = RawSource(SOURCE_TYPE_INPUT, 0).toValue();
+    ls.val2 = value;
+  }
+
+  static void addSensor(ModelData & model, int idx, const char * label)
+  {
+    SensorData & sensor = model.sensorData[idx];
+    sensor.clear();
+    sensor.type = SensorData::TELEM_TYPE_CUSTOM;
+    sensor.id = 0xF101 + idx;
+    strcpy(sensor.label, label);
+  }
+
+  ModelChanges diff() const { return diffModels(from, to); }
+};
+
+}  // namespace
+
+TEST_F(ModelDiff, IdenticalModels)
+{
+  EXPECT_TRUE(diff().isEmpty());
+}
+
+TEST_F(ModelDiff, MixChanged)
+{
+  to.mixData[1].weight = 25;
+
+  const ModelChanges changes = diff();
+  ASSERT_EQ(1, changes.size());
+  EXPECT_EQ(ModelChange::Changed, changes[0].type);
+  EXPECT_EQ(ModelChange::Mix, changes[0].section);
+  EXPECT_EQ(0, changes[0].index);
+  EXPECT_EQ(1, changes[0].fromLine);
+  EXPECT_EQ(1, changes[0].toLine);
+  EXPECT_EQ(QStringList({"weight: 50 -> 25"}), changes[0].fields);
+  EXPECT_EQ(QString("Mix CH1 line 2"), changes[0].item());
+}
+
+TEST_F(ModelDiff, MixMovedAndChanged)
+{
+  // new first line on CH1, moving down the changed second one
+  for (int i = CPN_MAX_MIXERS - 1; i > 0; i--)
+    to.mixData[i] = to.mixData[i - 1];
+  to.mixData[0].weight = 30;
+  to.mixData[2].weight = 25;
+
+  const ModelChanges changes = diff();
+  ASSERT_EQ(2, changes.size());
+
+  EXPECT_EQ(ModelChange::Added, changes[0].type);
+  EXPECT_EQ(-1, changes[0].fromLine);
+  EXPECT_EQ(0, changes[0].toLine);
+
+  EXPECT_EQ(ModelChange::Changed, changes[1].type);
+  EXPECT_EQ(0, changes[1].index);
+  EXPECT_EQ(1, changes[1].fromLine);
+  EXPECT_EQ(2, changes[1].toLine);
+  EXPECT_EQ(QStringList({"weight: 50 -> 25"}), changes[1].fields);
+  EXPECT_EQ(QString("Mix CH1 line 2 -> 3"), changes[1].item());
+}
+
+TEST_F(ModelDiff, MixInsertedAndRemoved)
+{
+  // new last line on CH1, CH3 mix moved to CH4
+  addMix(to, 0, 3, 30);
+  to.mixData[3].destCh = 4;
+
+  const ModelChanges changes = diff();
+  ASSERT_EQ(3, changes.size());
+
+  EXPECT_EQ(ModelChange::Added, changes[0].type);
+  EXPECT_EQ(ModelChange::Mix, changes[0].section);
+  EXPECT_EQ(0, changes[0].index);
+  EXPECT_EQ(-1, changes[0].fromLine);
+  EXPECT_EQ(2, changes[0].toLine);
+
+  EXPECT_EQ(ModelChange::Removed, changes[1].type);
+  EXPECT_EQ(2, changes[1].index);
+  EXPECT_EQ(0, changes[1].fromLine);
+  EXPECT_EQ(-1, changes[1].toLine);
+
+  EXPECT_EQ(ModelChange::Added, changes[2].type);
+  EXPECT_EQ(3, changes[2].index);
+  EXPECT_EQ(-1, changes[2].fromLine);
+  EXPECT_EQ(0, changes[2].toLine);
+}
+
+TEST_F(ModelDiff, InputChanged)
+{
+  to.expoData[1].weight = 80;
+
+  const ModelChanges changes = diff();
+  ASSERT_EQ(1, changes.size());
+  EXPECT_EQ(ModelChange::Changed, changes[0].type);
+  EXPECT_EQ(ModelChange::Input, changes[0].section);
+  EXPECT_EQ(1, changes[0].index);
+  EXPECT_EQ(0, changes[0].fromLine);
+  EXPECT_EQ(0, changes[0].toLine);
+  EXPECT_EQ(1, changes[0].fields.size());
+}
+
+TEST_F(ModelDiff, LogicalSwitches)
+{
+  addLogicalSwitch(to, 0, 20);
+  addLogicalSwitch(to, 4, 10);
+
+  const ModelChanges changes = diff();
+  ASSERT_EQ(2, changes.size());
+  EXPECT_EQ(ModelChange::Changed, changes[0].type);
+  EXPECT_EQ(ModelChange::LogicalSwitch, changes[0].section);
+  EXPECT_EQ(0, changes[0].index);
+  EXPECT_EQ(-1, changes[0].fromLine);
+  EXPECT_EQ(-1, changes[0].toLine);
+  EXPECT_EQ(ModelChange::Added, changes[1].type);
+  EXPECT_EQ(4, changes[1].index);
+
+  // and the other way round
+  const ModelChanges reverse = diffModels(to, from);
+  ASSERT_EQ(2, reverse.size());
+  EXPECT_EQ(ModelChange::Removed, reverse[1].type);
+  EXPECT_EQ(4, reverse[1].index);
+}
+
+TEST_F(ModelDiff, Sensors)
+{
+  strcpy(to.sensorData[0].label, "Rssi");
+  addSensor(to, 1, "RxBt");
+
+  const ModelChanges changes = diff();
+  ASSERT_EQ(2, changes.size());
+  EXPECT_EQ(ModelChange::Changed, changes[0].type);
+  EXPECT_EQ(ModelChange::Sensor, changes[0].section);
+  EXPECT_EQ(0, changes[0].index);
+  EXPECT_TRUE(changes[0].fields.first().contains("RSSI -> Rssi"));
+  EXPECT_EQ(ModelChange::Added, changes[1].type);
+  EXPECT_EQ(1, changes[1].index);
+}
+
+TEST_F(ModelDiff, OtherSettings)
+{
+  to.name = "Glider2";
+
+  const ModelChanges changes = diff();
+  ASSERT_EQ(1, changes.size());
+  EXPECT_EQ(ModelChange::Other, changes[0].section);
+  EXPECT_EQ(QString("header"), changes[0].key);
+  EXPECT_EQ(QStringList({"header.name: Glider -> Glider2"}), changes[0].fields);
+}
@@ -0,0 +1,180 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+
+// Model image thumbnails cache: images are decoded once per contents, served
+// from the cache afterwards, and the least recently used ones are evicted.
+
+#include "gtests.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QImage>
+#include <QTemporaryDir>
+
+#include "modelimagecache.h"
+
+namespace {
+
+class ModelImageCacheTest : public ::testing::Test
+{
+ protected:
+  QTemporaryDir dir;
+
+  void SetUp() override
+  {
+    ASSERT_TRUE(dir.isValid());
+  }
+
+  QString writeImage(const QString & name, QRgb color, const QSize & size = QSize(192, 114))
+  {
+    QImage image(size, QImage::Format_RGB32);
+    image.fill(color);
+    const QString path = dir.filePath(name);
+    EXPECT_TRUE(image.save(path, "PNG"));
+    return path;
+  }
+
+  // thumbnail, once decoded in the background
+  QImage fetch(ModelImageCache & cache, const QString & path)
+  {
+    QImage image = cache.thumbnail(path);
+    if (!image.isNull())
+      return image;
+
+    bool ready = false;
+    auto connection = QObject::connect(&cache, &ModelImageCache::thumbnailReady,
+                                       [&](const QString & p) { ready |= (p == path); });
+    QElapsedTimer timer;
+    timer.start();
+    while (!ready && timer.elapsed() < 5000)
+      QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+    QObject::disconnect(connection);
+
+    return cache.thumbnail(path);
+  }
+};
+
+}  // namespace
+
+TEST_F(ModelImageCacheTest, DecodedOnceThenServedFromCache)
+{
+  ModelImageCache cache(QSize(40, 24));
+  const QString path = writeImage("plane.png", qRgb(255, 0, 0));
+
+  EXPECT_FALSE(cache.contains(path));
+  QImage image = fetch(cache, path);
+  ASSERT_FALSE(image.isNull());
+  EXPECT_EQ(QSize(40, 24), image.size());
+  EXPECT_EQ(1, cache.decodeCount());
+  EXPECT_TRUE(cache.contains(path));
+
+  // cache hit: returned right away, without decoding again
+  EXPECT_FALSE(cache.thumbnail(path).isNull());
+  EXPECT_EQ(1, cache.decodeCount());
+}
+
+TEST_F(ModelImageCacheTest, SameContentsAreDecodedOnce)
+{
+  ModelImageCache cache(QSize(40, 24));
+  const QString first = writeImage("first.png", qRgb(0, 255, 0));
+  const QString second = dir.filePath("second.png");
+  ASSERT_TRUE(QFile::copy(first, second));
+
+  ASSERT_FALSE(fetch(cache, first).isNull());
+  ASSERT_FALSE(fetch(cache, second).isNull());
+  EXPECT_EQ(1, cache.decodeCount());
+}
+
+TEST_F(ModelImageCacheTest, ChangedFileIsDecodedAgain)
+{
+  ModelImageCache cache(QSize(40, 24));
+  const QString path = writeImage("heli.png", qRgb(0, 0, 255));
+  ASSERT_FALSE(fetch(cache, path).isNull());
+
+  writeImage("heli.png", qRgb(0, 0, 255), QSize(64, 32));
+  cache.revalidate();
+  QImage image = fetch(cache, path);
+  ASSERT_FALSE(image.isNull());
+  EXPECT_EQ(QSize(40, 20), image.size());
+  EXPECT_EQ(2, cache.decodeCount());
+}
+
+TEST_F(ModelImageCacheTest, ChangedFileIsOnlyCheckedOnRevalidate)
+{
+  ModelImageCache cache(QSize(40, 24));
+  const QString path = writeImage("heli.png", qRgb(0, 0, 255));
+  ASSERT_EQ(QSize(40, 24), fetch(cache, path).size());
+
+  writeImage("heli.png", qRgb(0, 0, 255), QSize(64, 32));
+  EXPECT_EQ(QSize(40, 24), cache.thumbnail(path).size());
+  QCoreApplication::processEvents();
+  EXPECT_EQ(1, cache.decodeCount());
+
+  cache.revalidate();
+  EXPECT_EQ(QSize(40, 20), fetch(cache, path).size());
+  EXPECT_EQ(2, cache.decodeCount());
+}
+
+TEST_F(ModelImageCacheTest, InvalidImageIsNotRetried)
+{
+  ModelImageCache cache(QSize(40, 24));
+  const QString path = dir.filePath("broken.png");
+  QFile file(path);
+  ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+  file.write("not an image");
+  file.close();
+
+  cache.thumbnail(path);
+  QElapsedTimer timer;
+  timer.start();
+  while (cache.decodeCount() == 0 && timer.elapsed() < 5000)
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+
+  EXPECT_TRUE(cache.thumbnail(path).isNull());
+  QCoreApplication::processEvents();
+  EXPECT_EQ(1, cache.decodeCount());
+}
+
+TEST_F(ModelImageCacheTest, LeastRecentlyUsedIsEvicted)
+{
+  // 40x24 thumbnails cost 3 KB each: room for two of them
+  ModelImageCache cache(QSize(40, 24), 7);
+  const QString a = writeImage("a.png", qRgb(10, 10, 10));
+  const QString b = writeImage("b.png", qRgb(20, 20, 20));
+  const QString c = writeImage("c.png", qRgb(30, 30, 30));
+
+  ASSERT_FALSE(fetch(cache, a).isNull());
+  ASSERT_FALSE(fetch(cache, b).isNull());
+  ASSERT_FALSE(cache.thumbnail(a).isNull());  // a is now more recent than b
+  ASSERT_FALSE(fetch(cache, c).isNull());
+  EXPECT_EQ(3, cache.decodeCount());
+
+  EXPECT_LE(cache.totalCost(), cache.maxCost());
+  EXPECT_TRUE(cache.contains(a));
+  EXPECT_FALSE(cache.contains(b));
+  EXPECT_TRUE(cache.contains(c));
+
+  // evicted: decoded again when asked for
+  ASSERT_FALSE(fetch(cache, b).isNull());
+  EXPECT_EQ(4, cache.decodeCount());
+}
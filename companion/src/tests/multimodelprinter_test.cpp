@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+// Cached section rendering of the model printer: a warm render must give the
+// same document as a cold one, and only the changed sections are rendered
+// again.
+
+#include "gtests.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QRegularExpression>
+
+#include "firmwares/eeprominterface.h"
+#include "print/multimodelprinter.h"
+#include "testhelpers.h"
+
+namespace {
+
+class MultiModelPrinterTest : public ::testing::Test
+{
+ protected:
+  ModelData model;
+  GeneralSettings settings;
+
+  void SetUp() override
+  {
+    ASSERT_NO_FATAL_FAILURE(TestHelpers::selectFirmware());
+    MultiModelPrinter::clearCache();
+
+    settings.init();
+    model.clear();
+    model.used = true;
+    model.name = "Printed";
+
+    TestHelpers::fillModel(model, 32);
+  }
+
+  QString print(MultiModelPrinter & printer)
+  {
+    printer.setModel(0, &model, &settings);
+    return printer.print(nullptr);
+  }
+
+  // without the curve image urls, unique to each render of the section
+  static QString withoutImages(QString html)
+  {
+    return html.replace(QRegularExpression("mydata://curve-[0-9]+-"), "mydata://curve-");
+  }
+};
+
+}  // namespace
+
+TEST_F(MultiModelPrinterTest, WarmRenderIsIdentical)
+{
+  MultiModelPrinter printer(getCurrentFirmware());
+  QString cold = print(printer);
+  ASSERT_TRUE(cold.contains("Printed"));
+  EXPECT_GT(printer.renderedSections(), 0);
+  EXPECT_EQ(cold, print(printer));
+  EXPECT_EQ(printer.renderedSections(), 0);
+
+  // another printer uses the same fragments
+  MultiModelPrinter other(getCurrentFirmware());
+  EXPECT_EQ(cold, print(other));
+  EXPECT_EQ(other.renderedSections(), 0);
+}
+
+TEST_F(MultiModelPrinterTest, ChangedSectionIsRenderedAgain)
+{
+  MultiModelPrinter printer(getCurrentFirmware());
+  QString before = print(printer);
+
+  model.mixData[3].weight = -42;
+  QString after = print(printer);
+  EXPECT_NE(before, after);
+  // the mixes only, the other sections are unchanged
+  EXPECT_EQ(printer.renderedSections(), 1);
+
+  MultiModelPrinter::clearCache();
+  EXPECT_EQ(withoutImages(after), withoutImages(print(printer)));
+}
+
+TEST_F(MultiModelPrinterTest, AsyncMatchesSync)
+{
+  MultiModelPrinter printer(getCurrentFirmware());
+  QString sync = print(printer);
+  MultiModelPrinter::clearCache();
+
+  QString sections;
+  bool complete = false;
+  int updates = 0;
+  QObject::connect(&printer, &MultiModelPrinter::sectionsAdded,
+                   [&](const QString & s, bool c) { sections += s; complete = c; updates++; });
+  printer.printAsync(nullptr);
+
+  QElapsedTimer timer;
+  timer.start();
+  while (!complete && timer.elapsed() < 10000)
+    QCoreApplication::processEvents(QEventLoop::AllEvents, 10);
+
+  ASSERT_TRUE(complete);
+  EXPECT_GE(updates, 1);
+  EXPECT_EQ(withoutImages(sync), withoutImages(MultiModelPrinter::table(sections)));
+}
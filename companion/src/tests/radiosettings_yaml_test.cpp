@@ -0,0 +1,96 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "gtests.h"
+
+#include <QByteArray>
+
+#include "firmwares/eeprominterface.h"
+#include "firmwares/edgetx/edgetxinterface.h"
+
+namespace {
+
+class RadioSettingsYaml : public ::testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    Firmware::setCurrentVariant(Firmware::getFirmwareForFlavour("tx16s"));
+    ASSERT_NE(getCurrentFirmware(), nullptr);
+  }
+};
+
+}  // namespace
+
+TEST_F(RadioSettingsYaml, AdcFilterRoundTrip)
+{
+  for (int filter = 0; filter < GeneralSettings::ADCFILTER_COUNT; filter++) {
+    GeneralSettings in;
+    in.clear();
+    in.noJitterFilter = false;
+    in.adcFilter = filter;
+
+    QByteArray yaml;
+    ASSERT_TRUE(writeRadioSettingsToYaml(in, yaml));
+
+    GeneralSettings out;
+    out.clear();
+    out.noJitterFilter = true;
+    ASSERT_TRUE(loadRadioSettingsFromYaml(out, yaml));
+    EXPECT_FALSE(out.noJitterFilter);
+    EXPECT_EQ((unsigned)filter, out.adcFilter) << yaml.constData();
+  }
+}
+
+TEST_F(RadioSettingsYaml, AdcFilterNames)
+{
+  GeneralSettings in;
+  in.clear();
+  in.adcFilter = GeneralSettings::ADCFILTER_ONE_EURO;
+
+  // same names as the radio
+  QByteArray yaml;
+  writeRadioSettingsToYaml(in, yaml);
+  EXPECT_TRUE(yaml.contains("adcFilter: ONE_EURO")) << yaml.constData();
+}
+
+TEST_F(RadioSettingsYaml, AdcFilterDefaultsToMma)
+{
+  GeneralSettings in;
+  in.clear();
+  in.adcFilter = GeneralSettings::ADCFILTER_KALMAN;
+
+  // settings written before the filter could be chosen, without the
+  // checksum which no longer matches
+  QByteArray yaml;
+  writeRadioSettingsToYaml(in, yaml);
+  ASSERT_TRUE(yaml.startsWith("checksum:"));
+  yaml.remove(0, yaml.indexOf('\n') + 1);
+  const int start = yaml.indexOf("adcFilter:");
+  ASSERT_GE(start, 0);
+  yaml.remove(start, yaml.indexOf('\n', start) + 1 - start);
+
+  GeneralSettings out;
+  out.clear();
+  ASSERT_TRUE(loadRadioSettingsFromYaml(out, yaml));
+  EXPECT_EQ((unsigned)GeneralSettings::ADCFILTER_MMA, out.adcFilter);
+}
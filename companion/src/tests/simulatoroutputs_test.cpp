@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+// Simulator outputs are published as one snapshot per poll, with a change
+// bit per value. A simulator fed from a frame source is polled, and the
+// outputsChange() signals it emits are counted.
+
+#include "gtests.h"
+
+#include <QSignalSpy>
+
+#include "simulation/simulatorinterface.h"
+
+#define POLL_PERIOD_MS      50  // outputs poll of the simulator
+#define SIMULATED_MS        1000
+#define OUTPUTS_LIMIT       1024
+
+namespace {
+
+typedef SimulatorInterface::OutputsFrame OutputsFrame;
+typedef SimulatorInterface::TxOutputs TxOutputs;
+
+// Simulator without firmware: each poll publishes the given outputs, the way
+// the WASM simulator publishes the outputs read from the firmware
+class OutputsSimulator : public SimulatorInterface
+{
+  public:
+    void poll(const TxOutputs & outputs, bool reset = false)
+    {
+      for (int i = 0; i < CPN_MAX_CHNOUT; i++) {
+        m_outputs.setChannel(i, outputs.chans[i], reset);
+        m_outputs.setMix(i, outputs.ex_chans[i], reset);
+      }
+      for (int i = 0; i < CPN_MAX_LOGICAL_SWITCHES; i++)
+        m_outputs.setVirtualSw(i, outputs.vsw[i], reset);
+      for (int fm = 0; fm < CPN_MAX_FLIGHT_MODES; fm++) {
+        for (int gv = 0; gv < CPN_MAX_GVARS; gv++)
+          m_outputs.setGVar(fm, gv, outputs.gvars[fm][gv], reset);
+      }
+      publishOutputs(OUTPUTS_LIMIT);
+    }
+
+    QString name() override { return "outputs"; }
+    bool isRunning() override { return true; }
+    void readRadioData(QByteArray &) override {}
+    uint8_t * getLcd() override { return nullptr; }
+    uint8_t getSensorInstance(uint16_t, uint8_t defaultValue = 0) override { return defaultValue; }
+    uint16_t getSensorRatio(uint16_t) override { return 0; }
+    const int getCapability(Capability) override { return 0; }
+    void init() override {}
+    void start(const char *, bool) override {}
+    void stop() override {}
+    void setSdPath(const QString &, const QString &) override {}
+    void setVolumeGain(const int) override {}
+    void setRadioData(const QByteArray &) override {}
+    void setAnalogValue(uint8_t, int16_t) override {}
+    void setKey(uint8_t, bool) override {}
+    void setSwitch(uint8_t, int8_t) override {}
+    void setTrim(unsigned int, int) override {}
+    void setTrimSwitch(uint8_t, bool) override {}
+    void setTrainerInput(unsigned int, int16_t) override {}
+    void setInputValue(int, uint8_t, int16_t) override {}
+    void rotaryEncoderEvent(int) override {}
+    void touchEvent(int, int, int) override {}
+    void lcdFlushed() override {}
+    void setTrainerTimeout(uint16_t) override {}
+    void sendInternalModuleTelemetry(const quint8, const QByteArray) override {}
+    void sendExternalModuleTelemetry(const quint8, const QByteArray) override {}
+    void setLuaStateReloadPermanentScripts() override {}
+    void addTracebackDevice(QIODevice *) override {}
+    void removeTracebackDevice(QIODevice *) override {}
+    void receiveAuxSerialData(const quint8, const QByteArray &) override {}
+};
+
+// everything moves on each poll
+void moveOutputs(TxOutputs & outputs, int poll)
+{
+  for (int i = 0; i < CPN_MAX_CHNOUT; i++) {
+    outputs.chans[i] = (poll * 37 + i) % 2048 - 1024;
+    outputs.ex_chans[i] = (poll * 53 + i) % 4096 - 2048;
+  }
+  for (int i = 0; i < CPN_MAX_LOGICAL_SWITCHES; i++)
+    outputs.vsw[i] = (poll + i) % 2;
+  for (int fm = 0; fm < CPN_MAX_FLIGHT_MODES; fm++) {
+    for (int gv = 0; gv < CPN_MAX_GVARS; gv++)
+      outputs.gvars[fm][gv] = (fm << 16) | ((poll + gv) & 0xFF);
+  }
+}
+
+bool sameOutputs(const TxOutputs & a, const TxOutputs & b)
+{
+  return !memcmp(a.chans, b.chans, sizeof(a.chans)) &&
+         !memcmp(a.ex_chans, b.ex_chans, sizeof(a.ex_chans)) &&
+         !memcmp(a.vsw, b.vsw, sizeof(a.vsw)) &&
+         !memcmp(a.gvars, b.gvars, sizeof(a.gvars));
+}
+
+OutputsFrame signalFrame(const QSignalSpy & spy, int index)
+{
+  return spy.at(index).at(0).value<OutputsFrame>();
+}
+
+}  // namespace
+
+TEST(SimulatorOutputs, OnlyChangedValuesAreFlagged)
+{
+  OutputsFrame frame;
+  EXPECT_FALSE(frame.changed());
+
+  frame.setChannel(3, 100);
+  frame.setVirtualSw(40, true);
+  frame.setGVar(2, 5, 7);
+  EXPECT_EQ(frame.chansChanged, 1u << 3);
+  EXPECT_EQ(frame.mixesChanged, 0u);
+  EXPECT_EQ(frame.vswChanged, (quint64)1 << 40);
+  EXPECT_EQ(frame.gvarsChanged[2], 1u << 5);
+  EXPECT_EQ(countChanges(frame), 3);
+
+  // same values again: nothing to publish
+  frame.clearChanges();
+  frame.setChannel(3, 100);
+  frame.setVirtualSw(40, true);
+  frame.setGVar(2, 5, 7);
+  EXPECT_FALSE(frame.changed());
+
+  // unless forced, as after a simulator restart
+  frame.setMix(0, 0, true);
+  EXPECT_EQ(frame.mixesChanged, 1u);
+}
+
+TEST(SimulatorOutputs, MergeKeepsLatestValuesAndAllChanges)
+{
+  OutputsFrame pending, first, second;
+  first.setChannel(0, 10);
+  first.setChannel(1, 20);
+  second.values = first.values;
+  second.setChannel(1, 30);
+  second.setVirtualSw(63, true);
+  second.limit = 1024;
+
+  pending.merge(first);
+  pending.merge(second);
+  EXPECT_EQ(pending.chansChanged, 3u);
+  EXPECT_EQ(pending.vswChanged, (quint64)1 << 63);
+  EXPECT_EQ(pending.values.chans[0], 10);
+  EXPECT_EQ(pending.values.chans[1], 30);
+  EXPECT_EQ(pending.limit, 1024);
+}
+
+TEST(SimulatorOutputs, OneSignalPerPollWithChanges)
+{
+  OutputsSimulator simulator;
+  QSignalSpy spy(&simulator, &SimulatorInterface::outputsChange);
+  ASSERT_TRUE(spy.isValid());
+
+  // receiver batching the frames as the outputs widget does
+  OutputsFrame pending;
+  int slotInvocations = 0;
+  QObject::connect(&simulator, &SimulatorInterface::outputsChange,
+                   [&](const OutputsFrame & frame) {
+                     slotInvocations++;
+                     pending.merge(frame);
+                   });
+
+  TxOutputs outputs;
+  for (int ms = 0; ms < SIMULATED_MS; ms += POLL_PERIOD_MS) {
+    moveOutputs(outputs, ms / POLL_PERIOD_MS);
+    simulator.poll(outputs);
+  }
+
+  // one invocation per poll, where every moving value used to get its own
+  EXPECT_EQ(spy.count(), SIMULATED_MS / POLL_PERIOD_MS);
+  EXPECT_EQ(slotInvocations, spy.count());
+
+  OutputsFrame last = signalFrame(spy, spy.count() - 1);
+  EXPECT_EQ(last.chansChanged, (quint32)((1ull << CPN_MAX_CHNOUT) - 1));
+  EXPECT_EQ(last.limit, OUTPUTS_LIMIT);
+  EXPECT_TRUE(sameOutputs(last.values, outputs));
+  EXPECT_TRUE(sameOutputs(pending.values, outputs));
+}
+
+TEST(SimulatorOutputs, UnchangedOutputsAreNotPublished)
+{
+  OutputsSimulator simulator;
+  QSignalSpy spy(&simulator, &SimulatorInterface::outputsChange);
+  ASSERT_TRUE(spy.isValid());
+
+  TxOutputs outputs;
+  moveOutputs(outputs, 1);
+  simulator.poll(outputs);
+  ASSERT_EQ(spy.count(), 1);
+
+  // same outputs: nothing is emitted
+  for (int i = 0; i < 10; i++)
+    simulator.poll(outputs);
+  EXPECT_EQ(spy.count(), 1);
+
+  // a single change is published alone
+  outputs.ex_chans[5] += 10;
+  outputs.vsw[3] = !outputs.vsw[3];
+  simulator.poll(outputs);
+  ASSERT_EQ(spy.count(), 2);
+  OutputsFrame frame = signalFrame(spy, 1);
+  EXPECT_EQ(frame.chansChanged, 0u);
+  EXPECT_EQ(frame.mixesChanged, 1u << 5);
+  EXPECT_EQ(frame.vswChanged, (quint64)1 << 3);
+  EXPECT_EQ(frame.values.ex_chans[5], outputs.ex_chans[5]);
+  for (int fm = 0; fm < CPN_MAX_FLIGHT_MODES; fm++)
+    EXPECT_EQ(frame.gvarsChanged[fm], 0u);
+
+  // unless the simulator restarts
+  simulator.poll(outputs, true);
+  ASSERT_EQ(spy.count(), 3);
+  EXPECT_EQ(signalFrame(spy, 2).chansChanged, (quint32)((1ull << CPN_MAX_CHNOUT) - 1));
+}
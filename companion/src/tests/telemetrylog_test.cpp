@@ -0,0 +1,157 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+// Telemetry log loader tests: a log as recorded by the radio (10 Hz, 64
+// sensors) is generated and loaded.
+
+#include "gtests.h"
+
+#include <QTemporaryDir>
+#include <algorithm>
+
+#include "telemetrylog.h"
+#include "testhelpers.h"
+
+#define LOG_SENSORS  64
+
+class TelemetryLogTest : public ::testing::Test
+{
+ protected:
+  QTemporaryDir dir;
+  QString path;
+
+  void SetUp() override
+  {
+    ASSERT_TRUE(dir.isValid());
+    path = dir.filePath("model-2024-03-05-101500.csv");
+  }
+
+  void writeLog(int rows, const QByteArray & extra = QByteArray())
+  {
+    TestHelpers::writeTelemetryLog(path, rows, LOG_SENSORS, extra);
+  }
+};
+
+TEST_F(TelemetryLogTest, Values)
+{
+  ASSERT_NO_FATAL_FAILURE(writeLog(1000, "2024-03-05,10:20:00.000,1,2\n2024-03-05,1O:20:00.000" +
+                 QByteArray(LOG_SENSORS + 2, ',') + "\n"));
+
+  TelemetryLog log;
+  ASSERT_TRUE(log.load(path));
+  EXPECT_EQ(1000, log.rowCount());
+  EXPECT_EQ(1002, log.lines());
+  EXPECT_EQ(2, log.errors());
+  ASSERT_EQ(LOG_SENSORS + 4, log.columnCount());
+  EXPECT_EQ(QString("S0(m)"), log.columnNames().at(2));
+
+  qint64 start = QDateTime(QDate(2024, 3, 5), QTime(10, 15, 0)).toMSecsSinceEpoch();
+  for (int row = 0; row < log.rowCount(); row++) {
+    EXPECT_EQ(start + row * 100, log.timestamp(row));
+    for (int sensor = 0; sensor < LOG_SENSORS; sensor += 7) {
+      EXPECT_DOUBLE_EQ(TestHelpers::telemetryLogValue(row, sensor), log.values(sensor + 2).at(row));
+    }
+  }
+
+  // text cells are kept, numeric columns are 0
+  EXPECT_EQ(QString("45.123456 7.654321"), log.cell(10, LOG_SENSORS + 2));
+  EXPECT_EQ(QString("Normal"), log.cell(10, LOG_SENSORS + 3));
+  EXPECT_EQ(0.0, log.values(LOG_SENSORS + 3).at(10));
+  EXPECT_FALSE(log.isNumeric(10, LOG_SENSORS + 3));
+  EXPECT_TRUE(log.isNumeric(10, 2));
+  EXPECT_TRUE(log.line(0).startsWith("2024-03-05,10:15:00.000,"));
+
+  log.clear();
+  EXPECT_TRUE(log.isEmpty());
+}
+
+TEST_F(TelemetryLogTest, EmptyCells)
+{
+  QByteArray extra;
+  for (int row = 0; row < 3; row++) {
+    extra += "2024-03-05,10:20:00." + QByteArray::number(row * 100) + (row == 1 ? ", ," : ",-5,") +
+             QByteArray(LOG_SENSORS, ',') + "\n";
+  }
+  ASSERT_NO_FATAL_FAILURE(writeLog(10, extra));
+
+  TelemetryLog log;
+  ASSERT_TRUE(log.load(path));
+  ASSERT_EQ(13, log.rowCount());
+  EXPECT_TRUE(log.isNumeric(10, 2));
+  EXPECT_FALSE(log.isNumeric(11, 2));
+  EXPECT_TRUE(log.isNumeric(12, 2));
+  EXPECT_EQ(-5.0, log.values(2).at(10));
+  EXPECT_EQ(0.0, log.values(2).at(11));
+  EXPECT_FALSE(log.isNumeric(11, 3));
+}
+
+TEST_F(TelemetryLogTest, FileIsReleased)
+{
+  ASSERT_NO_FATAL_FAILURE(writeLog(100));
+
+  TelemetryLog log;
+  ASSERT_TRUE(log.load(path));
+  const QByteArray first = log.line(0);
+
+  // the radio may write the file again while the log is shown
+  QFile file(path);
+  ASSERT_TRUE(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+  file.write("Date,Time\n");
+  file.close();
+
+  EXPECT_EQ(first, log.line(0));
+  EXPECT_EQ(100, log.rowCount());
+}
+
+TEST_F(TelemetryLogTest, NotALog)
+{
+  QFile file(path);
+  ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+  file.write("Time,Date\n");
+  file.close();
+
+  TelemetryLog log;
+  EXPECT_FALSE(log.load(path));
+  EXPECT_FALSE(log.load(dir.filePath("missing.csv")));
+}
+
+TEST(TelemetryLogDecimate, KeepsPeaks)
+{
+  QVector<double> x, y, outX, outY;
+  for (int i = 0; i < 100000; i++) {
+    x.append(i);
+    y.append(i % 1000 == 500 ? 1 : (i % 1000 == 700 ? -1 : 0));
+  }
+
+  TelemetryLog::decimate(x, y, 10000, 59999, 200, outX, outY);
+  EXPECT_LE(outX.count(), 2 * 200 + 2);
+  EXPECT_EQ(9999.0, outX.first());
+  EXPECT_EQ(60000.0, outX.last());
+  EXPECT_EQ(50, std::count(outY.begin(), outY.end(), 1.0));
+  EXPECT_EQ(50, std::count(outY.begin(), outY.end(), -1.0));
+  EXPECT_TRUE(std::is_sorted(outX.begin(), outX.end()));
+
+  // less points than pixels: all of them are kept
+  TelemetryLog::decimate(x, y, 100, 199, 200, outX, outY);
+  EXPECT_EQ(102, outX.count());
+  EXPECT_EQ(x.mid(99, 102), outX);
+}
@@ -0,0 +1,227 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+// Telemetry log replay: the log is encoded once into timestamped frames,
+// which are then played at their log time, whatever the speed.
+
+#include "gtests.h"
+
+#include <QTemporaryDir>
+
+#include "simulation/telemetrylogreplay.h"
+
+#define LOG_ROWS      50
+#define LOG_PERIOD    100  // ms
+
+namespace {
+
+// One frame per supported item, holding "item=value"
+class TestProvider : public TelemetryProvider
+{
+  public:
+    bool canEncode = true;
+    QHash<QString, QString> supportedItems = { { "Alt", "m" }, { "RSSI", "dB" } };
+
+    void resetRssi() override {}
+    void loadUiFromSimulator(SimulatorInterface *) override {}
+    void loadItemFromLog(QString, QString) override {}
+    QHash<QString, QString> * getSupportedLogItems() override { return &supportedItems; }
+    QString getLogfileIdentifier() override { return "TEST"; }
+    void generateTelemetryFrame(SimulatorInterface *) override {}
+
+    bool encodeLogItems(const QHash<QString, QString> & items, QList<TelemetryFrame> & frames) override
+    {
+      if (!canEncode)
+        return false;
+      for (const char * item : { "RSSI", "Alt" }) {
+        if (items.contains(item))
+          frames.append(TelemetryFrame(SIMU_TELEMETRY_PROTOCOL_CROSSFIRE, (item + ("=" + items.value(item))).toUtf8()));
+      }
+      return true;
+    }
+};
+
+// Replay on a simulated clock: time only moves with advance(), which fires
+// the timer events due in the meantime
+class ManualReplay : public TelemetryLogReplay
+{
+  public:
+    qint64 now = 0;   // ns
+    qint64 due = -1;  // ns, -1 when the timer is not armed
+
+    void advance(qint64 ms)
+    {
+      const qint64 end = now + ms * 1000000;
+      while (isPlaying() && due >= 0 && due <= end) {
+        now = due;
+        due = -1;
+        onTimer();
+      }
+      now = end;
+    }
+
+  protected:
+    qint64 clockTime() const override { return now; }
+    void armTimer(qint64 delay) override { due = now + delay * 1000000; }
+};
+
+class TelemetryLogReplayTest : public ::testing::Test
+{
+  protected:
+    QTemporaryDir dir;
+    TestProvider provider;
+    ManualReplay replay;
+    QList<QByteArray> received;
+    QList<qint64> receivedAt;  // ms of the simulated clock
+
+    void SetUp() override
+    {
+      ASSERT_TRUE(dir.isValid());
+      QString path = dir.filePath("model-2024-03-05.csv");
+      QFile file(path);
+      ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+      file.write("Date,Time,RSSI(dB),Alt(ft),Tmp1(°C)\n");
+      for (int row = 0; row < LOG_ROWS; row++) {
+        QTime time = QTime(10, 15).addMSecs(row * LOG_PERIOD);
+        file.write(QString("2024-03-05,%1,%2,%3,20\n").arg(time.toString("hh:mm:ss.zzz")).arg(row).arg(row * 10).toUtf8());
+      }
+      file.close();
+
+      ASSERT_TRUE(replay.load(path));
+      QObject::connect(&replay, &TelemetryLogReplay::internalTelemetryDataChanged,
+                       [this](const quint8, const QByteArray data) {
+                         received.append(data);
+                         receivedAt.append(replay.now / 1000000);
+                       });
+    }
+};
+
+}  // namespace
+
+TEST_F(TelemetryLogReplayTest, FramesAreStampedWithTheirRecordTime)
+{
+  ASSERT_TRUE(replay.encode(&provider, nullptr));
+
+  const QVector<TelemetryLogReplay::Frame> & frames = replay.frames();
+  ASSERT_EQ(frames.count(), 2 * LOG_ROWS);
+
+  // both frames of a record are spread over the record period
+  EXPECT_EQ(frames[0].time, 0);
+  EXPECT_EQ(frames[1].time, LOG_PERIOD / 2);
+  EXPECT_EQ(frames[2].time, LOG_PERIOD);
+  EXPECT_FALSE(frames[0].external);
+  EXPECT_EQ(frames[2].frame.first, SIMU_TELEMETRY_PROTOCOL_CROSSFIRE);
+  EXPECT_EQ(frames[2].frame.second, QByteArray("RSSI=1"));
+
+  // values are converted to the units of the provider
+  EXPECT_EQ(frames[3].frame.second, QByteArray("Alt=3.048"));
+  EXPECT_EQ(replay.duration(), frames.last().time);
+  EXPECT_EQ(replay.row(frames[2].time), 1);
+  EXPECT_EQ(replay.rowPosition(2), 2 * LOG_PERIOD);
+}
+
+TEST_F(TelemetryLogReplayTest, ProviderWithoutEncoderIsNotReplayed)
+{
+  provider.canEncode = false;
+  EXPECT_FALSE(replay.encode(&provider, nullptr));
+  EXPECT_FALSE(replay.isEncoded());
+  EXPECT_FALSE(replay.encode(nullptr, nullptr));
+}
+
+TEST_F(TelemetryLogReplayTest, PlaysAllFramesInOrderAtHighSpeed)
+{
+  ASSERT_TRUE(replay.encode(&provider, nullptr));
+  replay.setLooping(false);
+  replay.setSpeed(TELEMETRY_REPLAY_MAX_SPEED);
+  replay.play();
+
+  // about 5 s of log at 50x: half of it after 50 ms
+  const qint64 playTime = replay.duration() / TELEMETRY_REPLAY_MAX_SPEED;
+  replay.advance(playTime / 2);
+  EXPECT_TRUE(replay.isPlaying());
+  EXPECT_NEAR(received.count(), LOG_ROWS, 2);
+
+  replay.advance(playTime);
+  EXPECT_FALSE(replay.isPlaying());
+  ASSERT_EQ(received.count(), 2 * LOG_ROWS);
+  for (int i = 0; i < received.count(); i++) {
+    const TelemetryLogReplay::Frame & frame = replay.frames()[i];
+    EXPECT_EQ(received[i], frame.frame.second);
+    // each one sent at its log time
+    EXPECT_NEAR(receivedAt[i], frame.time / TELEMETRY_REPLAY_MAX_SPEED, 1) << "frame " << i;
+  }
+  EXPECT_EQ(replay.position(), replay.duration());
+}
+
+TEST_F(TelemetryLogReplayTest, SpeedChangeKeepsThePosition)
+{
+  ASSERT_TRUE(replay.encode(&provider, nullptr));
+  replay.setLooping(false);
+  replay.play();
+
+  replay.advance(1000);
+  EXPECT_EQ(replay.position(), 1000);
+  EXPECT_EQ(received.count(), 2 * 1000 / LOG_PERIOD + 1);
+
+  replay.setSpeed(10);
+  EXPECT_EQ(replay.position(), 1000);
+  replay.advance(100);
+  EXPECT_EQ(replay.position(), 2000);
+  EXPECT_EQ(received.count(), 2 * 2000 / LOG_PERIOD + 1);
+
+  replay.stop();
+  replay.advance(1000);
+  EXPECT_EQ(replay.position(), 2000);
+  EXPECT_EQ(received.count(), 2 * 2000 / LOG_PERIOD + 1);
+}
+
+TEST_F(TelemetryLogReplayTest, SeekStartsFromThePosition)
+{
+  ASSERT_TRUE(replay.encode(&provider, nullptr));
+  replay.setLooping(false);
+  replay.setSpeed(TELEMETRY_REPLAY_MAX_SPEED);
+  replay.seek(replay.rowPosition(LOG_ROWS - 10));
+  replay.play();
+
+  replay.advance(replay.duration() / TELEMETRY_REPLAY_MAX_SPEED);
+
+  EXPECT_FALSE(replay.isPlaying());
+  ASSERT_EQ(received.count(), 2 * 10);
+  EXPECT_EQ(received.first(), QByteArray("RSSI=40"));
+}
+
+TEST_F(TelemetryLogReplayTest, LoopsBackToTheStart)
+{
+  ASSERT_TRUE(replay.encode(&provider, nullptr));
+  replay.setSpeed(TELEMETRY_REPLAY_MAX_SPEED);
+  replay.seek(replay.rowPosition(LOG_ROWS - 2));
+  replay.play();
+
+  // the last 2 records, then the first ones again
+  replay.advance(3 * LOG_PERIOD / TELEMETRY_REPLAY_MAX_SPEED);
+  EXPECT_TRUE(replay.isPlaying());
+  replay.stop();
+
+  ASSERT_GT(received.count(), 4);
+  EXPECT_EQ(received[0], QByteArray("RSSI=48"));
+  EXPECT_EQ(received[4], QByteArray("RSSI=0"));
+}
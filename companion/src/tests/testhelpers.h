@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+// Fixtures shared by the storage, print and telemetry log tests and by the
+// benchmarks: the test firmware, a numbered collection of models, and the
+// [ BENCH    ] timings report.
+
+#include "gtests.h"
+
+#include <QDateTime>
+#include <QFile>
+#include <algorithm>
+#include <cstdio>
+#include <iostream>
+
+#include "firmwares/eeprominterface.h"
+
+namespace TestHelpers {
+
+inline void selectFirmware()
+{
+  Firmware::setCurrentVariant(Firmware::getFirmwareForFlavour("tx16s"));
+  ASSERT_NE(getCurrentFirmware(), nullptr);
+}
+
+inline QString modelFilename(int index)
+{
+  return QString("model%1.yml").arg(index, 2, 10, QChar('0'));
+}
+
+inline QString modelName(int index)
+{
+  return QString("Model%1").arg(index);
+}
+
+// Each model gets its own name, file, labels and timer value
+inline void initModel(ModelData & model, int index)
+{
+  model.clear();
+  model.used = true;
+  model.modelIndex = index;
+  model.name = modelName(index).toStdString();
+  model.filename = modelFilename(index).toStdString();
+  model.labels = (index % 3) ? "fav" : "race,heli";
+  model.timers[0].val = index * 10;
+}
+
+inline void initRadioData(RadioData & radioData, int models)
+{
+  radioData.generalSettings.init();
+  radioData.models.resize(models);
+  for (int i = 0; i < models; i++) {
+    initModel(radioData.models[i], i);
+  }
+}
+
+// A busy model: inputs, up to items mixes, logical switches and sensors, and
+// a few curves
+inline void fillModel(ModelData & model, int items)
+{
+  for (int i = 0; i < std::min(items, 8); i++) {
+    ExpoData & expo = model.expoData[i];
+    expo.clear();
+    expo.chn = i;
+    expo.mode = INPUT_MODE_BOTH;
+    expo.srcRaw = RawSource(SOURCE_TYPE_INPUT, i % 4);
+    expo.weight = 100 - i;
+  }
+
+  for (int i = 0; i < items && i < CPN_MAX_MIXERS; i++) {
+    MixData & mix = model.mixData[i];
+    mix.clear();
+    mix.destCh = i / 2 + 1;
+    mix.srcRaw = RawSource(SOURCE_TYPE_VIRTUAL_INPUT, i % 8);
+    mix.weight = 50 + i;
+    mix.sOffset = i;
+  }
+
+  for (int i = 0; i < items && i < CPN_MAX_LOGICAL_SWITCHES; i++) {
+    LogicalSwitchData & ls = model.logicalSw[i];
+    ls.clear();
+    ls.func = LS_FN_VPOS;
+    ls.val1 = RawSource(SOURCE_TYPE_INPUT, i % 4).toValue();
+    ls.val2 = i;
+  }
+
+  for (int i = 0; i < items && i < CPN_MAX_SENSORS; i++) {
+    SensorData & sensor = model.sensorData[i];
+    sensor.clear();
+    sensor.type = SensorData::TELEM_TYPE_CUSTOM;
+    sensor.id = 0x0210 + i;
+    sensor.instance = i % 8 + 1;
+    snprintf(sensor.label, sizeof(sensor.label), "S%02d", i);
+    sensor.unit = SensorData::UNIT_VOLTS;
+    sensor.prec = 1;
+  }
+
+  for (int i = 0; i < 4; i++) {
+    CurveData & curve = model.curves[i];
+    curve.count = 5;
+    for (int j = 0; j < curve.count; j++)
+      curve.points[j].y = (j - 2) * 25 * (i + 1) / 4;
+  }
+}
+
+// Value of a sensor in a generated telemetry log
+inline double telemetryLogValue(int row, int sensor)
+{
+  return ((row * (sensor + 1)) % 2000 - 1000) / 10.0;
+}
+
+// A log as recorded by the radio at 10 Hz, with a GPS and a flight mode
+// column after the sensors
+inline void writeTelemetryLog(const QString & path, int rows, int sensors,
+                              const QByteArray & extra = QByteArray())
+{
+  QFile file(path);
+  ASSERT_TRUE(file.open(QIODevice::WriteOnly));
+
+  QByteArray line = "Date,Time";
+  for (int sensor = 0; sensor < sensors; sensor++) {
+    line += ",S" + QByteArray::number(sensor) + "(m)";
+  }
+  line += ",GPS,FM\n";
+  file.write(line);
+
+  QTime start(10, 15, 0);
+  for (int row = 0; row < rows; row++) {
+    QTime time = start.addMSecs(row * 100);
+    line = "2024-03-05," + time.toString("HH:mm:ss.zzz").toLatin1();
+    for (int sensor = 0; sensor < sensors; sensor++) {
+      line += ',' + QByteArray::number(telemetryLogValue(row, sensor), 'f', 1);
+    }
+    line += ",45.123456 7.654321,Normal\r\n";
+    file.write(line);
+  }
+  file.write(extra);
+}
+
+// Prints a timing and records it as a property of the current test
+// (microseconds), so that --gtest_output=json or xml gives it too
+inline void reportBenchmark(const std::string & metric, qint64 nsecs)
+{
+  const int us = nsecs / 1000;
+  const ::testing::TestInfo * test = ::testing::UnitTest::GetInstance()->current_test_info();
+  ::testing::Test::RecordProperty(metric, us);
+  std::cout << "[ BENCH    ] " << test->test_suite_name() << "." << test->name()
+            << " " << metric << ": " << us << " us" << std::endl;
+}
+
+}  // namespace TestHelpers
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+
+// Packing of COUNT values of BITS bits each, LSB first, as used by the
+// CRSF and SBUS channel frames.
+//
+// The position of each byte and of each value is computed at compile time,
+// so that packing and unpacking are straight loops over a layout table,
+// without the branches of a bit accumulator.
+
+template <unsigned BITS, unsigned COUNT>
+struct BitPackingLayout {
+  static_assert(BITS >= 8 && BITS <= 16, "unsupported value size");
+  static_assert(COUNT > 0 && COUNT <= 255, "unsupported value count");
+
+  static constexpr unsigned SIZE = (BITS * COUNT + 7) / 8;
+
+  // Byte made of the bits of 'value' from 'shift', followed by the bits of
+  // 'next'. 'mask' clears the padding bits of the last byte.
+  struct Byte {
+    uint8_t value;
+    uint8_t next;
+    uint8_t shift;
+    uint8_t mask;
+  };
+
+  // Value starting at bit 'shift' of bytes[0] (3 bytes at most). Bytes past
+  // the end are clamped to the last one, their bits are masked out anyway.
+  struct Value {
+    uint8_t bytes[3];
+    uint8_t shift;
+  };
+
+  Byte bytes[SIZE] = {};
+  Value values[COUNT] = {};
+
+  constexpr BitPackingLayout()
+  {
+    for (unsigned i = 0; i < SIZE; i++) {
+      unsigned value = (8 * i) / BITS;
+      unsigned available = BITS * COUNT - 8 * i;
+      bytes[i].value = value;
+      bytes[i].next = value + 1 < COUNT ? value + 1 : COUNT - 1;
+      bytes[i].shift = (8 * i) % BITS;
+      bytes[i].mask = available >= 8 ? 0xFF : (1 << available) - 1;
+    }
+    for (unsigned i = 0; i < COUNT; i++) {
+      unsigned byte = (BITS * i) / 8;
+      for (unsigned j = 0; j < 3; j++) {
+        values[i].bytes[j] = byte + j < SIZE ? byte + j : SIZE - 1;
+      }
+      values[i].shift = (BITS * i) % 8;
+    }
+  }
+};
+
+template <unsigned BITS, unsigned COUNT>
+struct BitPacking {
+  static constexpr unsigned SIZE = BitPackingLayout<BITS, COUNT>::SIZE;
+  static constexpr uint32_t MASK = (1u << BITS) - 1;
+  static constexpr BitPackingLayout<BITS, COUNT> layout = {};
+
+  // Size in bytes of 'count' packed values
+  static constexpr unsigned size(unsigned count)
+  {
+    return (BITS * count + 7) / 8;
+  }
+
+  // Values are truncated to BITS bits
+  static void pack(uint8_t* buf, const uint16_t* values)
+  {
+    for (unsigned i = 0; i < SIZE; i++) {
+      const auto& byte = layout.bytes[i];
+      uint32_t bits = ((values[byte.value] & MASK) >> byte.shift) |
+                      ((values[byte.next] & MASK) << (BITS - byte.shift));
+      buf[i] = bits & byte.mask;
+    }
+  }
+
+  // Packs the first 'count' values only, 'values' must still hold COUNT
+  // values. Returns the number of bytes written.
+  static unsigned pack(uint8_t* buf, const uint16_t* values, unsigned count)
+  {
+    unsigned len = size(count);
+    for (unsigned i = 0; i < len; i++) {
+      const auto& byte = layout.bytes[i];
+      uint32_t bits = ((values[byte.value] & MASK) >> byte.shift) |
+                      ((values[byte.next] & MASK) << (BITS - byte.shift));
+      buf[i] = bits & byte.mask;
+    }
+    if (len > 0) {
+      buf[len - 1] &= 0xFF >> ((8 * len - BITS * count) & 7);
+    }
+    return len;
+  }
+
+  static void unpack(const uint8_t* buf, uint16_t* values)
+  {
+    for (unsigned i = 0; i < COUNT; i++) {
+      const auto& value = layout.values[i];
+      uint32_t bits = buf[value.bytes[0]] | (buf[value.bytes[1]] << 8) |
+                      ((uint32_t)buf[value.bytes[2]] << 16);
+      values[i] = (bits >> value.shift) & MASK;
+    }
+  }
+};
@@ -43,6 +43,7 @@
 
 #include "tasks.h"
 #include "tasks/mixer_task.h"
+#include "mixer_scheduler.h"
 
 #include "cli.h"
 
@@ -52,6 +53,7 @@
 #include <stdarg.h>
 #include <string.h>
 
+#include "lua/custom_allocator.h"
 #include "lua/lua_states.h"
 #include "pdm_wav_recorder.h"
 
@@ -1049,6 +1051,13 @@ extern unsigned char *heap;
 
 int cliMemoryInfo(const char ** argv)
 {
+#if defined(LUA_SLAB_ALLOCATOR)
+  if (!strcmp(argv[1], "reset")) {
+    luaSlab.resetStats();
+    return 0;
+  }
+#endif
+
   // struct mallinfo {
   //   int arena;    /* total space allocated from system */
   //   int ordblks;  /* number of non-inuse chunks */
@@ -1088,11 +1097,93 @@ int cliMemoryInfo(const char ** argv)
   cliSerialPrint("------------");
   cliSerialPrint("\tTotal   %u", s + w + e);
 #endif
+#if defined(LUA_SLAB_ALLOCATOR)
+  cliSerialPrint("\nLua slab:");
+  cliSerialPrint("\tsize  slots  used   max  allocs  spills  misses");
+  for (uint8_t i = 0; i < luaSlab.classCount(); i++) {
+    const SlabAllocator::ClassStats & c = luaSlab.classStats(i);
+    cliSerialPrint("\t%4u %6u %5u %5u %7u %7u %7u", c.size, c.slots, c.used,
+                   c.maxUsed, c.allocs, c.spills, c.misses);
+  }
+  const SlabAllocator::HeapStats & h = luaSlab.heapStats();
+  cliSerialPrint("\tfree %u bytes, used %u bytes (%u wasted)",
+                 luaSlab.freeBytes(), luaSlab.usedBytes(), luaSlab.wastedBytes());
+  cliSerialPrint("\theap %u blocks, %u bytes (max %u), %u large, %u failed",
+                 h.blocks, h.bytes, h.maxBytes, h.large, h.failures);
+#endif
 #endif
   return 0;
 }
 #endif
 
+int cliSync(const char ** argv)
+{
+  bool reset = !strcmp(argv[1], "reset");
+
+  for (uint8_t i = 0; i < NUM_MODULES; i++) {
+    ModuleSyncStatus & status = getModuleSyncStatus(i);
+    if (reset) {
+      status.resetStats();
+      continue;
+    }
+    if (!status.isValid()) {
+      cliSerialPrint("Module %d: no sync", i);
+      continue;
+    }
+    cliSerialPrint("Module %d: %s", i, status.isLocked() ? "locked" : "unlocked");
+    cliSerialPrint("\trate %dus, lag %dus, offset %d/256us", status.refreshRate,
+                   status.inputLag, (int)status.periodOffset);
+    cliSerialPrint("\tphase error %dus, jitter %dus, max lag %dus",
+                   (int)status.phaseError / 16, (int)status.jitter / 16, status.maxLag);
+    cliSerialPrint("\t%d reports, %d slips, lock time %dms", status.reports,
+                   status.slips, status.lockTime * 10);
+  }
+  return 0;
+}
+
+int cliLatency(const char ** argv)
+{
+  if (!strcmp(argv[1], "reset")) {
+    resetModuleLatency();
+    return 0;
+  }
+
+  for (uint8_t i = 0; i < NUM_MODULES; i++) {
+    const ModuleLatency & latency = getModuleLatency(i);
+    if (!latency.frames) {
+      cliSerialPrint("Module %d: no frame", i);
+      continue;
+    }
+    cliSerialPrint("Module %d: period %dus, %d frames", i,
+                   mixerSchedulerGetPeriod(i), (int)latency.frames);
+    cliSerialPrint("\tlatency %dus, min %dus, avg %dus, max %dus", latency.last,
+                   latency.lowest, latency.average(), latency.highest);
+  }
+  return 0;
+}
+
+#if defined(LUA)
+int cliLuaStats(const char ** argv)
+{
+  if (!strcmp(argv[1], "reset")) {
+    luaResetScriptStats();
+    return 0;
+  }
+
+  cliSerialPrint("#  name      runs  last(us)   max(us)  gc(us)  alloc(B)  instr  prmt  ovr");
+  for (int i = 0; i < luaScriptsCount; i++) {
+    const ScriptInternalData & sid = scriptInternalData[i];
+    const ScriptStats & stats = sid.stats;
+    cliSerialPrint("%-2d %-8.*s %5u %9u %9u %7u %9u %6u %5u %4u%s", i,
+                   LEN_SCRIPT_FILENAME, luaGetScriptName(i), stats.runs,
+                   stats.lastTime, stats.maxTime, stats.maxGcTime,
+                   stats.maxAlloc, stats.instructions, stats.preemptions,
+                   stats.overruns, sid.state == SCRIPT_OK ? "" : " (error)");
+  }
+  return 0;
+}
+#endif
+
 int cliReboot(const char ** argv)
 {
 #if !defined(SIMU)
@@ -1864,7 +1955,9 @@ const CliCommand cliCommands[] = {
   { "print", cliDisplay, "<address> [<size>] | <what>" },
   { "p", cliDisplay, "<address> [<size>] | <what>" },
   { "stackinfo", cliStackInfo, "" },
-  { "meminfo", cliMemoryInfo, "" },
+  { "meminfo", cliMemoryInfo, "[reset]" },
+  { "sync", cliSync, "[reset]" },
+  { "latency", cliLatency, "[reset]" },
   { "test", cliTest, "new | graphics | memspd" },
   { "trace", cliTrace, "on | off" },
   { "debugvars", cliDebugVars, "" },
@@ -1872,6 +1965,9 @@ const CliCommand cliCommands[] = {
   { "testfatfs", cliTestFatFsSD, "" },
 #endif
   { "help", cliHelp, "[<command>]" },
+#if defined(LUA)
+  { "luastats", cliLuaStats, "[reset]" },
+#endif
 #if defined(JITTER_MEASURE)
   { "jitter", cliShowJitter, "" },
 #endif
@@ -692,6 +692,24 @@ enum ModelOverridableEnable {
   OVERRIDE_ON
 };
 
+// Filter applied to the analog inputs
+enum AdcFilter {
+  ADCFILTER_MMA,
+  ADCFILTER_ONE_EURO,
+  ADCFILTER_KALMAN
+};
+
+// Model ADC filter: the first values match ModelOverridableEnable
+// ("ON" is the filter selected in the radio settings)
+enum ModelAdcFilter {
+  MDLFILTER_GLOBAL,
+  MDLFILTER_OFF,
+  MDLFILTER_ON,
+  MDLFILTER_MMA,
+  MDLFILTER_ONE_EURO,
+  MDLFILTER_KALMAN
+};
+
 #define SELECTED_THEME_NAME_LEN 26
 
 // PPM Units
@@ -807,8 +807,7 @@ PACK(struct ModelData {
 
   uint8_t thrTrimSw:3;
   uint8_t potsWarnMode:2 ENUM(PotsWarnMode);
-  NOBACKUP(uint8_t jitterFilter:2 ENUM(ModelOverridableEnable));
-  uint8_t spare1:1 SKIP;
+  NOBACKUP(uint8_t jitterFilter:3 ENUM(ModelAdcFilter));
 
   ModuleData moduleData[NUM_MODULES];
   int16_t failsafeChannels[MAX_OUTPUT_CHANNELS];
@@ -1164,12 +1163,15 @@ PACK(struct RadioData {
   // Radio level tabs control (global settings)
   NOBACKUP(uint8_t modelSelectLayout:2);
   NOBACKUP(uint8_t radioThemesDisabled:1);
-  NOBACKUP(uint8_t spare:7 SKIP);
+  NOBACKUP(uint8_t adcFilter:2 ENUM(AdcFilter));
+  NOBACKUP(uint8_t spare:5 SKIP);
 #elif LCD_W == 128
   uint8_t invertLCD:1;          // Invert B&W LCD display
-  NOBACKUP(uint8_t spare:4 SKIP);
+  NOBACKUP(uint8_t adcFilter:2 ENUM(AdcFilter));
+  NOBACKUP(uint8_t spare:2 SKIP);
 #else
-  NOBACKUP(uint8_t spare:5 SKIP);
+  NOBACKUP(uint8_t adcFilter:2 ENUM(AdcFilter));
+  NOBACKUP(uint8_t spare:3 SKIP);
 #endif
 
   NOBACKUP(uint8_t pwrOffIfInactive);
@@ -172,13 +172,17 @@ const char * const debugTimerNames[DEBUG_TIMERS_COUNT] = {
   ,"Mix getsw  "   // debugTimerGetSwitches
   ,"Mix eval   "   // debugTimerEvalMixes
   ,"Mix 10ms   "   // debugTimerMixes10ms
+  ,"Mix funcs  "   // debugTimerFunctions
   ,"ADC read   "   // debugTimerAdcRead
   ,"mix-pulses "   // debugTimerMixerCalcToUsage
   ,"mix-int.   "   // debugTimerMixerIterval
   ,"Audio int. "   // debugTimerAudioIterval
   ,"Audio dur. "   // debugTimerAudioDuration
   ," A. consume"   // debugTimerAudioConsume
+  ,"YAML scan  "   // debugTimerYamlScan
+#if defined(SPACEMOUSE)
   ,"SpaceMouse "   // debugTimerSpaceMouseWakeup
+#endif
 };
 
 #endif
@@ -379,6 +379,7 @@ enum DebugTimers {
   debugTimerGetSwitches,
   debugTimerEvalMixes,
   debugTimerMixes10ms,
+  debugTimerFunctions,
 
   debugTimerAdcRead,
 
@@ -185,4 +185,6 @@ const etx_imu_driver_t imu_icm42607_driver = {
   gyro42607Init,
   gyro42607Read,
   "ICM42607",
+  60976,  // +/-2000 dps
+  {-1, -1, 1},  // gyro X/Y read negated, not the accelerometer
 };
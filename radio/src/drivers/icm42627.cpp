@@ -218,4 +218,6 @@ const etx_imu_driver_t imu_icm42627_driver = {
   gyro42627Init,
   gyro42627Read,
   "ICM42627",
+  60976,  // +/-2000 dps
+  {1, 1, 1},  // remapped like the accelerometer
 };
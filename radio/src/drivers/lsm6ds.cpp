@@ -263,5 +263,7 @@ const etx_imu_driver_t imu_lsm6ds_driver = {
   lsm6dsInit,
   lsm6dsRead,
   "LSM6DS",
+  8750,   // +/-245 dps
+  {1, 1, 1},
 };
 
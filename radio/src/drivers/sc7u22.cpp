@@ -238,4 +238,6 @@ const etx_imu_driver_t imu_sc7u22_driver = {
   gyroSC7U22Init,
   gyroSC7U22Read,
   "SC7U22",
+  61035,  // +/-2000 dps
+  {-1, -1, 1},  // gyro X/Y read negated, not the accelerometer
 };
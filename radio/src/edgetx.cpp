@@ -93,6 +93,7 @@ Clipboard clipboard;
 GlobalData globalData;
 
 uint32_t maxMixerDuration; // microseconds
+uint32_t mixerSampleTime; // microseconds
 
 constexpr uint8_t HEART_TIMER_10MS = 0x01;
 uint8_t heartbeat;
@@ -116,15 +117,14 @@ void toggleLatencySwitch()
   latencyToggleSwitch ^= 1;
 
 #if defined(PCBHORUS)
+#if !defined(SIMU)
   if (latencyToggleSwitch)
     gpio_clear(EXTMODULE_TX_GPIO);
   else
     gpio_set(EXTMODULE_TX_GPIO);
+#endif
 #else
-  if (latencyToggleSwitch)
-    sportUpdatePowerOn();
-  else
-    sportUpdatePowerOff();
+  modulePortSetPower(SPORT_MODULE, latencyToggleSwitch);
 #endif
 }
 #endif
@@ -154,14 +154,28 @@ struct CustomFunctionsContext {
   MASK_CFN_TYPE  activeSwitches;
   tmr10ms_t lastFunctionTime[MAX_SPECIAL_FUNCTIONS];
 
+  // Configured functions, in slot order. Functions with the same trigger
+  // point to the first of them (indexGroup), so that it is evaluated once.
+  uint8_t indexCount;
+  uint8_t indexSlot[MAX_SPECIAL_FUNCTIONS];
+  uint8_t indexGroup[MAX_SPECIAL_FUNCTIONS];
+  bool indexDirty;
+
   inline bool isFunctionActive(uint8_t func)
   {
     return activeFunctions & ((MASK_FUNC_TYPE)1 << func);
   }
 
+  // To be called once the functions are edited or loaded
+  void invalidateIndex()
+  {
+    indexDirty = true;
+  }
+
   void reset()
   {
     memclear(this, sizeof(*this));
+    invalidateIndex();
   }
 };
 
@@ -445,6 +459,13 @@ inline bool isFunctionActive(uint8_t func)
   return globalFunctionsContext.isFunctionActive(func) || modelFunctionsContext.isFunctionActive(func);
 }
 void evalFunctions(CustomFunctionData * functions, CustomFunctionsContext & functionsContext);
+// To be called once the special (EE_MODEL) or global (EE_GENERAL) functions
+// have been edited
+inline void invalidateFunctionsIndex(uint8_t eeFlags)
+{
+  if (eeFlags & EE_MODEL) modelFunctionsContext.invalidateIndex();
+  if (eeFlags & EE_GENERAL) globalFunctionsContext.invalidateIndex();
+}
 inline void customFunctionsReset()
 {
   globalFunctionsContext.reset();
@@ -849,6 +870,7 @@ enum JackMode {
 
 #if defined(DEBUG_LATENCY)
 extern uint8_t latencyToggleSwitch;
+void toggleLatencySwitch();
 #endif
 
 #include "module.h"
@@ -161,6 +161,43 @@ bool isRepeatDelayElapsed(const CustomFunctionData * functions, CustomFunctionsC
   }
 }
 
+static uint8_t getFunctionSwitchFlags(const CustomFunctionData * cfn)
+{
+  return IS_PLAY_FUNC(CFN_FUNC(cfn)) ? GETSWITCH_MIDPOS_DELAY : 0;
+}
+
+static void buildFunctionsIndex(const CustomFunctionData * functions, CustomFunctionsContext & functionsContext)
+{
+  uint8_t count = 0;
+
+  for (uint8_t i=0; i<MAX_SPECIAL_FUNCTIONS; i++) {
+    const CustomFunctionData * cfn = &functions[i];
+    if (CFN_EMPTY(cfn))
+      continue;
+
+    uint8_t group = count;
+    for (uint8_t n=0; n<count; n++) {
+      const CustomFunctionData * first = &functions[functionsContext.indexSlot[n]];
+      if (CFN_SWITCH(first) == CFN_SWITCH(cfn) &&
+          getFunctionSwitchFlags(first) == getFunctionSwitchFlags(cfn)) {
+        group = n;
+        break;
+      }
+    }
+
+    // inactive functions are only visited on their falling edge, which
+    // resets their repeat delay: make sure it is reset for new ones
+    if (!(functionsContext.activeSwitches & ((MASK_CFN_TYPE)1 << i)))
+      functionsContext.lastFunctionTime[i] = 0;
+
+    functionsContext.indexSlot[count] = i;
+    functionsContext.indexGroup[count] = group;
+    count++;
+  }
+
+  functionsContext.indexCount = count;
+}
+
 void evalFunctions(CustomFunctionData * functions, CustomFunctionsContext & functionsContext)
 {
   MASK_FUNC_TYPE newActiveFunctions  = 0;
@@ -188,15 +225,31 @@ void evalFunctions(CustomFunctionData * functions, CustomFunctionsContext & func
   bool videoEnabled = false;
 #endif
 
-  for (uint8_t i=0; i<MAX_SPECIAL_FUNCTIONS; i++) {
+  // cleared before the build: an edit made meanwhile marks it dirty again
+  if (functionsContext.indexDirty) {
+    functionsContext.indexDirty = false;
+    buildFunctionsIndex(functions, functionsContext);
+  }
+
+  // switch state of each function, shared by the functions of its group
+  int8_t states[MAX_SPECIAL_FUNCTIONS];
+
+  for (uint8_t n=0; n<functionsContext.indexCount; n++) {
+    uint8_t i = functionsContext.indexSlot[n];
     CustomFunctionData * cfn = &functions[i];
     swsrc_t swtch = CFN_SWITCH(cfn);
+    states[n] = -1;
     if (swtch) {
       MASK_CFN_TYPE switch_mask = ((MASK_CFN_TYPE)1 << i);
 
-      bool active = getSwitch(swtch, IS_PLAY_FUNC(CFN_FUNC(cfn)) ? GETSWITCH_MIDPOS_DELAY : 0);
-      if (CFN_ACTIVE(cfn) == 0)
-        active = false;
+      if (CFN_ACTIVE(cfn)) {
+        uint8_t group = functionsContext.indexGroup[n];
+        if (group != n && states[group] >= 0)
+          states[n] = states[group];
+        else
+          states[n] = getSwitch(swtch, getFunctionSwitchFlags(cfn));
+      }
+      bool active = states[n] > 0;
 
       if (active) {
         switch (CFN_FUNC(cfn)) {
@@ -477,19 +530,21 @@ void evalFunctions(CustomFunctionData * functions, CustomFunctionsContext & func
           }
         }
 #endif
+      }
+
+      // falling edge: nothing to do for functions which stay inactive
+      if (!active && (functionsContext.activeSwitches & switch_mask)) {
         functionsContext.lastFunctionTime[i] = 0;
 #if defined(DANGEROUS_MODULE_FUNCTIONS)
-        if (functionsContext.activeSwitches & switch_mask) {
-          switch (CFN_FUNC(cfn)) {
-            case FUNC_RANGECHECK:
-            case FUNC_BIND:
-            {
-              unsigned int moduleIndex = CFN_PARAM(cfn);
-              if (moduleIndex < NUM_MODULES) {
-                moduleState[moduleIndex].mode = 0;
-              }
-              break;
+        switch (CFN_FUNC(cfn)) {
+          case FUNC_RANGECHECK:
+          case FUNC_BIND:
+          {
+            unsigned int moduleIndex = CFN_PARAM(cfn);
+            if (moduleIndex < NUM_MODULES) {
+              moduleState[moduleIndex].mode = 0;
             }
+            break;
           }
         }
 #endif
@@ -48,6 +48,7 @@ extern uint8_t trimsCheckTimer;
 extern uint8_t trimsDisplayTimer;
 extern uint8_t trimsDisplayMask;
 extern uint32_t maxMixerDuration;
+extern uint32_t mixerSampleTime;
 
 #if defined(AUDIO)
 extern uint8_t requiredSpeakerVolume;
@@ -183,6 +183,7 @@ void menuModelFlightModeOne(event_t event)
           if (checkIncDec_Ret) {
             if (v == GVAR_MAX) v = 0;
             fm->gvars[idx] = v;
+            invalidateGVarFlightModes();
           }
         }
         editGVarValue(17*FW, y, event, idx, getGVarFlightMode(s_currIdx, idx), posHorz==2 ? attr : 0);
@@ -801,6 +801,11 @@ static void menuModelCFSOne(event_t event)
 
 void menuModelSetup(event_t event)
 {
+  // a timer setting edited on the previous refresh is stored by now
+  if (checkIncDec_Ret) {
+    invalidateTimersConfig();
+  }
+
   int8_t old_editMode = s_editMode;
   bool CURSOR_ON_CELL = (menuHorizontalPosition >= 0);
 
@@ -1407,7 +1412,7 @@ void menuModelSetup(event_t event)
       } break;
 
       case ITEM_MODEL_SETUP_USE_JITTER_FILTER:
-        g_model.jitterFilter = editChoice(MODEL_SETUP_2ND_COLUMN, y, STR_JITTER_FILTER, STR_ADCFILTERVALUES, g_model.jitterFilter, 0, 2, attr, event);
+        g_model.jitterFilter = editChoice(MODEL_SETUP_2ND_COLUMN, y, STR_JITTER_FILTER, STR_MODEL_ADCFILTERS, g_model.jitterFilter, 0, MDLFILTER_KALMAN, attr, event);
         break;
 
 
@@ -1855,7 +1860,7 @@ void menuModelSetup(event_t event)
               CHECK_INCDEC_MODELVAR_ZERO(event, moduleData.channelsStart, 32-8-moduleData.channelsCount);
               break;
             case 1:
-              CHECK_INCDEC_MODELVAR_CHECK(event, moduleData.channelsCount, -4, min<int8_t>(maxModuleChannels_M8(moduleIdx), 32-8-moduleData.channelsStart), moduleData.type == MODULE_TYPE_ISRM_PXX2 ? isPxx2IsrmChannelsCountAllowed : nullptr);
+              CHECK_INCDEC_MODELVAR_CHECK(event, moduleData.channelsCount, max<int8_t>(-4, minModuleChannels(moduleIdx) - 8), min<int8_t>(maxModuleChannels_M8(moduleIdx), 32-8-moduleData.channelsStart), moduleData.type == MODULE_TYPE_ISRM_PXX2 ? isPxx2IsrmChannelsCountAllowed : nullptr);
               if (checkIncDec_Ret && moduleData.type == MODULE_TYPE_PPM) {
                 setDefaultPpmFrameLength(moduleIdx);
               }
@@ -135,20 +135,24 @@ void onCustomFunctionsMenu(const char * result)
   else if (result == STR_PASTE) {
     *cfn = clipboard.data.cfn;
     storageDirty(eeFlags);
+    invalidateFunctionsIndex(eeFlags);
   }
   else if (result == STR_CLEAR) {
     memset(cfn, 0, sizeof(CustomFunctionData));
     storageDirty(eeFlags);
+    invalidateFunctionsIndex(eeFlags);
   }
   else if (result == STR_INSERT) {
     memmove(cfn+1, cfn, (MAX_SPECIAL_FUNCTIONS-sub-1)*sizeof(CustomFunctionData));
     memset(cfn, 0, sizeof(CustomFunctionData));
     storageDirty(eeFlags);
+    invalidateFunctionsIndex(eeFlags);
   }
   else if (result == STR_DELETE) {
     memmove(cfn, cfn+1, (MAX_SPECIAL_FUNCTIONS-sub-1)*sizeof(CustomFunctionData));
     memset(&g_model.customFn[MAX_SPECIAL_FUNCTIONS-1], 0, sizeof(CustomFunctionData));
     storageDirty(eeFlags);
+    invalidateFunctionsIndex(eeFlags);
   }
 }
 #endif // PCBTARANIS
@@ -544,6 +548,11 @@ void menuSpecialFunctions(event_t event, CustomFunctionData * functions, CustomF
     }
 #endif
   }
+
+  // the field being edited has been stored above
+  if (s_editMode > 0) {
+    invalidateFunctionsIndex(eeFlags);
+  }
 }
 
 void menuModelSpecialFunctions(event_t event)
@@ -122,6 +122,13 @@ void menuRadioDiagAnalogs(event_t event)
 #if defined(IMU)
   y += FH;
   lcdDrawTextAlignedLeft(y, STR_IMU);
+  uint8_t inverted = gyroInvertedAxes();
+  if (inverted) {
+    lcdDrawText(LCD_W / 2 + INDENT_WIDTH, y, STR_IMU_GYRO_INVERTED);
+    for (uint8_t i = 0; i < 3; i++) {
+      if (inverted & (1 << i)) lcdDrawChar(lcdNextPos + 1, y, 'X' + i);
+    }
+  }
   y += FH;
   uint8_t x = INDENT_WIDTH;
   lcdDrawText(x, y, "X:");
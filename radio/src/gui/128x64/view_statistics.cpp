@@ -25,6 +25,10 @@
 #include "mixer_scheduler.h"
 #include "tasks/mixer_task.h"
 
+#if defined(DEBUG_LATENCY)
+#include "heartbeat_driver.h"
+#endif
+
 #include "hal/adc_driver.h"
 
 #if defined(BLUETOOTH)
@@ -124,8 +128,10 @@ void menuStatisticsDebug(event_t event)
 #if defined(LUA)
       maxLuaInterval = 0;
       maxLuaDuration = 0;
+      luaResetScriptStats();
 #endif
       maxMixerDuration  = 0;
+      resetModuleSyncStats();
       break;
 
     case EVT_KEY_FIRST(KEY_UP):
@@ -189,6 +195,21 @@ void menuStatisticsDebug(event_t event)
   y += FH;
 #endif
 
+  // Module synchronization: filtered phase error / jitter
+  lcdDrawTextAlignedLeft(y, STR_SYNC);
+  int8_t syncModule = getSyncedModule();
+  if (syncModule >= 0) {
+    const ModuleSyncStatus & status = getModuleSyncStatus(syncModule);
+    lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, status.phaseError / 16, LEFT);
+    lcdDrawText(lcdLastRightPos, y, "/");
+    lcdDrawNumber(lcdLastRightPos, y, status.jitter / 16, LEFT);
+    lcdDrawText(lcdLastRightPos, y, "us");
+  }
+  else {
+    lcdDrawText(MENU_DEBUG_COL1_OFS, y, "---");
+  }
+  y += FH;
+
   lcdDrawText(LCD_W/2, 7*FH+1, STR_MENUTORESET, CENTERED);
   lcdInvertLastLine();
 }
@@ -198,9 +219,9 @@ void menuStatisticsDebug2(event_t event)
   title(STR_MENUDEBUG);
 
   switch(event) {
-    // case EVT_KEY_BREAK(KEY_ENTER):
-    //   telemetryErrors  = 0;
-    //   break;
+    case EVT_KEY_BREAK(KEY_ENTER):
+      resetModuleLatency();
+      break;
 
     case EVT_KEY_FIRST(KEY_UP):
     case EVT_KEY_BREAK(KEY_PAGEDN):
@@ -221,6 +242,20 @@ void menuStatisticsDebug2(event_t event)
 
   // lcdDrawTextAlignedLeft(y, "Tlm RX Err");
   // lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, telemetryErrors, RIGHT);
+
+  // Stick-to-UART latency: average of each module
+  lcdDrawTextAlignedLeft(y, STR_RF_LATENCY);
+  coord_t x = MENU_DEBUG_COL1_OFS;
+  for (uint8_t i = 0; i < NUM_MODULES; i++) {
+    const ModuleLatency & latency = getModuleLatency(i);
+    if (!latency.frames) continue;
+    lcdDrawNumber(x, y, latency.average(), LEFT);
+    lcdDrawText(lcdLastRightPos, y, "us");
+    x = lcdLastRightPos + FW;
+  }
+  if (x == MENU_DEBUG_COL1_OFS) {
+    lcdDrawText(x, y, "---");
+  }
   y += FH;
 
 #if defined(BLUETOOTH)
@@ -229,6 +264,18 @@ void menuStatisticsDebug2(event_t event)
   y += FH;
 #endif
 
+#if defined(LUA)
+  // Lua scripts accounting: max duration and CPU budget used
+  for (int i = 0; i < luaScriptsCount && y < 7*FH; i++, y += FH) {
+    const ScriptStats & stats = scriptInternalData[i].stats;
+    lcdDrawSizedText(0, y, luaGetScriptName(i), LEN_SCRIPT_FILENAME, 0);
+    lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, stats.maxTime / 10, PREC2|LEFT);
+    lcdDrawText(lcdLastRightPos, y, STR_MS);
+    lcdDrawNumber(LCD_W - FW, y, scriptInternalData[i].instructions, RIGHT);
+    lcdDrawChar(LCD_W - FW, y, '%');
+  }
+#endif
+
   lcdDrawText(LCD_W/2, 7*FH+1, STR_MENUTORESET, CENTERED);
   lcdInvertLastLine();
 }
@@ -107,6 +107,7 @@ void onGVARSMenu(const char * result)
     for (int i=0; i<MAX_FLIGHT_MODES; i++) {
       g_model.flightModeData[i].gvars[sub] = 0;
     }
+    invalidateGVarFlightModes();
     storageDirty(EE_MODEL);
   }
 }
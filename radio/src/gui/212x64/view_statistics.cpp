@@ -25,6 +25,10 @@
 #include "tasks.h"
 #include "tasks/mixer_task.h"
 
+#if defined(DEBUG_LATENCY)
+#include "heartbeat_driver.h"
+#endif
+
 #define STATS_1ST_COLUMN               FW/2
 #define STATS_2ND_COLUMN               12*FW+FW/2
 #define STATS_3RD_COLUMN               24*FW+FW/2
@@ -132,8 +136,10 @@ void menuStatisticsDebug(event_t event)
 #if defined(LUA)
       maxLuaInterval = 0;
       maxLuaDuration = 0;
+      luaResetScriptStats();
 #endif
       maxMixerDuration  = 0;
+      resetModuleSyncStats();
       break;
 
     case EVT_KEY_BREAK(KEY_PLUS):
@@ -208,6 +214,23 @@ void menuStatisticsDebug(event_t event)
   y += FH;
 #endif
 
+  // Module synchronization: filtered phase error / jitter
+  lcdDrawTextAlignedLeft(y, STR_SYNC);
+  int8_t syncModule = getSyncedModule();
+  if (syncModule >= 0) {
+    const ModuleSyncStatus & status = getModuleSyncStatus(syncModule);
+    lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, status.phaseError / 16, LEFT);
+    lcdDrawText(lcdLastRightPos, y, "/");
+    lcdDrawNumber(lcdLastRightPos, y, status.jitter / 16, LEFT);
+    lcdDrawText(lcdLastRightPos, y, "us");
+    lcdDrawText(lcdLastRightPos+FW, y, "S");
+    lcdDrawNumber(lcdLastRightPos, y, status.slips, LEFT);
+  }
+  else {
+    lcdDrawText(MENU_DEBUG_COL1_OFS, y, "---");
+  }
+  y += FH;
+
   lcdDrawText(LCD_W/2, 7*FH+1, STR_MENUTORESET, CENTERED);
   lcdInvertLastLine();
 }
@@ -234,12 +257,48 @@ void menuStatisticsDebug2(event_t event)
     case EVT_KEY_BREAK(KEY_EXIT):
       chainMenu(menuMainView);
       break;
+
+    case EVT_KEY_BREAK(KEY_ENTER):
+      resetModuleLatency();
+      break;
   }
 
   // UART statistics
   // lcdDrawTextAlignedLeft(MENU_DEBUG_ROW1, "Tlm RX Err");
   // lcdDrawNumber(MENU_DEBUG_COL1_OFS, MENU_DEBUG_ROW1, telemetryErrors, RIGHT);
 
+  // Stick-to-UART latency of each module: average / max
+  lcdDrawTextAlignedLeft(MENU_DEBUG_ROW1, STR_RF_LATENCY);
+  coord_t x = MENU_DEBUG_COL1_OFS;
+  for (uint8_t i = 0; i < NUM_MODULES; i++) {
+    const ModuleLatency & latency = getModuleLatency(i);
+    if (!latency.frames) continue;
+    lcdDrawNumber(x, MENU_DEBUG_ROW1, latency.average(), LEFT);
+    lcdDrawText(lcdLastRightPos, MENU_DEBUG_ROW1, "/");
+    lcdDrawNumber(lcdLastRightPos, MENU_DEBUG_ROW1, latency.highest, LEFT);
+    lcdDrawText(lcdLastRightPos, MENU_DEBUG_ROW1, "us");
+    x = lcdLastRightPos + 2*FW;
+  }
+  if (x == MENU_DEBUG_COL1_OFS) {
+    lcdDrawText(x, MENU_DEBUG_ROW1, "---");
+  }
+
+#if defined(LUA)
+  // Lua scripts accounting: max duration, GC, CPU budget used and overruns
+  coord_t y = MENU_DEBUG_ROW2;
+  for (int i = 0; i < luaScriptsCount && y < 7*FH; i++, y += FH) {
+    const ScriptStats & stats = scriptInternalData[i].stats;
+    lcdDrawSizedText(0, y, luaGetScriptName(i), LEN_SCRIPT_FILENAME, 0);
+    lcdDrawNumber(MENU_DEBUG_COL1_OFS, y, stats.maxTime / 10, PREC2|LEFT);
+    lcdDrawText(lcdLastRightPos, y, STR_MS);
+    lcdDrawText(lcdLastRightPos+FW, y, STR_LUA_GC);
+    lcdDrawNumber(lcdLastRightPos, y, stats.maxGcTime / 10, PREC2|LEFT);
+    lcdDrawNumber(LCD_W - 5*FW, y, scriptInternalData[i].instructions, RIGHT);
+    lcdDrawChar(LCD_W - 5*FW, y, '%');
+    lcdDrawNumber(LCD_W, y, stats.overruns, RIGHT);
+  }
+#endif
+
   lcdDrawText(LCD_W/2, 7*FH+1, STR_MENUTORESET, CENTERED);
   lcdInvertLastLine();
 }
@@ -31,6 +31,10 @@
 #include "tasks.h"
 #include "tasks/mixer_task.h"
 
+#if defined(DEBUG_LATENCY)
+#include "heartbeat_driver.h"
+#endif
+
 static const lv_coord_t col_dsc[] = {LV_GRID_FR(1), LV_GRID_FR(1),
                                      LV_GRID_FR(1), LV_GRID_FR(1),
                                      LV_GRID_TEMPLATE_LAST};
@@ -247,6 +251,42 @@ void DebugViewPage::build(Window* window)
   line = window->newLine(grid);
   line->padAll(PAD_TINY);
 
+  // Module synchronization: filtered phase error, jitter and slips
+  new StaticText(line, rect_t{}, STR_SYNC);
+  new DynamicText(line, rect_t{}, [] {
+    int8_t module = getSyncedModule();
+    if (module < 0) return std::string("---");
+    const ModuleSyncStatus& status = getModuleSyncStatus(module);
+    char s[48];
+    snprintf(s, sizeof(s), "%d/%dus, %d ", (int)status.phaseError / 16,
+             (int)status.jitter / 16, status.slips);
+    std::string text = std::string(s) + STR_SYNC_SLIPS;
+    if (!status.isLocked())
+      text += std::string(" (") + STR_SYNC_UNLOCKED + ")";
+    return text;
+  });
+
+  line = window->newLine(grid);
+  line->padAll(PAD_TINY);
+
+  // Stick-to-UART latency of each module: average / max
+  new StaticText(line, rect_t{}, STR_RF_LATENCY);
+  new DynamicText(line, rect_t{}, [] {
+    std::string s;
+    for (uint8_t i = 0; i < NUM_MODULES; i++) {
+      const ModuleLatency& latency = getModuleLatency(i);
+      if (!latency.frames) continue;
+      char buf[24];
+      snprintf(buf, sizeof(buf), "%s%d/%dus", s.empty() ? "" : ", ",
+               latency.average(), latency.highest);
+      s += buf;
+    }
+    return s.empty() ? std::string("---") : s;
+  });
+
+  line = window->newLine(grid);
+  line->padAll(PAD_TINY);
+
   // Free mem
   static std::string pad_STR_BYTES = " " + std::string(STR_BYTES);
   new StaticText(line, rect_t{}, STR_FREE_MEM_LABEL);
@@ -297,6 +337,48 @@ void DebugViewPage::build(Window* window)
   new DebugInfoNumber<uint32_t>(
       line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
       [] { return luaExtraMemoryUsage; }, STR_MEM_USED_EXTRA);
+
+  line = window->newLine(grid);
+  line->padAll(PAD_ZERO);
+#if PORTRAIT
+  line->padLeft(PAD_LARGE);
+#else
+  grid.nextCell();
+#endif
+
+  // Script using the most CPU time
+  new DynamicText(line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT}, [] {
+    int idx = luaGetGreediestScript();
+    if (idx < 0) return std::string("---");
+    const char* name = luaGetScriptName(idx);
+    return std::string(name, strnlen(name, LEN_SCRIPT_FILENAME));
+  });
+  new DebugInfoNumber<uint32_t>(
+      line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+      [] {
+        int idx = luaGetGreediestScript();
+        return idx < 0 ? 0 : scriptInternalData[idx].stats.maxTime;
+      },
+      STR_LUA_MAX_US);
+#if PORTRAIT
+  line = window->newLine(grid);
+  line->padAll(PAD_ZERO);
+  line->padLeft(PAD_LARGE);
+#endif
+  new DebugInfoNumber<uint32_t>(
+      line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+      [] {
+        int idx = luaGetGreediestScript();
+        return idx < 0 ? 0 : scriptInternalData[idx].stats.maxGcTime;
+      },
+      STR_LUA_GC_US);
+  new DebugInfoNumber<uint16_t>(
+      line, rect_t{0, 0, DBG_B_WIDTH, DBG_B_HEIGHT},
+      [] {
+        int idx = luaGetGreediestScript();
+        return idx < 0 ? 0 : scriptInternalData[idx].stats.overruns;
+      },
+      STR_LUA_OVERRUNS);
 #endif
 
   line = window->newLine(grid);
@@ -366,9 +448,12 @@ void DebugViewPage::build(Window* window)
   auto btn = new TextButton(line, rect_t{0, 0, 0, RST_BTN_H}, STR_MENUTORESET,
                             [=]() -> uint8_t {
                               maxMixerDuration = 0;
+                              resetModuleSyncStats();
+                              resetModuleLatency();
 #if defined(LUA)
                               maxLuaInterval = 0;
                               maxLuaDuration = 0;
+                              luaResetScriptStats();
 #endif
                               return 0;
                             });
@@ -489,6 +489,7 @@ class GVarEditWindow : public Page
             line, rect_t{}, [=] { return fmData->gvars[index] <= GVAR_MAX; },
             [=](uint8_t checked) {
               fmData->gvars[index] = checked ? 0 : GVAR_MAX + 1;
+              invalidateGVarFlightModes();
               SET_DIRTY();
               setProperties(flightMode);
             });
@@ -499,7 +500,11 @@ class GVarEditWindow : public Page
 
       values[flightMode] = new NumberEdit(
           line, rect_t{}, GVAR_MIN + gvar->min, GVAR_MAX + MAX_FLIGHT_MODES - 1,
-          GET_SET_DEFAULT(fmData->gvars[index]));
+          GET_DEFAULT(fmData->gvars[index]), [=](int32_t newValue) {
+            fmData->gvars[index] = newValue;
+            if (newValue > GVAR_MAX) invalidateGVarFlightModes();
+            SET_DIRTY();
+          });
       values[flightMode]->setAccelFactor(16);
       line = window->newLine(grid);
     }
@@ -554,12 +559,14 @@ void ModelGVarsPage::build(Window* window)
       menu->addLine(STR_CLEAR, [=]() {
         for (auto& flightMode : g_model.flightModeData)
           flightMode.gvars[index] = 0;
+        invalidateGVarFlightModes();
         SET_DIRTY();
       });
       menu->addLine(STR_SF_RESET, [=]() {
         for (auto& flightMode : g_model.flightModeData)
           flightMode.gvars[index] = GVAR_MAX + 1;
         g_model.flightModeData[0].gvars[index] = 0;
+        invalidateGVarFlightModes();
         SET_DIRTY();
       });
       return 0;
@@ -260,7 +260,7 @@ const static SetupLineDef otherPageSetupLines[] = {
   {
     STR_DEF(STR_JITTER_FILTER),
     [](Window* parent, coord_t x, coord_t y) {
-      new Choice(parent, {x, y, 0, 0}, STR_ADCFILTERVALUES, 0, 2,
+      new Choice(parent, {x, y, 0, 0}, STR_MODEL_ADCFILTERS, 0, MDLFILTER_KALMAN,
                 GET_SET_DEFAULT(g_model.jitterFilter));
     }
   },
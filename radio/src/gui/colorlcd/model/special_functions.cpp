@@ -745,7 +745,7 @@ void FunctionsPage::pasteSpecialFunction(Window *window, uint8_t index,
   if (CFN_FUNC(cfn) == FUNC_PLAY_SCRIPT) LUA_LOAD_MODEL_SCRIPTS();
   *cfn = clipboard.data.cfn;
   if (CFN_FUNC(cfn) == FUNC_PLAY_SCRIPT) LUA_LOAD_MODEL_SCRIPTS();
-  storageDirty(EE_MODEL);
+  setDirty();
   focusIndex = index;
   if (!button)
     rebuild(window);
@@ -849,6 +849,7 @@ void FunctionsPage::build(Window *window)
                         (MAX_SPECIAL_FUNCTIONS - i - 1) *
                             sizeof(CustomFunctionData));
                 memset(cfn, 0, sizeof(CustomFunctionData));
+                SET_DIRTY();
                 editSpecialFunction(window, i, nullptr);
               });
               break;
@@ -965,7 +966,11 @@ class SpecialFunctionEditPage : public FunctionEditPage
     return ::isAssignableFunctionAvailable(function, true);
   }
 
-  void setDirty() const override { storageDirty(EE_MODEL); }
+  void setDirty() const override
+  {
+    storageDirty(EE_MODEL);
+    invalidateFunctionsIndex(EE_MODEL);
+  }
 };
 
 //-----------------------------------------------------------------------------
@@ -993,7 +998,11 @@ FunctionLineButton *SpecialFunctionsPage::functionButton(Window *parent,
   return new SpecialFunctionLineButton(parent, rect, index);
 }
 
-void SpecialFunctionsPage::setDirty() const { storageDirty(EE_MODEL); }
+void SpecialFunctionsPage::setDirty() const
+{
+  storageDirty(EE_MODEL);
+  invalidateFunctionsIndex(EE_MODEL);
+}
 
 //-----------------------------------------------------------------------------
 
@@ -1045,7 +1054,11 @@ class GlobalFunctionEditPage : public FunctionEditPage
     return ::isAssignableFunctionAvailable(function, false);
   }
 
-  void setDirty() const override { storageDirty(EE_GENERAL); }
+  void setDirty() const override
+  {
+    storageDirty(EE_GENERAL);
+    invalidateFunctionsIndex(EE_GENERAL);
+  }
 };
 
 //-----------------------------------------------------------------------------
@@ -1072,4 +1085,8 @@ FunctionLineButton *GlobalFunctionsPage::functionButton(Window *parent,
   return new GlobalFunctionLineButton(parent, rect, index);
 }
 
-void GlobalFunctionsPage::setDirty() const { storageDirty(EE_GENERAL); }
+void GlobalFunctionsPage::setDirty() const
+{
+  storageDirty(EE_GENERAL);
+  invalidateFunctionsIndex(EE_GENERAL);
+}
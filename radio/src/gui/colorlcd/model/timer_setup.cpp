@@ -29,7 +29,13 @@
 #include "timeedit.h"
 #include "toggleswitch.h"
 
-#define SET_DIRTY() storageDirty(EE_MODEL)
+static void setTimerDirty()
+{
+  storageDirty(EE_MODEL);
+  invalidateTimersConfig();
+}
+
+#define SET_DIRTY() setTimerDirty()
 
 TimerWindow::TimerWindow(uint8_t timer) :
   SubPage(ICON_STATS_TIMERS, STR_MAIN_MODEL_SETTINGS, (std::string(STR_TIMER) + std::to_string(timer + 1)).c_str())
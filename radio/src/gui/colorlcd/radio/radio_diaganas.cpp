@@ -134,6 +134,16 @@ class AnaViewWindow : public Window
       grid.setColSpan(3);
       new StaticText(line, rect_t{}, imuGetName());
       grid.setColSpan(1);
+      new DynamicText(line, rect_t{}, []() -> std::string {
+        // gyro axes found inverted compared to the accelerometer
+        std::string axes;
+        uint8_t inverted = gyroInvertedAxes();
+        for (uint8_t i = 0; i < 3; i++) {
+          if (inverted & (1 << i)) axes += (char)('X' + i);
+        }
+        if (axes.empty()) return axes;
+        return std::string(STR_IMU_GYRO_INVERTED) + " " + axes;
+      }, COLOR_THEME_WARNING_INDEX);
 
       line = newLine(grid);
       lv_obj_set_style_pad_column(line->getLvObj(), PAD_SMALL, LV_PART_MAIN);
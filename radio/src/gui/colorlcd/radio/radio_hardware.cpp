@@ -21,6 +21,7 @@
 
 #include "radio_hardware.h"
 
+#include "choice.h"
 #include "edgetx.h"
 #include "getset_helpers.h"
 #include "hal/adc_driver.h"
@@ -147,7 +148,17 @@ const static SetupLineDef setupLines[] = {
     // ADC filter
     STR_DEF(STR_JITTER_FILTER),
     [](Window* parent, coord_t x, coord_t y) {
-      new ToggleSwitch(parent, {x, y, 0, 0}, GET_SET_INVERTED(g_eeGeneral.noJitterFilter));
+      // Off, then each filter type
+      new Choice(
+          parent, {x, y, 0, 0}, STR_RADIO_ADCFILTERS, 0, 1 + ADCFILTER_KALMAN,
+          [] {
+            return g_eeGeneral.noJitterFilter ? 0 : 1 + g_eeGeneral.adcFilter;
+          },
+          [](int value) {
+            g_eeGeneral.noJitterFilter = (value == 0);
+            if (value) g_eeGeneral.adcFilter = value - 1;
+            SET_DIRTY();
+          });
     }
   },
 #if defined(AUDIO_MUTE_GPIO)
@@ -23,6 +23,8 @@
 
 #include "dma2d.h"
 #include "keys.h"
+#include "lua/custom_allocator.h"
+#include "lua/lua_bytecode_cache.h"
 #include "lua/lua_event.h"
 #include "view_main.h"
 
@@ -55,7 +57,7 @@ static void luaStandaloneHook(lua_State * L, lua_Debug *ar)
 static void luaStandaloneInit()
 {
 #if defined(USE_CUSTOM_ALLOCATOR)
-  lsStandalone = lua_newstate(custom_l_alloc, nullptr);   //we use our own allocator!
+  lsStandalone = lua_newstate(custom_l_alloc, LUA_ALLOCATOR_UD);   //we use our own allocator!
 #elif defined(LUA_ALLOCATOR_TRACER)
   memclear(&lsStandaloneTrace, sizeof(lsStandaloneTrace));
   lsStandaloneTrace.script = "lua_newstate(scripts)";
@@ -88,7 +90,9 @@ void luaExecStandalone(const char * filename)
     luaStandaloneInit();
 
   PROTECT_LUA() {
-    if (luaLoadScriptFileToState(lsStandalone, filename, LUA_SCRIPT_LOAD_MODE) == SCRIPT_OK) {
+    int status = luaLoadScriptFileToState(lsStandalone, filename, LUA_SCRIPT_LOAD_MODE);
+    luaBytecodeCacheClose();
+    if (status == SCRIPT_OK) {
       if (lua_pcall(lsStandalone, 0, 1, 0) == LUA_OK && lua_istable(lsStandalone, -1)) {
         int initFunction = LUA_REFNIL, runFunction = LUA_REFNIL;
         bool lvglLayout = false;
@@ -581,11 +581,16 @@ void menuRadioHardware(event_t event)
         break;
 
       case ITEM_RADIO_HARDWARE_JITTER_FILTER:
-        g_eeGeneral.noJitterFilter =
-            1 - editCheckBox(1 - g_eeGeneral.noJitterFilter,
-                             HW_SETTINGS_COLUMN2, y, STR_JITTER_FILTER, attr,
-                             event);
+      {
+        // Off, then each filter type
+        uint8_t filter = g_eeGeneral.noJitterFilter ? 0 : 1 + g_eeGeneral.adcFilter;
+        filter = editChoice(HW_SETTINGS_COLUMN2, y, STR_JITTER_FILTER,
+                            STR_RADIO_ADCFILTERS, filter, 0,
+                            1 + ADCFILTER_KALMAN, attr, event);
+        g_eeGeneral.noJitterFilter = (filter == 0);
+        if (filter) g_eeGeneral.adcFilter = filter - 1;
         break;
+      }
 
       case ITEM_RADIO_HARDWARE_RAS:
 #if defined(HARDWARE_INTERNAL_RAS)
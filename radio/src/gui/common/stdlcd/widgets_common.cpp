@@ -152,10 +152,12 @@ void editGVarValue(coord_t x, coord_t y, event_t event, uint8_t gvar, uint8_t fl
     if (event == EVT_KEY_LONG(KEY_ENTER) && flightMode > 0) {
       killEvents(event);
       *v = (*v > GVAR_MAX ? 0 : GVAR_MAX+1);
+      invalidateGVarFlightModes();
       storageDirty(EE_MODEL);
     }
     else if (s_editMode > 0) {
       *v = checkIncDec(event, *v, vmin, vmax, EE_MODEL);
+      if (checkIncDec_Ret && *v > GVAR_MAX) invalidateGVarFlightModes();
     }
   }
 }
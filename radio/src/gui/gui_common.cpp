@@ -1415,7 +1415,7 @@ uint8_t MODULE_CHANNELS_ROWS(int moduleIdx)
       return 0;
   }
 #endif
-  else if (isModuleDSM2(moduleIdx) || isModuleCrossfire(moduleIdx) ||
+  else if (isModuleDSM2(moduleIdx) ||
              isModuleGhost(moduleIdx) || isModuleSBUS(moduleIdx) ||
              isModuleDSMP(moduleIdx)) {
     // fixed number of channels
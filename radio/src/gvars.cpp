@@ -24,7 +24,8 @@
 uint8_t gvarDisplayTimer = 0;
 uint8_t gvarLastChanged = 0;
 
-uint8_t getGVarFlightMode(uint8_t fm, uint8_t gv) // TODO change params order to be consistent!
+// Walks the inheritance chain of a GVar from a flight mode
+static uint8_t resolveGVarFlightMode(uint8_t fm, uint8_t gv)
 {
   for (uint8_t i=0; i<MAX_FLIGHT_MODES; i++) {
     if (fm == 0) return 0;
@@ -37,6 +38,38 @@ uint8_t getGVarFlightMode(uint8_t fm, uint8_t gv) // TODO change params order to
   return 0;
 }
 
+// Flight mode holding the value of each GVar, for every flight mode. It only
+// depends on the inheritance links, so it is rebuilt when they are modified
+// (the serial is bumped), not when a GVar value changes. A serial bumped
+// during a rebuild triggers another one.
+static uint8_t gvarFlightModes[MAX_FLIGHT_MODES][MAX_GVARS];
+static volatile uint32_t gvarFlightModesSerial = 1;
+static volatile uint32_t gvarFlightModesBuilt = 0;
+
+void invalidateGVarFlightModes()
+{
+  gvarFlightModesSerial++;
+}
+
+static void updateGVarFlightModes()
+{
+  uint32_t serial = gvarFlightModesSerial;
+  if (gvarFlightModesBuilt == serial) return;
+
+  for (uint8_t fm=0; fm<MAX_FLIGHT_MODES; fm++) {
+    for (uint8_t gv=0; gv<MAX_GVARS; gv++) {
+      gvarFlightModes[fm][gv] = resolveGVarFlightMode(fm, gv);
+    }
+  }
+  gvarFlightModesBuilt = serial;
+}
+
+uint8_t getGVarFlightMode(uint8_t fm, uint8_t gv) // TODO change params order to be consistent!
+{
+  updateGVarFlightModes();
+  return gvarFlightModes[fm][gv];
+}
+
 int16_t getGVarValue(int8_t gv, int8_t fm)
 {
   int8_t mul = 1;
@@ -62,6 +95,7 @@ void setGVarValue(uint8_t gv, int16_t value, int8_t fm)
   fm = getGVarFlightMode(fm, gv);
   if (GVAR_VALUE(gv, fm) != value) {
     GVAR_VALUE(gv, fm) = value;
+    if (value > GVAR_MAX) invalidateGVarFlightModes();
     storageDirty(EE_MODEL);
     if (g_model.gvars[gv].popup) {
       gvarLastChanged = gv;
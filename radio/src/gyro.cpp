@@ -23,84 +23,25 @@
 #include "hal.h"
 #include "hal/usb_driver.h"
 
-#define _USE_MATH_DEFINES
-#include <math.h>
+#include "gyro_fusion.h"
+#include "timers_driver.h"
 
-#define COMPLEMENTARY_ALPHA  0.92f
-#define LP_FILTER_ALPHA      0.9f
-#define SAMPLE_TIME_S        0.005f
+// Attitude is estimated at a fixed rate from the mixer task, independently
+// of the UI
+#define IMU_SAMPLE_PERIOD_US  4000
 
 int16_t gyroOutputs[2];
 
 static imu_read_fn readFn;
+static uint32_t gyroScale;
+static int8_t gyroSign[3];
 static uint8_t errors;
 static int16_t offset_x, offset_y;
 static int16_t range_x = 8192, range_y = 8192;
 static int16_t raw_ax, raw_ay;
 
-// filter state
-static bool filterInitialized;
-static float roll, pitch, yaw;
-static float filteredAccel[3];
-static float prevAccel[3];
-static float filteredGyro[3];
-static float prevGyro[3];
-
-static float lowPass(float val, float prev, float alpha)
-{
-  return alpha * prev + (1.0f - alpha) * val;
-}
-
-static void gyroFilter(etx_imu_data_t* raw)
-{
-  // low-pass
-  filteredAccel[0] = lowPass(raw->accel_x, prevAccel[0], LP_FILTER_ALPHA);
-  filteredAccel[1] = lowPass(raw->accel_y, prevAccel[1], LP_FILTER_ALPHA);
-  filteredAccel[2] = lowPass(raw->accel_z, prevAccel[2], LP_FILTER_ALPHA);
-
-  filteredGyro[0] = lowPass(raw->gyro_x, prevGyro[0], LP_FILTER_ALPHA);
-  filteredGyro[1] = lowPass(raw->gyro_y, prevGyro[1], LP_FILTER_ALPHA);
-  filteredGyro[2] = lowPass(raw->gyro_z, prevGyro[2], LP_FILTER_ALPHA);
-
-  prevAccel[0] = filteredAccel[0];
-  prevAccel[1] = filteredAccel[1];
-  prevAccel[2] = filteredAccel[2];
-
-  prevGyro[0] = filteredGyro[0];
-  prevGyro[1] = filteredGyro[1];
-  prevGyro[2] = filteredGyro[2];
-
-  // complementary filter for attitude
-  float ax = raw->accel_x;
-  float ay = raw->accel_y;
-  float az = raw->accel_z;
-
-  float norm = sqrtf(ax * ax + ay * ay + az * az);
-  if (norm == 0.0f) return;
-  ax /= norm;
-  ay /= norm;
-  az /= norm;
-
-  float accelRoll  = atan2f(ay, sqrtf(ax * ax + az * az));
-  float accelPitch = atan2f(-ax, sqrtf(ay * ay + az * az));
-
-  if (!filterInitialized) {
-    roll  = accelRoll;
-    pitch = accelPitch;
-    yaw   = 0.0f;
-    filterInitialized = true;
-  } else {
-    float dt = SAMPLE_TIME_S;
-    roll  = COMPLEMENTARY_ALPHA * (roll  + raw->gyro_x * dt) +
-            (1.0f - COMPLEMENTARY_ALPHA) * accelRoll;
-    pitch = COMPLEMENTARY_ALPHA * (pitch + raw->gyro_y * dt) +
-            (1.0f - COMPLEMENTARY_ALPHA) * accelPitch;
-    yaw  += raw->gyro_z * dt;
-
-    if (yaw > (float)M_PI) yaw -= 2.0f * (float)M_PI;
-    if (yaw < -(float)M_PI) yaw += 2.0f * (float)M_PI;
-  }
-}
+static GyroFusionState fusion;
+static uint32_t lastSampleTime;
 
 // Fixed hardware mounting correction from the target hal.h (X = bit 0, Y = bit 1).
 // This accounts for how the chip is physically positioned and is always applied.
@@ -130,7 +71,7 @@ void setImuInversion(uint8_t axis, bool value)
     g_eeGeneral.imuInvert &= ~(1 << axis);
 }
 
-// Effective inversion applied to sensor data: hardware correction XOR user choice.
+// Effective inversion applied to the tilt: hardware correction XOR user choice.
 static bool imuAxisInverted(uint8_t axis)
 {
   uint8_t effective = g_eeGeneral.imuInvert ^ imuHwInvertMask();
@@ -140,18 +81,25 @@ static bool imuAxisInverted(uint8_t axis)
 void gyroStart(imu_read_fn fn)
 {
   readFn = fn;
+  gyroScale = imuGetGyroScale();
+  for (uint8_t i = 0; i < 3; i++) gyroSign[i] = imuGetGyroSign(i);
+  gyroFusionReset(&fusion);
 }
 
-void gyroWakeup()
+uint8_t gyroInvertedAxes()
 {
-  static tmr10ms_t gyroWakeupTime = 0;
+  return gyroFusionInvertedAxes(&fusion);
+}
 
-  tmr10ms_t now = get_tmr10ms();
-  if (!readFn || errors >= 100 || now < gyroWakeupTime ||
+void gyroWakeup()
+{
+  uint32_t now = timersGetUsTick();
+  if (!readFn || errors >= 100 || now - lastSampleTime < IMU_SAMPLE_PERIOD_US ||
       usbPluggedInStorageMode())
     return;
 
-  gyroWakeupTime = now + 1; /* 10ms default */
+  uint32_t dt = now - lastSampleTime;
+  lastSampleTime = now;
 
   etx_imu_data_t raw;
   if (readFn(&raw) < 0) {
@@ -161,19 +109,18 @@ void gyroWakeup()
 
   errors = 0;
 
-  if (imuAxisInverted(IMU_AXIS_X)) {
-    raw.accel_x = -raw.accel_x;
-    raw.gyro_x  = -raw.gyro_x;
-  }
-  if (imuAxisInverted(IMU_AXIS_Y)) {
-    raw.accel_y = -raw.accel_y;
-    raw.gyro_y  = -raw.gyro_y;
-  }
-
-  gyroFilter(&raw);
-
-  raw_ax = (int16_t)filteredAccel[0];
-  raw_ay = (int16_t)filteredAccel[1];
+  const int32_t accel[3] = {(int32_t)raw.accel_x, (int32_t)raw.accel_y,
+                            (int32_t)raw.accel_z};
+  const int32_t gyro[3] = {gyroSign[0] * (int32_t)raw.gyro_x,
+                           gyroSign[1] * (int32_t)raw.gyro_y,
+                           gyroSign[2] * (int32_t)raw.gyro_z};
+  gyroFusionUpdate(&fusion, accel, gyro, gyroScale, dt);
+
+  // Inversion applies to the estimated tilt
+  raw_ax = gyroFusionTilt(&fusion, IMU_AXIS_X);
+  if (imuAxisInverted(IMU_AXIS_X)) raw_ax = -raw_ax;
+  raw_ay = gyroFusionTilt(&fusion, IMU_AXIS_Y);
+  if (imuAxisInverted(IMU_AXIS_Y)) raw_ay = -raw_ay;
 
   int16_t ax = raw_ax - offset_x;
   int16_t ay = raw_ay - offset_y;
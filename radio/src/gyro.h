@@ -45,4 +45,8 @@ void gyroSetIMU_Y(int16_t offset, int16_t range);
 int16_t gyroScaledX();
 int16_t gyroScaledY();
 
+// Gyro axes found inverted compared to the accelerometer (bit per axis),
+// despite the driver gyro signs.
+uint8_t gyroInvertedAxes();
+
 extern int16_t gyroOutputs[2];
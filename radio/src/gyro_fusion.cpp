@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "gyro_fusion.h"
+#include "edgetx.h"
+
+// pi / 180 (Q24)
+#define DEG_TO_RAD  292819
+
+// Q16 cross product
+static void cross(const int32_t u[3], const int32_t v[3], int32_t r[3])
+{
+  r[0] = ((int64_t)u[1] * v[2] - (int64_t)u[2] * v[1]) >> 16;
+  r[1] = ((int64_t)u[2] * v[0] - (int64_t)u[0] * v[2]) >> 16;
+  r[2] = ((int64_t)u[0] * v[1] - (int64_t)u[1] * v[0]) >> 16;
+}
+
+void gyroFusionReset(GyroFusionState* st)
+{
+  memset(st, 0, sizeof(GyroFusionState));
+}
+
+// The drivers gyro signs bring the rates to the accelerometer axes: the
+// rotation of each axis is checked against the change of the accelerometer
+// direction it should produce, and an axis found inverted is reported.
+static void checkGyroSigns(GyroFusionState* st, const int32_t a[3],
+                           const int32_t rate[3], uint32_t dt)
+{
+  // accelerometer direction change per second (Q16)
+  int32_t da[3];
+  for (int i = 0; i < 3; i++) {
+    da[i] = (int64_t)(a[i] - st->a[i]) * 1000000 / dt;
+  }
+
+  // a rotation around axis i moves the gravity by g x rate_i
+  int32_t expected[3];
+  cross(da, st->g, expected);
+
+  for (int i = 0; i < 3; i++) {
+    int64_t& check = st->signCheck[i];
+    check += (((int64_t)(rate[i] >> 8) * expected[i]) >> 16) * dt / 1000000;
+    check = limit<int64_t>(-4 * GYRO_FUSION_SIGN_THRESHOLD, check,
+                           4 * GYRO_FUSION_SIGN_THRESHOLD);
+    if (check < -GYRO_FUSION_SIGN_THRESHOLD) {
+      if (!(st->inverted & (1 << i))) {
+        TRACE("IMU: gyro axis %d inverted", i);
+        st->inverted |= (1 << i);
+      }
+    } else if (check > GYRO_FUSION_SIGN_THRESHOLD) {
+      st->inverted &= ~(1 << i);
+    }
+  }
+}
+
+void gyroFusionUpdate(GyroFusionState* st, const int32_t accel[3],
+                      const int32_t gyro[3], uint32_t gyroScale, uint32_t dt)
+{
+  uint32_t norm2 = 0;
+  for (int i = 0; i < 3; i++) {
+    norm2 += (uint32_t)(accel[i] * accel[i]);
+  }
+  int32_t norm = isqrt32(norm2);
+  if (norm == 0) return;
+
+  int32_t a[3];
+  for (int i = 0; i < 3; i++) {
+    a[i] = ((int64_t)accel[i] << 16) / norm;
+  }
+
+  if (!st->initialized || dt == 0 || dt > GYRO_FUSION_MAX_DT) {
+    // (re)start from the accelerometer, keeping the bias learnt
+    memcpy(st->g, a, sizeof(a));
+    memcpy(st->a, a, sizeof(a));
+    if (!st->initialized) st->gravity = norm << 8;
+    st->initialized = true;
+    return;
+  }
+
+  st->gravity += ((int64_t)(norm << 8) - st->gravity) * dt /
+                 GYRO_FUSION_GRAVITY_TAU;
+
+  // gyro rates (Q24 rad/s)
+  int32_t rate[3];
+  for (int i = 0; i < 3; i++) {
+    rate[i] = (int64_t)gyro[i] * gyroScale * DEG_TO_RAD / 1000000;
+  }
+
+  int32_t gravity = st->gravity >> 8;
+  if (abs(norm - gravity) < gravity / GYRO_FUSION_ACCEL_TOL) {
+    checkGyroSigns(st, a, rate, dt);
+
+    // rotation bringing the estimate towards the accelerometer
+    int32_t e[3];
+    cross(a, st->g, e);
+    for (int i = 0; i < 3; i++) {
+      st->bias[i] = limit<int32_t>(
+          -GYRO_FUSION_MAX_BIAS,
+          st->bias[i] + (((int64_t)e[i] * GYRO_FUSION_KI * dt / 1000000) >> 8),
+          GYRO_FUSION_MAX_BIAS);
+      rate[i] += ((int64_t)e[i] * GYRO_FUSION_KP) >> 8;
+    }
+  }
+  memcpy(st->a, a, sizeof(a));
+
+  // rotate the estimate: g += g x (rate * dt)
+  int32_t angle[3], dg[3];
+  for (int i = 0; i < 3; i++) {
+    angle[i] = ((int64_t)(rate[i] + st->bias[i]) * dt / 1000000) >> 8;
+  }
+  cross(st->g, angle, dg);
+
+  // and keep it a unit vector: g *= (3 - |g|^2) / 2
+  int64_t n2 = 0;
+  for (int i = 0; i < 3; i++) {
+    st->g[i] += dg[i];
+    n2 += (int64_t)st->g[i] * st->g[i];
+  }
+  int64_t k = (3LL << 32) - n2;
+  for (int i = 0; i < 3; i++) {
+    st->g[i] = (st->g[i] * k) >> 33;
+  }
+}
+
+int16_t gyroFusionTilt(const GyroFusionState* st, uint8_t axis)
+{
+  int32_t v = ((int64_t)st->g[axis] * (st->gravity >> 8)) >> 16;
+  return limit<int32_t>(INT16_MIN, v, INT16_MAX);
+}
+
+uint8_t gyroFusionInvertedAxes(const GyroFusionState* st)
+{
+  return st->inverted;
+}
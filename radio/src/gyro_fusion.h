@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+
+// Attitude estimation from accelerometer and gyro samples, in fixed point.
+//
+// The estimate is the direction of gravity in the sensor frame. It follows
+// the gyro rates and is pulled towards the accelerometer (Mahony filter):
+// the proportional term removes the drift, the integral term converges to
+// the gyro bias. The accelerometer is ignored while its norm is far from 1g
+// (linear accelerations).
+
+#define GYRO_FUSION_KP           (2 << 16)   // 1/s (Q16)
+#define GYRO_FUSION_KI           (1 << 14)   // 1/s^2 (Q16)
+#define GYRO_FUSION_MAX_BIAS     (1 << 23)   // rad/s (Q24), ~30 dps
+#define GYRO_FUSION_ACCEL_TOL    10          // |norm - 1g| < 1g / 10
+#define GYRO_FUSION_GRAVITY_TAU  2000000     // us, 1g estimation
+#define GYRO_FUSION_MAX_DT       50000       // us, restart beyond
+
+// A gyro axis whose rates disagree with the accelerometer over this
+// (accumulated rate x tilt change, Q16) is reported as inverted
+#define GYRO_FUSION_SIGN_THRESHOLD  (1 << 16)
+
+struct GyroFusionState {
+  int32_t g[3];         // gravity direction, unit vector (Q16)
+  int32_t a[3];         // last accelerometer direction (Q16)
+  int32_t bias[3];      // gyro bias correction (Q24 rad/s)
+  int64_t signCheck[3]; // gyro / accelerometer agreement, per axis
+  uint8_t inverted;     // gyro axes seen inverted (bit per axis)
+  int32_t gravity;      // 1g in accelerometer LSB (Q8)
+  bool initialized;
+};
+
+void gyroFusionReset(GyroFusionState* st);
+
+// accel: accelerometer (LSB), gyro: rates (LSB),
+// gyroScale: micro-degrees/s per gyro LSB, dt: us since the previous sample
+void gyroFusionUpdate(GyroFusionState* st, const int32_t accel[3],
+                      const int32_t gyro[3], uint32_t gyroScale, uint32_t dt);
+
+// Gravity in the sensor X/Y axes, in accelerometer LSB
+int16_t gyroFusionTilt(const GyroFusionState* st, uint8_t axis);
+
+// Gyro axes seen inverted compared to the accelerometer (bit per axis)
+uint8_t gyroFusionInvertedAxes(const GyroFusionState* st);
@@ -20,12 +20,14 @@
  */
 
 #include "adc_driver.h"
+#include "adc_filter.h"
 #include "board.h"
 #if defined(FLYSKY_GIMBAL)
   #include "flysky_gimbal_driver.h"
 #endif
 
 #include "edgetx.h"
+#include "timers_driver.h"
 
 const etx_hal_adc_driver_t* _hal_adc_driver = nullptr;
 const etx_hal_adc_inputs_t* _hal_adc_inputs = nullptr;
@@ -259,7 +261,9 @@ uint16_t* getAnalogValues()
 // used by diaganas
 uint32_t s_anaFilt[MAX_ANALOG_INPUTS];
 
-#define ANALOG_MULTIPLIER (1 << ANALOG_SCALE)
+static AdcFilterState adcFilters[MAX_ANALOG_INPUTS];
+static uint32_t adcLastSampleTime;
+
 #define ANA_FILT(chan)    (s_anaFilt[chan] / (JITTER_ALPHA * ANALOG_MULTIPLIER))
 #if (JITTER_ALPHA * ANALOG_MULTIPLIER > 32)
   #error "JITTER_FILTER_STRENGTH and ANALOG_SCALE are too big, their summ should be <= 5 !!!"
@@ -281,11 +285,15 @@ void anaSetFiltered(uint8_t chan, uint16_t val)
 {
   val += RESX;
   s_anaFilt[chan] = val * (JITTER_ALPHA * ANALOG_MULTIPLIER);
+  adcFilterReset(&adcFilters[chan]);
 }
 
 void anaResetFiltered()
 {
   memset(s_anaFilt, 0, sizeof(s_anaFilt));
+  for (auto& filter : adcFilters) {
+    adcFilterReset(&filter);
+  }
 }
 
 #if defined(JITTER_MEASURE)
@@ -294,69 +302,23 @@ JitterMeter<uint16_t> avgJitter[MAX_ANALOG_INPUTS];
 tmr10ms_t jitterResetTime = 0;
 #endif
 
-static uint32_t apply_low_pass_filter(uint32_t v, uint32_t v_prev,
-                                      bool is_main_input)
-{
-  // Jitter filter:
-  //    * pass trough any big change directly
-  //    * for small change use Modified moving average (MMA) filter
-  //
-  // Explanation:
-  //
-  // Normal MMA filter has this formula:
-  //            <out> = ((ALPHA-1)*<out> + <in>)/ALPHA
-  //
-  // If calculation is done this way with integer arithmetics, then any small
-  // change in input signal is lost. One way to combat that, is to rearrange the
-  // formula somewhat, to store a more precise (larger) number between
-  // iterations. The basic idea is to store undivided value between iterations.
-  // Therefore an new variable <filtered> is used. The new formula becomes:
-  //           <filtered> = <filtered> - <filtered>/ALPHA + <in>
-  //           <out> = <filtered>/ALPHA  (use only when out is needed)
-  //
-  // The above formula with a maximum allowed ALPHA value (we are limited by
-  // the 16 bit s_anaFilt[]) was tested on the radio. The resulting signal still
-  // had some jitter (a value of 1 was observed). The jitter might be bigger on
-  // other radios.
-  //
-  // So another idea is to use larger input values for filtering. So instead of
-  // using input in a range from 0 to 2047, we use twice larger number (temp[x]
-  // is divided less)
-  //
-  // This also means that ALPHA must be lowered (remember 16 bit limit), but
-  // test results have proved that this kind of filtering gives better results.
-  // So the recommended values for filter are:
-  //     JITTER_FILTER_STRENGTH  4
-  //     ANALOG_SCALE            1
-  //
-  uint32_t previous = v_prev / JITTER_ALPHA;
-  uint32_t diff = (v > previous) ? (v - previous) : (previous - v);
-
-  // Combine ADC jitter filter setting form radio and model.
-  // Model can override (on or off) or use setting from radio setup.
-  // Model setting is active when 1, radio setting is active when 0
-  // Please note: these settings only apply to main controls.
-  bool useJitterFilter = true;
-  if (is_main_input) {
-    if (g_model.jitterFilter == OVERRIDE_GLOBAL) {
-      // Use radio setting - which is inverted
-      useJitterFilter = !g_eeGeneral.noJitterFilter;
-    } else {
-      // Enable if value is "On", disable if "Off"
-      useJitterFilter = (g_model.jitterFilter == OVERRIDE_ON);
-    }
+// Filter applied to main controls, following radio and model settings
+static uint8_t getMainsFilter()
+{
+  uint8_t filter = g_model.jitterFilter;
+  if (filter == MDLFILTER_GLOBAL) {
+    // Use radio setting - which is inverted
+    filter = g_eeGeneral.noJitterFilter ? MDLFILTER_OFF : MDLFILTER_ON;
   }
 
-  uint32_t out;
-  if (useJitterFilter && diff < (10 * ANALOG_MULTIPLIER)) {
-    // apply jitter filter
-    out = (v_prev - previous) + v;
-  } else {
-    // use unfiltered value
-    out = v * JITTER_ALPHA;
+  switch (filter) {
+    case MDLFILTER_OFF:
+      return ADC_FILTER_NONE;
+    case MDLFILTER_ON:
+      return ADC_FILTER_MMA + g_eeGeneral.adcFilter;
+    default:
+      return ADC_FILTER_MMA + (filter - MDLFILTER_MMA);
   }
-
-  return out;
 }
 
 static uint32_t apply_calibration(const CalibData* calib, uint32_t v)
@@ -438,6 +400,15 @@ void getADC()
   if (!adcRead()) { TRACE("adcRead failed"); }
   DEBUG_TIMER_STOP(debugTimerAdcRead);
 
+  uint32_t now = timersGetUsTick();
+  uint32_t dt = now - adcLastSampleTime;
+  adcLastSampleTime = now;
+
+  // Switches (multipos) and other inputs always use the MMA filter,
+  // other pots use the same adaptive filter as the main controls
+  uint8_t mains_filter = getMainsFilter();
+  uint8_t pots_filter = max<uint8_t>(mains_filter, ADC_FILTER_MMA);
+
   for (uint8_t x = 0; x < max_analogs; x++) {
 
     bool is_flex_input = (x >= pot_offset) && (x < pot_offset + max_pots);
@@ -463,7 +434,13 @@ void getADC()
     }
 
     // Apply filtering
-    s_anaFilt[x] = apply_low_pass_filter(v, s_anaFilt[x], x < max_mains);
+    uint8_t filter = ADC_FILTER_MMA;
+    if (x < max_mains) {
+      filter = mains_filter;
+    } else if (is_flex_input && !is_multipos) {
+      filter = pots_filter;
+    }
+    s_anaFilt[x] = adcFilterApply(&adcFilters[x], filter, v, s_anaFilt[x], dt);
 
     if (is_multipos) {
 #if defined(SIMU)
@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "adc_filter.h"
+#include "adc_driver.h"
+
+#include "edgetx.h"
+
+#define MMA_THRESHOLD  (10 * ANALOG_MULTIPLIER)
+
+static uint32_t apply_mma(uint32_t v, uint32_t v_prev)
+{
+  // Jitter filter:
+  //    * pass trough any big change directly
+  //    * for small change use Modified moving average (MMA) filter
+  //
+  // Explanation:
+  //
+  // Normal MMA filter has this formula:
+  //            <out> = ((ALPHA-1)*<out> + <in>)/ALPHA
+  //
+  // If calculation is done this way with integer arithmetics, then any small
+  // change in input signal is lost. One way to combat that, is to rearrange the
+  // formula somewhat, to store a more precise (larger) number between
+  // iterations. The basic idea is to store undivided value between iterations.
+  // Therefore an new variable <filtered> is used. The new formula becomes:
+  //           <filtered> = <filtered> - <filtered>/ALPHA + <in>
+  //           <out> = <filtered>/ALPHA  (use only when out is needed)
+  //
+  // The above formula with a maximum allowed ALPHA value (we are limited by
+  // the 16 bit s_anaFilt[]) was tested on the radio. The resulting signal still
+  // had some jitter (a value of 1 was observed). The jitter might be bigger on
+  // other radios.
+  //
+  // So another idea is to use larger input values for filtering. So instead of
+  // using input in a range from 0 to 2047, we use twice larger number (temp[x]
+  // is divided less)
+  //
+  // This also means that ALPHA must be lowered (remember 16 bit limit), but
+  // test results have proved that this kind of filtering gives better results.
+  // So the recommended values for filter are:
+  //     JITTER_FILTER_STRENGTH  4
+  //     ANALOG_SCALE            1
+  //
+  uint32_t previous = v_prev / JITTER_ALPHA;
+  uint32_t diff = (v > previous) ? (v - previous) : (previous - v);
+
+  if (diff < MMA_THRESHOLD) {
+    // apply jitter filter
+    return (v_prev - previous) + v;
+  }
+
+  // use unfiltered value
+  return v * JITTER_ALPHA;
+}
+
+// Smoothing factor (Q16) of a first order low pass: w / (1 + w),
+// with w = 2*pi*fc*dt (fc in 0.01Hz, dt in us)
+static uint32_t lowPassAlpha(uint32_t fc, uint32_t dt)
+{
+  uint32_t w = fc * dt;
+  return ((uint64_t)w << 16) / (w + 15915494);
+}
+
+// One-euro filter: a low pass whose cutoff rises with the input speed,
+// quiet at rest without lagging behind fast moves
+static void apply_one_euro(AdcFilterState* st, int32_t z, uint32_t dt)
+{
+  int32_t speed = (int64_t)(z - st->x) * 1000000 / ((int64_t)dt << 8);
+  st->dx += ((int64_t)(speed - st->dx) *
+             lowPassAlpha(ONE_EURO_D_CUTOFF, dt)) >> 16;
+
+  uint32_t cutoff = ONE_EURO_MIN_CUTOFF + abs(st->dx) / ONE_EURO_BETA_DIV;
+  cutoff = min<uint32_t>(cutoff, ONE_EURO_MAX_CUTOFF);
+  st->x += ((int64_t)(z - st->x) * lowPassAlpha(cutoff, dt)) >> 16;
+}
+
+// 1-D Kalman filter with a constant position model. A single innovation
+// beyond the gate is taken as a spike and ignored; two in the same direction
+// mean the input is moving: the variance is raised so that the filter
+// follows the measurement.
+static void apply_kalman(AdcFilterState* st, int32_t z, uint32_t dt)
+{
+  // Q16 variances
+  uint32_t p = min<uint64_t>(
+      st->p + (uint64_t)KALMAN_Q * dt / 1000000, KALMAN_P_MAX);
+
+  int32_t innov = z - st->x;
+  uint64_t innov2 = (int64_t)innov * innov;
+  if (innov2 > (uint64_t)KALMAN_GATE * (p + KALMAN_R)) {
+    int32_t outlier = innov > 0 ? 1 : -1;
+    if (st->dx != outlier) {
+      st->dx = outlier;
+      st->p = p;
+      return;
+    }
+    p = min<uint64_t>(p + innov2, KALMAN_P_MAX);
+  } else {
+    st->dx = 0;
+  }
+
+  uint32_t k = ((uint64_t)p << 16) / (p + KALMAN_R);
+  st->x += ((int64_t)innov * k) >> 16;
+  st->p = p - (((uint64_t)p * k) >> 16);
+}
+
+uint32_t adcFilterApply(AdcFilterState* st, uint8_t type, uint32_t v,
+                        uint32_t filtered, uint32_t dt)
+{
+  if (type == ADC_FILTER_MMA || type == ADC_FILTER_NONE) {
+    st->valid = false;
+    return type == ADC_FILTER_MMA ? apply_mma(v, filtered) : v * JITTER_ALPHA;
+  }
+
+  int32_t z = v << 8;
+  if (!st->valid || st->type != type) {
+    st->x = z;
+    st->dx = 0;
+    st->p = KALMAN_R;
+    st->type = type;
+    st->valid = true;
+    return v * JITTER_ALPHA;
+  }
+
+  dt = limit<uint32_t>(ADC_FILTER_MIN_DT, dt, ADC_FILTER_MAX_DT);
+  if (type == ADC_FILTER_ONE_EURO) {
+    apply_one_euro(st, z, dt);
+  } else {
+    apply_kalman(st, z, dt);
+  }
+
+  // Q8 -> JITTER_ALPHA units
+  int32_t out = (st->x + 128 / JITTER_ALPHA) / (256 / JITTER_ALPHA);
+  return limit<int32_t>(0, out, 4 * RESX * JITTER_ALPHA);
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+
+// Filter stage applied to each analog input by getADC().
+//
+// Inputs are calibrated values (0 .. 4*RESX), outputs are in the units of
+// s_anaFilt[] (input * JITTER_ALPHA). All filters are fixed point.
+enum AdcFilterType : uint8_t {
+  ADC_FILTER_NONE,
+  ADC_FILTER_MMA,       // modified moving average + pass-through
+  ADC_FILTER_ONE_EURO,  // speed adaptive low pass
+  ADC_FILTER_KALMAN,    // 1-D Kalman with innovation gate
+};
+
+// Sample period limits (us)
+#define ADC_FILTER_MIN_DT  250
+#define ADC_FILTER_MAX_DT  50000
+
+// One-euro: cutoff = MIN_CUTOFF + |speed| / BETA_DIV (in 0.01Hz)
+#define ONE_EURO_MIN_CUTOFF  100   // 1Hz
+#define ONE_EURO_D_CUTOFF    100   // 1Hz, speed filter
+#define ONE_EURO_MAX_CUTOFF  10000 // 100Hz
+#define ONE_EURO_BETA_DIV    4
+
+// Kalman (Q16 variances, input units)
+#define KALMAN_R             (9 << 16)   // measurement noise: 3 units RMS
+#define KALMAN_Q             (10 << 16)  // process noise per second
+#define KALMAN_GATE          9           // 3 sigma (squared)
+#define KALMAN_P_MAX         (1 << 30)
+
+struct AdcFilterState {
+  int32_t x;       // filtered value (Q8)
+  int32_t dx;      // one-euro: filtered speed (units/s), kalman: last outlier
+  uint32_t p;      // kalman: error variance (Q16)
+  uint8_t type;
+  bool valid;
+};
+
+inline void adcFilterReset(AdcFilterState* st) { st->valid = false; }
+
+// Returns the next value of 'filtered' for the raw input 'v', 'dt' us after
+// the previous sample
+uint32_t adcFilterApply(AdcFilterState* st, uint8_t type, uint32_t v,
+                        uint32_t filtered, uint32_t dt);
@@ -22,12 +22,16 @@
 #include "hal/imu.h"
 
 static const char* s_imu_name = nullptr;
+static uint32_t s_imu_gyro_scale = 0;
+static const int8_t* s_imu_gyro_sign = nullptr;
 
 imu_read_fn imuDetect(const etx_imu_t* candidates, uint8_t count)
 {
   for (uint8_t i = 0; i < count; i++) {
     if (candidates[i].driver->init(candidates[i].bus, candidates[i].addr) == 0) {
       s_imu_name = candidates[i].driver->name;
+      s_imu_gyro_scale = candidates[i].driver->gyro_scale;
+      s_imu_gyro_sign = candidates[i].driver->gyro_sign;
       return candidates[i].driver->read;
     }
   }
@@ -38,3 +42,13 @@ const char* imuGetName()
 {
   return s_imu_name;
 }
+
+uint32_t imuGetGyroScale()
+{
+  return s_imu_gyro_scale;
+}
+
+int8_t imuGetGyroSign(uint8_t axis)
+{
+  return s_imu_gyro_sign ? s_imu_gyro_sign[axis] : 1;
+}
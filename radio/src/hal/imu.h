@@ -36,6 +36,10 @@ struct etx_imu_driver_t {
   imu_init_fn init;
   imu_read_fn read;
   const char* name;
+  uint32_t gyro_scale;  // gyro sensitivity (micro-degrees/s per LSB)
+  // Gyro axis signs bringing the rates read back to the accelerometer axes.
+  // Both sensors share the chip axes, but read() may remap them differently.
+  int8_t gyro_sign[3];
 };
 
 struct etx_imu_t {
@@ -49,3 +53,9 @@ imu_read_fn imuDetect(const etx_imu_t* candidates, uint8_t count);
 
 // Returns the name of the detected IMU, or nullptr if none
 const char* imuGetName();
+
+// Returns the gyro sensitivity of the detected IMU, or 0 if none
+uint32_t imuGetGyroScale();
+
+// Returns the gyro sign of an axis of the detected IMU, or 1 if none
+int8_t imuGetGyroSign(uint8_t axis);
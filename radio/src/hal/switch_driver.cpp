@@ -128,6 +128,16 @@ SwitchHwPos switchGetPosition(uint8_t sw_idx)
   return SWITCH_HW_UP;
 }
 
+uint64_t switchGetPositions()
+{
+  uint64_t positions = 0;
+  auto max_switches = switchGetMaxAllSwitches();
+  for (uint8_t i = 0; i < max_switches; i++) {
+    positions |= (uint64_t)1 << (i * 3 + switchGetPosition(i));
+  }
+  return positions;
+}
+
 static const char * const _flex_sw_canon_names[] = {
   "FL1", "FL2", "FL3", "FL4"
 };
@@ -88,6 +88,10 @@ uint32_t switchState(uint8_t pos_idx);
 // returns a position for a switch index
 SwitchHwPos switchGetPosition(uint8_t idx);
 
+// returns the positions of all switches as a bitmask, with one bit per
+// switch position (3 bits per switch, same layout as switchState())
+uint64_t switchGetPositions();
+
 const char* switchGetDefaultName(uint8_t idx);
 SwitchHwType switchGetHwType(uint8_t idx);
 int8_t switchGetIndexFromName(const char* name);
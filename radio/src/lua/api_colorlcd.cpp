@@ -30,12 +30,151 @@
 
 #include "lua_api.h"
 #include "lua_widget.h"
+#include "lua_draw_list.h"
 #include "api_colorlcd.h"
 
-#define BITMAP_METATABLE "BITMAP*"
-
 BitmapBuffer* luaLcdBuffer  = nullptr;
 
+// Areas touched by recorded lcd.* calls (see lua_draw_list.h)
+
+static bool boundsPoints(const LuaDrawArgs& args, int count, rect_t& rect)
+{
+  coord_t x1 = args.integer(1), y1 = args.integer(2);
+  coord_t x2 = x1, y2 = y1;
+  for (int i = 1; i < count; i++) {
+    coord_t x = args.integer(2 * i + 1), y = args.integer(2 * i + 2);
+    x1 = min(x1, x); x2 = max(x2, x);
+    y1 = min(y1, y); y2 = max(y2, y);
+  }
+  rect = {x1, y1, x2 - x1 + 1, y2 - y1 + 1};
+  return true;
+}
+
+static bool boundsPoint(const LuaDrawArgs& args, rect_t& rect)
+{
+  return boundsPoints(args, 1, rect);
+}
+
+static bool boundsLine(const LuaDrawArgs& args, rect_t& rect)
+{
+  return boundsPoints(args, 2, rect);
+}
+
+static bool boundsTriangle(const LuaDrawArgs& args, rect_t& rect)
+{
+  return boundsPoints(args, 3, rect);
+}
+
+static bool boundsRect(const LuaDrawArgs& args, rect_t& rect)
+{
+  rect = {(coord_t)args.integer(1), (coord_t)args.integer(2),
+          (coord_t)args.integer(3), (coord_t)args.integer(4)};
+  return true;
+}
+
+static bool boundsCircle(const LuaDrawArgs& args, rect_t& rect)
+{
+  coord_t r = args.integer(3);
+  rect = {(coord_t)args.integer(1) - r, (coord_t)args.integer(2) - r,
+          2 * r + 1, 2 * r + 1};
+  return true;
+}
+
+static bool boundsAnnulus(const LuaDrawArgs& args, rect_t& rect)
+{
+  coord_t r = args.integer(4);
+  rect = {(coord_t)args.integer(1) - r, (coord_t)args.integer(2) - r,
+          2 * r + 1, 2 * r + 1};
+  return true;
+}
+
+static bool boundsHudRectangle(const LuaDrawArgs& args, rect_t& rect)
+{
+  coord_t xmin = args.integer(3), xmax = args.integer(4);
+  coord_t ymin = args.integer(5), ymax = args.integer(6);
+  rect = {xmin, ymin, xmax - xmin + 1, ymax - ymin + 1};
+  return true;
+}
+
+static bool boundsBitmap(const LuaDrawArgs& args, rect_t& rect)
+{
+  if (args.count < 3) return false;
+  const BitmapBuffer* b = args.bitmap(1);
+  if (!b) return false;
+  coord_t w = b->width(), h = b->height();
+  coord_t scale = args.integer(4);
+  if (scale) {
+    w = w * scale / 100 + 1;
+    h = h * scale / 100 + 1;
+  }
+  rect = {(coord_t)args.integer(2), (coord_t)args.integer(3), w, h};
+  return true;
+}
+
+static bool boundsMask(const LuaDrawArgs& args, rect_t& rect)
+{
+  if (args.count < 3 || !args.isString(1) ||
+      args.args[0].i < (lua_Integer)sizeof(MaskBitmap))
+    return false;
+  auto m = reinterpret_cast<const MaskBitmap*>(args.string(1));
+  rect = {(coord_t)args.integer(2), (coord_t)args.integer(3), m->width,
+          m->height};
+  return true;
+}
+
+// Text: the invert box margin and shadow are added around the string
+static void textBounds(coord_t x, coord_t y, const char* s, LcdFlags flags,
+                       rect_t& rect)
+{
+  constexpr coord_t TEXT_MARGIN = 3;
+  coord_t h = getFontHeight(flags & 0xFFFF);
+  coord_t w = getTextWidth(s, 0, flags);
+  if (flags & VCENTERED) y -= h / 2;
+  if (flags & RIGHT)
+    x -= w;
+  else if (flags & CENTERED)
+    x -= w / 2;
+  rect = {x - TEXT_MARGIN, y - TEXT_MARGIN, w + 2 * TEXT_MARGIN,
+          h + 2 * TEXT_MARGIN};
+}
+
+// Text whose content is not known in advance: full width band
+static bool boundsTextBand(const LuaDrawArgs& args, rect_t& rect)
+{
+  LcdFlags flags = args.integer(4);
+  coord_t y = args.integer(2);
+  coord_t h = getFontHeight(flags & 0xFFFF);
+  if (flags & VCENTERED) y -= h / 2;
+  rect = {-LCD_W, y - 3, 3 * LCD_W, h + 6};
+  return true;
+}
+
+static bool boundsText(const LuaDrawArgs& args, rect_t& rect)
+{
+  textBounds(args.integer(1), args.integer(2), args.string(3),
+             args.integer(4), rect);
+  return true;
+}
+
+static void formatTimer(char* s, int tme, LcdFlags flags);
+
+static bool boundsTimer(const LuaDrawArgs& args, rect_t& rect)
+{
+  char s[LEN_TIMER_STRING];
+  formatTimer(s, args.integer(3), args.integer(4));
+  textBounds(args.integer(1), args.integer(2), s, args.integer(4), rect);
+  return true;
+}
+
+static bool boundsNumber(const LuaDrawArgs& args, rect_t& rect)
+{
+  char s[49];
+  LcdFlags flags = args.integer(4);
+  formatNumberAsString(s, 49, args.integer(3), flags & 0xFFFF);
+  textBounds(args.integer(1), args.integer(2), s, flags, rect);
+  return true;
+}
+
 /*luadoc
 @function lcd.refresh()
 
@@ -65,6 +204,8 @@ Clear the LCD screen
 */
 static int luaLcdClear(lua_State * L)
 {
+  LUA_LCD_RECORD(L, luaLcdClear, 0, nullptr);
+
   if (luaLcdAllowed && luaLcdBuffer) {
     LcdFlags flags = luaL_optinteger(L, 1, COLOR2FLAGS(COLOR_THEME_SECONDARY3_INDEX));
     flags = colorToRGB(flags);
@@ -108,6 +249,8 @@ bottom line is 63. Drawing on an existing black pixel produces white pixel (TODO
 */
 static int luaLcdDrawPoint(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawPoint, 3, boundsPoint);
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -142,6 +285,8 @@ whole line will not be drawn (starting from OpenTX 2.1.5)
 */
 static int luaLcdDrawLine(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawLine, 6, boundsLine);
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -238,6 +383,8 @@ Draw a text beginning at (x,y)
 */
 static int luaLcdDrawText(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawText, 4, boundsText);
+
   const char * s = luaL_checkstring(L, 3);
   LcdFlags flags = luaL_optinteger(L, 4, 0);
   drawString(L, s, flags);
@@ -289,6 +436,9 @@ Draw text inside rectangle (x,y,w,h) with line breaks
 */
 static int luaLcdDrawTextLines(lua_State *L)
 {
+  // Returns the end position, which is only known once drawn
+  if (luaLcdRecorder) luaLcdRecorder->abort();
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -352,14 +502,21 @@ Display a value formatted as time at (x,y)
 */
 static int luaLcdDrawTimer(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawTimer, 4, boundsTimer);
+
   char s[LEN_TIMER_STRING];
   int tme = luaL_checkinteger(L, 3);
   LcdFlags flags = luaL_optinteger(L, 4, 0);
+  formatTimer(s, tme, flags);
+  drawString(L, s, flags);
+  return 0;
+}
+
+static void formatTimer(char* s, int tme, LcdFlags flags)
+{
   TimerOptions timerOptions;
   timerOptions.options = (flags & TIMEHOUR) != 0 ? SHOW_TIME : SHOW_TIMER;
   getTimerString(s, tme, timerOptions);
-  drawString(L, s, flags);
-  return 0;
 }
 
 /*luadoc
@@ -379,6 +536,8 @@ Display a number at (x,y)
 */
 static int luaLcdDrawNumber(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawNumber, 4, boundsNumber);
+
   char s[49];
   int val = luaL_checkinteger(L, 3);
   LcdFlags flags = luaL_optinteger(L, 4, 0);
@@ -401,13 +560,8 @@ See getValue()
 
 @status current Introduced in 2.0.6, changed in 2.1.0 (only telemetry sources are valid)
 */
-static int luaLcdDrawChannel(lua_State *L)
+static int checkChannel(lua_State *L)
 {
-  if (!luaLcdAllowed || !luaLcdBuffer)
-    return 0;
-
-  int x = luaL_checkinteger(L, 1);
-  int y = luaL_checkinteger(L, 2);
   int channel = -1;
   if (lua_isnumber(L, 3)) {
     channel = luaL_checkinteger(L, 3);
@@ -420,6 +574,25 @@ static int luaLcdDrawChannel(lua_State *L)
       channel = field.id;
     }
   }
+  return channel;
+}
+
+// The displayed value is part of the recorded call
+static int32_t channelState(lua_State *L)
+{
+  return getValue(checkChannel(L));
+}
+
+static int luaLcdDrawChannel(lua_State *L)
+{
+  LUA_LCD_RECORD_STATE(L, luaLcdDrawChannel, 4, boundsTextBand, channelState);
+
+  if (!luaLcdAllowed || !luaLcdBuffer)
+    return 0;
+
+  int x = luaL_checkinteger(L, 1);
+  int y = luaL_checkinteger(L, 2);
+  int channel = checkChannel(L);
   LcdFlags flags = luaL_optinteger(L, 4, 0);
   flags = colorToRGB(flags);
   getvalue_t value = getValue(channel);
@@ -444,6 +617,8 @@ displays negated switch
 */
 static int luaLcdDrawSwitch(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawSwitch, 4, boundsTextBand);
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -472,6 +647,8 @@ Displays the name of the corresponding input as defined by the source at (x,y)
 */
 static int luaLcdDrawSource(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawSource, 4, boundsTextBand);
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -686,6 +863,8 @@ Omitting scale draws image in 1:1 scale and is faster than specifying 100 for sc
 */
 static int luaLcdDrawBitmap(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawBitmap, 0, boundsBitmap);
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -724,6 +903,8 @@ Displays a bitmap pattern at (x,y)
 */
 static int luaLcdDrawBitmapPattern(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawBitmapPattern, 4, boundsMask);
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -761,6 +942,8 @@ Displays a bitmap pattern pie at (x,y)
 */
 static int luaLcdDrawBitmapPatternPie(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawBitmapPatternPie, 6, boundsMask);
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -800,6 +983,8 @@ Draw a rectangle from top left corner (x,y) of specified width and height
 */
 static int luaLcdDrawRectangle(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawRectangle, 5, boundsRect);
+
   if (!luaLcdAllowed || !luaLcdBuffer) return 0;
 
   int x = luaL_checkinteger(L, 1);
@@ -836,6 +1021,8 @@ Draw a solid rectangle from top left corner (x,y) of specified width and height
 */
 static int luaLcdDrawFilledRectangle(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawFilledRectangle, 5, boundsRect);
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -873,6 +1060,8 @@ Invert a rectangle zone from top left corner (x,y) of specified width and height
 */
 static int luaLcdInvertRect(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdInvertRect, 5, boundsRect);
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -910,6 +1099,8 @@ Draw a simple gauge that is filled based upon fill value
 */
 static int luaLcdDrawGauge(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawGauge, 7, boundsRect);
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -942,6 +1133,12 @@ Please notice that changing theme colors affects not only other Lua widgets, but
 */
 static int luaLcdSetColor(lua_State *L)
 {
+  // Applied immediately as well, so that lcd.getColor() is consistent
+  if (luaLcdRecorder) {
+    static const LuaDrawOp drawOp = {luaLcdSetColor, 0, nullptr, nullptr};
+    luaLcdRecorder->record(L, &drawOp);
+  }
+
   unsigned int index = COLOR_VAL((uint32_t)luaL_checkinteger(L, 1));
   uint16_t color = COLOR_VAL(colorToRGB(luaL_checkinteger(L, 2)));
 
@@ -1032,6 +1229,8 @@ Draw a circle at (x, y) of specified radius
 */
 static int luaLcdDrawCircle(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawCircle, 4, boundsCircle);
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -1063,6 +1262,8 @@ Draw a filled circle at (x, y) of specified radius
 */
 static int luaLcdDrawFilledCircle(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawFilledCircle, 4, boundsCircle);
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -1092,6 +1293,8 @@ Draw a triangle
 */
 static int luaLcdDrawTriangle(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawTriangle, 7, boundsTriangle);
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -1126,6 +1329,8 @@ Draw a filled triangle
 */
 static int luaLcdDrawFilledTriangle(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawFilledTriangle, 7, boundsTriangle);
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -1162,6 +1367,8 @@ Draw an arc
 */
 static int luaLcdDrawArc(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawArc, 6, boundsCircle);
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -1198,6 +1405,8 @@ Draw a pie slice
 */
 static int luaLcdDrawPie(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawPie, 6, boundsCircle);
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -1234,6 +1443,8 @@ Draw an arc
 */
 static int luaLcdDrawAnnulus(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawAnnulus, 7, boundsAnnulus);
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -1270,6 +1481,8 @@ Draw a line only inside a rectangle
 */
 static int luaLcdDrawLineWithClipping(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawLineWithClipping, 10, boundsLine);
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -1380,6 +1593,8 @@ Draw a rectangle in perspective
 */
 static int luaLcdDrawHudRectangle(lua_State *L)
 {
+  LUA_LCD_RECORD(L, luaLcdDrawHudRectangle, 7, boundsHudRectangle);
+
   if (!luaLcdAllowed || !luaLcdBuffer)
     return 0;
 
@@ -24,5 +24,7 @@
 #include "definitions.h"
 #include "lua_states.h"
 
+#define BITMAP_METATABLE "BITMAP*"
+
 EXTERN_C(LUALIB_API int luaopen_bitmap(lua_State * L));
 EXTERN_C(LUALIB_API int luaopen_lvgl(lua_State * L));
@@ -2175,7 +2175,8 @@ static int luaLoadScript(lua_State * L)
   const char *mode = luaL_optstring(L, 2, NULL);
   int env = (!lua_isnone(L, 3) ? 3 : 0);  // 'env' index or 0 if no 'env'
   lua_settop(L, 0);
-  if (fname != NULL && luaLoadScriptFileToState(L, fname , mode) == SCRIPT_OK) {
+  int status = (fname != NULL ? luaLoadScriptFileToState(L, fname, mode) : SCRIPT_NOFILE);
+  if (status == SCRIPT_OK) {
     if (env != 0) {  // 'env' parameter?
       lua_pushvalue(L, env);  // environment for loaded function
       if (!lua_setupvalue(L, -2, 1))  // set it as 1st upvalue
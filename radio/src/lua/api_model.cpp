@@ -107,7 +107,7 @@ static int luaModelSetInfo(lua_State *L)
     }
     else if (!strcmp(key, "jitterFilter")) {
       auto j = lua_tointeger(L, -1);
-      if (j > OVERRIDE_ON) j = OVERRIDE_ON;
+      if (j > MDLFILTER_KALMAN) j = MDLFILTER_KALMAN;
       g_model.jitterFilter = j;
     }
 #if LCD_DEPTH > 1
@@ -386,6 +386,7 @@ static int luaModelSetTimer(lua_State *L)
       }
     }
     storageDirty(EE_MODEL);
+    invalidateTimersConfig();
   }
   return 0;
 }
@@ -464,6 +465,9 @@ Clear all flightModes
 static int luaModelDeleteFlightModes(lua_State *L)
 {
   memset(g_model.flightModeData, 0, sizeof(g_model.flightModeData));
+#if defined(GVARS)
+  invalidateGVarFlightModes();
+#endif
   return 0;
 }
 
@@ -1567,6 +1571,7 @@ static int luaModelSetCustomFunction(lua_State *L)
       }
     }
     storageDirty(EE_MODEL);
+    invalidateFunctionsIndex(EE_MODEL);
   }
 
   return 0;
@@ -25,4 +25,15 @@
 // wrapper for our custom allocator for Lua
 void *custom_l_alloc(void *ud, void *ptr, size_t osize, size_t nsize);
 int custom_avail();
+
+#if defined(STM32F4)
+#define LUA_ALLOCATOR_UD  nullptr
+#else
+#include "slab_allocator.h"
+// Size classes shared by the states created with 'ud' = LUA_ALLOCATOR_UD.
+// A state created with 'ud' = nullptr uses the heap only.
+#define LUA_SLAB_ALLOCATOR
+#define LUA_ALLOCATOR_UD  (&luaSlab)
+extern SlabAllocator luaSlab;
+#endif
 #endif
@@ -29,6 +29,7 @@
 #include "custom_allocator.h"
 
 #include "lua_api.h"
+#include "lua_bytecode_cache.h"
 #include "lua_event.h"
 
 #include "sdcard.h"
@@ -51,6 +52,16 @@ extern "C" {
 #endif
 #define PERMANENT_SCRIPTS_MAX_INSTRUCTIONS 100
 
+// Instructions a function or telemetry script may run per Lua cycle before
+// it is preempted. Mix scripts run first and are only preempted at the end
+// of the cycle.
+#define SCRIPT_CYCLE_INSTRUCTIONS          (200 * PERMANENT_SCRIPTS_MAX_INSTRUCTIONS)
+
+// Memory growth since the last full collection triggering a new one
+#define GC_FULL_MARGIN                     (16*1024)
+// Largest incremental GC step (in KB) used to pay back a script allocations
+#define GC_MAX_STEP_KB                     32
+
 // #if defined(HARDWARE_TOUCH)
 // #include "touch.h"
 // #endif
@@ -58,6 +69,12 @@ extern "C" {
 // The main thread - lsScripts is now a coroutine
 lua_State * mainState = nullptr;
 lua_State *lsScripts = nullptr;
+#if defined(LUA_MODEL_SCRIPTS)
+// Mix scripts run in their own coroutine, so that they are not held back by
+// a preempted function or telemetry script
+static lua_State * lsMixScripts = nullptr;
+static int mixScriptsRef = LUA_NOREF;
+#endif
 uint8_t luaState = 0;
 uint8_t luaScriptsCount = 0;
 bool    luaLcdAllowed = false;
@@ -68,6 +85,11 @@ uint16_t maxLuaInterval = 0;
 uint16_t maxLuaDuration = 0;
 uint32_t lastLuaTime = 0;
 tmr10ms_t luaCycleStart;
+// Coroutine being resumed, and its instructions budget for this cycle
+static lua_State * luaRunningThread = nullptr;
+static uint32_t luaRunHooks;
+static uint32_t luaRunBudget;
+static uint32_t gcFullThreshold;
 char lua_warning_info[LUA_WARNING_INFO_LEN+1];
 uint8_t errorState;
 struct our_longjmp * global_lj = nullptr;
@@ -122,8 +144,10 @@ int custom_lua_atpanic(lua_State * L)
 static void luaHook(lua_State * L, lua_Debug *ar)
 {
   if (ar->event == LUA_HOOKCOUNT) {
-    if (get_tmr10ms() - luaCycleStart >= LUA_TASK_PERIOD_TICKS) {
-      lua_yield(lsScripts, 0);
+    luaRunHooks++;
+    if (get_tmr10ms() - luaCycleStart >= LUA_TASK_PERIOD_TICKS ||
+        (luaRunBudget && luaRunHooks >= luaRunBudget)) {
+      lua_yield(luaRunningThread ? luaRunningThread : lsScripts, 0);
     }
   }
   
@@ -265,12 +289,17 @@ void luaClose(lua_State ** L)
 
 void luaClose()
 {
+  luaBytecodeCacheClose();
 #if defined(COLORLCD)
   luaClose(&lsWidgets);
 #endif
   // Close main state last
   luaClose(&mainState);
   lsScripts = nullptr;
+#if defined(LUA_MODEL_SCRIPTS)
+  lsMixScripts = nullptr;
+  mixScriptsRef = LUA_NOREF;
+#endif
 }
 
 void luaRegisterLibraries(lua_State * L)
@@ -281,16 +310,11 @@ void luaRegisterLibraries(lua_State * L)
 
 #define GC_REPORT_TRESHOLD    (2*1024)
 
-void luaDoGc(lua_State * L, bool full)
+static void luaGc(lua_State * L, int what, int data)
 {
   if (L) {
     PROTECT_LUA() {
-      if (full) {
-        lua_gc(L, LUA_GCCOLLECT, 0);
-      }
-      else {
-        lua_gc(L, LUA_GCSTEP, 10);
-      }
+      lua_gc(L, what, data);
 // #if defined(DEBUG)
 //       if (L == lsScripts) {
 //         static uint32_t lastgcSctipts = 0;
@@ -323,6 +347,50 @@ void luaDoGc(lua_State * L, bool full)
   }
 }
 
+void luaDoGc(lua_State * L, bool full)
+{
+  if (full) {
+    luaGc(L, LUA_GCCOLLECT, 0);
+  }
+  else {
+    luaGc(L, LUA_GCSTEP, 10);
+  }
+}
+
+// Incremental GC paced by the memory allocated by the last script call, and
+// limited to a basic step when there is no idle time left in the Lua cycle.
+// A full collection is only run when memory grew too much since the last one.
+// Returns the time spent (us).
+static uint32_t luaPaceGc(lua_State * L, uint32_t allocated)
+{
+  uint32_t t0 = timersGetUsTick();
+
+  if (luaGetMemUsed(L) > gcFullThreshold) {
+    luaGc(L, LUA_GCCOLLECT, 0);
+    gcFullThreshold = luaGetMemUsed(L) + GC_FULL_MARGIN;
+  }
+  else if (get_tmr10ms() - luaCycleStart < LUA_TASK_PERIOD_TICKS - 1) {
+    luaGc(L, LUA_GCSTEP, min<int>((allocated >> 10) + 1, GC_MAX_STEP_KB));
+  }
+  else {
+    luaGc(L, LUA_GCSTEP, 0);
+  }
+
+  return timersGetUsTick() - t0;
+}
+
+#if defined(LUA_MODEL_SCRIPTS)
+// (Re)create the mix scripts coroutine. It is anchored in the registry, so
+// that 'lsScripts' stays on top of the main stack.
+static void luaNewMixScriptsThread()
+{
+  if (mixScriptsRef != LUA_NOREF)
+    luaL_unref(mainState, LUA_REGISTRYINDEX, mixScriptsRef);
+  lsMixScripts = lua_newthread(mainState);
+  mixScriptsRef = luaL_ref(mainState, LUA_REGISTRYINDEX);
+}
+#endif
+
 void luaFree(lua_State * L, ScriptInternalData & sid)
 {
   PROTECT_LUA() {
@@ -477,13 +545,21 @@ int luaLoadScriptFileToState(lua_State * L, const char * filename, const char *
   }
   strncat(filenameFull, filename, fnamelen);
 
+  // check if text version exists
+  strcpy(filenameFull + fnamelen, SCRIPT_EXT);
+  frLuaS = f_stat(filenameFull, &fnoLuaS);
+
+  // the bytecode cache holds the compiled version of unchanged sources
+  if (frLuaS == FR_OK && strchr(lmode, 'b') && !strchr(lmode, 'c') &&
+      luaBytecodeCache.load(L, filenameFull, fnoLuaS, !strchr(lmode, 'd'))) {
+    TRACE("luaLoadScriptFileToState(%s, %s): loaded from bytecode cache", filename, lmode);
+    return SCRIPT_OK;
+  }
+
   // check if binary version exists
   strcpy(filenameFull + fnamelen, SCRIPT_BIN_EXT);
   frLuaC = f_stat(filenameFull, &fnoLuaC);
-
-  // check if text version exists
   strcpy(filenameFull + fnamelen, SCRIPT_EXT);
-  frLuaS = f_stat(filenameFull, &fnoLuaS);
 
   // decide which version to load, text or binary
   if (frLuaC != FR_OK && frLuaS == FR_OK) {
@@ -558,8 +634,12 @@ int luaLoadScriptFileToState(lua_State * L, const char * filename, const char *
   }
   if (lstatus == LUA_OK) {
     if (scriptNeedsCompile && loadFileType == 1) {
-      strcpy(filenameFull + fnamelen, SCRIPT_BIN_EXT);
-      luaDumpState(L, filenameFull, &fnoLuaS, (strchr(lmode, 'd') ? 0 : 1));
+      int stripDebug = strchr(lmode, 'd') ? 0 : 1;
+      if (!luaBytecodeCache.store(L, filenameFull, fnoLuaS, stripDebug)) {
+        // cache not available: fall back to a .luac file
+        strcpy(filenameFull + fnamelen, SCRIPT_BIN_EXT);
+        luaDumpState(L, filenameFull, &fnoLuaS, stripDebug);
+      }
     }
     ret = SCRIPT_OK;
   }
@@ -585,7 +665,7 @@ int luaLoadScriptFileToState(lua_State * L, const char * filename, const char *
 }
 
 // Get the name of a script for error reporting etc.
-static const char * getScriptName(uint8_t idx)
+const char * luaGetScriptName(uint8_t idx)
 {
   int ref = scriptInternalData[idx].reference;
 
@@ -849,7 +929,7 @@ static int luaRegisterFunction(const char * key)
   }
   else {
     if (typ != LUA_TNIL) {
-      TRACE_ERROR("luaRegisterFunction(%s): Error: '%.*s' is not a function\n", LEN_SCRIPT_FILENAME, getScriptName(luaScriptsCount - 1), key);
+      TRACE_ERROR("luaRegisterFunction(%s): Error: '%.*s' is not a function\n", LEN_SCRIPT_FILENAME, luaGetScriptName(luaScriptsCount - 1), key);
     }
     lua_pop(lsScripts, 1);
     return LUA_REFNIL;
@@ -960,7 +1040,7 @@ static void luaLoadScripts(bool init, const char * filename = nullptr)
             sid.background = luaRegisterFunction("background");
             initFunction = luaRegisterFunction("init");
             if (sid.run == LUA_REFNIL) {
-              snprintf(lua_warning_info, LUA_WARNING_INFO_LEN, "luaLoadScripts(%.*s): No run function\n", LEN_SCRIPT_FILENAME, getScriptName(idx));
+              snprintf(lua_warning_info, LUA_WARNING_INFO_LEN, "luaLoadScripts(%.*s): No run function\n", LEN_SCRIPT_FILENAME, luaGetScriptName(idx));
               sid.state = SCRIPT_SYNTAX_ERROR;
               initFunction = LUA_REFNIL;
             }
@@ -978,7 +1058,7 @@ static void luaLoadScripts(bool init, const char * filename = nullptr)
 #endif
           }
           else {
-            snprintf(lua_warning_info, LUA_WARNING_INFO_LEN, "luaLoadScripts(%.*s): The script did not return a table\n", LEN_SCRIPT_FILENAME, getScriptName(idx));
+            snprintf(lua_warning_info, LUA_WARNING_INFO_LEN, "luaLoadScripts(%.*s): The script did not return a table\n", LEN_SCRIPT_FILENAME, luaGetScriptName(idx));
             sid.state = SCRIPT_SYNTAX_ERROR;
             initFunction = LUA_REFNIL;
           }
@@ -1016,6 +1096,7 @@ static void luaLoadScripts(bool init, const char * filename = nullptr)
   } while(++ref < SCRIPT_REF_LAST);
  
   // Loading has finished - start running scripts
+  luaBytecodeCacheClose();
   luaState = INTERPRETER_START_RUNNING;
 
 } // luaLoadScripts
@@ -1030,6 +1111,130 @@ void luaExec(const char * filename)
 }
 #endif
 
+// Resume a call of 'sid' on coroutine 'L' (for a new call, the function and
+// its 'nargs' arguments are already pushed). The call is preempted after
+// 'budget' instructions in this cycle (0 means until the end of the cycle).
+static int luaResumeScript(lua_State * L, ScriptInternalData & sid, int nargs,
+                           uint32_t budget)
+{
+  ScriptStats & stats = sid.stats;
+
+  if (lua_status(L) == LUA_OK) {
+    stats.callTime = 0;
+    stats.callInstructions = 0;
+    stats.callMemStart = luaGetMemUsed(L);
+  }
+
+  luaRunningThread = L;
+  luaRunHooks = 0;
+  luaRunBudget = budget / PERMANENT_SCRIPTS_MAX_INSTRUCTIONS;
+
+  uint32_t t0 = timersGetUsTick();
+  int luaStatus = lua_resume(L, nullptr, nargs);
+  stats.callTime += timersGetUsTick() - t0;
+  stats.callInstructions += luaRunHooks * PERMANENT_SCRIPTS_MAX_INSTRUCTIONS;
+
+  luaRunningThread = nullptr;
+  luaRunBudget = 0;
+  stats.callPreempted = (luaStatus == LUA_YIELD);
+
+  if (luaStatus == LUA_YIELD) {
+    if (get_tmr10ms() - luaCycleStart >= LUA_TASK_PERIOD_TICKS)
+      stats.overruns++;
+    else
+      stats.preemptions++;
+  }
+  else if (luaStatus == LUA_OK) {
+    uint32_t memUsed = luaGetMemUsed(L);
+    stats.runs++;
+    stats.instructions = stats.callInstructions;
+    stats.lastTime = stats.callTime;
+    stats.maxTime = max(stats.maxTime, stats.lastTime);
+    stats.lastAlloc = memUsed > stats.callMemStart ? memUsed - stats.callMemStart : 0;
+    stats.maxAlloc = max(stats.maxAlloc, stats.lastAlloc);
+    sid.instructions = min<uint32_t>(100 * stats.instructions / SCRIPT_CYCLE_INSTRUCTIONS, 255);
+
+    // The script pays for its own garbage
+    stats.gcTime = luaPaceGc(lsScripts, stats.lastAlloc);
+    stats.maxGcTime = max(stats.maxGcTime, stats.gcTime);
+  }
+
+  return luaStatus;
+}
+
+#if defined(LUA_MODEL_SCRIPTS)
+// Run the mix scripts, ahead of any other script. Returns false if they were
+// preempted by the end of the cycle.
+static bool resumeMixScripts(bool init, bool & scriptWasRun)
+{
+  static uint8_t idx;
+  if (init) idx = 0;
+
+  for (; idx < luaScriptsCount; idx++) {
+    ScriptInternalData & sid = scriptInternalData[idx];
+    uint8_t ref = sid.reference;
+
+    if (ref > SCRIPT_MIX_LAST || sid.state != SCRIPT_OK) continue;
+
+    ScriptInputsOutputs * sio = & scriptInputsOutputs[ref - SCRIPT_MIX_FIRST];
+    int inputsCount = 0;
+
+    if (lua_status(lsMixScripts) == LUA_OK) {
+      // Not preempted - setup another function call
+      lua_settop(lsMixScripts, 0);
+      lua_rawgeti(lsMixScripts, LUA_REGISTRYINDEX, sid.run);
+
+      ScriptData & sd = g_model.scriptsData[ref - SCRIPT_MIX_FIRST];
+      inputsCount = sio -> inputsCount;
+
+      for (int j = 0; j < inputsCount; j++) {
+        if (sio->inputs[j].type == INPUT_TYPE_SOURCE)
+          luaGetValueAndPush(lsMixScripts, sd.inputs[j].source);
+        else
+          lua_pushinteger(lsMixScripts,
+                          sd.inputs[j].value + sio->inputs[j].def);
+      }
+    }
+
+    int luaStatus = luaResumeScript(lsMixScripts, sid, inputsCount, 0);
+
+    if (luaStatus == LUA_YIELD) {
+      // Coroutine yielded - finish in the next cycle
+      return false;
+    }
+
+    scriptWasRun = true;
+
+    if (luaStatus == LUA_OK) {
+      lua_settop(lsMixScripts, sio -> outputsCount);
+
+      for (int j = sio -> outputsCount - 1; j >= 0; j--) {
+        if (!lua_isnumber(lsMixScripts, -1)) {
+          sid.state = SCRIPT_SYNTAX_ERROR;
+          snprintf(lua_warning_info, LUA_WARNING_INFO_LEN, "Script %.*s: run function did not return a number\n", LEN_SCRIPT_FILENAME, luaGetScriptName(idx));
+          luaError(lsMixScripts, sid.state);
+          break;
+        }
+        sio -> outputs[j].value = lua_tointeger(lsMixScripts, -1);
+        lua_pop(lsMixScripts, 1);
+      }
+    }
+    else {
+      // Error
+      sid.state = SCRIPT_SYNTAX_ERROR;
+      luaError(lsMixScripts, sid.state);
+
+      // Replace the dead coroutine with a new one
+      luaNewMixScriptsThread();
+      luaFree(lsScripts, sid);
+    }
+  }
+
+  idx = 0;
+  return true;
+}
+#endif
+
 static bool resumeLua(bool init, bool allowLcdUsage)
 {
   static uint8_t idx;
@@ -1037,11 +1242,21 @@ static bool resumeLua(bool init, bool allowLcdUsage)
   if (init) idx = 0;
 
   bool scriptWasRun = false;
-  bool fullGC = !allowLcdUsage;
 #if !defined(COLORLCD)
   static uint8_t luaDisplayStatistics = false;
 #endif
 
+#if defined(LUA_MODEL_SCRIPTS)
+  // Mix scripts first, whatever the state of the other scripts
+  if (!allowLcdUsage) {
+    bool lcdAllowed = luaLcdAllowed;
+    luaLcdAllowed = false;
+    bool mixDone = resumeMixScripts(init, scriptWasRun);
+    luaLcdAllowed = lcdAllowed;
+    if (!mixDone) return scriptWasRun;
+  }
+#endif
+
   // Run in the right interactive mode
   if (lua_status(lsScripts) == LUA_YIELD && allowLcdUsage != luaLcdAllowed) {
 #if defined(PCBTARANIS)
@@ -1079,7 +1294,12 @@ static bool resumeLua(bool init, bool allowLcdUsage)
 
       continue;
     }
-    
+
+#if defined(LUA_MODEL_SCRIPTS)
+    // Mix scripts have their own coroutine
+    if (ref <= SCRIPT_MIX_LAST) continue;
+#endif
+
     int inputsCount = 0;
     int luaStatus = lua_status(lsScripts);
 
@@ -1103,23 +1323,6 @@ static bool resumeLua(bool init, bool allowLcdUsage)
       } else
 #endif
       {
-#if defined(LUA_MODEL_SCRIPTS)
-        if (ref <= SCRIPT_MIX_LAST) {
-          lua_rawgeti(lsScripts, LUA_REGISTRYINDEX, sid.run);
-         
-          ScriptData & sd = g_model.scriptsData[ref - SCRIPT_MIX_FIRST];
-          ScriptInputsOutputs * sio = & scriptInputsOutputs[ref - SCRIPT_MIX_FIRST];
-          inputsCount = sio -> inputsCount;
-
-          for (int j = 0; j < inputsCount; j++) {
-            if (sio->inputs[j].type == INPUT_TYPE_SOURCE)
-              luaGetValueAndPush(lsScripts, sd.inputs[j].source);
-            else
-              lua_pushinteger(lsScripts,
-                              sd.inputs[j].value + sio->inputs[j].def);
-          }
-        } else
-#endif
         if (ref <= SCRIPT_GFUNC_LAST) {
           uint8_t idx;
           CustomFunctionData * fn;
@@ -1159,12 +1362,10 @@ static bool resumeLua(bool init, bool allowLcdUsage)
       }
     }
     
-    // Full garbage collection at the start of every cycle
-    luaDoGc(lsScripts, fullGC);
-    fullGC = false;
-
-    // Resume running the coroutine
-    luaStatus = lua_resume(lsScripts, nullptr, inputsCount);
+    // Resume running the coroutine, with a per script budget in the
+    // background (the standalone / telemetry screen owns the foreground)
+    luaStatus = luaResumeScript(lsScripts, sid, inputsCount,
+                                allowLcdUsage ? 0 : SCRIPT_CYCLE_INSTRUCTIONS);
 
     if (luaStatus == LUA_YIELD) {
       // Coroutine yielded - wait for the next cycle
@@ -1174,23 +1375,6 @@ static bool resumeLua(bool init, bool allowLcdUsage)
       // Coroutine returned
       scriptWasRun = true;
       
-#if defined(LUA_MODEL_SCRIPTS)
-      if (ref <= SCRIPT_MIX_LAST) {
-        ScriptInputsOutputs * sio = & scriptInputsOutputs[ref - SCRIPT_MIX_FIRST];
-        lua_settop(lsScripts, sio -> outputsCount);
-
-        for (int j = sio -> outputsCount - 1; j >= 0; j--) {
-          if (!lua_isnumber(lsScripts, -1)) {
-            sid.state = SCRIPT_SYNTAX_ERROR;
-            snprintf(lua_warning_info, LUA_WARNING_INFO_LEN, "Script %.*s: run function did not return a number\n", LEN_SCRIPT_FILENAME, getScriptName(idx));
-            luaError(lsScripts, sid.state);
-            break;
-          }
-          sio -> outputs[j].value = lua_tointeger(lsScripts, -1);
-          lua_pop(lsScripts, 1);
-        }
-      } else
-#endif
 #if !defined(COLORLCD)
       if (ref == SCRIPT_STANDALONE) {
         lua_settop(lsScripts, 1);
@@ -1253,7 +1437,6 @@ static bool resumeLua(bool init, bool allowLcdUsage)
       lua_pop(mainState, 1);  // Pop the dead coroutine off the main stack
       lsScripts = lua_newthread(mainState);  // Push the new coroutine
       luaFree(lsScripts, sid);
-      luaDoGc(lsScripts, true);
     }
     
     scriptWasRun = true;
@@ -1308,14 +1491,132 @@ bool luaTask(bool allowLcdUsage)
   return scriptWasRun;
 }
 
-void checkLuaMemoryUsage()
+int luaGetGreediestScript()
+{
+  int greediest = -1;
+  for (int i = 0; i < luaScriptsCount; i++) {
+    if (scriptInternalData[i].state != SCRIPT_OK) continue;
+    if (greediest < 0 || scriptInternalData[i].stats.maxTime >
+                             scriptInternalData[greediest].stats.maxTime)
+      greediest = i;
+  }
+  return greediest;
+}
+
+// Script holding the most memory right now: the growth of its preempted call,
+// or else of its last call. None if 'othersAlloc', the growth of the memory
+// counted in the limit but not owned by any script, is larger.
+int luaGetGreediestAllocator(uint32_t othersAlloc)
 {
+  uint32_t memUsed = luaGetMemUsed(lsScripts);
+  int greediest = -1;
+  uint32_t greediestAlloc = othersAlloc;
+  for (int i = 0; i < luaScriptsCount; i++) {
+    if (scriptInternalData[i].state != SCRIPT_OK) continue;
+    const ScriptStats & stats = scriptInternalData[i].stats;
+    uint32_t alloc = stats.lastAlloc;
+    if (stats.callPreempted)
+      alloc = memUsed > stats.callMemStart ? memUsed - stats.callMemStart : 0;
+    if (alloc > greediestAlloc) {
+      greediest = i;
+      greediestAlloc = alloc;
+    }
+  }
+  return greediest;
+}
+
+void luaResetScriptStats()
+{
+  for (int i = 0; i < luaScriptsCount; i++) {
+    ScriptStats & stats = scriptInternalData[i].stats;
+    stats.runs = 0;
+    stats.maxTime = 0;
+    stats.maxGcTime = 0;
+    stats.maxAlloc = 0;
+    stats.preemptions = 0;
+    stats.overruns = 0;
+  }
+}
+
 #if (LUA_MEM_MAX > 0)
+static uint32_t luaGetTotalMemUsed()
+{
   uint32_t totalMemUsed = luaGetMemUsed(lsScripts);
 #if defined(COLORLCD)
   totalMemUsed += luaGetMemUsed(lsWidgets);
   totalMemUsed += luaExtraMemoryUsage;
 #endif
+  return totalMemUsed;
+}
+
+#if defined(COLORLCD)
+// Growth of the widgets memory, bitmaps included, since the previous check.
+// Measured over the whole check period, it weighs more than the last call of
+// a script: a script is only blamed when it clearly holds more.
+static uint32_t luaGetWidgetsAlloc()
+{
+  static uint32_t lastWidgetsMem;
+  uint32_t widgetsMem = luaGetMemUsed(lsWidgets) + luaExtraMemoryUsage;
+  uint32_t alloc = widgetsMem > lastWidgetsMem ? widgetsMem - lastWidgetsMem : 0;
+  lastWidgetsMem = widgetsMem;
+  return alloc;
+}
+#endif
+
+// Stop the script holding the most memory, instead of the whole of Lua. The
+// calls of the other scripts are left alone. Nothing is stopped when the
+// memory was taken by something else ('othersAlloc').
+static bool luaKillGreediestAllocator(uint32_t othersAlloc)
+{
+  int victim = luaGetGreediestAllocator(othersAlloc);
+  if (victim < 0) return false;
+
+  bool killed = false;
+  PROTECT_LUA() {
+    ScriptInternalData & sid = scriptInternalData[victim];
+    TRACE_ERROR("checkLuaMemoryUsage(): stopping %.*s\n", LEN_SCRIPT_FILENAME,
+                luaGetScriptName(victim));
+    sid.state = SCRIPT_PANIC;
+    snprintf(lua_warning_info, LUA_WARNING_INFO_LEN,
+             "Script %.*s: stopped, memory limit reached\n",
+             LEN_SCRIPT_FILENAME, luaGetScriptName(victim));
+    lua_pushstring(mainState, lua_warning_info);
+    luaError(mainState, sid.state);
+    lua_pop(mainState, 1);
+
+    // Its own preempted call cannot be resumed any more
+    if (sid.stats.callPreempted) {
+#if defined(LUA_MODEL_SCRIPTS)
+      if (sid.reference <= SCRIPT_MIX_LAST) {
+        luaNewMixScriptsThread();
+      } else
+#endif
+      {
+        lua_pop(mainState, 1);
+        lsScripts = lua_newthread(mainState);
+      }
+      sid.stats.callPreempted = false;
+    }
+    luaFree(mainState, sid);
+    killed = true;
+  }
+  UNPROTECT_LUA();
+  return killed;
+}
+#endif
+
+void checkLuaMemoryUsage()
+{
+#if (LUA_MEM_MAX > 0)
+  uint32_t othersAlloc = 0;
+#if defined(COLORLCD)
+  othersAlloc = luaGetWidgetsAlloc();
+#endif
+  uint32_t totalMemUsed = luaGetTotalMemUsed();
+  if (totalMemUsed > LUA_MEM_MAX && luaState == INTERPRETER_RUNNING &&
+      luaKillGreediestAllocator(othersAlloc)) {
+    totalMemUsed = luaGetTotalMemUsed();
+  }
   if (totalMemUsed > LUA_MEM_MAX) {
     TRACE_ERROR("checkLuaMemoryUsage(): max limit reached (%u), killing Lua\n", totalMemUsed);
     // disable Lua scripts
@@ -1335,7 +1636,7 @@ void luaInitMainState()
   if (mainState != nullptr) return;
 
 #if defined(USE_CUSTOM_ALLOCATOR)
-  mainState = lua_newstate(custom_l_alloc, nullptr);   //we use our own allocator!
+  mainState = lua_newstate(custom_l_alloc, LUA_ALLOCATOR_UD);   //we use our own allocator!
 #elif defined(LUA_ALLOCATOR_TRACER)
   memclear(&lsScriptsTrace, sizeof(lsScriptsTrace));
   lsScriptsTrace.script = "lua_newstate(scripts)";
@@ -1369,11 +1670,22 @@ void luaInit()
         lua_gc(lsScripts, LUA_GCCOLLECT, 0);
         lsScripts = nullptr;
       }
+#if defined(LUA_MODEL_SCRIPTS)
+      if (mixScriptsRef != LUA_NOREF) {
+        luaL_unref(mainState, LUA_REGISTRYINDEX, mixScriptsRef);
+        mixScriptsRef = LUA_NOREF;
+        lsMixScripts = nullptr;
+      }
+#endif
       lua_settop(mainState, 0);
       lua_gc(mainState, LUA_GCCOLLECT, 0);
+      gcFullThreshold = luaGetMemUsed(mainState) + GC_FULL_MARGIN;
 
       // lsScripts is now a coroutine in lieu of the main thread to support preemption
       lsScripts = lua_newthread(mainState);
+#if defined(LUA_MODEL_SCRIPTS)
+      luaNewMixScriptsThread();
+#endif
      
       // Clear loaded scripts
       memclear(scriptInternalData, sizeof(scriptInternalData));
@@ -143,12 +143,34 @@ enum ScriptReference {
 #endif
 };
 
+// Per-script accounting, updated each time a run() or background() call
+// completes. Times are in us, memory in bytes.
+struct ScriptStats {
+  uint32_t runs;          // completed calls
+  uint32_t instructions;  // instructions of the last call
+  uint32_t lastTime;      // wall time of the last call (all slices)
+  uint32_t maxTime;
+  uint32_t gcTime;        // GC time paid after the last call
+  uint32_t maxGcTime;
+  uint32_t lastAlloc;     // memory growth of the last call
+  uint32_t maxAlloc;
+  uint16_t preemptions;   // calls which did not complete within their budget
+  uint16_t overruns;      // calls preempted by the end of the Lua cycle
+
+  // call in progress
+  uint32_t callTime;
+  uint32_t callInstructions;
+  uint32_t callMemStart;
+  bool callPreempted;     // waiting to be resumed in the next cycle
+};
+
 struct ScriptInternalData {
   uint8_t reference;
   uint8_t state;
   int run;
   int background;
-  uint8_t instructions;
+  uint8_t instructions;   // % of the per cycle budget used by the last call
+  ScriptStats stats;
 #if defined(COLORLCD)  
   bool useLvgl;
 #endif
@@ -182,6 +204,10 @@ extern ScriptInputsOutputs scriptInputsOutputs[MAX_SCRIPTS];
 
 bool luaTask(bool allowLcdUsage);
 void checkLuaMemoryUsage();
+const char * luaGetScriptName(uint8_t idx);
+int luaGetGreediestScript();
+int luaGetGreediestAllocator(uint32_t othersAlloc);
+void luaResetScriptStats();
 void luaExec(const char * filename);
 bool isTelemetryScriptAvailable();
 
@@ -0,0 +1,392 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "lua_bytecode_cache.h"
+
+#if defined(LUA_COMPILER)
+
+#include <ctype.h>
+#include <string.h>
+
+#include "edgetx.h"
+#include "sdcard.h"
+
+extern "C" {
+  #include <lundump.h>
+}
+
+#define BYTECODE_CACHE_MAGIC    "ELBC"
+#define BYTECODE_CACHE_VERSION  1
+
+#define ENTRY_STRIPPED          0x01
+
+LuaBytecodeCache luaBytecodeCache(SCRIPTS_PATH "/luacache.bin");
+
+// Buffer shared by reads, writes and compaction (guarded by the cache mutex)
+static uint8_t cacheBuffer[256];
+
+// FAT file names are case insensitive
+static uint32_t hashPath(const char* path)
+{
+  uint32_t hash = 2166136261u;  // FNV-1a
+  while (*path) {
+    hash ^= (uint8_t)tolower(*path++);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+static uint32_t sourceDate(const FILINFO& source)
+{
+  return ((uint32_t)source.fdate << 16) | source.ftime;
+}
+
+static bool writeData(FIL* file, const void* data, UINT size)
+{
+  UINT written;
+  return f_write(file, data, size, &written) == FR_OK && written == size;
+}
+
+static bool readData(FIL* file, void* data, UINT size)
+{
+  UINT read;
+  return f_read(file, data, size, &read) == FR_OK && read == size;
+}
+
+struct CacheWriter {
+  FIL* file;
+  uint32_t length;
+  UINT pos;
+  bool error;
+
+  bool flush()
+  {
+    if (pos > 0 && !error) error = !writeData(file, cacheBuffer, pos);
+    pos = 0;
+    return !error;
+  }
+};
+
+// callback for luaU_dump()
+static int writeChunk(lua_State* L, const void* p, size_t size, void* ud)
+{
+  UNUSED(L);
+  auto writer = (CacheWriter*)ud;
+  auto b = (const uint8_t*)p;
+  writer->length += size;
+  while (size > 0 && !writer->error) {
+    size_t len = min(size, sizeof(cacheBuffer) - writer->pos);
+    memcpy(&cacheBuffer[writer->pos], b, len);
+    writer->pos += len;
+    size -= len;
+    b += len;
+    if (writer->pos >= sizeof(cacheBuffer)) writer->flush();
+  }
+  return writer->error;
+}
+
+struct CacheReader {
+  FIL* file;
+  uint32_t remaining;
+};
+
+// callback for lua_load()
+static const char* readChunk(lua_State* L, void* ud, size_t* size)
+{
+  UNUSED(L);
+  auto reader = (CacheReader*)ud;
+  UINT len = min<uint32_t>(reader->remaining, sizeof(cacheBuffer));
+  UINT read = 0;
+  if (len == 0 || f_read(reader->file, cacheBuffer, len, &read) != FR_OK) {
+    read = 0;
+  }
+  reader->remaining -= read;
+  *size = read;
+  return read ? (const char*)cacheBuffer : nullptr;
+}
+
+mutex_handle_t* LuaBytecodeCache::getMutex()
+{
+  if (!mutexCreated) {
+    mutex_create(&mutex);
+    mutexCreated = true;
+  }
+  return &mutex;
+}
+
+void LuaBytecodeCache::reset()
+{
+  memcpy(header.magic, BYTECODE_CACHE_MAGIC, sizeof(header.magic));
+  header.version = BYTECODE_CACHE_VERSION;
+  header.format = LUAC_VERSION;
+  header.count = 0;
+  header.indexOffset = sizeof(Header);
+  header.stale = 0;
+  index.clear();
+}
+
+bool LuaBytecodeCache::readIndex()
+{
+  if (f_lseek(&file, 0) != FR_OK || !readData(&file, &header, sizeof(header)))
+    return false;
+
+  if (memcmp(header.magic, BYTECODE_CACHE_MAGIC, sizeof(header.magic)) ||
+      header.version != BYTECODE_CACHE_VERSION ||
+      header.format != LUAC_VERSION || header.indexOffset < sizeof(Header))
+    return false;
+
+  index.resize(header.count);
+  if (header.count == 0) return true;
+
+  return f_lseek(&file, header.indexOffset) == FR_OK &&
+         readData(&file, index.data(), header.count * sizeof(Entry));
+}
+
+bool LuaBytecodeCache::writeIndex(uint32_t offset)
+{
+  if (f_lseek(&file, offset) != FR_OK ||
+      (!index.empty() &&
+       !writeData(&file, index.data(), index.size() * sizeof(Entry))))
+    return false;
+
+  // The header is written last: until then it points at the previous index
+  header.count = index.size();
+  header.indexOffset = offset;
+  return f_lseek(&file, 0) == FR_OK &&
+         writeData(&file, &header, sizeof(header));
+}
+
+bool LuaBytecodeCache::open(bool write)
+{
+  if (opened && (writable || !write)) return true;
+
+  if (opened) {
+    // reopen for writing
+    f_close(&file);
+    opened = false;
+  }
+
+  BYTE mode = write ? (FA_READ | FA_WRITE | FA_OPEN_ALWAYS) : FA_READ;
+  if (f_open(&file, path, mode) != FR_OK) return false;
+
+  opened = true;
+  writable = write;
+
+  if (!readIndex()) {
+    // missing, outdated or corrupted: start again
+    reset();
+    if (write && !writeIndex(sizeof(Header))) {
+      TRACE("LuaBytecodeCache: cannot initialize %s", path);
+      f_close(&file);
+      opened = writable = false;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+uint32_t LuaBytecodeCache::end() const
+{
+  return header.indexOffset + header.count * sizeof(Entry);
+}
+
+int LuaBytecodeCache::find(uint32_t hash) const
+{
+  for (unsigned i = 0; i < index.size(); i++) {
+    if (index[i].hash == hash) return i;
+  }
+  return -1;
+}
+
+void LuaBytecodeCache::remove(int idx)
+{
+  header.stale += index[idx].length;
+  index.erase(index.begin() + idx);
+}
+
+bool LuaBytecodeCache::seek(const char* filename, const FILINFO& source,
+                            bool stripDebug, uint32_t& length)
+{
+  int idx = find(hashPath(filename));
+  if (idx < 0) return false;
+
+  const Entry& entry = index[idx];
+  if (entry.date != sourceDate(source) || entry.size != source.fsize ||
+      entry.flags != (stripDebug ? ENTRY_STRIPPED : 0u))
+    return false;
+
+  // Check the path, in case of a hash collision
+  uint16_t len;
+  if (f_lseek(&file, entry.offset) != FR_OK || !readData(&file, &len, sizeof(len)) ||
+      len != strlen(filename) || len >= sizeof(cacheBuffer) ||
+      sizeof(len) + len > entry.length || !readData(&file, cacheBuffer, len) ||
+      strncasecmp((const char*)cacheBuffer, filename, len))
+    return false;
+
+  length = entry.length - sizeof(len) - len;
+  return true;
+}
+
+bool LuaBytecodeCache::load(lua_State* L, const char* filename,
+                            const FILINFO& source, bool stripDebug)
+{
+  // Pushed before locking: a memory error would not release the mutex
+  lua_pushfstring(L, "@%s", filename);
+
+  MutexLock lock = MutexLock::MakeInstance(getMutex());
+
+  CacheReader reader = {&file, 0};
+  if (!open(false) || !seek(filename, source, stripDebug, reader.remaining)) {
+    lua_pop(L, 1);  // chunk name
+    return false;
+  }
+
+  int status = lua_load(L, readChunk, &reader, lua_tostring(L, -1), "b");
+  lua_remove(L, -2);  // chunk name
+
+  if (status != LUA_OK) {
+    TRACE("LuaBytecodeCache::load(%s): %s", filename, lua_tostring(L, -1));
+    lua_pop(L, 1);
+    return false;
+  }
+
+  return true;
+}
+
+bool LuaBytecodeCache::store(lua_State* L, const char* filename,
+                             const FILINFO& source, bool stripDebug)
+{
+  MutexLock lock = MutexLock::MakeInstance(getMutex());
+
+  size_t pathLen = strlen(filename);
+  if (pathLen >= sizeof(cacheBuffer) || !lua_isfunction(L, -1) ||
+      !open(true))
+    return false;
+
+  int idx = find(hashPath(filename));
+  if (idx >= 0) remove(idx);
+
+  // New blob and index go after the current index, which becomes stale
+  uint32_t offset = end();
+  header.stale += header.count * sizeof(Entry);
+
+  uint16_t len = pathLen;
+  CacheWriter writer = {&file, 0, 0, false};
+  if (f_lseek(&file, offset) == FR_OK && writeData(&file, &len, sizeof(len)) &&
+      writeData(&file, filename, len)) {
+    lua_lock(L);
+    luaU_dump(L, getproto(L->top - 1), writeChunk, &writer, stripDebug);
+    lua_unlock(L);
+    writer.flush();
+  }
+  else {
+    writer.error = true;
+  }
+
+  Entry entry = {hashPath(filename), sourceDate(source), (uint32_t)source.fsize,
+                 offset, (uint32_t)(sizeof(len) + len + writer.length),
+                 stripDebug ? ENTRY_STRIPPED : 0u};
+
+  if (!writer.error) {
+    index.push_back(entry);
+    if (writeIndex(offset + entry.length)) {
+      TRACE("LuaBytecodeCache::store(%s): %u bytes", filename, entry.length);
+      return true;
+    }
+  }
+
+  // The header on disk still describes the previous index
+  TRACE("LuaBytecodeCache::store(%s): error", filename);
+  if (!readIndex()) reset();
+  return false;
+}
+
+bool LuaBytecodeCache::compact()
+{
+  char tmpPath[FF_MAX_LFN + 1];
+  snprintf(tmpPath, sizeof(tmpPath), "%s.tmp", path);
+
+  FIL out;
+  if (f_open(&out, tmpPath, FA_WRITE | FA_CREATE_ALWAYS) != FR_OK) return false;
+
+  Header newHeader = header;
+  newHeader.stale = 0;
+  std::vector<Entry> newIndex(index);
+
+  bool ok = writeData(&out, &newHeader, sizeof(newHeader));
+  uint32_t offset = sizeof(Header);
+
+  for (auto& entry : newIndex) {
+    if (!ok || f_lseek(&file, entry.offset) != FR_OK) {
+      ok = false;
+      break;
+    }
+    for (uint32_t remaining = entry.length; ok && remaining > 0;) {
+      UINT len = min<uint32_t>(remaining, sizeof(cacheBuffer));
+      ok = readData(&file, cacheBuffer, len) && writeData(&out, cacheBuffer, len);
+      remaining -= len;
+    }
+    entry.offset = offset;
+    offset += entry.length;
+  }
+
+  if (ok && !newIndex.empty()) {
+    ok = writeData(&out, newIndex.data(), newIndex.size() * sizeof(Entry));
+  }
+  if (ok) {
+    newHeader.count = newIndex.size();
+    newHeader.indexOffset = offset;
+    ok = f_lseek(&out, 0) == FR_OK &&
+         writeData(&out, &newHeader, sizeof(newHeader));
+  }
+
+  f_close(&out);
+  f_close(&file);
+  opened = writable = false;
+
+  if (!ok || f_unlink(path) != FR_OK || f_rename(tmpPath, path) != FR_OK) {
+    TRACE("LuaBytecodeCache: compaction of %s failed", path);
+    f_unlink(tmpPath);
+    return false;
+  }
+
+  TRACE("LuaBytecodeCache: compacted %s to %u bytes", path, offset);
+  return true;
+}
+
+void LuaBytecodeCache::close()
+{
+  MutexLock lock = MutexLock::MakeInstance(getMutex());
+
+  if (!opened) return;
+
+  if (writable && header.stale > LUA_BYTECODE_CACHE_COMPACT_SIZE &&
+      header.stale > end() - header.stale) {
+    compact();
+  }
+
+  if (opened) f_close(&file);
+  opened = writable = false;
+  index.clear();
+}
+
+#endif  // LUA_COMPILER
@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "ff.h"
+#include "lua_states.h"
+#include "os/task.h"
+
+#if defined(LUA_COMPILER)
+
+// Stale data above which the archive is compacted on close()
+#define LUA_BYTECODE_CACHE_COMPACT_SIZE  (32 * 1024)
+
+// Single indexed archive of precompiled scripts, used in lieu of a .luac file
+// beside each source file:
+//
+//   header | blob | blob | ... | index
+//
+// A blob holds the script path followed by its bytecode. An index entry holds
+// the hash of the path, the date and size of the source the bytecode was
+// compiled from, and the location of the blob.
+//
+// The archive is opened once and entries are read with a seek. New entries
+// are appended together with a new index, then the header is updated to
+// point at it, so that an interrupted write leaves the previous index valid.
+//
+// Entries are built lazily, by the task that compiled the script on a miss:
+// the bytecode is dumped from the prototype held by the caller's lua_State,
+// which no other task may touch, and this only adds a sequential write to
+// the compilation that was needed anyway. Scripts are loaded from the Lua
+// task and from the UI (widgets, standalone scripts), so every access to the
+// archive is serialized by a mutex.
+class LuaBytecodeCache
+{
+ public:
+  explicit LuaBytecodeCache(const char* path) : path(path) {}
+
+  // Push the chunk of 'filename' if it was compiled from the source described
+  // by 'source'. Returns false (and pushes nothing) if there is no such entry.
+  bool load(lua_State* L, const char* filename, const FILINFO& source,
+            bool stripDebug);
+
+  // Add the function on top of the stack of 'L', compiled from 'filename'
+  bool store(lua_State* L, const char* filename, const FILINFO& source,
+             bool stripDebug);
+
+  // Close the archive, compacting it first if it holds too much stale data
+  void close();
+
+  size_t size() const { return index.size(); }
+  uint32_t staleSize() const { return header.stale; }
+
+ protected:
+  struct Header {
+    char magic[4];
+    uint8_t version;
+    uint8_t format;
+    uint16_t count;
+    uint32_t indexOffset;
+    uint32_t stale;  // bytes used by replaced blobs and indexes
+  };
+
+  struct Entry {
+    uint32_t hash;
+    uint32_t date;  // source fdate / ftime
+    uint32_t size;  // source size
+    uint32_t offset;
+    uint32_t length;
+    uint32_t flags;
+  };
+
+  const char* path;
+  mutex_handle_t mutex;
+  bool mutexCreated = false;
+  FIL file;
+  bool opened = false;
+  bool writable = false;
+  Header header;
+  std::vector<Entry> index;
+
+  mutex_handle_t* getMutex();
+  bool open(bool write);
+  void reset();
+  bool readIndex();
+  bool writeIndex(uint32_t offset);
+  uint32_t end() const;
+  int find(uint32_t hash) const;
+  void remove(int idx);
+  // Position the file on the bytecode of an up to date entry for 'filename'
+  bool seek(const char* filename, const FILINFO& source, bool stripDebug,
+            uint32_t& length);
+  bool compact();
+};
+
+extern LuaBytecodeCache luaBytecodeCache;
+
+inline void luaBytecodeCacheClose() { luaBytecodeCache.close(); }
+
+#else
+
+inline void luaBytecodeCacheClose() {}
+
+#endif
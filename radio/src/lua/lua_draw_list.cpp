@@ -0,0 +1,354 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "lua_draw_list.h"
+
+#include <string.h>
+
+#include "edgetx.h"
+#include "api_colorlcd.h"
+
+LuaDrawList* luaLcdRecorder = nullptr;
+
+// Argument tags in the recorded stream
+enum LuaDrawTag : uint8_t {
+  DRAW_TAG_NIL,
+  DRAW_TAG_BOOLEAN,
+  DRAW_TAG_INTEGER,
+  DRAW_TAG_NUMBER,
+  DRAW_TAG_STRING,
+  DRAW_TAG_USERDATA,
+  DRAW_TAG_BITMAP,    // userdata with the Bitmap metatable
+  // not arguments: blink phase of a call using BLINK, live value
+  DRAW_TAG_BLINK,
+  DRAW_TAG_STATE,
+};
+
+bool LuaDrawArgs::isString(int idx) const
+{
+  return idx >= 1 && idx <= count && args[idx - 1].type == DRAW_TAG_STRING;
+}
+
+lua_Integer LuaDrawArgs::integer(int idx, lua_Integer def) const
+{
+  if (idx < 1 || idx > count) return def;
+  const Arg& a = args[idx - 1];
+  if (a.type == DRAW_TAG_INTEGER) return a.i;
+  if (a.type == DRAW_TAG_NUMBER) return (lua_Integer)a.n;
+  return def;
+}
+
+const char* LuaDrawArgs::string(int idx) const
+{
+  return isString(idx) ? args[idx - 1].s : "";
+}
+
+BitmapBuffer* LuaDrawArgs::bitmap(int idx) const
+{
+  if (idx < 1 || idx > count || args[idx - 1].type != DRAW_TAG_BITMAP)
+    return nullptr;
+  return *(BitmapBuffer* const*)args[idx - 1].s;
+}
+
+template <class T>
+static void appendValue(std::vector<uint8_t>& data, const T& value)
+{
+  auto p = reinterpret_cast<const uint8_t*>(&value);
+  data.insert(data.end(), p, p + sizeof(T));
+}
+
+template <class T>
+static const uint8_t* readValue(const uint8_t* p, T& value)
+{
+  memcpy(&value, p, sizeof(T));
+  return p + sizeof(T);
+}
+
+void LuaDrawList::clear(lua_State* L)
+{
+  if (L && anchorsRef != LUA_NOREF) luaL_unref(L, LUA_REGISTRYINDEX, anchorsRef);
+  anchorsRef = LUA_NOREF;
+  data.clear();
+  offsets.clear();
+  valid = false;
+  aborted = false;
+}
+
+void LuaDrawList::beginRecord(lua_State* L)
+{
+  clear(L);
+}
+
+bool LuaDrawList::endRecord(lua_State* L)
+{
+  if (aborted) {
+    clear(L);
+    return false;
+  }
+  valid = true;
+  return true;
+}
+
+void LuaDrawList::record(lua_State* L, const LuaDrawOp* op)
+{
+  int nargs = lua_gettop(L);
+  if (aborted || nargs > LUA_DRAW_MAX_ARGS) {
+    aborted = true;
+    return;
+  }
+
+  offsets.push_back(data.size());
+  appendValue(data, op);
+  data.push_back((uint8_t)nargs);
+
+  for (int i = 1; i <= nargs; i++) {
+    switch (lua_type(L, i)) {
+      case LUA_TNIL:
+      case LUA_TNONE:
+        data.push_back(DRAW_TAG_NIL);
+        break;
+
+      case LUA_TBOOLEAN:
+        data.push_back(DRAW_TAG_BOOLEAN);
+        data.push_back(lua_toboolean(L, i) ? 1 : 0);
+        break;
+
+      case LUA_TNUMBER:
+        if (lua_isinteger(L, i)) {
+          data.push_back(DRAW_TAG_INTEGER);
+          appendValue(data, lua_tointeger(L, i));
+        } else {
+          data.push_back(DRAW_TAG_NUMBER);
+          appendValue(data, lua_tonumber(L, i));
+        }
+        break;
+
+      case LUA_TSTRING: {
+        size_t len;
+        const char* s = lua_tolstring(L, i, &len);
+        if (len > UINT16_MAX) {
+          aborted = true;
+          return;
+        }
+        data.push_back(DRAW_TAG_STRING);
+        appendValue(data, (uint16_t)len);
+        data.insert(data.end(), s, s + len);
+        data.push_back('\0');
+        break;
+      }
+
+      case LUA_TUSERDATA: {
+        // Keep the object alive until the list is cleared:
+        // anchors[lightuserdata] = userdata
+        const void* ud = lua_touserdata(L, i);
+        if (anchorsRef == LUA_NOREF) {
+          lua_newtable(L);
+          anchorsRef = luaL_ref(L, LUA_REGISTRYINDEX);
+        }
+        lua_rawgeti(L, LUA_REGISTRYINDEX, anchorsRef);
+        lua_pushvalue(L, i);
+        lua_rawsetp(L, -2, ud);
+        lua_pop(L, 1);
+        data.push_back(luaL_testudata(L, i, BITMAP_METATABLE)
+                           ? DRAW_TAG_BITMAP
+                           : DRAW_TAG_USERDATA);
+        appendValue(data, ud);
+        break;
+      }
+
+      default:
+        // tables, functions, ... are not used by lcd.* drawing functions
+        aborted = true;
+        return;
+    }
+  }
+
+  if (op->flagsArg && op->flagsArg <= nargs && lua_isinteger(L, op->flagsArg) &&
+      (lua_tointeger(L, op->flagsArg) & BLINK)) {
+    data.push_back(DRAW_TAG_BLINK);
+    data.push_back(BLINK_ON_PHASE ? 1 : 0);
+  }
+
+  if (op->state) {
+    data.push_back(DRAW_TAG_STATE);
+    appendValue(data, op->state(L));
+  }
+}
+
+const uint8_t* LuaDrawList::entryData(size_t idx, size_t& len) const
+{
+  size_t end = (idx + 1 < offsets.size()) ? offsets[idx + 1] : data.size();
+  len = end - offsets[idx];
+  return &data[offsets[idx]];
+}
+
+const LuaDrawOp* LuaDrawList::decode(size_t idx, LuaDrawArgs* args) const
+{
+  size_t len;
+  const uint8_t* p = entryData(idx, len);
+
+  const LuaDrawOp* op;
+  p = readValue(p, op);
+  args->count = *p++;
+
+  for (int i = 0; i < args->count; i++) {
+    LuaDrawArgs::Arg& a = args->args[i];
+    a.type = *p++;
+    switch (a.type) {
+      case DRAW_TAG_BOOLEAN:
+        a.i = *p++;
+        break;
+      case DRAW_TAG_INTEGER:
+        p = readValue(p, a.i);
+        break;
+      case DRAW_TAG_NUMBER:
+        p = readValue(p, a.n);
+        break;
+      case DRAW_TAG_STRING: {
+        uint16_t slen;
+        p = readValue(p, slen);
+        a.i = slen;
+        a.s = (const char*)p;
+        p += slen + 1;
+        break;
+      }
+      case DRAW_TAG_USERDATA:
+      case DRAW_TAG_BITMAP: {
+        const void* ud;
+        p = readValue(p, ud);
+        a.s = (const char*)ud;
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  return op;
+}
+
+bool LuaDrawList::entryEquals(const LuaDrawList& other, size_t idx) const
+{
+  size_t len, otherLen;
+  const uint8_t* p = entryData(idx, len);
+  const uint8_t* q = other.entryData(idx, otherLen);
+  return len == otherLen && memcmp(p, q, len) == 0;
+}
+
+bool LuaDrawList::replay(lua_State* L) const
+{
+  LuaDrawArgs args;
+  for (size_t idx = 0; idx < offsets.size(); idx++) {
+    const LuaDrawOp* op = decode(idx, &args);
+    lua_pushcfunction(L, op->fn);
+    for (int i = 0; i < args.count; i++) {
+      const LuaDrawArgs::Arg& a = args.args[i];
+      switch (a.type) {
+        case DRAW_TAG_BOOLEAN:
+          lua_pushboolean(L, (int)a.i);
+          break;
+        case DRAW_TAG_INTEGER:
+          lua_pushinteger(L, a.i);
+          break;
+        case DRAW_TAG_NUMBER:
+          lua_pushnumber(L, a.n);
+          break;
+        case DRAW_TAG_STRING:
+          lua_pushlstring(L, a.s, a.i);
+          break;
+        case DRAW_TAG_USERDATA:
+        case DRAW_TAG_BITMAP:
+          lua_rawgeti(L, LUA_REGISTRYINDEX, anchorsRef);
+          lua_rawgetp(L, -1, a.s);
+          lua_remove(L, -2);
+          break;
+        default:
+          lua_pushnil(L);
+          break;
+      }
+    }
+    if (lua_pcall(L, args.count, 0, 0) != LUA_OK) {
+      TRACE("LuaDrawList::replay() error: %s", lua_tostring(L, -1));
+      lua_pop(L, 1);
+      return false;
+    }
+  }
+  return true;
+}
+
+static void mergeRect(rect_t& r, const rect_t& other)
+{
+  coord_t x1 = min(r.left(), other.left());
+  coord_t y1 = min(r.top(), other.top());
+  coord_t x2 = max(r.right(), other.right());
+  coord_t y2 = max(r.bottom(), other.bottom());
+  r = {x1, y1, x2 - x1, y2 - y1};
+}
+
+static bool addDirty(const LuaDrawList& list, size_t idx, rect_t* dirty,
+                     int& count, int maxDirty)
+{
+  rect_t r;
+  if (!list.bounds(idx, r)) return false;
+  if (r.w <= 0 || r.h <= 0) return true;
+
+  if (count < maxDirty) {
+    dirty[count++] = r;
+  } else {
+    mergeRect(dirty[maxDirty - 1], r);
+  }
+  return true;
+}
+
+bool LuaDrawList::bounds(size_t idx, rect_t& rect) const
+{
+  LuaDrawArgs args;
+  const LuaDrawOp* op = decode(idx, &args);
+  return op->bounds && op->bounds(args, rect);
+}
+
+int LuaDrawList::diff(const LuaDrawList& prev, rect_t* dirty,
+                      int maxDirty) const
+{
+  if (!valid || !prev.valid) return -1;
+
+  int count = 0;
+  size_t n = max(size(), prev.size());
+  for (size_t idx = 0; idx < n; idx++) {
+    bool inNew = idx < size();
+    bool inPrev = idx < prev.size();
+    if (inNew && inPrev && entryEquals(prev, idx)) continue;
+    // Both the previous and the new areas need to be redrawn
+    if (inPrev && !addDirty(prev, idx, dirty, count, maxDirty)) return -1;
+    if (inNew && !addDirty(*this, idx, dirty, count, maxDirty)) return -1;
+  }
+
+  return count;
+}
+
+void LuaDrawList::swap(LuaDrawList& other)
+{
+  std::swap(valid, other.valid);
+  std::swap(aborted, other.aborted);
+  std::swap(anchorsRef, other.anchorsRef);
+  data.swap(other.data);
+  offsets.swap(other.offsets);
+}
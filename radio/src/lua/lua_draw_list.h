@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <vector>
+
+#include "lua_states.h"
+#include "edgetx_types.h"
+
+class BitmapBuffer;
+
+// Maximum number of arguments recorded per lcd.* call
+#define LUA_DRAW_MAX_ARGS   12
+
+// Above this number of changed areas, a single bounding box is invalidated
+#define LUA_DRAW_MAX_DIRTY  4
+
+// Decoded arguments of a recorded lcd.* call (1-based like the Lua stack)
+struct LuaDrawArgs {
+  struct Arg {
+    uint8_t type;
+    lua_Integer i;
+    lua_Number n;
+    const char* s;
+  };
+
+  uint8_t count = 0;
+  Arg args[LUA_DRAW_MAX_ARGS];
+
+  bool isString(int idx) const;
+  lua_Integer integer(int idx, lua_Integer def = 0) const;
+  const char* string(int idx) const;
+  // nullptr if the argument is not a Bitmap object
+  BitmapBuffer* bitmap(int idx) const;
+};
+
+// Description of a recordable lcd.* function.
+//  - flagsArg: 1-based index of the 'flags' argument (0 if none), used to
+//    detect BLINK which changes the output without changing the arguments
+//  - bounds: computes the area touched by the call, relative to the widget.
+//    Returns false if the area cannot be determined (full invalidation).
+//  - state: optional, returns the live value drawn by the call (i.e. a
+//    telemetry value), which is then part of the comparison.
+struct LuaDrawOp {
+  lua_CFunction fn;
+  uint8_t flagsArg;
+  bool (*bounds)(const LuaDrawArgs& args, rect_t& rect);
+  int32_t (*state)(lua_State* L);
+};
+
+// Retained display list of the lcd.* calls made by a Lua widget 'refresh()'
+class LuaDrawList
+{
+ public:
+  LuaDrawList() = default;
+
+  // Release recorded calls and anchored bitmaps
+  void clear(lua_State* L);
+  bool isValid() const { return valid; }
+  size_t size() const { return offsets.size(); }
+
+  // Start / stop recording calls into this list.
+  // Bitmaps used by the list are anchored in a registry table.
+  // endRecord() returns false if the recording was aborted.
+  void beginRecord(lua_State* L);
+  bool endRecord(lua_State* L);
+
+  // Append a call. Arguments are read from the Lua stack of 'L'.
+  void record(lua_State* L, const LuaDrawOp* op);
+
+  // Called by lcd.* functions which cannot be recorded (i.e. they return
+  // values computed while drawing). The list is then left invalid.
+  void abort() { aborted = true; }
+
+  // Area touched by the call at 'idx' (relative to the widget)
+  bool bounds(size_t idx, rect_t& rect) const;
+
+  // Replay all recorded calls, drawing into the current 'luaLcdBuffer'
+  bool replay(lua_State* L) const;
+
+  // Compare with 'prev' and compute the areas to invalidate.
+  // Returns the number of areas (0 if identical), or -1 if the whole widget
+  // must be redrawn.
+  int diff(const LuaDrawList& prev, rect_t* dirty, int maxDirty) const;
+
+  void swap(LuaDrawList& other);
+
+ protected:
+  bool valid = false;
+  bool aborted = false;
+  int anchorsRef = LUA_NOREF;
+  std::vector<uint8_t> data;
+  std::vector<uint32_t> offsets;
+
+  const LuaDrawOp* decode(size_t idx, LuaDrawArgs* args) const;
+  bool entryEquals(const LuaDrawList& other, size_t idx) const;
+  const uint8_t* entryData(size_t idx, size_t& len) const;
+};
+
+// Non null while a Lua widget 'refresh()' is being recorded
+extern LuaDrawList* luaLcdRecorder;
+
+// Must be placed at the beginning of recordable lcd.* functions
+#define LUA_LCD_RECORD_STATE(L, fn, flagsArg, bounds, state)        \
+  if (luaLcdRecorder) {                                             \
+    static const LuaDrawOp _drawOp = {fn, flagsArg, bounds, state}; \
+    luaLcdRecorder->record(L, &_drawOp);                            \
+    return 0;                                                       \
+  }
+
+#define LUA_LCD_RECORD(L, fn, flagsArg, bounds) \
+  LUA_LCD_RECORD_STATE(L, fn, flagsArg, bounds, nullptr)
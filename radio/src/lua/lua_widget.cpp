@@ -221,10 +221,14 @@ void LuaWidget::redraw_cb(lv_event_t* e)
     buf.setClippingRect(clipping.x1 - a.x1, clipping.x2 + 1 - a.x1,
                         clipping.y1 - a.y1, clipping.y2 + 1 - a.y1);
 
-    auto save = luaScriptManager;
-    luaScriptManager = widget;
-    widget->refresh(&buf);
-    luaScriptManager = save;
+    if (widget->drawList.isValid()) {
+      widget->replayDrawList(&buf);
+    } else {
+      auto save = luaScriptManager;
+      luaScriptManager = widget;
+      widget->refresh(&buf);
+      luaScriptManager = save;
+    }
   }
 }
 
@@ -236,6 +240,8 @@ LuaWidget::LuaWidget(const WidgetFactory* factory, Window* parent,
     zoneRectDataRef(zoneRectDataRef), optionsDataRef(optionsDataRef),
     errorMessage(nullptr)
 {
+  retainedMode = useRetainedMode();
+
   // Push create function
   lua_rawgeti(lsWidgets, LUA_REGISTRYINDEX, createFunctionRef);
   // Push stored zone for 'create' call
@@ -267,6 +273,7 @@ LuaWidget::LuaWidget(const WidgetFactory* factory, Window* parent,
 
 LuaWidget::~LuaWidget()
 {
+  drawList.clear(lsWidgets);
   luaL_unref(lsWidgets, LUA_REGISTRYINDEX, zoneRectDataRef);
   if (errorMessage)
     free(errorMessage);
@@ -317,6 +324,9 @@ void LuaWidget::foreground()
       }
       luaScriptManager = save;
       UNPROTECT_LUA();
+    } else if (retainedMode && !errorMessage) {
+      // Only redraw what changed since last refresh
+      recordDrawList();
     } else {
       // Force call to redraw_cb()
       invalidate();
@@ -438,6 +448,8 @@ void LuaWidget::updateZoneRect(rect_t rect, bool updateUI)
 
     lua_pop(lsWidgets, 1);
 
+    if (changed) drawList.clear(lsWidgets);
+
     if (changed && updateUI)
       updateWithoutRefresh();
   }
@@ -445,6 +457,8 @@ void LuaWidget::updateZoneRect(rect_t rect, bool updateUI)
 
 void LuaWidget::onFullscreen(bool enable)
 {
+  drawList.clear(lsWidgets);
+
   if (enable) {
     setupHandler(this);
   } else {
@@ -538,6 +552,90 @@ void LuaWidget::refresh(BitmapBuffer* dc)
   luaLcdBuffer = nullptr;
 }
 
+void LuaWidget::recordDrawList()
+{
+  auto save = luaScriptManager;
+  bool lla = luaLcdAllowed;
+  bool recorded = false;
+
+  PROTECT_LUA() {
+    luaScriptManager = this;
+    nextDrawList.beginRecord(lsWidgets);
+    luaLcdRecorder = &nextDrawList;
+    refresh(nullptr);
+    luaLcdRecorder = nullptr;
+    refreshInstructionsPercent = instructionsPercent;
+    recorded = nextDrawList.endRecord(lsWidgets);
+  } else {
+    luaLcdRecorder = nullptr;
+    luaLcdAllowed = lla;
+    luaLcdBuffer = nullptr;
+    setErrorMessage("refresh protect Lua error");
+  }
+  luaScriptManager = save;
+  UNPROTECT_LUA();
+
+  if (!recorded || errorMessage) {
+    // Script cannot be recorded (or failed): back to immediate mode
+    if (!errorMessage) {
+      TRACE("Lua widget %s: retained mode disabled", factory->getName());
+      retainedMode = false;
+    }
+    nextDrawList.clear(lsWidgets);
+    drawList.clear(lsWidgets);
+    invalidate();
+    return;
+  }
+
+  rect_t dirty[LUA_DRAW_MAX_DIRTY];
+  int count = nextDrawList.diff(drawList, dirty, LUA_DRAW_MAX_DIRTY);
+
+  // Previous list is kept until now, as it anchors the bitmaps it uses
+  drawList.swap(nextDrawList);
+  nextDrawList.clear(lsWidgets);
+
+  if (count < 0) {
+    invalidate();
+  } else {
+    for (int i = 0; i < count; i++) invalidateArea(dirty[i]);
+  }
+}
+
+void LuaWidget::replayDrawList(BitmapBuffer* dc)
+{
+  auto save = luaScriptManager;
+  bool lla = luaLcdAllowed;
+
+  PROTECT_LUA() {
+    luaScriptManager = this;
+    luaSetInstructionsLimit(lsWidgets, MAX_INSTRUCTIONS);
+    luaLcdBuffer = dc;
+    luaLcdAllowed = true;
+    drawList.replay(lsWidgets);
+  } else {
+    setErrorMessage("replay protect Lua error");
+  }
+  luaLcdAllowed = lla;
+  luaLcdBuffer = nullptr;
+  luaScriptManager = save;
+  UNPROTECT_LUA();
+
+  // The error is drawn by refresh() from now on
+  if (errorMessage) drawList.clear(lsWidgets);
+}
+
+void LuaWidget::invalidateArea(const rect_t& rect)
+{
+  lv_area_t a;
+  lv_obj_get_coords(lvobj, &a);
+  a.x1 += rect.x;
+  a.y1 += rect.y;
+  a.x2 = a.x1 + rect.w - 1;
+  a.y2 = a.y1 + rect.h - 1;
+  // clipped to the widget by LVGL
+  lv_obj_invalidate_area(lvobj, &a);
+}
+
 void LuaWidget::background()
 {
   if (lsWidgets == 0 || errorMessage) return;
@@ -571,6 +669,11 @@ void LuaWidget::clear()
 
 bool LuaWidget::useLvglLayout() const { return luaFactory()->useLvglLayout(); }
 
+bool LuaWidget::useRetainedMode() const
+{
+  return !useLvglLayout() && luaFactory()->useRetainedMode();
+}
+
 bool LuaWidget::isAppMode() const
 {
   return ((WidgetsContainer*)parent)->isAppMode();
@@ -28,6 +28,7 @@
 #include "lua_states.h"
 #include "lua_api.h"
 #include "lua_lvgl_widget.h"
+#include "lua_draw_list.h"
 #include "telemetry/telemetry.h"
 
 #include "edgetx_types.h"
@@ -130,6 +131,7 @@ class LuaWidget : public Widget, public LuaScriptManager
   Window* getCurrentParent() const override { return (tempParent && tempParent->getWindow()) ? tempParent->getWindow() : (Window*)this; }
 
   bool useLvglLayout() const override;
+  bool useRetainedMode() const;
   bool isAppMode() const override;
   bool isWidget() override { return !inSettings; }
   bool isFullscreen() override { return Widget::isFullscreen(); }
@@ -149,6 +151,11 @@ class LuaWidget : public Widget, public LuaScriptManager
   int optionsDataRef;
   char* errorMessage;
 
+  // Retained mode: lcd.* calls of the last 'refresh' and scratch list
+  bool retainedMode;
+  LuaDrawList drawList;
+  LuaDrawList nextDrawList;
+
   // Window interface
   void onClicked() override;
   void onCancel() override;
@@ -164,6 +171,11 @@ class LuaWidget : public Widget, public LuaScriptManager
   // Calls LUA widget 'refresh' method
   void refresh(BitmapBuffer* dc);
 
+  // Records 'refresh' into a display list and invalidates the changed areas
+  void recordDrawList();
+  void replayDrawList(BitmapBuffer* dc);
+  void invalidateArea(const rect_t& rect);
+
   static void redraw_cb(lv_event_t *e);
 };
 
@@ -31,7 +31,7 @@
 LuaWidgetFactory::LuaWidgetFactory(const char* name, WidgetOption* widgetOptions, int optionDefinitionsReference,
                                    int createFunction, int updateFunction, int refreshFunction,
                                    int backgroundFunction, int translateFunction, bool lvglLayout,
-                                   const char* filename) :
+                                   bool retainedMode, const char* filename) :
     WidgetFactory(name, widgetOptions),
     optionDefinitionsReference(optionDefinitionsReference),
     createFunction(createFunction),
@@ -40,6 +40,7 @@ LuaWidgetFactory::LuaWidgetFactory(const char* name, WidgetOption* widgetOptions
     backgroundFunction(backgroundFunction),
     translateFunction(translateFunction),
     lvglLayout(lvglLayout),
+    retainedMode(retainedMode),
     path(filename)
 {
   path = path.substr(0, path.rfind("/") + 1);
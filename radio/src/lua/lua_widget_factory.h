@@ -31,7 +31,7 @@ class LuaWidgetFactory : public WidgetFactory
   LuaWidgetFactory(const char* name, WidgetOption* widgetOptions, int optionDefinitionsReference,
                    int createFunction, int updateFunction, int refreshFunction,
                    int backgroundFunction, int translateFunction, bool lvgllayout,
-                   const char* filename);
+                   bool retainedMode, const char* filename);
   ~LuaWidgetFactory();
 
   Widget* createNew(Window* parent, const rect_t& rect,
@@ -40,6 +40,7 @@ class LuaWidgetFactory : public WidgetFactory
   bool isLuaWidgetFactory() const override { return true; }
 
   bool useLvglLayout() const { return lvglLayout; }
+  bool useRetainedMode() const { return retainedMode; }
 
   static WidgetOption* parseOptionDefinitions(int reference);
   const void parseOptionDefaults() const override;
@@ -54,5 +55,6 @@ class LuaWidgetFactory : public WidgetFactory
   int backgroundFunction;
   int translateFunction;
   bool lvglLayout;
+  bool retainedMode;
   std::string path;
 };
@@ -0,0 +1,211 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "slab_allocator.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+SlabAllocator::SlabAllocator(const ClassDef* defs, uint8_t count, void* arena) :
+    count(count < SLAB_MAX_CLASSES ? count : SLAB_MAX_CLASSES),
+    arenaStart((uint8_t*)arena)
+{
+  uint8_t* p = arenaStart;
+  for (uint8_t i = 0; i < this->count; i++) {
+    SizeClass& c = classes[i];
+    memset(&c.stats, 0, sizeof(c.stats));
+    c.stats.size = defs[i].size;
+    c.stats.slots = defs[i].count;
+    c.freeList = nullptr;
+    // Slots are linked in address order
+    for (int s = defs[i].count - 1; s >= 0; s--) {
+      Slot* slot = (Slot*)(p + s * defs[i].size);
+      slot->next = c.freeList;
+      c.freeList = slot;
+    }
+    p += defs[i].size * defs[i].count;
+    c.end = p;
+  }
+  arenaEnd = p;
+  memset(&heap, 0, sizeof(heap));
+}
+
+void* SlabAllocator::luaAlloc(void* ud, void* ptr, size_t osize, size_t nsize)
+{
+  return ((SlabAllocator*)ud)->alloc(ptr, osize, nsize);
+}
+
+uint8_t SlabAllocator::classFor(size_t size) const
+{
+  uint8_t idx = 0;
+  while (idx < count && size > classes[idx].stats.size) idx++;
+  return idx;
+}
+
+uint8_t SlabAllocator::classOf(const void* ptr) const
+{
+  uint8_t idx = 0;
+  while (ptr >= classes[idx].end) idx++;
+  return idx;
+}
+
+void* SlabAllocator::allocSlot(uint8_t idx, size_t size)
+{
+  SizeClass& c = classes[idx];
+  Slot* slot = c.freeList;
+  c.freeList = slot->next;
+  c.stats.allocs++;
+  c.stats.requested += size;
+  if (++c.stats.used > c.stats.maxUsed) c.stats.maxUsed = c.stats.used;
+  return slot;
+}
+
+void* SlabAllocator::allocate(size_t size)
+{
+  uint8_t best = classFor(size);
+  for (uint8_t idx = best; idx < count; idx++) {
+    if (classes[idx].freeList) {
+      if (idx != best) classes[best].stats.spills++;
+      return allocSlot(idx, size);
+    }
+  }
+
+  if (best < count)
+    classes[best].stats.misses++;
+  else
+    heap.large++;
+
+  void* res = malloc(size);
+  if (res) {
+    heap.blocks++;
+    heap.bytes += size;
+    if (heap.bytes > heap.maxBytes) heap.maxBytes = heap.bytes;
+  } else {
+    heap.failures++;
+  }
+  return res;
+}
+
+void SlabAllocator::release(void* ptr, size_t size)
+{
+  if (owns(ptr)) {
+    SizeClass& c = classes[classOf(ptr)];
+    Slot* slot = (Slot*)ptr;
+    slot->next = c.freeList;
+    c.freeList = slot;
+    c.stats.used--;
+    c.stats.frees++;
+    c.stats.requested -= size;
+  } else {
+    free(ptr);
+    heap.blocks--;
+    heap.bytes -= size;
+  }
+}
+
+void* SlabAllocator::alloc(void* ptr, size_t osize, size_t nsize)
+{
+  if (nsize == 0) {
+    if (ptr) release(ptr, osize);
+    return nullptr;
+  }
+
+  // 'osize' encodes the type of the object when 'ptr' is null
+  if (!ptr) return allocate(nsize);
+
+  if (owns(ptr)) {
+    uint8_t idx = classOf(ptr);
+    SizeClass& c = classes[idx];
+    if (nsize <= c.stats.size) {
+      // Stay in place, unless a smaller class now fits and has room
+      uint8_t best = classFor(nsize);
+      if (best == idx || !classes[best].freeList) {
+        c.stats.requested += nsize - osize;
+        return ptr;
+      }
+      void* res = allocSlot(best, nsize);
+      memcpy(res, ptr, nsize);
+      release(ptr, osize);
+      return res;
+    }
+    void* res = allocate(nsize);
+    if (res) {
+      memcpy(res, ptr, osize);
+      release(ptr, osize);
+    }
+    return res;
+  }
+
+  // Heap block shrinking into a class: move it to the arena if possible
+  if (nsize < osize) {
+    uint8_t best = classFor(nsize);
+    for (uint8_t idx = best; idx < count && idx <= best + 1; idx++) {
+      if (classes[idx].freeList) {
+        void* res = allocSlot(idx, nsize);
+        memcpy(res, ptr, nsize);
+        release(ptr, osize);
+        return res;
+      }
+    }
+  }
+
+  void* res = realloc(ptr, nsize);
+  if (res) {
+    heap.bytes += nsize - osize;
+    if (heap.bytes > heap.maxBytes) heap.maxBytes = heap.bytes;
+  } else {
+    heap.failures++;
+  }
+  return res;
+}
+
+uint32_t SlabAllocator::freeBytes() const
+{
+  uint32_t bytes = 0;
+  for (uint8_t i = 0; i < count; i++) {
+    const ClassStats& s = classes[i].stats;
+    bytes += (s.slots - s.used) * s.size;
+  }
+  return bytes;
+}
+
+uint32_t SlabAllocator::usedBytes() const
+{
+  return (arenaEnd - arenaStart) - freeBytes();
+}
+
+uint32_t SlabAllocator::wastedBytes() const
+{
+  uint32_t requested = 0;
+  for (uint8_t i = 0; i < count; i++) requested += classes[i].stats.requested;
+  return usedBytes() - requested;
+}
+
+void SlabAllocator::resetStats()
+{
+  for (uint8_t i = 0; i < count; i++) {
+    ClassStats& s = classes[i].stats;
+    s.allocs = s.frees = s.spills = s.misses = 0;
+    s.maxUsed = s.used;
+  }
+  heap.maxBytes = heap.bytes;
+  heap.large = heap.failures = 0;
+}
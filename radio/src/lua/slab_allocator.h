@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#pragma once
+
+#include <stddef.h>
+#include <stdint.h>
+
+#define SLAB_MAX_CLASSES  8
+
+// Slot sizes are multiples of this, so that any Lua object can be stored
+#define SLAB_ALIGN        8
+
+// Size classes in front of the general heap, for the many small objects
+// (strings, tables, closures, upvalues) created by Lua.
+//
+// Each class is an array of equally sized slots linked in a free list, all
+// classes sharing a single arena. A request goes to the smallest class able to
+// hold it, then to the next larger ones if it is full ("spill"), and only then
+// to the general heap ("miss").
+//
+// Lua passes the size of the block being freed or reallocated, which is used
+// to maintain the number of bytes actually requested in each class: the
+// difference with the size of the slots in use is the internal fragmentation.
+class SlabAllocator
+{
+ public:
+  struct ClassDef {
+    uint16_t size;   // multiple of SLAB_ALIGN
+    uint16_t count;
+  };
+
+  struct ClassStats {
+    uint16_t size;
+    uint16_t slots;
+    uint16_t used;
+    uint16_t maxUsed;    // high-water mark
+    uint32_t allocs;
+    uint32_t frees;
+    uint32_t spills;     // requests served by a larger class
+    uint32_t misses;     // requests sent to the heap, all classes being full
+    uint32_t requested;  // bytes requested by the objects in the used slots
+  };
+
+  struct HeapStats {
+    uint32_t blocks;     // blocks currently allocated on the heap
+    uint32_t bytes;
+    uint32_t maxBytes;   // high-water mark
+    uint32_t large;      // requests larger than the largest class
+    uint32_t failures;   // requests the heap could not satisfy
+  };
+
+  static constexpr size_t arenaSize(const ClassDef* defs, uint8_t count)
+  {
+    size_t size = 0;
+    for (uint8_t i = 0; i < count; i++) size += defs[i].size * defs[i].count;
+    return size;
+  }
+
+  // 'arena' must be aligned on SLAB_ALIGN and hold arenaSize(defs, count)
+  SlabAllocator(const ClassDef* defs, uint8_t count, void* arena);
+
+  // lua_Alloc function, 'ud' being the allocator
+  static void* luaAlloc(void* ud, void* ptr, size_t osize, size_t nsize);
+
+  // Same semantics as lua_Alloc
+  void* alloc(void* ptr, size_t osize, size_t nsize);
+
+  bool owns(const void* ptr) const
+  {
+    return ptr >= arenaStart && ptr < arenaEnd;
+  }
+
+  uint8_t classCount() const { return count; }
+  const ClassStats& classStats(uint8_t idx) const { return classes[idx].stats; }
+  const HeapStats& heapStats() const { return heap; }
+
+  // Bytes available in the slots
+  uint32_t freeBytes() const;
+  // Bytes in use in the slots, and the part which was not requested
+  uint32_t usedBytes() const;
+  uint32_t wastedBytes() const;
+
+  // Reset the counters, high-water marks start again from the current usage
+  void resetStats();
+
+ protected:
+  struct Slot {
+    Slot* next;
+  };
+
+  struct SizeClass {
+    uint8_t* end;
+    Slot* freeList;
+    ClassStats stats;
+  };
+
+  uint8_t count;
+  uint8_t* arenaStart;
+  uint8_t* arenaEnd;
+  SizeClass classes[SLAB_MAX_CLASSES];
+  HeapStats heap;
+
+  // Smallest class able to hold 'size' ('count' if none)
+  uint8_t classFor(size_t size) const;
+  uint8_t classOf(const void* ptr) const;
+  void* allocSlot(uint8_t idx, size_t size);
+  void* allocate(size_t size);
+  void release(void* ptr, size_t size);
+};
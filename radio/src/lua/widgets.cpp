@@ -23,7 +23,9 @@
 #include <stdio.h>
 
 #include "edgetx.h"
+#include "custom_allocator.h"
 #include "lua_api.h"
+#include "lua_bytecode_cache.h"
 
 #include "widget.h"
 #include "lib_file.h"
@@ -106,6 +108,7 @@ void luaLoadWidgetCallback(const char* filename)
   int optionDefinitionsReference = LUA_REFNIL, createFunction = LUA_REFNIL, updateFunction = LUA_REFNIL,
       refreshFunction = LUA_REFNIL, backgroundFunction = LUA_REFNIL, translateFunction = LUA_REFNIL;
   bool lvglLayout = false;
+  bool retainedMode = false;
 
   luaL_checktype(lsWidgets, -1, LUA_TTABLE);
 
@@ -141,6 +144,9 @@ void luaLoadWidgetCallback(const char* filename)
     else if (!strcasecmp(key, "useLvgl")) {
       lvglLayout = lua_toboolean(lsWidgets, -1);
     }
+    else if (!strcasecmp(key, "retained")) {
+      retainedMode = lua_toboolean(lsWidgets, -1);
+    }
   }
 
   if (name && createFunction != LUA_REFNIL) {
@@ -148,7 +154,7 @@ void luaLoadWidgetCallback(const char* filename)
     if (options) {
       new LuaWidgetFactory(strdup(name), options, optionDefinitionsReference,
               createFunction, updateFunction, refreshFunction, backgroundFunction,
-              translateFunction, lvglLayout, filename);
+              translateFunction, lvglLayout, retainedMode, filename);
       TRACE("Loaded Lua widget %s", name);
     }
   }
@@ -226,7 +232,7 @@ void luaInitThemesAndWidgets()
   TRACE("luaInitThemesAndWidgets");
 
 #if defined(USE_CUSTOM_ALLOCATOR)
-  lsWidgets = lua_newstate(custom_l_alloc, NULL);   //we use our own allocator!
+  lsWidgets = lua_newstate(custom_l_alloc, LUA_ALLOCATOR_UD);   //we use our own allocator!
 #elif defined(LUA_ALLOCATOR_TRACER)
   memclear(&lsWidgetsTrace, sizeof(lsWidgetsTrace));
   lsWidgetsTrace.script = "lua_newstate(widgets)";
@@ -254,6 +260,7 @@ void luaInitThemesAndWidgets()
     UNPROTECT_LUA();
     TRACE("lsWidgets %p", lsWidgets);
     luaLoadFiles(WIDGETS_PATH);
+    luaBytecodeCacheClose();
     luaDoGc(lsWidgets, true);
   }
 }
@@ -27,6 +27,7 @@
 
 #include "edgetx.h"
 #include "lua/lua_states.h"
+#include "lua/lua_bytecode_cache.h"
 
 #if defined(COLORLCD)
 #include "view_main.h"
@@ -566,6 +567,12 @@ void perMain()
 {
   DEBUG_TIMER_START(debugTimerPerMain1);
 
+#if defined(LUA)
+  // loadScript() calls of the previous pass share one opening of the bytecode
+  // cache: close it before the SD card may be handed over to USB
+  luaBytecodeCacheClose();
+#endif
+
   checkSpeakerVolume();
 
   if (!usbPlugged() || (getSelectedUsbMode() == USB_UNSELECTED_MODE)) {
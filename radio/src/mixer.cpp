@@ -1211,6 +1211,7 @@ void evalMixes(uint8_t tick10ms)
   // must be done after mixing because some functions use the inputs/channels values
   // must be done before limits because of the applyLimit function: it checks for safety switches which would be not initialized otherwise
   if (tick10ms) {
+    DEBUG_TIMER_START(debugTimerFunctions);
     if (radioGFEnabled()) {
       evalFunctions(g_eeGeneral.customFn, globalFunctionsContext);
     } else {
@@ -1221,6 +1222,7 @@ void evalMixes(uint8_t tick10ms)
     } else {
       modelFunctionsContext.reset();
     }
+    DEBUG_TIMER_STOP(debugTimerFunctions);
 #if defined(OVERRIDE_CHANNEL_FUNCTION)
     if (!radioGFEnabled() && !modelSFEnabled()) {
       for (uint8_t i = 0; i < MAX_OUTPUT_CHANNELS; i++) {
@@ -23,8 +23,10 @@
 #include "tasks/mixer_task.h"
 #include "hal/usb_driver.h"
 #include "os/sleep.h"
+#include "timers_driver.h"
 
 #include "dataconstants.h"
+#include "edgetx_helpers.h"
 #include <string.h>
 
 bool mixerSchedulerWaitForTrigger(uint8_t timeoutMs)
@@ -48,20 +50,41 @@ bool mixerSchedulerWaitForTrigger(uint8_t timeoutMs)
     return true;
   }
 #else
-  sleep_ms(timeoutMs);
-  return true;
+  // No scheduler timer: wait for the next module slot
+  static uint32_t nextTrigger = 0;
+  int32_t delay = (int32_t)(nextTrigger - timersGetUsTick());
+  if (delay > timeoutMs * 1000) {
+    sleep_ms(timeoutMs);
+    return true;
+  }
+  if (delay > 0) {
+    sleep_ms((delay + 999) / 1000);
+  }
+  uint32_t now = timersGetUsTick();
+  nextTrigger = now + mixerSchedulerNextTrigger(now);
+  return false;
 #endif
 }
 
-#if !defined(SIMU)
-
-// Global trigger flag
-
 // Mixer schedule
+//
+// Counters are written by a single context (trigger or mixer task), and a
+// difference between them signals an event to the other one.
 struct MixerSchedule {
 
   // period in us
   volatile uint16_t period;
+
+  // next transmit slot (trigger only)
+  uint32_t nextSlot;
+
+  // slots reached (trigger) / sent (mixer task)
+  volatile uint8_t slots;
+  uint8_t sent;
+
+  // heartbeats received (ISR) / handled (trigger)
+  volatile uint8_t heartbeats;
+  uint8_t heartbeatsHandled;
 };
 
 static MixerSchedule mixerSchedules[NUM_MODULES];
@@ -108,6 +131,70 @@ uint16_t mixerSchedulerGetPeriod(uint8_t moduleIdx)
   return mixerSchedules[moduleIdx].period;
 }
 
+uint16_t mixerSchedulerNextTrigger(uint32_t now)
+{
+  int32_t delay = MAX_REFRESH_RATE;
+  bool scheduled = false;
+
+  for (uint8_t i = 0; i < NUM_MODULES; i++) {
+    auto& schedule = mixerSchedules[i];
+    int32_t period = schedule.period;
+    if (!period) continue;
+    scheduled = true;
+
+    int32_t next = (int32_t)(schedule.nextSlot - now);
+    if (schedule.heartbeats != schedule.heartbeatsHandled) {
+      schedule.heartbeatsHandled = schedule.heartbeats;
+      schedule.nextSlot = now;
+      next = 0;
+    }
+
+    if (next <= (int32_t)MIXER_SCHEDULER_SLOT_MARGIN_US) {
+      schedule.slots++;
+      if (next < -period) {
+        // slot missed, or first one: restart from now
+        schedule.nextSlot = now + period;
+      } else {
+        schedule.nextSlot += period;
+      }
+    } else if (next > period) {
+      // period shortened
+      schedule.nextSlot = now + period;
+    }
+
+    delay = min<int32_t>(delay, (int32_t)(schedule.nextSlot - now));
+  }
+
+  if (!scheduled) {
+    delay = getMixerSchedulerPeriod();
+  }
+
+  return limit<int32_t>(MIXER_SCHEDULER_SLOT_MARGIN_US, delay, MAX_REFRESH_RATE);
+}
+
+void mixerSchedulerHeartbeat(uint8_t moduleIdx)
+{
+  mixerSchedules[moduleIdx].heartbeats++;
+}
+
+uint8_t mixerSchedulerGetDueModules()
+{
+  uint8_t modules = 0;
+  for (uint8_t i = 0; i < NUM_MODULES; i++) {
+    auto& schedule = mixerSchedules[i];
+    uint8_t slots = schedule.slots;
+    if (!schedule.period) {
+      modules |= 1 << i;
+    } else if (slots != schedule.sent) {
+      schedule.sent = slots;
+      modules |= 1 << i;
+    }
+  }
+  return modules;
+}
+
+#if !defined(SIMU)
+
 void mixerSchedulerISRTrigger()
 {
   BaseType_t xHigherPriorityTaskWoken = pdFALSE;
@@ -29,23 +29,45 @@
 #define MIN_REFRESH_RATE       850 /* us */
 #define MAX_REFRESH_RATE     50000 /* us */
 
-#if !defined(SIMU)
+// Transmit slots closer than this to a trigger are served by the same
+// mixer run, which is also the minimum delay between two triggers
+#define MIXER_SCHEDULER_SLOT_MARGIN_US  250u
 
 // Call once to initialize the mixer scheduler
 void mixerSchedulerInit();
 
-// Configure and start the scheduler timer
-void mixerSchedulerStart();
-
-// Stop the scheduler timer
-void mixerSchedulerStop();
-
 // Set the scheduling period for a given module
 void mixerSchedulerSetPeriod(uint8_t moduleIdx, uint16_t periodUs);
 
 // Get the scheduling period for a given module
 uint16_t mixerSchedulerGetPeriod(uint8_t moduleIdx);
 
+// Fetch the current scheduling period
+uint16_t getMixerSchedulerPeriod();
+
+// Each module with a period has its own transmit slots. The mixer is
+// triggered at the earliest slot, so that the frame of each module is built
+// from a mixer run made just before it is sent.
+//
+// Called on each trigger ('now' in us): marks the modules whose slot has
+// been reached and returns the delay until the next slot.
+uint16_t mixerSchedulerNextTrigger(uint32_t now);
+
+// Slot signalled by the module itself (heartbeat), from an ISR
+void mixerSchedulerHeartbeat(uint8_t moduleIdx);
+
+// Mask of the modules to be sent by the current mixer run: modules whose
+// slot was reached since the last call, and modules without a period
+uint8_t mixerSchedulerGetDueModules();
+
+#if !defined(SIMU)
+
+// Configure and start the scheduler timer
+void mixerSchedulerStart();
+
+// Stop the scheduler timer
+void mixerSchedulerStop();
+
 // Enable the timer trigger
 void mixerSchedulerEnableTrigger();
 
@@ -55,26 +77,19 @@ void mixerSchedulerDisableTrigger();
 // Trigger mixer from heartbeat interrupt 
 void mixerSchedulerSoftTrigger();
 
-// Fetch the current scheduling period
-uint16_t getMixerSchedulerPeriod();
-
 // Trigger mixer from an ISR
 void mixerSchedulerISRTrigger();
 
 #else
 
-#define mixerSchedulerInit()
 #define mixerSchedulerStart()
 #define mixerSchedulerStop()
-#define mixerSchedulerSetPeriod(m,p) ((void)(p))
-#define mixerSchedulerGetPeriod(m) ((uint16_t)MIXER_SCHEDULER_DEFAULT_PERIOD_US)
 
 #define mixerSchedulerEnableTrigger()
 #define mixerSchedulerDisableTrigger()
 
 #define mixerSchedulerSoftTrigger()
 
-#define getMixerSchedulerPeriod() (MIXER_SCHEDULER_DEFAULT_PERIOD_US)
 #define mixerSchedulerISRTrigger()
 
 #endif
@@ -80,6 +80,7 @@ void setDefaultGVars()
       g_model.flightModeData[fmIdx].gvars[gvarIdx] = GVAR_MAX + 1;
     }
   }
+  invalidateGVarFlightModes();
 #endif
 }
 
@@ -71,7 +71,6 @@ static void afhds2SendPulses(void* ctx, uint8_t* buffer, int16_t* channels, uint
   mixerSchedulerSetPeriod(module, status.isValid()
                                       ? status.getAdjustedRefreshRate()
                                       : AFHDS2_PERIOD);
-  status.invalidate();
 
   auto p_data = buffer;
   setupPulsesAFHDS2(p_data);
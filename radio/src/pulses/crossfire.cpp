@@ -31,17 +31,39 @@
 
 #include "crossfire.h"
 #include "telemetry/crossfire.h"
+#include "bit_packing.h"
 
 #define CROSSFIRE_CH_BITS           11
+
+typedef BitPacking<CROSSFIRE_CH_BITS, CROSSFIRE_CHANNELS_COUNT> CrossfireChannelsPacking;
 #define CROSSFIRE_CENTER            0x3E0
 #if defined(PPM_CENTER_ADJUSTABLE)
   #define CROSSFIRE_CENTER_CH_OFFSET(ch)            ((2 * limitAddress(ch)->ppmCenter) + 1)  // + 1 is for rouding
+  #define CROSSFIRE_SUBSET_CH_OFFSET(ch)            (2 * limitAddress(ch)->ppmCenter)
 #else
   #define CROSSFIRE_CENTER_CH_OFFSET(ch)            (0)
+  #define CROSSFIRE_SUBSET_CH_OFFSET(ch)            (0)
 #endif
 
 #define MIN_FRAME_LEN 3
 
+#define CROSSFIRE_SUBSET_RES_11BITS   1
+#define CROSSFIRE_SUBSET_CENTER       1024
+#define CROSSFIRE_SUBSET_OVERHEAD     5   // address, length, type, config, CRC
+#define CROSSFIRE_SUBSET_REFRESH      25  // frames between full refreshes
+
+// Regular RC frame: 1500us + (value - 992) x 0.625us
+uint16_t crossfireChannelValue(uint8_t channel, int16_t pulse)
+{
+  return limit(0, CROSSFIRE_CENTER + (CROSSFIRE_CENTER_CH_OFFSET(channel) * 4) / 5 + (pulse * 4) / 5, 2 * CROSSFIRE_CENTER);
+}
+
+// Subset frame, 11 bits resolution: 988us + value x 0.5us, as the pulses
+uint16_t crossfireSubsetChannelValue(uint8_t channel, int16_t pulse)
+{
+  return limit(0, CROSSFIRE_SUBSET_CENTER + CROSSFIRE_SUBSET_CH_OFFSET(channel) + pulse, 2047);
+}
+
 #define MODULE_ALIVE_TIMEOUT  50                      // if the module has sent a valid frame within 500ms it is declared alive
 static tmr10ms_t lastAlive[NUM_MODULES];              // last time stamp module sent CRSF frames
 static bool moduleAlive[NUM_MODULES];                 // module alive status
@@ -93,7 +115,7 @@ uint8_t createCrossfireModelIDFrame(uint8_t moduleIdx, uint8_t * frame)
 }
 
 // Range for pulses (channels output) is [-1024:+1024]
-uint8_t createCrossfireChannelsFrame(uint8_t moduleIdx, uint8_t * frame, int16_t * pulses)
+uint8_t createCrossfireChannelsFrame(uint8_t moduleIdx, uint8_t * frame, int16_t * pulses, uint8_t nChannels)
 {
   //
   // sends channel data and also communicates commanded armed status in arming mode Switch.
@@ -105,23 +127,19 @@ uint8_t createCrossfireChannelsFrame(uint8_t moduleIdx, uint8_t * frame, int16_t
   uint8_t armingMode = md->crsf.crsfArmingMode; // 0 = Channel mode, 1 = Switch mode
   uint8_t lenAdjust = (armingMode == ARMING_MODE_SWITCH) ? 1 : 0;
 
+  // channels not available to the module are sent centered
+  uint16_t values[CROSSFIRE_CHANNELS_COUNT];
+  for (int i=0; i<CROSSFIRE_CHANNELS_COUNT; i++) {
+    values[i] = crossfireChannelValue(i, i < nChannels ? pulses[i] : 0);
+  }
+
   uint8_t * buf = frame;
   *buf++ = MODULE_ADDRESS;
   *buf++ = 24 + lenAdjust;      // 1(ID) + 22(channel data) + (+1 extra byte if Switch mode) + 1(CRC)
   uint8_t * crc_start = buf;
   *buf++ = CHANNELS_ID;
-  uint32_t bits = 0;
-  uint8_t bitsavailable = 0;
-  for (int i=0; i<CROSSFIRE_CHANNELS_COUNT; i++) {
-    uint32_t val = limit(0, CROSSFIRE_CENTER + (CROSSFIRE_CENTER_CH_OFFSET(i) * 4) / 5 + (pulses[i] * 4) / 5, 2 * CROSSFIRE_CENTER);
-    bits |= val << bitsavailable;
-    bitsavailable += CROSSFIRE_CH_BITS;
-    while (bitsavailable >= 8) {
-      *buf++ = bits;
-      bits >>= 8;
-      bitsavailable -= 8;
-    }
-  }
+  CrossfireChannelsPacking::pack(buf, values);
+  buf += CrossfireChannelsPacking::SIZE;
   
   if (armingMode == ARMING_MODE_SWITCH) {
     swsrc_t sw =  md->crsf.crsfArmingTrigger;
@@ -133,6 +151,111 @@ uint8_t createCrossfireChannelsFrame(uint8_t moduleIdx, uint8_t * frame, int16_t
   return buf - frame;
 }
 
+// Subset frame: 'count' channels starting at channel 'first' (0 based),
+// 11 bits resolution
+uint8_t createCrossfireSubsetChannelsFrame(uint8_t * frame, uint8_t first,
+                                           const uint16_t * values, uint8_t count)
+{
+  count = min<uint8_t>(count, CROSSFIRE_CHANNELS_COUNT);
+
+  uint8_t * buf = frame;
+  *buf++ = MODULE_ADDRESS;
+  *buf++ = 3 + CrossfireChannelsPacking::size(count);  // 1(ID) + 1(config) + channel data + 1(CRC)
+  uint8_t * crc_start = buf;
+  *buf++ = SUBSET_CHANNELS_ID;
+  *buf++ = (first & 0x1F) | (CROSSFIRE_SUBSET_RES_11BITS << 5);
+  uint16_t subset[CROSSFIRE_CHANNELS_COUNT] = {};
+  memcpy(subset, values, count * sizeof(uint16_t));
+  buf += CrossfireChannelsPacking::pack(buf, subset, count);
+  *buf = crc8(crc_start, buf - crc_start);
+  buf++;
+  return buf - frame;
+}
+
+// Channels beyond the regular RC frame are sent in a subset frame, only when
+// they changed: the frame covers the range from the first to the last changed
+// channel, with a full refresh every CROSSFIRE_SUBSET_REFRESH frames. When
+// they do not all fit in the frame, the next frames continue after the last
+// channel sent.
+struct CrossfireExtraChannels {
+  uint16_t values[CROSSFIRE_MAX_CHANNELS - CROSSFIRE_CHANNELS_COUNT];  // last sent
+  uint32_t pending;  // channels not sent since they changed
+  uint8_t count;
+  uint8_t refresh;
+  uint8_t next;      // first channel looked at by the next frame
+};
+
+static CrossfireExtraChannels extraChannels[NUM_MODULES];
+
+void resetCrossfireExtraChannels(uint8_t moduleIdx)
+{
+  memset(&extraChannels[moduleIdx], 0, sizeof(CrossfireExtraChannels));
+}
+
+uint8_t createCrossfireExtraChannelsFrame(uint8_t moduleIdx, uint8_t * frame,
+                                          int16_t * pulses, uint8_t nChannels,
+                                          uint8_t maxLen)
+{
+  auto & extra = extraChannels[moduleIdx];
+  uint8_t count = nChannels > CROSSFIRE_CHANNELS_COUNT
+                      ? min<uint8_t>(nChannels, CROSSFIRE_MAX_CHANNELS) -
+                            CROSSFIRE_CHANNELS_COUNT
+                      : 0;
+
+  if (extra.refresh == 0 || extra.count != count) {
+    extra.pending = (1ull << count) - 1;
+    extra.refresh = CROSSFIRE_SUBSET_REFRESH;
+  } else {
+    extra.refresh--;
+  }
+  extra.count = count;
+  if (count == 0) return 0;
+
+  uint16_t values[CROSSFIRE_MAX_CHANNELS - CROSSFIRE_CHANNELS_COUNT];
+  for (uint8_t i = 0; i < count; i++) {
+    uint8_t ch = CROSSFIRE_CHANNELS_COUNT + i;
+    values[i] = crossfireSubsetChannelValue(ch, pulses[ch]);
+    if (values[i] != extra.values[i]) extra.pending |= 1u << i;
+  }
+
+  int maxChannels = maxLen > CROSSFIRE_SUBSET_OVERHEAD
+                        ? (maxLen - CROSSFIRE_SUBSET_OVERHEAD) * 8 / CROSSFIRE_CH_BITS
+                        : 0;
+  if (!extra.pending || maxChannels == 0) return 0;
+
+  uint8_t first = 0, last = count - 1;
+  while (!(extra.pending & (1u << first))) first++;
+  while (!(extra.pending & (1u << last))) last--;
+
+  if (last - first >= maxChannels) {
+    // not all in this frame: continue from where the last one stopped
+    if (extra.next >= count) extra.next = 0;
+    first = extra.next;
+    while (!(extra.pending & (1u << first))) first = (first + 1) % count;
+    last = first;
+    for (uint8_t i = first; i < count && i < first + maxChannels; i++) {
+      if (extra.pending & (1u << i)) last = i;
+    }
+  }
+
+  for (uint8_t i = first; i <= last; i++) {
+    extra.values[i] = values[i];
+    extra.pending &= ~(1u << i);
+  }
+  extra.next = last + 1;
+
+  return createCrossfireSubsetChannelsFrame(
+      frame, CROSSFIRE_CHANNELS_COUNT + first, &values[first],
+      last - first + 1);
+}
+
+// RC frames may take half of a period at the configured baud rate, the
+// other half being left to the telemetry sent back by the module
+static uint16_t crossfireFramesBudget(uint8_t module)
+{
+  return (CROSSFIRE_BAUDRATE(module) / 1000) * mixerSchedulerGetPeriod(module) / 10000 / 2;
+}
+
 static void setupPulsesCrossfire(uint8_t module, uint8_t*& p_buf,
                                  uint8_t endpoint, int16_t* channels,
                                  uint8_t nChannels)
@@ -183,8 +306,16 @@ static void setupPulsesCrossfire(uint8_t module, uint8_t*& p_buf,
       p_buf += createCrossfireBindFrame(module, p_buf);
       moduleState[module].mode = MODULE_MODE_NORMAL;
     } else {
-      /* TODO: nChannels */
-      p_buf += createCrossfireChannelsFrame(module, p_buf, channels);
+      // the regular frame is always sent, the extra channels only get what
+      // is left of the budget and wait for the next periods otherwise
+      uint8_t len = createCrossfireChannelsFrame(module, p_buf, channels, nChannels);
+      p_buf += len;
+      uint16_t budget = crossfireFramesBudget(module);
+      if (budget > len) {
+        p_buf += createCrossfireExtraChannelsFrame(
+            module, p_buf, channels, nChannels,
+            min<uint16_t>(budget - len, CROSSFIRE_FRAME_MAXLEN));
+      }
     }
   }
 }
@@ -429,6 +560,7 @@ static void* crossfireInit(uint8_t module)
 #endif
 
   if (mod_st) {
+    resetCrossfireExtraChannels(module);
     mixerSchedulerSetPeriod(module, CROSSFIRE_PERIOD(module));
   }
 
@@ -24,3 +24,23 @@
 #include "hal/module_driver.h"
 
 extern const etx_proto_driver_t CrossfireDriver;
+
+// Channel value (11 bits) of a channel in regular and in subset RC frames,
+// which do not use the same encoding
+uint16_t crossfireChannelValue(uint8_t channel, int16_t pulse);
+uint16_t crossfireSubsetChannelValue(uint8_t channel, int16_t pulse);
+
+// Regular RC frame (first 16 channels)
+uint8_t createCrossfireChannelsFrame(uint8_t moduleIdx, uint8_t * frame,
+                                     int16_t * pulses, uint8_t nChannels);
+
+// Subset RC frame, 11 bits channel values
+uint8_t createCrossfireSubsetChannelsFrame(uint8_t * frame, uint8_t first,
+                                           const uint16_t * values, uint8_t count);
+
+// Subset RC frame with the channels above 16 which changed since they were
+// last sent, at most maxLen bytes (returns 0 if there is nothing to send)
+uint8_t createCrossfireExtraChannelsFrame(uint8_t moduleIdx, uint8_t * frame,
+                                          int16_t * pulses, uint8_t nChannels,
+                                          uint8_t maxLen = CROSSFIRE_FRAME_MAXLEN);
+void resetCrossfireExtraChannels(uint8_t moduleIdx);
@@ -42,7 +42,8 @@ extern uint32_t NV14internalModuleFwVersion;
 #include "pulses/afhds3_module.h"
 #endif
 
-#define CROSSFIRE_CHANNELS_COUNT        16
+#define CROSSFIRE_CHANNELS_COUNT        16  // channels of the regular RC frame
+#define CROSSFIRE_MAX_CHANNELS          32  // extra channels go in subset frames
 #define GHOST_CHANNELS_COUNT            16
 
 #define IS_NATIVE_FRSKY_PROTOCOL(module)                                \
@@ -437,7 +438,7 @@ static const int8_t maxChannelsModules_M8[] = {
   0, // MODULE_TYPE_XJT_PXX1: index NOT USED
   16,// MODULE_TYPE_ISRM_PXX2
   -2,// MODULE_TYPE_DSM2
-  CROSSFIRE_CHANNELS_COUNT - 8, // MODULE_TYPE_CROSSFIRE
+  CROSSFIRE_MAX_CHANNELS - 8, // MODULE_TYPE_CROSSFIRE
   8, // MODULE_TYPE_MULTIMODULE
   0, // MODULE_TYPE_R9M_PXX1: index NOT USED
   0, // MODULE_TYPE_R9M_PXX2: index NOT USED
@@ -496,6 +497,8 @@ inline int8_t defaultModuleChannels_M8(uint8_t idx)
 {
   if (isModulePPM(idx))
     return 0; // 8 channels
+  else if (isModuleCrossfire(idx))
+    return CROSSFIRE_CHANNELS_COUNT - 8;
   else
     return maxModuleChannels_M8(idx);
 }
@@ -75,6 +75,7 @@
 
 static module_pulse_driver _module_drivers[MAX_MODULES];
 static module_pulse_buffer _module_buffers[MAX_MODULES] __DMA_NO_CACHE;
+static ModuleLatency _module_latency[MAX_MODULES];
 
 void pulsesInit()
 {
@@ -569,17 +570,49 @@ void pulsesSendNextFrame(uint8_t module)
 
     uint8_t channelStart = g_model.moduleData[module].channelsStart;
     int16_t* channels = &channelOutputs[channelStart];
-    uint8_t nChannels = 16;  // TODO: MAX_CHANNELS - channelsStart
+    uint8_t nChannels = min<uint8_t>(sentModuleChannels(module),
+                                     MAX_OUTPUT_CHANNELS - channelStart);
 
     auto buffer = _module_buffers[module]._buffer;
     drv->sendPulses(ctx, buffer, channels, nChannels);
+    _module_latency[module].update(timersGetUsTick() - mixerSampleTime);
   }
 }
 
-void pulsesSendChannels()
+void pulsesSendChannels(uint8_t modules)
 {
   for (uint8_t i = 0; i < MAX_MODULES; i++) {
-    pulsesSendNextFrame(i);
+    if (modules & (1 << i)) pulsesSendNextFrame(i);
+  }
+}
+
+void ModuleLatency::update(uint32_t latency)
+{
+  last = min<uint32_t>(latency, UINT16_MAX);
+  if (frames++ == 0) {
+    lowest = highest = last;
+    filtered = last * 16;
+    return;
+  }
+  if (last < lowest) lowest = last;
+  if (last > highest) highest = last;
+  filtered += (int32_t)(last * 16 - filtered) / 16;
+}
+
+void ModuleLatency::reset()
+{
+  memset(this, 0, sizeof(ModuleLatency));
+}
+
+const ModuleLatency& getModuleLatency(uint8_t module)
+{
+  return _module_latency[module];
+}
+
+void resetModuleLatency()
+{
+  for (uint8_t i = 0; i < MAX_MODULES; i++) {
+    _module_latency[i].reset();
   }
 }
 
@@ -166,7 +166,26 @@ uint8_t* pulsesGetModuleBuffer(uint8_t module);
 
 void pulsesStopModule(uint8_t module);
 void pulsesSendNextFrame(uint8_t module);
-void pulsesSendChannels();
+
+// Send the next frame of the modules in 'modules' (bit mask)
+void pulsesSendChannels(uint8_t modules);
+
+// Stick-to-UART latency: from the sampling of the inputs by the mixer run
+// to the frame being handed to the module port, in us
+struct ModuleLatency {
+  uint16_t last;
+  uint16_t lowest;
+  uint16_t highest;
+  uint32_t filtered;  // in 1/16 us
+  uint32_t frames;
+
+  uint16_t average() const { return filtered / 16; }
+  void update(uint32_t latency);
+  void reset();
+};
+
+const ModuleLatency& getModuleLatency(uint8_t module);
+void resetModuleLatency();
 
 typedef void (*module_init_cb_t)(uint8_t, const etx_proto_driver_t*);
 typedef void (*module_deinit_cb_t)(uint8_t, const etx_proto_driver_t*);
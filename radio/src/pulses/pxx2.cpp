@@ -283,7 +283,7 @@ void Pxx2Pulses::addChannels(uint8_t module, int16_t* channels, uint8_t nChannel
   uint8_t count = sentModuleChannels(module);
 
   for (int8_t i = 0; i < count; i++, channel++) {
-    int value = channels[i] + 2*PPM_CH_CENTER(channel) - 2*PPM_CENTER;
+    int value = i < nChannels ? channels[i] + 2*PPM_CH_CENTER(channel) - 2*PPM_CENTER : 0;
     pulseValue = limit(1, (value * 512 / 682) + 1024, 2046);
 #if defined(DEBUG_LATENCY_RF_ONLY)
     if (latencyToggleSwitch)
@@ -25,6 +25,7 @@
 #include "mixer_scheduler.h"
 
 #include "edgetx.h"
+#include "bit_packing.h"
 
 #define SBUS_NORMAL_CHANS 16
 #define SBUS_CHAN_BITS    11
@@ -60,23 +61,19 @@ static void setupPulsesSbus(uint8_t module, uint8_t*& p_buf)
   // Sync Byte
   sendByte(p_buf, SBUS_FRAME_BEGIN_BYTE);
 
-  uint32_t bits = 0;
-  uint8_t bitsavailable = 0;
-
   // byte 1-22, channels 0..2047, limits not really clear (B
+  uint16_t values[SBUS_NORMAL_CHANS];
   for (int i=0; i<SBUS_NORMAL_CHANS; i++) {
     int value = getChannelValue(module, i);
 
     value =  value*8/10 + SBUS_CHAN_CENTER;
-    bits |= limit(0, value, 2047) << bitsavailable;
-    bitsavailable += SBUS_CHAN_BITS;
-    while (bitsavailable >= 8) {
-      sendByte(p_buf, (uint8_t) (bits & 0xff));
-      bits >>= 8;
-      bitsavailable -= 8;
-    }
+    values[i] = limit(0, value, 2047);
   }
 
+  typedef BitPacking<SBUS_CHAN_BITS, SBUS_NORMAL_CHANS> SbusChannelsPacking;
+  SbusChannelsPacking::pack(p_buf, values);
+  p_buf += SbusChannelsPacking::SIZE;
+
   // flags
   uint8_t flags=0;
   if (getChannelValue(module, 16) > 0)
@@ -23,6 +23,7 @@
 
 #include "edgetx.h"
 #include "timers_driver.h"
+#include "bit_packing.h"
 
 #define SBUS_FRAME_SIZE 25
 #define SBUS_START_BYTE 0x0F
@@ -32,7 +33,6 @@
 #define SBUS_FAILSAFE_BIT 3
 
 #define SBUS_CH_BITS 11
-#define SBUS_CH_MASK ((1 << SBUS_CH_BITS) - 1)
 
 #define SBUS_CH_CENTER 0x3E0
 
@@ -86,18 +86,12 @@ static void sbusProcessFrame(int16_t* pulses, uint8_t* sbus, uint32_t size)
     return;  // SBUS invalid frame or failsafe mode
   }
 
-  sbus++;  // skip start byte
+  // bytes 1-22: channels after the start byte
+  uint16_t values[MAX_TRAINER_CHANNELS];
+  BitPacking<SBUS_CH_BITS, MAX_TRAINER_CHANNELS>::unpack(sbus + 1, values);
 
-  uint32_t inputbitsavailable = 0;
-  uint32_t inputbits = 0;
   for (uint32_t i = 0; i < MAX_TRAINER_CHANNELS; i++) {
-    while (inputbitsavailable < SBUS_CH_BITS) {
-      inputbits |= *sbus++ << inputbitsavailable;
-      inputbitsavailable += 8;
-    }
-    *pulses++ = ((int32_t)(inputbits & SBUS_CH_MASK) - SBUS_CH_CENTER) * 5 / 8;
-    inputbitsavailable -= SBUS_CH_BITS;
-    inputbits >>= SBUS_CH_BITS;
+    pulses[i] = ((int32_t)values[i] - SBUS_CH_CENTER) * 5 / 8;
   }
 
   trainerResetTimer();
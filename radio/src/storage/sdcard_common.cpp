@@ -135,6 +135,8 @@ void storageCheck(bool immediately)
   if (storageDirtyMsk & EE_MODEL) {
     if (retryModelCount < retryLimit) {
       TRACE("SD card write model settings");
+      // the persistent timers are saved along with any other change
+      updatePersistentTimers();
       const char * error = writeModel();
 #if defined(STORAGE_MODELSLIST)
       modelslist.updateCurrentModelCell();
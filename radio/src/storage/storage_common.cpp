@@ -89,6 +89,8 @@ void preModelLoad()
 
 void postRadioSettingsLoad()
 {
+  globalFunctionsContext.invalidateIndex();
+
 #if LCD_W == 128
   // Prevent GVARS to be off when imported or manually modified yaml
   // Since there is no way to have those back
@@ -172,6 +174,11 @@ static void sanitizeMixerLines()
 
 void postModelLoad(bool alarms)
 {
+#if defined(GVARS)
+  invalidateGVarFlightModes();
+#endif
+  modelFunctionsContext.invalidateIndex();
+
 #if defined(COLORLCD)
   if (!g_model.hasScreenData(0))
     LayoutFactory::loadDefaultLayout();
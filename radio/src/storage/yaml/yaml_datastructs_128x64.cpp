@@ -99,6 +99,12 @@ const struct YamlIdStr enum_SwitchConfig[] = {
   {  SWITCH_3pos, "3pos"  },
   {  0, NULL  }
 };
+const struct YamlIdStr enum_AdcFilter[] = {
+  {  ADCFILTER_MMA, "MMA"  },
+  {  ADCFILTER_ONE_EURO, "ONE_EURO"  },
+  {  ADCFILTER_KALMAN, "KALMAN"  },
+  {  0, NULL  }
+};
 const struct YamlIdStr enum_TimerModes[] = {
   {  TMRMODE_OFF, "OFF"  },
   {  TMRMODE_ON, "ON"  },
@@ -168,10 +174,13 @@ const struct YamlIdStr enum_PotsWarnMode[] = {
   {  POTS_WARN_AUTO, "WARN_AUTO"  },
   {  0, NULL  }
 };
-const struct YamlIdStr enum_ModelOverridableEnable[] = {
-  {  OVERRIDE_GLOBAL, "GLOBAL"  },
-  {  OVERRIDE_OFF, "OFF"  },
-  {  OVERRIDE_ON, "ON"  },
+const struct YamlIdStr enum_ModelAdcFilter[] = {
+  {  MDLFILTER_GLOBAL, "GLOBAL"  },
+  {  MDLFILTER_OFF, "OFF"  },
+  {  MDLFILTER_ON, "ON"  },
+  {  MDLFILTER_MMA, "MMA"  },
+  {  MDLFILTER_ONE_EURO, "ONE_EURO"  },
+  {  MDLFILTER_KALMAN, "KALMAN"  },
   {  0, NULL  }
 };
 const struct YamlIdStr enum_FailsafeModes[] = {
@@ -212,6 +221,12 @@ const struct YamlIdStr enum_USBJoystickCh[] = {
   {  USBJOYS_CH_SIM, "CH_SIM"  },
   {  0, NULL  }
 };
+const struct YamlIdStr enum_ModelOverridableEnable[] = {
+  {  OVERRIDE_GLOBAL, "GLOBAL"  },
+  {  OVERRIDE_OFF, "OFF"  },
+  {  OVERRIDE_ON, "ON"  },
+  {  0, NULL  }
+};
 
 //
 // Structs last
@@ -386,7 +401,8 @@ static const struct YamlNode struct_RadioData[] = {
   YAML_UNSIGNED( "oneLogPerDay", 1 ),
   YAML_UNSIGNED( "keyLockEnabled", 1 ),
   YAML_UNSIGNED( "invertLCD", 1 ),
-  YAML_PADDING( 4 ),
+  YAML_ENUM("adcFilter", 2, enum_AdcFilter, NULL),
+  YAML_PADDING( 2 ),
   YAML_UNSIGNED( "pwrOffIfInactive", 8 ),
   YAML_END
 };
@@ -849,8 +865,7 @@ static const struct YamlNode struct_ModelData[] = {
   YAML_STRUCT("rfAlarms", 16, struct_RFAlarmData, NULL),
   YAML_UNSIGNED( "thrTrimSw", 3 ),
   YAML_ENUM("potsWarnMode", 2, enum_PotsWarnMode, NULL),
-  YAML_ENUM("jitterFilter", 2, enum_ModelOverridableEnable, NULL),
-  YAML_PADDING( 1 ),
+  YAML_ENUM("jitterFilter", 3, enum_ModelAdcFilter, NULL),
   YAML_ARRAY("moduleData", 232, 2, struct_ModuleData, NULL),
   YAML_ARRAY("failsafeChannels", 16, 32, struct_signed_16, NULL),
   YAML_STRUCT("trainerData", 40, struct_TrainerModuleData, NULL),
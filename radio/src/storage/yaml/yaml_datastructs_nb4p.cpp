@@ -144,6 +144,12 @@ const struct YamlIdStr enum_QMPage[] = {
   {  QM_APP, "APP"  },
   {  0, NULL  }
 };
+const struct YamlIdStr enum_AdcFilter[] = {
+  {  ADCFILTER_MMA, "MMA"  },
+  {  ADCFILTER_ONE_EURO, "ONE_EURO"  },
+  {  ADCFILTER_KALMAN, "KALMAN"  },
+  {  0, NULL  }
+};
 const struct YamlIdStr enum_TimerModes[] = {
   {  TMRMODE_OFF, "OFF"  },
   {  TMRMODE_ON, "ON"  },
@@ -213,6 +219,15 @@ const struct YamlIdStr enum_PotsWarnMode[] = {
   {  POTS_WARN_AUTO, "WARN_AUTO"  },
   {  0, NULL  }
 };
+const struct YamlIdStr enum_ModelAdcFilter[] = {
+  {  MDLFILTER_GLOBAL, "GLOBAL"  },
+  {  MDLFILTER_OFF, "OFF"  },
+  {  MDLFILTER_ON, "ON"  },
+  {  MDLFILTER_MMA, "MMA"  },
+  {  MDLFILTER_ONE_EURO, "ONE_EURO"  },
+  {  MDLFILTER_KALMAN, "KALMAN"  },
+  {  0, NULL  }
+};
 const struct YamlIdStr enum_ModelOverridableEnable[] = {
   {  OVERRIDE_GLOBAL, "GLOBAL"  },
   {  OVERRIDE_OFF, "OFF"  },
@@ -449,7 +464,8 @@ static const struct YamlNode struct_RadioData[] = {
   YAML_UNSIGNED( "favMultiMode", 1 ),
   YAML_UNSIGNED( "modelSelectLayout", 2 ),
   YAML_UNSIGNED( "radioThemesDisabled", 1 ),
-  YAML_PADDING( 7 ),
+  YAML_ENUM("adcFilter", 2, enum_AdcFilter, NULL),
+  YAML_PADDING( 5 ),
   YAML_UNSIGNED( "pwrOffIfInactive", 8 ),
   YAML_ARRAY("keyShortcuts", 8, 6, struct_KeyShortcut, NULL),
   YAML_ARRAY("qmFavorites", 8, 12, struct_QMFavorite, NULL),
@@ -934,8 +950,7 @@ static const struct YamlNode struct_ModelData[] = {
   YAML_STRUCT("rfAlarms", 16, struct_RFAlarmData, NULL),
   YAML_UNSIGNED( "thrTrimSw", 3 ),
   YAML_ENUM("potsWarnMode", 2, enum_PotsWarnMode, NULL),
-  YAML_ENUM("jitterFilter", 2, enum_ModelOverridableEnable, NULL),
-  YAML_PADDING( 1 ),
+  YAML_ENUM("jitterFilter", 3, enum_ModelAdcFilter, NULL),
   YAML_ARRAY("moduleData", 232, 2, struct_ModuleData, NULL),
   YAML_ARRAY("failsafeChannels", 16, 32, struct_signed_16, NULL),
   YAML_STRUCT("trainerData", 40, struct_TrainerModuleData, NULL),
@@ -74,6 +74,10 @@ CircularBuffer<uint8_t, 8> luaSetStickySwitchBuffer;
 
 tmr10ms_t switchesMidposStart[MAX_SWITCHES];
 uint64_t  switchesPos = 0;
+static uint64_t switchesPosChanges = 0;
+
+// hardware positions on the last call to getSwitchesPosition()
+static uint64_t switchesHwPos = 0;
 
 static_assert(sizeof(uint64_t) * 8 >= ((MAX_SWITCHES - 1) / 2) + 1,
               "MAX_SWITCHES too big for uint64_t position state");
@@ -81,6 +85,17 @@ static_assert(sizeof(uint64_t) * 8 >= ((MAX_SWITCHES - 1) / 2) + 1,
 tmr10ms_t potsLastposStart[MAX_POTS];
 uint8_t   potsPos[MAX_POTS];
 
+// multipos pots: position thresholds, derived from the calibration steps
+// count and recomputed when it changes. The mixer and the UI task have a
+// table each, so that neither one reads a table the other one is updating.
+struct MultiposThresholds {
+  uint8_t  stepsCount[MAX_POTS];
+  uint16_t values[MAX_POTS][XPOTS_MULTIPOS_COUNT - 1];
+};
+
+static MultiposThresholds mixerMultiposThresholds;
+static MultiposThresholds uiMultiposThresholds;
+
 #define SWITCH_POSITION(sw) (switchesPos & ((MASK_CFN_TYPE)1 << (sw)))
 #define POT_POSITION(sw)                            \
   ((potsPos[(sw) / XPOTS_MULTIPOS_COUNT] & 0x0f) == \
@@ -342,12 +357,11 @@ SwitchConfig switchGetMaxType(uint8_t idx)
   }
 }
 
-static uint64_t checkSwitchPosition(uint8_t idx, bool startup)
+static uint64_t checkSwitchPosition(uint8_t idx, SwitchHwPos pos, bool startup)
 {
   uint64_t result = 0;
   uint32_t index = idx * 3;
 
-  auto pos = switchGetPosition(idx);
   switch(pos) {
 
   case SWITCH_HW_UP:
@@ -386,14 +400,62 @@ static uint64_t checkSwitchPosition(uint8_t idx, bool startup)
   return result;
 }
 
+static SwitchHwPos getHwPosition(uint64_t positions, uint8_t idx)
+{
+  auto bits = (positions >> (idx * 3)) & 0x7;
+  if (bits & (1 << SWITCH_HW_DOWN)) return SWITCH_HW_DOWN;
+  if (bits & (1 << SWITCH_HW_MID)) return SWITCH_HW_MID;
+  return SWITCH_HW_UP;
+}
+
+// returns the position of a multipos pot, -1 if not calibrated
+static int8_t getMultiposPosition(MultiposThresholds & cache, uint8_t idx,
+                                  uint8_t analogIdx)
+{
+#if defined(SIMU)
+  uint8_t count = XPOTS_MULTIPOS_COUNT - 1;
+#else
+  auto calib = (const StepsCalibData *)&g_eeGeneral.calib[analogIdx];
+  if (!IS_MULTIPOS_CALIBRATED(calib)) return -1;
+  uint8_t count = calib->count;
+#endif
+
+  uint16_t * thresholds = cache.values[idx];
+  if (cache.stepsCount[idx] != count) {
+    for (uint8_t i = 0; i < XPOTS_MULTIPOS_COUNT - 1; i++) {
+      thresholds[i] = (i + 1) * (2 * RESX / count);
+    }
+    cache.stepsCount[idx] = count;
+  }
+
+  uint16_t value = anaIn(analogIdx);
+  uint8_t pos = 0;
+  while (pos < XPOTS_MULTIPOS_COUNT - 1 && value >= thresholds[pos]) {
+    pos++;
+  }
+  return pos;
+}
+
 void getSwitchesPosition(bool startup)
 {
+  uint64_t hwPos = switchGetPositions();
+  uint64_t hwChanges = hwPos ^ switchesHwPos;
+  switchesHwPos = hwPos;
+
+  // Only the switches which moved, or waiting for the mid position delay,
+  // have to be decoded again
   uint64_t newPos = 0;
   for (unsigned i = 0; i < switchGetMaxAllSwitches(); i++) {
     if (!SWITCH_EXISTS(i)) continue;
-    newPos |= checkSwitchPosition(i, startup);
+    uint64_t mask = (uint64_t)0x7 << (i * 3);
+    uint64_t pos = switchesPos & mask;
+    if (startup || !pos || (hwChanges & mask) || switchesMidposStart[i]) {
+      pos = checkSwitchPosition(i, getHwPosition(hwPos, i), startup);
+    }
+    newPos |= pos;
   }
 
+  switchesPosChanges = switchesPos ^ newPos;
   switchesPos = newPos;
 
   auto max_pots = adcGetMaxInputs(ADC_INPUT_FLEX);
@@ -402,15 +464,8 @@ void getSwitchesPosition(bool startup)
   for (int i = 0; i < max_pots; i++) {
     if (IS_POT_MULTIPOS(i)) {
       auto analog_idx = offset + i;
-      StepsCalibData * calib = (StepsCalibData *) &g_eeGeneral.calib[analog_idx];
-#if defined(SIMU)
-      {
-        uint8_t count = XPOTS_MULTIPOS_COUNT - 1;
-#else
-      if (IS_MULTIPOS_CALIBRATED(calib)) {
-        uint8_t count = calib->count;
-#endif
-        uint8_t pos = anaIn(analog_idx) / (2 * RESX / count);
+      int8_t pos = getMultiposPosition(mixerMultiposThresholds, i, analog_idx);
+      if (pos >= 0) {
         uint8_t previousPos = potsPos[i] >> 4;
         uint8_t previousStoredPos = potsPos[i] & 0x0F;
         if (startup) {
@@ -433,6 +488,11 @@ void getSwitchesPosition(bool startup)
   }
 }
 
+uint64_t getSwitchesPositionChanges()
+{
+  return switchesPosChanges;
+}
+
 uint8_t getSwitchCount()
 {
   int count = 0;
@@ -844,16 +904,9 @@ swsrc_t getMovedSwitch()
   // Multipos
   for (int i = 0; i < MAX_POTS; i++) {
     if (IS_POT_MULTIPOS(i)) {
-      StepsCalibData * calib = (StepsCalibData *) &g_eeGeneral.calib[MAX_STICKS + i];
-#if defined(SIMU)
-      {
-        uint8_t count = XPOTS_MULTIPOS_COUNT - 1;
-#else
-      if (IS_MULTIPOS_CALIBRATED(calib)) {
-        uint8_t count = calib->count;
-#endif
+      int8_t next = getMultiposPosition(uiMultiposThresholds, i, MAX_STICKS + i);
+      if (next >= 0) {
         uint8_t prev = potsPos[i] & 0x0F;
-        uint8_t next = anaIn(MAX_STICKS + i) / (2 * RESX / count);
         if (prev != next) {
           result = SWSRC_FIRST_MULTIPOS_SWITCH + i * XPOTS_MULTIPOS_COUNT + next;
         }
@@ -53,6 +53,10 @@ bool isSwitchWarningRequired(uint16_t &bad_pots);
 
 void getSwitchesPosition(bool startup);
 
+// switch positions (3 bits per switch) which changed on the last call to
+// getSwitchesPosition()
+uint64_t getSwitchesPositionChanges();
+
 uint8_t getSwitchCount();
 
 uint8_t switchGetMaxRow(uint8_t col);
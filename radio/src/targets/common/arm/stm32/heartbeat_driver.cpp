@@ -26,6 +26,7 @@
 #include "stm32_hal_ll.h"
 
 #include "mixer_scheduler.h"
+#include "dataconstants.h"
 #include "board.h"
 #include "debug.h"
 
@@ -44,6 +45,7 @@ static void trigger_intmodule_heartbeat()
   heartbeatCapture.count++;
 #endif
 
+  mixerSchedulerHeartbeat(INTERNAL_MODULE);
   mixerSchedulerSoftTrigger();
 }
 
@@ -25,6 +25,7 @@
 
 #include "FreeRTOSConfig.h"
 #include "hal.h"
+#include "timers_driver.h"
 
 // Start scheduler with default period
 void mixerSchedulerStart()
@@ -77,8 +78,8 @@ extern "C" void MIXER_SCHEDULER_TIMER_IRQHandler(void)
   MIXER_SCHEDULER_TIMER->SR &= ~TIM_SR_UIF; // clear flag
   mixerSchedulerDisableTrigger();
 
-  // set next period
-  MIXER_SCHEDULER_TIMER->ARR = getMixerSchedulerPeriod() - 1;
+  // set delay until the next module slot
+  MIXER_SCHEDULER_TIMER->ARR = mixerSchedulerNextTrigger(timersGetUsTick()) - 1;
 
   // trigger mixer start
   mixerSchedulerISRTrigger();
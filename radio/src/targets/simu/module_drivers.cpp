@@ -22,6 +22,7 @@
 #include "hal.h"
 #include "hal/serial_driver.h"
 #include "hal/module_port.h"
+#include "heartbeat_driver.h"
 #include "dataconstants.h"
 #include "debug.h"
 
@@ -55,6 +56,8 @@ bool is_trainer_dsc_connected() { return false; }
 void trainer_init_module_cppm() {}
 void trainer_stop_module_cppm() {}
 
+volatile HeartbeatCapture heartbeatCapture;
+
 void init_intmodule_heartbeat() {}
 void stop_intmodule_heartbeat() {}
 
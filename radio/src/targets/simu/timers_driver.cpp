@@ -21,6 +21,16 @@
 
 #include "timers_driver.h"
 
+#include <chrono>
+
 void watchdogSuspend(unsigned int) {}
-uint32_t timersGetUsTick() { return 0; }
+
+// Wraps around like the hardware counter
+uint32_t timersGetUsTick()
+{
+  static auto start = std::chrono::steady_clock::now();
+  auto now = std::chrono::steady_clock::now();
+  return std::chrono::duration_cast<std::chrono::microseconds>(now - start)
+      .count();
+}
 
@@ -181,7 +181,7 @@ void mixerTask()
       mixerTaskLock();
 
       doMixerCalculations();
-      pulsesSendChannels();
+      pulsesSendChannels(mixerSchedulerGetDueModules());
       doMixerPeriodicUpdates();
 
       // TODO: what are these for???
@@ -232,6 +232,9 @@ void doMixerCalculations()
   // therefore forget the exact calculation and use only 1 instead; good compromise
   lastTMR = tmr10ms;
 
+  // start of the stick-to-UART latency of the frames built from this run
+  mixerSampleTime = timersGetUsTick();
+
   DEBUG_TIMER_START(debugTimerGetAdc);
   getADC();
   DEBUG_TIMER_STOP(debugTimerGetAdc);
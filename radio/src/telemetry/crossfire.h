@@ -43,6 +43,7 @@
 #define VOLT_ARRAY_ID                  0xFE  // Pseudo sensor out of 0x0E frame
 #define LINK_ID                        0x14
 #define CHANNELS_ID                    0x16
+#define SUBSET_CHANNELS_ID             0x17
 #define LINK_RX_ID                     0x1C
 #define LINK_TX_ID                     0x1D
 #define ATTITUDE_ID                    0x1E
@@ -188,6 +189,17 @@ const uint8_t CROSSFIRE_FRAME_PERIODS[] = {
 #define EXT_CROSSFIRE_PERIOD   (CROSSFIRE_FRAME_PERIODS[EXT_CROSSFIRE_BR_IDX] * 1000)
 #endif
 
+#if defined(HARDWARE_INTERNAL_MODULE) && defined(HARDWARE_EXTERNAL_MODULE)
+#define CROSSFIRE_BAUDRATE(module) \
+  (module == INTERNAL_MODULE ? INT_CROSSFIRE_BAUDRATE : EXT_CROSSFIRE_BAUDRATE)
+#elif defined(HARDWARE_INTERNAL_MODULE)
+#define CROSSFIRE_BAUDRATE(module) INT_CROSSFIRE_BAUDRATE
+#elif defined(HARDWARE_EXTERNAL_MODULE)
+#define CROSSFIRE_BAUDRATE(module) EXT_CROSSFIRE_BAUDRATE
+#else
+#define CROSSFIRE_BAUDRATE(module) CROSSFIRE_BAUDRATES[0]
+#endif
+
 #if defined(HARDWARE_INTERNAL_MODULE) && defined(HARDWARE_EXTERNAL_MODULE)
 #define CROSSFIRE_PERIOD(module) \
   (module == INTERNAL_MODULE ? INT_CROSSFIRE_PERIOD : EXT_CROSSFIRE_PERIOD)
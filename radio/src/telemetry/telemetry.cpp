@@ -301,12 +301,7 @@ void telemetryWakeup()
   }
   _telemetryIsPolling = false;
 
-  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
-    const TelemetrySensor& sensor = g_model.telemetrySensors[i];
-    if (sensor.type == TELEM_TYPE_CALCULATED) {
-      telemetryItems[i].eval(sensor);
-    }
-  }
+  evalCalculatedSensors();
 
 #if defined(VARIO)
   if (TELEMETRY_STREAMING() && !IS_FAI_ENABLED()) {
@@ -393,14 +388,12 @@ void telemetryWakeup()
 void telemetryInterrupt10ms()
 {
   if (telemetryStreaming > 0) {
-    bool tick160ms = (telemetryStreaming & 0x0F) == 0;
-    for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
-      const TelemetrySensor & sensor = g_model.telemetrySensors[i];
-      if (sensor.type == TELEM_TYPE_CALCULATED) {
-        telemetryItems[i].per10ms(sensor);
-      }
-      if (tick160ms && telemetryItems[i].timeout > 0) {
-        telemetryItems[i].timeout--;
+    calculatedSensorsPer10ms();
+    if ((telemetryStreaming & 0x0F) == 0) {
+      for (auto & telemetryItem : telemetryItems) {
+        if (telemetryItem.timeout > 0) {
+          telemetryItem.timeout--;
+        }
       }
     }
     telemetryStreaming--;
@@ -424,6 +417,7 @@ void telemetryReset()
   for (auto & telemetryItem : telemetryItems) {
     telemetryItem.clear();
   }
+  invalidateCalculatedSensors();
 
   telemetryStreaming = 0; // reset counter only if valid telemetry packets are being detected
   telemetryState = TELEMETRY_INIT;
@@ -504,9 +498,54 @@ ModuleSyncStatus &getModuleSyncStatus(uint8_t moduleIdx)
 }
 #endif
 
+int8_t getSyncedModule()
+{
+  for (uint8_t i = 0; i < NUM_MODULES; i++) {
+    if (getModuleSyncStatus(i).isValid()) return i;
+  }
+  return -1;
+}
+
+void resetModuleSyncStats()
+{
+  for (uint8_t i = 0; i < NUM_MODULES; i++) {
+    getModuleSyncStatus(i).resetStats();
+  }
+}
+
+// Consecutive reports within the lock threshold to be locked
+#define SYNC_LOCK_REPORTS  4
+
+// Lag under which the loop is considered locked, in us
+static int32_t syncLockThreshold(uint16_t refreshRate)
+{
+  return max<int32_t>(refreshRate / 64, 10);
+}
+
+// A new packet rate, or the first report after a loss of sync
+static bool syncRestarts(uint16_t refreshRate, tmr10ms_t lastUpdate,
+                         uint16_t newRefreshRate)
+{
+  return !refreshRate || get_tmr10ms() - lastUpdate >= 200 ||
+         abs(newRefreshRate - refreshRate) > refreshRate / 16;
+}
+
 ModuleSyncStatus::ModuleSyncStatus()
 {
-  memset(this, 0, sizeof(ModuleSyncStatus));
+  memset(reinterpret_cast<void *>(this), 0, sizeof(ModuleSyncStatus));
+}
+
+void ModuleSyncStatus::restart()
+{
+  reports = 0;
+  lockCount = 0;
+  lockTime = 0;
+  lockStart = get_tmr10ms();
+}
+
+bool ModuleSyncStatus::isLocked() const
+{
+  return isValid() && lockCount >= SYNC_LOCK_REPORTS;
 }
 
 void ModuleSyncStatus::update(uint16_t newRefreshRate, int16_t newInputLag)
@@ -519,47 +558,107 @@ void ModuleSyncStatus::update(uint16_t newRefreshRate, int16_t newInputLag)
   else if (newRefreshRate > MAX_REFRESH_RATE)
     newRefreshRate = MAX_REFRESH_RATE;
 
+  // Lost or new packet rate: lock again
+  if (syncRestarts(refreshRate, lastUpdate, newRefreshRate)) {
+    restart();
+  }
+
   refreshRate = newRefreshRate;
   inputLag    = newInputLag;
-  currentLag  = newInputLag;
+
+  // Statistics
+  int32_t lag = newInputLag;
+  int32_t absLag = abs(lag);
+  if (reports++ == 0) {
+    phaseError = lag * 16;
+    jitter = 0;
+  }
+  else {
+    phaseError += (lag * 16 - phaseError) / 8;
+    jitter += (abs(lag * 16 - phaseError) - jitter) / 8;
+  }
+  if (absLag > maxLag) maxLag = min<int32_t>(absLag, UINT16_MAX);
+  if (absLag > refreshRate / 2) {
+    slips++;
+  }
+  if (absLag <= syncLockThreshold(refreshRate)) {
+    if (lockCount < SYNC_LOCK_REPORTS && ++lockCount == SYNC_LOCK_REPORTS &&
+        !lockTime) {
+      lockTime = max<tmr10ms_t>(get_tmr10ms() - lockStart, 1);
+    }
+  }
+  else {
+    lockCount = 0;
+  }
+
+  // Hand the report over to the scheduler, which runs the controller
+  pendingReport = (uint32_t)newRefreshRate << 16 | (uint16_t)newInputLag;
+
+  // update timestamp last to avoid race conditions
   lastUpdate  = get_tmr10ms();
 
 #if 0
-  TRACE("[SYNC] update rate = %dus; lag = %dus",refreshRate,currentLag);
+  TRACE("[SYNC] update rate = %dus; lag = %dus",refreshRate,inputLag);
 #endif
 }
 
-void ModuleSyncStatus::invalidate() {
-  //make invalid after use
-  currentLag = 0;
+void ModuleSyncStatus::applyReport(uint16_t rate, int16_t lag)
+{
+  if (syncRestarts(loopRate, loopUpdate, rate)) {
+    periodOffset = 0;
+    residue = 0;
+    frames = 0;
+  }
+  loopRate = rate;
+  loopUpdate = get_tmr10ms();
+
+  // Controller: the integral part needs the number of frames between reports
+  int32_t error = lag * 256;
+  if (frames > 0) {
+    int32_t maxOffset = (int32_t)loopRate * 256 / 32;
+    periodOffset += error / 8 / frames;
+    periodOffset = limit<int32_t>(-maxOffset, periodOffset, maxOffset);
+  }
+  phaseCorrection = error / 2;
+  phaseStep = abs(phaseCorrection) / max<int32_t>(frames, 1) + 1;
+  frames = 0;
 }
 
 uint16_t ModuleSyncStatus::getAdjustedRefreshRate()
 {
-  int16_t lag = currentLag;
-  int32_t newRefreshRate = refreshRate;
-
-  if (lag == 0) {
-    return refreshRate;
+  uint32_t report = pendingReport.exchange(0);
+  if (report) {
+    applyReport(report >> 16, (int16_t)(report & 0xFFFF));
   }
 
-  newRefreshRate += lag;
+  if (frames < UINT16_MAX) frames++;
+
+  int32_t step = limit<int32_t>(-phaseStep, phaseCorrection, phaseStep);
+  phaseCorrection -= step;
+
+  int32_t period = (int32_t)loopRate * 256 + periodOffset + step + residue;
+  residue = period & 0xFF;
+  int32_t newRefreshRate = period >> 8;
 
   if (newRefreshRate < MIN_REFRESH_RATE) {
-      newRefreshRate = MIN_REFRESH_RATE;
+    newRefreshRate = MIN_REFRESH_RATE;
   }
   else if (newRefreshRate > MAX_REFRESH_RATE) {
     newRefreshRate = MAX_REFRESH_RATE;
   }
-
-  currentLag -= newRefreshRate - refreshRate;
 #if 0
-  TRACE("[SYNC] mod rate = %dus; lag = %dus",newRefreshRate,currentLag);
+  TRACE("[SYNC] mod rate = %dus; correction = %d/256us",newRefreshRate,phaseCorrection);
 #endif
 
   return (uint16_t)newRefreshRate;
 }
 
+void ModuleSyncStatus::resetStats()
+{
+  maxLag = 0;
+  slips = 0;
+}
+
 void ModuleSyncStatus::getRefreshString(char * statusText)
 {
   if (!isValid()) {
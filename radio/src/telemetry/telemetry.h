@@ -29,6 +29,8 @@
 #include "frsky.h"
 #include "io/frsky_sport.h"
 
+#include <atomic>
+
 extern uint8_t telemetryStreaming; // >0 (true) == data is streaming in. 0 = no data detected for some time
 
 inline bool TELEMETRY_STREAMING()
@@ -246,6 +248,18 @@ void processPXX2Frame(uint8_t idx, const uint8_t* frame,
                       const etx_serial_driver_t* drv, void* ctx);
 
 // Module pulse synchronization
+//
+// Phase-locked loop on the frame clock of the RF module, which reports its
+// refresh rate and the lag of our frames. On each report, a PI controller:
+//  - spreads a correction of half the lag over the frames sent until the next
+//    report (a full correction oscillates, as reports lag the corrections),
+//  - integrates the lag into a period offset, which tracks the frequency
+//    difference between both clocks.
+//
+// Reports are received by the telemetry, while the loop runs in the context
+// of the scheduler: each report is published as a single 32-bit word, which
+// the scheduler takes on its next frame, so that no loop state is ever
+// written from both sides.
 struct ModuleSyncStatus
 {
   // feedback input: last received values
@@ -253,26 +267,56 @@ struct ModuleSyncStatus
   int16_t   inputLag;    // in us
 
   tmr10ms_t lastUpdate;  // in 10ms
-  int16_t   currentLag;  // in us
-  
+
+  // last report not taken yet by the scheduler: rate << 16 | lag, 0 if none
+  std::atomic<uint32_t> pendingReport;
+
+  // loop state, in 1/256 us (scheduler context only)
+  uint16_t  loopRate;         // in us, of the last report taken
+  tmr10ms_t loopUpdate;       // time of the last report taken
+  int32_t   periodOffset;     // per frame
+  int32_t   phaseCorrection;  // left to apply
+  int32_t   phaseStep;        // max. per frame
+  uint16_t  residue;          // fraction of us carried to the next frame
+  uint16_t  frames;           // sent since the last report
+
+  // statistics (telemetry context)
+  int32_t   phaseError;  // filtered lag, in 1/16 us
+  int32_t   jitter;      // filtered deviation of the lag, in 1/16 us
+  uint16_t  maxLag;      // in us
+  uint16_t  slips;       // reports of a lag over half a period
+  uint16_t  reports;
+  tmr10ms_t lockStart;   // first report
+  tmr10ms_t lockTime;    // in 10ms, from the first report (0 = never locked)
+  uint8_t   lockCount;   // consecutive reports within the lock threshold
+
   inline bool isValid() const {
     // 2 seconds
     return (get_tmr10ms() - lastUpdate < 200);
   }
 
+  bool isLocked() const;
+
   // Set feedback from RF module
   void update(uint16_t newRefreshRate, int16_t newInputLag);
 
-  //mark as timeouted
-  void invalidate();
-
   // Get computed settings for scheduler
   uint16_t getAdjustedRefreshRate();
 
+  void resetStats();
+
   // Status string for the UI
   void getRefreshString(char* refreshText);
 
   ModuleSyncStatus();
+
+ protected:
+  void restart();
+  void applyReport(uint16_t rate, int16_t lag);
 };
 
 ModuleSyncStatus& getModuleSyncStatus(uint8_t moduleIdx);
+
+// First module with a valid synchronization, -1 if none
+int8_t getSyncedModule();
+void resetModuleSyncStats();
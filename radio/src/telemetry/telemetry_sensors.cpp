@@ -76,6 +76,167 @@ uint32_t getDistFromEarthAxis(int32_t latitude)
                 12500);
 }
 
+// Dependency graph of the calculated sensors
+static struct {
+  uint32_t signature;          // of the sensors configuration
+  bool evalAll;
+  uint8_t count;
+  uint8_t order[MAX_TELEMETRY_SENSORS];
+  uint8_t per10msCount;
+  uint8_t per10ms[MAX_TELEMETRY_SENSORS];
+  uint8_t seen[MAX_TELEMETRY_SENSORS];  // sum of the sources updates
+  uint64_t totalizeSources;
+} calcGraph;
+
+static_assert(MAX_TELEMETRY_SENSORS <= 64, "totalizeSources is too small");
+
+static bool isTotalizeSource(const TelemetrySensor & sensor)
+{
+  unsigned index = &sensor - g_model.telemetrySensors;
+  return index < MAX_TELEMETRY_SENSORS &&
+         (calcGraph.totalizeSources & ((uint64_t)1 << index));
+}
+
+// Indexes of the sensors used by a calculated sensor evaluated by eval()
+static uint8_t getCalculatedSources(const TelemetrySensor & sensor,
+                                    uint8_t * sources)
+{
+  uint8_t count = 0;
+  auto add = [&](int source) {
+    if (source > 0 && source <= MAX_TELEMETRY_SENSORS)
+      sources[count++] = source - 1;
+  };
+
+  switch (sensor.formula) {
+    case TELEM_FORMULA_CELL:
+      add(sensor.cell.source);
+      break;
+
+    case TELEM_FORMULA_DIST:
+      add(sensor.dist.gps);
+      add(sensor.dist.alt);
+      break;
+
+    case TELEM_FORMULA_ADD:
+    case TELEM_FORMULA_AVERAGE:
+    case TELEM_FORMULA_MIN:
+    case TELEM_FORMULA_MAX:
+    case TELEM_FORMULA_MULTIPLY:
+      for (int i = 0; i < (sensor.formula == TELEM_FORMULA_MULTIPLY ? 2 : 4); i++)
+        add(abs(sensor.calc.sources[i]));
+      break;
+
+    default:
+      break;
+  }
+
+  return count;
+}
+
+static uint32_t sensorsSignature()
+{
+  uint32_t hash = 2166136261u;
+  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    const TelemetrySensor & sensor = g_model.telemetrySensors[i];
+    hash = (hash ^ (sensor.type | (sensor.instance << 1))) * 16777619u;
+    hash = (hash ^ sensor.param) * 16777619u;
+  }
+  return hash;
+}
+
+static void buildCalculatedSensorsGraph()
+{
+  bool placed[MAX_TELEMETRY_SENSORS];
+  uint8_t sources[4];
+
+  calcGraph.count = 0;
+  calcGraph.per10msCount = 0;
+  calcGraph.totalizeSources = 0;
+
+  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    const TelemetrySensor & sensor = g_model.telemetrySensors[i];
+    // sensors which are not evaluated by eval() do not constrain the order
+    placed[i] = (sensor.type != TELEM_TYPE_CALCULATED ||
+                 getCalculatedSources(sensor, sources) == 0);
+    if (sensor.type != TELEM_TYPE_CALCULATED)
+      continue;
+    if (sensor.formula == TELEM_FORMULA_CONSUMPTION) {
+      calcGraph.per10ms[calcGraph.per10msCount++] = i;
+    }
+    else if (sensor.formula == TELEM_FORMULA_TOTALIZE) {
+      uint8_t source = sensor.consumption.source;
+      if (source > 0 && source <= MAX_TELEMETRY_SENSORS)
+        calcGraph.totalizeSources |= (uint64_t)1 << (source - 1);
+    }
+  }
+
+  // Sensors are placed once all their sources are. Those left in a cycle are
+  // placed last, in index order.
+  bool progress = true;
+  while (progress) {
+    progress = false;
+    for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+      if (placed[i]) continue;
+      uint8_t count = getCalculatedSources(g_model.telemetrySensors[i], sources);
+      bool ready = true;
+      for (uint8_t j = 0; j < count; j++) {
+        if (!placed[sources[j]] && sources[j] != i) ready = false;
+      }
+      if (ready) {
+        calcGraph.order[calcGraph.count++] = i;
+        placed[i] = progress = true;
+      }
+    }
+  }
+  for (int i = 0; i < MAX_TELEMETRY_SENSORS; i++) {
+    if (!placed[i]) calcGraph.order[calcGraph.count++] = i;
+  }
+
+  calcGraph.evalAll = true;
+}
+
+void invalidateCalculatedSensors()
+{
+  calcGraph.evalAll = true;
+}
+
+void evalCalculatedSensors()
+{
+  uint32_t signature = sensorsSignature();
+  if (signature != calcGraph.signature) {
+    calcGraph.signature = signature;
+    buildCalculatedSensorsGraph();
+  }
+
+  uint8_t sources[4];
+  for (uint8_t i = 0; i < calcGraph.count; i++) {
+    uint8_t index = calcGraph.order[i];
+    const TelemetrySensor & sensor = g_model.telemetrySensors[index];
+    uint8_t count = getCalculatedSources(sensor, sources);
+    uint8_t updates = 0;
+    for (uint8_t j = 0; j < count; j++) {
+      updates += telemetryItems[sources[j]].updates;
+    }
+    if (calcGraph.evalAll || updates != calcGraph.seen[index]) {
+      calcGraph.seen[index] = updates;
+      telemetryItems[index].eval(sensor);
+    }
+  }
+
+  calcGraph.evalAll = false;
+}
+
+void calculatedSensorsPer10ms()
+{
+  for (uint8_t i = 0; i < calcGraph.per10msCount; i++) {
+    uint8_t index = calcGraph.per10ms[i];
+    const TelemetrySensor & sensor = g_model.telemetrySensors[index];
+    if (sensor.type == TELEM_TYPE_CALCULATED) {
+      telemetryItems[index].per10ms(sensor);
+    }
+  }
+}
+
 void TelemetryItem::setValue(const TelemetrySensor & sensor, const char * val, uint32_t, uint32_t)
 {
   strncpy(text, val, sizeof(text));
@@ -260,12 +421,14 @@ void TelemetryItem::setValue(const TelemetrySensor &sensor, int32_t val,
     }
   }
 
-  for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
-    TelemetrySensor & it = g_model.telemetrySensors[i];
-    if (it.type == TELEM_TYPE_CALCULATED && it.formula == TELEM_FORMULA_TOTALIZE && &g_model.telemetrySensors[it.consumption.source-1] == &sensor) {
-      TelemetryItem & item = telemetryItems[i];
-      int32_t increment = it.getValue(val, unit, prec);
-      item.setValue(it, item.value+increment, it.unit, it.prec);
+  if (isTotalizeSource(sensor)) {
+    for (int i=0; i<MAX_TELEMETRY_SENSORS; i++) {
+      TelemetrySensor & it = g_model.telemetrySensors[i];
+      if (it.type == TELEM_TYPE_CALCULATED && it.formula == TELEM_FORMULA_TOTALIZE && &g_model.telemetrySensors[it.consumption.source-1] == &sensor) {
+        TelemetryItem & item = telemetryItems[i];
+        int32_t increment = it.getValue(val, unit, prec);
+        item.setValue(it, item.value+increment, it.unit, it.prec);
+      }
     }
   }
 
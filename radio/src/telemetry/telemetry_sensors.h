@@ -45,6 +45,9 @@ class TelemetryItem
 
     int8_t timeout; // for detection of sensor loss
 
+    uint8_t updates; // incremented on each new value or loss, for the
+                     // calculated sensors using this one as a source
+
     union {
       struct {
         int32_t  offsetAuto;
@@ -77,13 +80,16 @@ class TelemetryItem
 
     TelemetryItem()
     {
-      clear();
+      memset(reinterpret_cast<void*>(this), 0, sizeof(TelemetryItem));
+      timeout = TELEMETRY_SENSOR_TIMEOUT_UNAVAILABLE;
     }
 
     void clear()
     {
+      uint8_t count = updates;
       memset(reinterpret_cast<void*>(this), 0, sizeof(TelemetryItem));
       timeout = TELEMETRY_SENSOR_TIMEOUT_UNAVAILABLE;
+      updates = count + 1;
     }
 
     void eval(const TelemetrySensor & sensor);
@@ -121,14 +127,23 @@ class TelemetryItem
     inline void setFresh()
     {
       timeout = TELEMETRY_SENSOR_TIMEOUT_START;
+      updates++;
     }
 
     inline void setOld()
     {
       timeout = TELEMETRY_SENSOR_TIMEOUT_OLD;
+      updates++;
     }
 };
 
 extern TelemetryItem telemetryItems[MAX_TELEMETRY_SENSORS];
+
+// Calculated sensors are evaluated in the order of their dependencies, and
+// only when one of their sources was updated. The dependency graph is rebuilt
+// when the sensors configuration changes.
+void evalCalculatedSensors();
+void calculatedSensorsPer10ms();
+void invalidateCalculatedSensors();
 extern bool allowNewSensors;
 bool isFaiForbidden(source_t idx);
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+#include "gtests.h"
+
+#include "adc_filter_trace.h"
+
+TEST(AdcFilter, restValue)
+{
+  for (uint8_t type = ADC_FILTER_NONE; type <= ADC_FILTER_KALMAN; type++) {
+    AdcFilterState state;
+    adcFilterReset(&state);
+    uint32_t filtered = 0;
+    for (int i = 0; i < 1000; i++) {
+      filtered = adcFilterApply(&state, type, 1234, filtered, TRACE_DT);
+    }
+    EXPECT_EQ(filtered, 1234u * JITTER_ALPHA) << "filter " << (int)type;
+  }
+}
+
+TEST(AdcFilter, limits)
+{
+  for (uint8_t type = ADC_FILTER_ONE_EURO; type <= ADC_FILTER_KALMAN; type++) {
+    AdcFilterState state;
+    adcFilterReset(&state);
+    uint32_t filtered = 0;
+    for (int i = 0; i < 1000; i++) {
+      uint32_t v = (i & 1) ? 4 * RESX : 0;
+      filtered = adcFilterApply(&state, type, v, filtered, i & 2 ? 0 : 1000000);
+      EXPECT_LE(filtered, 4u * RESX * JITTER_ALPHA);
+    }
+  }
+}
+
+TEST(AdcFilter, lagAndJitter)
+{
+  FilterStats stats[ADC_FILTER_KALMAN + 1];
+  for (uint8_t type = ADC_FILTER_NONE; type <= ADC_FILTER_KALMAN; type++) {
+    stats[type] = measureFilter(type);
+  }
+
+  const auto& mma = stats[ADC_FILTER_MMA];
+  EXPECT_LT(mma.noise, stats[ADC_FILTER_NONE].noise);
+
+  // adaptive filters: quiet at rest, spikes included...
+  for (uint8_t type = ADC_FILTER_ONE_EURO; type <= ADC_FILTER_KALMAN; type++) {
+    EXPECT_LT(stats[type].noise, mma.noise / 2) << adcFilterNames[type];
+    EXPECT_LT(stats[type].jitter, mma.jitter / 4) << adcFilterNames[type];
+  }
+
+  // ...while following stick moves within a few mixer periods
+  const auto& oneEuro = stats[ADC_FILTER_ONE_EURO];
+  EXPECT_LE(oneEuro.stepLag, 5 * TRACE_DT / 1000);
+  EXPECT_LT(oneEuro.slowLag, 15);
+  EXPECT_LT(oneEuro.fastLag, 2 * TRACE_DT / 1000);
+
+  const auto& kalman = stats[ADC_FILTER_KALMAN];
+  EXPECT_LE(kalman.stepLag, TRACE_DT / 1000);
+  EXPECT_LT(kalman.slowLag, 2 * TRACE_DT / 1000);
+  EXPECT_LT(kalman.fastLag, TRACE_DT / 1000);
+}
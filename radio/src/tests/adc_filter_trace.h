@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include <math.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+#include "hal/adc_driver.h"
+#include "hal/adc_filter.h"
+
+// Default mixer period
+#define TRACE_DT     4000  // us
+#define TRACE_RATE   (1000000 / TRACE_DT)
+
+// Noisy ADC trace (0 .. 4*RESX) of a given stick movement: gaussian noise
+// of 3 units RMS, as seen at rest on gimbals, with a few larger spikes
+inline std::vector<uint32_t> makeTrace(const std::vector<double>& signal,
+                                       unsigned seed)
+{
+  std::mt19937 gen(seed);
+  std::normal_distribution<double> noise(0.0, 3.0);
+  std::uniform_int_distribution<int> spike(0, 199);
+
+  std::vector<uint32_t> trace;
+  for (double value : signal) {
+    double v = value + noise(gen);
+    if (spike(gen) == 0) v += noise(gen) * 4;
+    trace.push_back(limit<int>(0, lround(v), 4 * RESX));
+  }
+  return trace;
+}
+
+// Filtered trace, in the anaIn() scale (0 .. 2*RESX)
+inline std::vector<double> runFilter(uint8_t type,
+                                     const std::vector<uint32_t>& trace)
+{
+  AdcFilterState state;
+  adcFilterReset(&state);
+
+  std::vector<double> out;
+  uint32_t filtered = trace[0] * JITTER_ALPHA;
+  for (uint32_t v : trace) {
+    filtered = adcFilterApply(&state, type, v, filtered, TRACE_DT);
+    out.push_back(double(filtered) / (JITTER_ALPHA * ANALOG_MULTIPLIER));
+  }
+  return out;
+}
+
+inline std::vector<double> rest(double value, double seconds)
+{
+  return std::vector<double>(seconds * TRACE_RATE, value);
+}
+
+inline std::vector<double> ramp(double from, double to, double seconds)
+{
+  std::vector<double> signal;
+  unsigned count = seconds * TRACE_RATE;
+  for (unsigned i = 0; i < count; i++) {
+    signal.push_back(from + (to - from) * i / count);
+  }
+  return signal;
+}
+
+inline std::vector<double> concat(std::initializer_list<std::vector<double>> parts)
+{
+  std::vector<double> signal;
+  for (auto& part : parts) signal.insert(signal.end(), part.begin(), part.end());
+  return signal;
+}
+
+static const char* const adcFilterNames[] = {"none", "MMA", "1-Euro",
+                                             "Kalman"};
+
+struct FilterStats {
+  double noise;     // RMS at rest
+  double jitter;    // peak to peak at rest
+  double stepLag;   // ms to reach 90% of a step
+  double slowLag;   // ms behind a slow ramp
+  double fastLag;   // ms behind a fast ramp
+};
+
+// Mean delay (ms) of the output behind a ramp of 'slope' units per sample,
+// between samples 'first' and 'last'
+inline double rampLag(const std::vector<double>& out,
+                      const std::vector<double>& signal, unsigned first,
+                      unsigned last, double slope)
+{
+  double error = 0;
+  for (unsigned i = first; i < last; i++) {
+    error += signal[i] / ANALOG_MULTIPLIER - out[i];
+  }
+  return error / (last - first) / slope * TRACE_DT / 1000;
+}
+
+inline FilterStats measureFilter(uint8_t type)
+{
+  FilterStats stats;
+
+  // 2s at rest (mid stick), after 1s to settle
+  auto signal = rest(2 * RESX, 3);
+  auto out = runFilter(type, makeTrace(signal, 1));
+  auto minmax = std::minmax_element(out.begin() + TRACE_RATE, out.end());
+  stats.jitter = *minmax.second - *minmax.first;
+  double sum2 = 0;
+  for (auto v = out.begin() + TRACE_RATE; v != out.end(); v++) {
+    sum2 += (*v - RESX) * (*v - RESX);
+  }
+  stats.noise = sqrt(sum2 / (out.size() - TRACE_RATE));
+
+  // -50% -> +50% step
+  signal = concat({rest(RESX, 1), rest(3 * RESX, 1)});
+  out = runFilter(type, makeTrace(signal, 2));
+  unsigned i = TRACE_RATE;
+  while (i < out.size() && out[i] < RESX / 2 + 0.9 * RESX) i++;
+  stats.stepLag = (i - TRACE_RATE) * TRACE_DT / 1000.0;
+
+  // full range in 2s
+  signal = concat({rest(0, 1), ramp(0, 4 * RESX, 2), rest(4 * RESX, 1)});
+  out = runFilter(type, makeTrace(signal, 3));
+  stats.slowLag = rampLag(out, signal, TRACE_RATE * 3 / 2, TRACE_RATE * 5 / 2,
+                          4.0 * RESX / ANALOG_MULTIPLIER / (2 * TRACE_RATE));
+
+  // full range in 100ms
+  signal = concat({rest(0, 1), ramp(0, 4 * RESX, 0.1), rest(4 * RESX, 1)});
+  out = runFilter(type, makeTrace(signal, 4));
+  stats.fastLag = rampLag(out, signal, TRACE_RATE + 5, TRACE_RATE * 11 / 10,
+                          4.0 * RESX / ANALOG_MULTIPLIER / (TRACE_RATE / 10));
+
+  return stats;
+}
@@ -0,0 +1,39 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+// ADC filter benchmark: noise, jitter and lag of each stick filter on the
+// traces of adc_filter.cpp, where only their bounds are asserted.
+
+#include "gtests.h"
+
+#include "adc_filter_trace.h"
+
+TEST(AdcFilterBenchmark, lagAndJitter)
+{
+  printf("filter    noise  jitter  step lag  slow lag  fast lag\n");
+  for (uint8_t type = ADC_FILTER_NONE; type <= ADC_FILTER_KALMAN; type++) {
+    FilterStats stats = measureFilter(type);
+    printf("%-8s %6.2f %7.2f %7.1fms %7.1fms %7.1fms\n", adcFilterNames[type],
+           stats.noise, stats.jitter, stats.stepLag, stats.slowLag,
+           stats.fastLag);
+  }
+}
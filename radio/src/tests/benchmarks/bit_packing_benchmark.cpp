@@ -0,0 +1,70 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+// Bit packing benchmark: a 16 channels, 11 bits frame is packed and unpacked
+// with the bit accumulator loop the channel frames used before, and with the
+// table driven BitPacking, and the time of each is reported.
+
+#include "gtests.h"
+
+#include <chrono>
+
+#include "bit_packing.h"
+#include "bit_packing_loop.h"
+
+TEST(BitPackingBenchmark, packUnpack)
+{
+  typedef BitPacking<11, 16> Packing;
+  constexpr int LOOPS = 200000;
+
+  uint16_t values[16];
+  uint8_t packed[Packing::SIZE];
+
+  // the checksum keeps the compiler from skipping the loops
+  auto measure = [&](auto pack, auto unpack, uint32_t& checksum) {
+    for (unsigned i = 0; i < 16; i++) values[i] = 172 + i * 100;
+    auto start = std::chrono::steady_clock::now();
+    for (int loop = 0; loop < LOOPS; loop++) {
+      values[loop & 15] = loop & Packing::MASK;
+      pack(packed, values);
+      unpack(packed, values);
+      checksum += values[(loop + 1) & 15];
+    }
+    std::chrono::duration<double, std::nano> elapsed =
+        std::chrono::steady_clock::now() - start;
+    return elapsed.count() / LOOPS;
+  };
+
+  uint32_t loopChecksum = 0, tableChecksum = 0;
+  double loopTime = measure(
+      [](uint8_t* buf, const uint16_t* v) { loopPack<11>(buf, v, 16); },
+      [](const uint8_t* buf, uint16_t* v) { loopUnpack<11>(buf, v, 16); },
+      loopChecksum);
+  double tableTime = measure(
+      [](uint8_t* buf, const uint16_t* v) { Packing::pack(buf, v); },
+      [](const uint8_t* buf, uint16_t* v) { Packing::unpack(buf, v); },
+      tableChecksum);
+
+  printf("16 channels pack + unpack: loop %.1f ns, table %.1f ns\n", loopTime,
+         tableTime);
+  EXPECT_EQ(loopChecksum, tableChecksum);
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+// Lua allocator benchmark: the synthetic allocation trace of the unit tests
+// is replayed with the size classes used on target, with the two bins they
+// replaced, and with the C library realloc(), and the time per operation of
+// each of them is reported along with the use of each size class.
+
+#include "gtests.h"
+
+#if defined(LUA)
+
+#include <chrono>
+
+#include "lua_allocation_trace.h"
+
+static void* heapAlloc(void* ud, void* ptr, size_t osize, size_t nsize)
+{
+  if (nsize == 0) {
+    free(ptr);
+    return nullptr;
+  }
+  return realloc(ptr, nsize);
+}
+
+static double timeTrace(const std::vector<TraceOp>& trace, lua_Alloc f,
+                        void* ud, uint32_t objects)
+{
+  auto start = std::chrono::steady_clock::now();
+  replayTrace(trace, f, ud, objects);
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / trace.size();
+}
+
+TEST(LuaAllocatorBenchmark, trace)
+{
+  auto trace = luaAllocationTrace(5000);
+  uint32_t objects = traceObjects(trace);
+
+  alignas(SLAB_ALIGN) static uint8_t arena[SlabAllocator::arenaSize(traceClasses, 6)];
+
+  SlabAllocator slab(traceClasses, 6, arena);
+  double slabTime = timeTrace(trace, SlabAllocator::luaAlloc, &slab, objects);
+
+  SlabAllocator twoBins(traceBins, 2, arena);
+  double binsTime = timeTrace(trace, SlabAllocator::luaAlloc, &twoBins, objects);
+
+  double heapTime = timeTrace(trace, heapAlloc, nullptr, objects);
+
+  printf("%u operations: heap %.1f ns/op, slab %.1f ns/op, 2 bins %.1f ns/op\n",
+         (unsigned)trace.size(), heapTime, slabTime, binsTime);
+  for (uint8_t i = 0; i < slab.classCount(); i++) {
+    const auto& c = slab.classStats(i);
+    printf("  class %3u: max %3u/%3u, %6u allocs, %5u spills, %5u misses\n",
+           c.size, c.maxUsed, c.slots, c.allocs, c.spills, c.misses);
+  }
+  printf("  heap requests: slab %u, 2 bins %u\n", heapRequests(slab),
+         heapRequests(twoBins));
+  printf("  heap high-water mark: slab %u bytes, 2 bins %u bytes\n",
+         slab.heapStats().maxBytes, twoBins.heapStats().maxBytes);
+}
+
+#endif  // LUA
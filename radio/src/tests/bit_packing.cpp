@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "gtests.h"
+
+#include "bit_packing.h"
+#include "bit_packing_loop.h"
+
+template <unsigned BITS, unsigned COUNT>
+static void checkRoundTrip()
+{
+  typedef BitPacking<BITS, COUNT> Packing;
+
+  uint16_t values[COUNT];
+  uint16_t unpacked[COUNT];
+  uint8_t expected[Packing::SIZE];
+  uint8_t packed[Packing::SIZE];
+
+  uint32_t seed = 0x12345678;
+  for (int loop = 0; loop < 100; loop++) {
+    for (unsigned i = 0; i < COUNT; i++) {
+      seed = seed * 1103515245 + 12345;
+      values[i] = (seed >> 8) & Packing::MASK;
+    }
+    // all bits set and cleared
+    if (loop < 2) {
+      for (unsigned i = 0; i < COUNT; i++) values[i] = loop ? 0 : Packing::MASK;
+    }
+
+    memset(expected, 0, sizeof(expected));
+    loopPack<BITS>(expected, values, COUNT);
+
+    memset(packed, 0xAA, sizeof(packed));
+    Packing::pack(packed, values);
+    ASSERT_EQ(0, memcmp(expected, packed, sizeof(packed))) << "loop " << loop;
+
+    Packing::unpack(packed, unpacked);
+    ASSERT_EQ(0, memcmp(values, unpacked, sizeof(values))) << "loop " << loop;
+  }
+}
+
+TEST(BitPacking, roundTrip)
+{
+  checkRoundTrip<11, 16>();  // CRSF / SBUS
+  checkRoundTrip<11, 1>();
+  checkRoundTrip<11, 7>();
+  checkRoundTrip<12, 4>();   // GHOST
+  checkRoundTrip<10, 8>();
+  checkRoundTrip<8, 5>();
+  checkRoundTrip<16, 3>();
+}
+
+TEST(BitPacking, partialPack)
+{
+  typedef BitPacking<11, 16> Packing;
+
+  uint16_t values[16];
+  for (unsigned i = 0; i < 16; i++) values[i] = 2047 - i * 100;
+
+  for (unsigned count = 1; count <= 16; count++) {
+    uint8_t expected[Packing::SIZE] = {};
+    uint8_t packed[Packing::SIZE + 1];
+    memset(packed, 0xAA, sizeof(packed));
+
+    loopPack<11>(expected, values, count);
+    unsigned len = Packing::pack(packed, values, count);
+    ASSERT_EQ(Packing::size(count), len);
+    // the values after 'count' must not leak in the last byte
+    ASSERT_EQ(0, memcmp(expected, packed, len)) << "count " << count;
+    EXPECT_EQ(0xAA, packed[len]) << "count " << count;
+  }
+}
+
+TEST(BitPacking, sbusFrame)
+{
+  // min, center and max channels, last one at 1024
+  const uint16_t values[16] = {172, 992, 1811, 992, 992, 992, 992, 992,
+                               992, 992, 992, 992, 992, 992, 992, 1024};
+  const uint8_t reference[22] = {
+    0xAC, 0x00, 0xDF, 0xC4, 0xC1, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x7C,
+    0xE0, 0x03, 0x1F, 0xF8, 0xC0, 0x07, 0x3E, 0xF0, 0x81, 0x0F, 0x80};
+
+  uint8_t packed[22];
+  BitPacking<11, 16>::pack(packed, values);
+  EXPECT_EQ(0, memcmp(reference, packed, sizeof(reference)));
+
+  uint16_t unpacked[16];
+  BitPacking<11, 16>::unpack(reference, unpacked);
+  EXPECT_EQ(0, memcmp(values, unpacked, sizeof(values)));
+}
+
+TEST(BitPacking, sameAsLoop)
+{
+  typedef BitPacking<11, 16> Packing;
+
+  uint16_t values[16];
+  for (unsigned i = 0; i < 16; i++) values[i] = 172 + i * 100;
+
+  for (int loop = 0; loop < 2048; loop++) {
+    values[loop & 15] = (loop * 7) & Packing::MASK;
+
+    uint8_t expected[Packing::SIZE] = {};
+    uint8_t packed[Packing::SIZE];
+    loopPack<11>(expected, values, 16);
+    Packing::pack(packed, values);
+    ASSERT_EQ(0, memcmp(expected, packed, sizeof(packed))) << "loop " << loop;
+
+    uint16_t unpacked[16];
+    Packing::unpack(packed, unpacked);
+    ASSERT_EQ(0, memcmp(values, unpacked, sizeof(values))) << "loop " << loop;
+  }
+}
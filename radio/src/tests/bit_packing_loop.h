@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include <stdint.h>
+
+// Bit accumulator previously used by the channel frames
+template <unsigned BITS>
+inline void loopPack(uint8_t* buf, const uint16_t* values, unsigned count)
+{
+  uint32_t bits = 0;
+  uint8_t bitsavailable = 0;
+  for (unsigned i = 0; i < count; i++) {
+    bits |= (uint32_t)values[i] << bitsavailable;
+    bitsavailable += BITS;
+    while (bitsavailable >= 8) {
+      *buf++ = bits;
+      bits >>= 8;
+      bitsavailable -= 8;
+    }
+  }
+  if (bitsavailable > 0) *buf = bits;
+}
+
+template <unsigned BITS>
+inline void loopUnpack(const uint8_t* buf, uint16_t* values, unsigned count)
+{
+  uint32_t bits = 0;
+  uint8_t bitsavailable = 0;
+  for (unsigned i = 0; i < count; i++) {
+    while (bitsavailable < BITS) {
+      bits |= (uint32_t)(*buf++) << bitsavailable;
+      bitsavailable += 8;
+    }
+    values[i] = bits & ((1 << BITS) - 1);
+    bitsavailable -= BITS;
+    bits >>= BITS;
+  }
+}
@@ -22,23 +22,142 @@
 #include "gtest/gtest.h"
 #include "gtests.h"
 #include "telemetry/telemetry.h"
+#include "pulses/crossfire.h"
+#include "bit_packing.h"
 
 #if defined(CROSSFIRE)
 
-uint8_t createCrossfireChannelsFrame(uint8_t moduleIdx, uint8_t * frame, int16_t * pulses);
 TEST(Crossfire, createCrossfireChannelsFrame)
 {
-  int16_t pulsesStart[MAX_TRAINER_CHANNELS];
+  int16_t pulsesStart[CROSSFIRE_CHANNELS_COUNT];
   uint8_t crossfire[CROSSFIRE_FRAME_MAXLEN];
 
+  MODEL_RESET();
   memset(crossfire, 0, sizeof(crossfire));
-  for (int i=0; i<MAX_TRAINER_CHANNELS; i++) {
-    pulsesStart[i] = -1024 + (2048 / MAX_TRAINER_CHANNELS) * i;
+  for (int i=0; i<CROSSFIRE_CHANNELS_COUNT; i++) {
+    pulsesStart[i] = -1024 + (2048 / CROSSFIRE_CHANNELS_COUNT) * i;
+  }
+
+  // only 12 channels available: the last 4 are sent centered
+  const uint8_t reference[] = {
+    0xEE, 0x18, 0x16, 0xAD, 0xA0, 0x88, 0x5E, 0xC0, 0x73, 0xA4, 0x56,
+    0x51, 0x4C, 0x6F, 0xE0, 0x33, 0x22, 0x2B, 0x27, 0x0A, 0x3E, 0xF0,
+    0x81, 0x0F, 0x7C, 0x84};
+
+  uint8_t len = createCrossfireChannelsFrame(EXTERNAL_MODULE, crossfire, pulsesStart, 12);
+  ASSERT_EQ(sizeof(reference), len);
+  EXPECT_EQ(0, memcmp(reference, crossfire, len));
+}
+
+TEST(Crossfire, createCrossfireSubsetChannelsFrame)
+{
+  uint8_t crossfire[CROSSFIRE_FRAME_MAXLEN];
+  const uint16_t values[] = {0, 1024, 2047, 1500};
+
+  // channels 17-20, 11 bits resolution
+  const uint8_t reference[] = {0xEE, 0x09, 0x17, 0x30, 0x00, 0x00,
+                               0xE0, 0xFF, 0xB9, 0x0B, 0xEA};
+
+  uint8_t len = createCrossfireSubsetChannelsFrame(crossfire, 16, values, 4);
+  ASSERT_EQ(sizeof(reference), len);
+  EXPECT_EQ(0, memcmp(reference, crossfire, len));
+  EXPECT_EQ(crc8(&crossfire[2], crossfire[1] - 1), crossfire[len - 1]);
+}
+
+TEST(Crossfire, createCrossfireExtraChannelsFrame)
+{
+  int16_t pulses[MAX_OUTPUT_CHANNELS];
+  uint8_t crossfire[CROSSFIRE_FRAME_MAXLEN];
+
+  MODEL_RESET();
+  memset(pulses, 0, sizeof(pulses));
+  resetCrossfireExtraChannels(EXTERNAL_MODULE);
+
+  // nothing above channel 16
+  EXPECT_EQ(0, createCrossfireExtraChannelsFrame(EXTERNAL_MODULE, crossfire, pulses, 16));
+
+  // first frame sends all the extra channels
+  uint8_t len = createCrossfireExtraChannelsFrame(EXTERNAL_MODULE, crossfire, pulses, 24);
+  EXPECT_EQ(2 + 3 + 11, len);
+  EXPECT_EQ(0x30, crossfire[3]);
+
+  // then only when they change
+  EXPECT_EQ(0, createCrossfireExtraChannelsFrame(EXTERNAL_MODULE, crossfire, pulses, 24));
+
+  pulses[18] = 100;
+  pulses[20] = -200;
+  const uint8_t reference[] = {0xEE, 0x08, 0x17, 0x32, 0x64, 0x04,
+                               0x20, 0xCE, 0x00, 0x8C};
+  len = createCrossfireExtraChannelsFrame(EXTERNAL_MODULE, crossfire, pulses, 24);
+  ASSERT_EQ(sizeof(reference), len);
+  EXPECT_EQ(0, memcmp(reference, crossfire, len));
+
+  // and periodically all of them
+  int frames = 1;
+  while (!createCrossfireExtraChannelsFrame(EXTERNAL_MODULE, crossfire, pulses, 24)) {
+    ASSERT_LT(frames++, 100);
+  }
+  EXPECT_EQ(0x30, crossfire[3]);
+}
+
+TEST(Crossfire, extraChannelsPulseWidth)
+{
+  int16_t pulses[MAX_OUTPUT_CHANNELS];
+  uint8_t crossfire[CROSSFIRE_FRAME_MAXLEN];
+  uint16_t values[CROSSFIRE_CHANNELS_COUNT];
+
+  MODEL_RESET();
+  resetCrossfireExtraChannels(EXTERNAL_MODULE);
+
+  // the same output gives the same pulse width on CH16 (regular frame) and
+  // CH17 (subset frame) at the center and both ends
+  for (int16_t pulse : {-1024, 0, 1024}) {
+    for (int i = 0; i < MAX_OUTPUT_CHANNELS; i++) pulses[i] = pulse;
+
+    createCrossfireChannelsFrame(EXTERNAL_MODULE, crossfire, pulses, 17);
+    BitPacking<11, CROSSFIRE_CHANNELS_COUNT>::unpack(&crossfire[3], values);
+    double ch16 = 1500 + (values[CROSSFIRE_CHANNELS_COUNT - 1] - 992) * 0.625;
+
+    ASSERT_NE(0, createCrossfireExtraChannelsFrame(EXTERNAL_MODULE, crossfire, pulses, 17));
+    double ch17 = 988 + ((crossfire[4] | crossfire[5] << 8) & 0x7FF) * 0.5;
+
+    EXPECT_NEAR(1500 + pulse / 2, ch16, 1) << "pulse " << pulse;
+    EXPECT_NEAR(ch16, ch17, 1) << "pulse " << pulse;
   }
+}
 
-  createCrossfireChannelsFrame(EXTERNAL_MODULE, crossfire, pulsesStart);
+TEST(Crossfire, extraChannelsSplit)
+{
+  int16_t pulses[MAX_OUTPUT_CHANNELS];
+  uint8_t crossfire[CROSSFIRE_FRAME_MAXLEN];
 
-  // TODO check
+  MODEL_RESET();
+  memset(pulses, 0, sizeof(pulses));
+  resetCrossfireExtraChannels(EXTERNAL_MODULE);
+
+  // room for 8 channels per frame: CH17-24, then CH25-32
+  uint8_t len = createCrossfireExtraChannelsFrame(EXTERNAL_MODULE, crossfire, pulses, 32, 16);
+  EXPECT_EQ(5 + 11, len);
+  EXPECT_EQ(0x30, crossfire[3]);
+  len = createCrossfireExtraChannelsFrame(EXTERNAL_MODULE, crossfire, pulses, 32, 16);
+  EXPECT_EQ(5 + 11, len);
+  EXPECT_EQ(0x38, crossfire[3]);
+  EXPECT_EQ(0, createCrossfireExtraChannelsFrame(EXTERNAL_MODULE, crossfire, pulses, 32, 16));
+
+  // a channel changing on each frame does not hold back the others
+  pulses[16] = 1;
+  pulses[31] = 1;
+  len = createCrossfireExtraChannelsFrame(EXTERNAL_MODULE, crossfire, pulses, 32, 16);
+  EXPECT_EQ(0x30, crossfire[3]);
+  EXPECT_EQ(5 + 2, len);
+  pulses[16] = 2;
+  len = createCrossfireExtraChannelsFrame(EXTERNAL_MODULE, crossfire, pulses, 32, 16);
+  EXPECT_EQ(0x3F, crossfire[3]);
+  EXPECT_EQ(5 + 2, len);
+
+  // nothing fits
+  pulses[16] = 3;
+  EXPECT_EQ(0, createCrossfireExtraChannelsFrame(EXTERNAL_MODULE, crossfire, pulses, 32, 5));
 }
 
 TEST(Crossfire, crc8)
@@ -435,6 +435,65 @@ TEST(FrSkySPORT, frskyVfas)
   EXPECT_EQ(telemetryItems[0].valueMax, 6524);
 }
 
+TEST(FrSkySPORT, calculatedSensorsDependencies)
+{
+  uint8_t packet[FRSKY_SPORT_PACKET_SIZE];
+
+  MODEL_RESET();
+  TELEMETRY_RESET();
+  telemetryStreaming = TELEMETRY_TIMEOUT10ms;
+  telemetryData.telemetryValid = 0x07;
+  allowNewSensors = true;
+
+  generateSportFasVoltagePacket(packet, 1000);
+  sportProcessTelemetryPacket(0, packet, sizeof(packet));
+  EXPECT_EQ(telemetryItems[0].value, 1000);
+
+  // sensor 2 = Vfas + sensor 3, sensor 3 = 2 * Vfas
+  TelemetrySensor & sum = g_model.telemetrySensors[1];
+  sum.type = TELEM_TYPE_CALCULATED;
+  sum.formula = TELEM_FORMULA_ADD;
+  sum.unit = UNIT_VOLTS;
+  sum.prec = 2;
+  sum.calc.sources[0] = 1;
+  sum.calc.sources[1] = 3;
+  TelemetrySensor & twice = g_model.telemetrySensors[2];
+  twice.type = TELEM_TYPE_CALCULATED;
+  twice.formula = TELEM_FORMULA_ADD;
+  twice.unit = UNIT_VOLTS;
+  twice.prec = 2;
+  twice.calc.sources[0] = 1;
+  twice.calc.sources[1] = 1;
+
+  // sources are evaluated first
+  telemetryWakeup();
+  EXPECT_EQ(telemetryItems[2].value, 2000);
+  EXPECT_EQ(telemetryItems[1].value, 3000);
+
+  // no new value: not evaluated again
+  uint8_t updates = telemetryItems[1].updates;
+  telemetryWakeup();
+  EXPECT_EQ(telemetryItems[1].updates, updates);
+
+  generateSportFasVoltagePacket(packet, 1200);
+  sportProcessTelemetryPacket(0, packet, sizeof(packet));
+  telemetryWakeup();
+  EXPECT_EQ(telemetryItems[2].value, 2400);
+  EXPECT_EQ(telemetryItems[1].value, 3600);
+  EXPECT_NE(telemetryItems[1].updates, updates);
+
+  // the graph follows the sensors configuration
+  sum.formula = TELEM_FORMULA_MAX;
+  telemetryWakeup();
+  EXPECT_EQ(telemetryItems[1].value, 2400);
+
+  // a lost source is propagated
+  telemetryItems[0].setOld();
+  telemetryWakeup();
+  EXPECT_TRUE(telemetryItems[2].isOld());
+  EXPECT_TRUE(telemetryItems[1].isOld());
+}
+
 void generateSportFasCurrentPacket(uint8_t * packet, uint32_t current)
 {
   packet[0] = 0x22; //DATA_ID_FAS
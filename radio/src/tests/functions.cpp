@@ -70,6 +70,69 @@ TEST_F(SpecialFunctionsTest, FlightReset)
   EXPECT_FALSE((bool)(mainRequestFlags & (1 << REQUEST_FLIGHT_RESET)));
 }
 
+#if defined(OVERRIDE_CHANNEL_FUNCTION)
+static void setOverride(uint8_t idx, swsrc_t swtch, uint8_t ch, int16_t value)
+{
+  CustomFunctionData * cfn = &g_model.customFn[idx];
+  cfn->swtch = swtch;
+  cfn->func = FUNC_OVERRIDE_CHANNEL;
+  cfn->all.param = ch;
+  cfn->all.val = value;
+  cfn->active = true;
+}
+
+TEST_F(SpecialFunctionsTest, SharedSwitchAndEdits)
+{
+  int sw;
+  for (sw = 0; sw < switchGetMaxAllSwitches(); sw += 1)
+    if (g_model.getSwitchType(sw) == SWITCH_3POS)
+      break;
+  int swPos = (sw * 3) + SWSRC_FIRST_SWITCH;
+
+  setOverride(0, swPos, 0, 50);
+  setOverride(5, swPos, 1, -30);
+  setOverride(10, swPos, 2, 20);
+  g_model.customFn[10].active = false;
+  setOverride(12, -swPos, 3, 10);
+
+  simuSetSwitch(sw, 0);
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(safetyCh[0], OVERRIDE_CHANNEL_UNDEFINED);
+  EXPECT_EQ(safetyCh[1], OVERRIDE_CHANNEL_UNDEFINED);
+  EXPECT_EQ(safetyCh[3], 10);
+  EXPECT_EQ(modelFunctionsContext.activeSwitches, (MASK_CFN_TYPE)1 << 12);
+
+  simuSetSwitch(sw, -1);
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(safetyCh[0], 50);
+  EXPECT_EQ(safetyCh[1], -30);
+  EXPECT_EQ(safetyCh[2], OVERRIDE_CHANNEL_UNDEFINED);
+  EXPECT_EQ(safetyCh[3], OVERRIDE_CHANNEL_UNDEFINED);
+  EXPECT_EQ(modelFunctionsContext.activeSwitches,
+            ((MASK_CFN_TYPE)1 << 0) | ((MASK_CFN_TYPE)1 << 5));
+
+  // saving the settings leaves the index alone
+  storageDirty(EE_MODEL | EE_GENERAL);
+  EXPECT_FALSE(modelFunctionsContext.indexDirty);
+
+  // functions edited as from the menus
+  setOverride(MAX_SPECIAL_FUNCTIONS - 1, swPos, 4, -5);
+  g_model.customFn[10].active = true;
+  memclear(&g_model.customFn[0], sizeof(CustomFunctionData));
+  storageDirty(EE_MODEL);
+  invalidateFunctionsIndex(EE_MODEL);
+  EXPECT_TRUE(modelFunctionsContext.indexDirty);
+  evalFunctions(g_model.customFn, modelFunctionsContext);
+  EXPECT_EQ(safetyCh[0], OVERRIDE_CHANNEL_UNDEFINED);
+  EXPECT_EQ(safetyCh[1], -30);
+  EXPECT_EQ(safetyCh[2], 20);
+  EXPECT_EQ(safetyCh[4], -5);
+  EXPECT_EQ(modelFunctionsContext.activeSwitches,
+            ((MASK_CFN_TYPE)1 << 5) | ((MASK_CFN_TYPE)1 << 10) |
+            ((MASK_CFN_TYPE)1 << (MAX_SPECIAL_FUNCTIONS - 1)));
+}
+#endif
+
 #if defined(GVARS)
 TEST_F(SpecialFunctionsTest, GvarsInc)
 {
@@ -82,11 +82,15 @@ inline void SYSTEM_RESET()
 inline void MODEL_RESET()
 {
   memset(&g_model, 0, sizeof(g_model));
+#if defined(GVARS)
+  invalidateGVarFlightModes();
+#endif
   anaResetFiltered();
   extern uint8_t s_mixer_first_run_done;
   s_mixer_first_run_done = false;
   evalMixes(1);  // this is needed to reset fp_act
   lastFlightMode = 255;
+  modelFunctionsContext.reset();
 }
 
 inline void MIXER_RESET()
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "gtests.h"
+
+#if defined(GVARS)
+
+class GVarsTest : public EdgeTxTest {};
+
+// Reference: the inheritance chain walked on each lookup
+static uint8_t chainGVarFlightMode(uint8_t fm, uint8_t gv)
+{
+  for (uint8_t i = 0; i < MAX_FLIGHT_MODES; i++) {
+    if (fm == 0) return 0;
+    int16_t val = GVAR_VALUE(gv, fm);
+    if (val <= GVAR_MAX) return fm;
+    uint8_t result = val - GVAR_MAX - 1;
+    if (result >= fm) result++;
+    fm = result;
+  }
+  return 0;
+}
+
+static uint32_t randomSeed = 1;
+
+static uint32_t randomValue(uint32_t range)
+{
+  randomSeed = randomSeed * 1103515245 + 12345;
+  return (randomSeed >> 16) % range;
+}
+
+static void randomGVars()
+{
+  for (uint8_t fm = 0; fm < MAX_FLIGHT_MODES; fm++) {
+    for (uint8_t gv = 0; gv < MAX_GVARS; gv++) {
+      if (fm > 0 && randomValue(3) > 0) {
+        // link to any other flight mode, loops included
+        GVAR_VALUE(gv, fm) = GVAR_MAX + 1 + randomValue(MAX_FLIGHT_MODES - 1);
+      } else {
+        GVAR_VALUE(gv, fm) = (int16_t)randomValue(2 * GVAR_MAX + 1) - GVAR_MAX;
+      }
+    }
+    g_model.gvars[fm % MAX_GVARS].prec = randomValue(2);
+  }
+}
+
+static void checkGVars()
+{
+  for (uint8_t fm = 0; fm < MAX_FLIGHT_MODES; fm++) {
+    for (uint8_t gv = 0; gv < MAX_GVARS; gv++) {
+      uint8_t ref = chainGVarFlightMode(fm, gv);
+      int16_t value = GVAR_VALUE(gv, ref);
+      int mul = g_model.gvars[gv].prec ? 1 : 10;
+      ASSERT_EQ(ref, getGVarFlightMode(fm, gv)) << "FM" << (int)fm << " GV" << gv + 1;
+      ASSERT_EQ(value, getGVarValue(gv, fm));
+      ASSERT_EQ(-value, getGVarValue(-1 - gv, fm));
+      ASSERT_EQ(value * mul, getGVarValuePrec1(gv, fm));
+      ASSERT_EQ(-value * mul, getGVarValuePrec1(-1 - gv, fm));
+    }
+  }
+}
+
+TEST_F(GVarsTest, defaultChains)
+{
+  checkGVars();
+
+  GVAR_VALUE(0, 0) = 12;
+  EXPECT_EQ(12, getGVarValue(0, 3));
+
+  // FM3 linked to FM1
+  GVAR_VALUE(0, 1) = -20;
+  GVAR_VALUE(0, 3) = GVAR_MAX + 2;
+  invalidateGVarFlightModes();
+  EXPECT_EQ(-20, getGVarValue(0, 3));
+  checkGVars();
+}
+
+TEST_F(GVarsTest, randomChains)
+{
+  for (int i = 0; i < 500; i++) {
+    randomGVars();
+    invalidateGVarFlightModes();
+    checkGVars();
+  }
+}
+
+TEST_F(GVarsTest, valuesWithoutRebuild)
+{
+  randomGVars();
+  invalidateGVarFlightModes();
+  checkGVars();
+
+  // only links are cached: new values are read at once
+  for (uint8_t fm = 0; fm < MAX_FLIGHT_MODES; fm++) {
+    for (uint8_t gv = 0; gv < MAX_GVARS; gv++) {
+      if (GVAR_VALUE(gv, fm) <= GVAR_MAX)
+        GVAR_VALUE(gv, fm) = fm * MAX_GVARS + gv;
+    }
+  }
+  checkGVars();
+
+  // written through the link to the flight mode holding the value
+  GVAR_VALUE(1, 0) = 5;
+  GVAR_VALUE(1, 2) = GVAR_MAX + 1;
+  GVAR_VALUE(1, 4) = GVAR_MAX + 3;
+  invalidateGVarFlightModes();
+  setGVarValue(1, 77, 4);
+  EXPECT_EQ(77, GVAR_VALUE(1, 0));
+  EXPECT_EQ(77, getGVarValue(1, 2));
+  checkGVars();
+}
+
+TEST_F(GVarsTest, flightModeSwitch)
+{
+  randomGVars();
+  invalidateGVarFlightModes();
+
+  // the table covers every flight mode: no rebuild needed when it changes
+  for (uint8_t fm = 0; fm < MAX_FLIGHT_MODES; fm++) {
+    mixerCurrentFlightMode = fm;
+    for (uint8_t gv = 0; gv < MAX_GVARS; gv++) {
+      EXPECT_EQ(GVAR_VALUE(gv, chainGVarFlightMode(fm, gv)),
+                getGVarValue(gv, mixerCurrentFlightMode));
+    }
+  }
+  mixerCurrentFlightMode = 0;
+}
+
+#endif
@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "gtests.h"
+
+#include <random>
+
+#include "gyro_fusion.h"
+
+// LSM6DS: +/-2g, +/-245 dps
+#define ACCEL_1G       16384
+#define GYRO_SCALE     8750     // udps per LSB
+#define SAMPLE_DT      4000     // us
+
+// Synthetic IMU: rotation around X (roll) then Y (pitch), in degrees
+struct ImuSimulator {
+  std::mt19937 gen;
+  std::normal_distribution<double> accelNoise{0.0, 50.0};
+  std::normal_distribution<double> gyroNoise{0.0, 20.0};
+  double roll = 0, pitch = 0;
+  double gyroBias[3] = {0, 0, 0};
+  int gyroSign[3] = {1, 1, 1};
+  double linearAccel[3] = {0, 0, 0};  // in g
+
+  explicit ImuSimulator(unsigned seed) : gen(seed) {}
+
+  // Moves to the given attitude over one sample
+  void sample(double newRoll, double newPitch, int32_t accel[3],
+              int32_t gyro[3])
+  {
+    double rollRate = (newRoll - roll) * 1000000 / SAMPLE_DT;
+    double pitchRate = (newPitch - pitch) * 1000000 / SAMPLE_DT;
+    roll = newRoll;
+    pitch = newPitch;
+
+    double r = roll * M_PI / 180, p = pitch * M_PI / 180;
+    double g[3] = {-sin(p), cos(p) * sin(r), cos(p) * cos(r)};
+    double rates[3] = {rollRate * cos(p), pitchRate, -rollRate * sin(p)};
+    for (int i = 0; i < 3; i++) {
+      accel[i] =
+          lround((g[i] + linearAccel[i]) * ACCEL_1G + accelNoise(gen));
+      gyro[i] = gyroSign[i] * lround((rates[i] + gyroBias[i]) * 1000000 /
+                                         GYRO_SCALE + gyroNoise(gen));
+    }
+  }
+};
+
+// Tilt (degrees) as given by gyroFusionTilt()
+static double tiltDegrees(int16_t tilt)
+{
+  return asin(limit(-1.0, double(tilt) / ACCEL_1G, 1.0)) * 180 / M_PI;
+}
+
+static void initFusion(GyroFusionState* st, ImuSimulator& imu)
+{
+  int32_t accel[3], gyro[3];
+  gyroFusionReset(st);
+  imu.sample(imu.roll, imu.pitch, accel, gyro);
+  gyroFusionUpdate(st, accel, gyro, GYRO_SCALE, SAMPLE_DT);
+}
+
+// Roll from 0 to 'angle' in 'duration' seconds, then back: returns the
+// largest error of the fused and of the previous low-pass tilt
+static void rollMoves(GyroFusionState* st, ImuSimulator& imu, double angle,
+                      double duration, int moves, double& fusedError,
+                      double& lowPassError)
+{
+  int32_t accel[3], gyro[3];
+  double lowPass = 0;
+  fusedError = lowPassError = 0;
+
+  unsigned steps = duration * 1000000 / SAMPLE_DT;
+  for (int move = 0; move < moves; move++) {
+    for (unsigned i = 0; i < 4 * steps; i++) {
+      double target = i < steps       ? angle * (i + 1) / steps
+                      : i < 2 * steps ? angle
+                      : i < 3 * steps ? angle * (3 * steps - i - 1) / steps
+                                      : 0;
+      imu.sample(target, 0, accel, gyro);
+      gyroFusionUpdate(st, accel, gyro, GYRO_SCALE, SAMPLE_DT);
+
+      // previous filter: 0.9 low pass of the accelerometer every 10ms
+      if (i % 5 < 2) lowPass = 0.9 * lowPass + 0.1 * accel[1];
+
+      double fused = tiltDegrees(gyroFusionTilt(st, 1));
+      fusedError = std::max(fusedError, fabs(fused - imu.roll));
+      lowPassError = std::max(lowPassError,
+                              fabs(tiltDegrees(lowPass) - imu.roll));
+    }
+  }
+}
+
+TEST(GyroFusion, tracksMoves)
+{
+  ImuSimulator imu(1);
+  GyroFusionState st;
+  initFusion(&st, imu);
+
+  double fusedError, lowPassError;
+  rollMoves(&st, imu, 30, 0.2, 3, fusedError, lowPassError);
+
+  EXPECT_LT(fusedError, 2.0);
+  EXPECT_LT(fusedError, lowPassError / 4);
+}
+
+TEST(GyroFusion, gyroBias)
+{
+  ImuSimulator imu(2);
+  imu.roll = 20;
+  imu.gyroBias[0] = 3;   // dps
+  imu.gyroBias[1] = -2;
+
+  GyroFusionState st;
+  initFusion(&st, imu);
+
+  int32_t accel[3], gyro[3];
+  for (int i = 0; i < 60 * 1000000 / SAMPLE_DT; i++) {
+    imu.sample(20, 0, accel, gyro);
+    gyroFusionUpdate(&st, accel, gyro, GYRO_SCALE, SAMPLE_DT);
+  }
+
+  EXPECT_NEAR(tiltDegrees(gyroFusionTilt(&st, 1)), 20, 0.5);
+  EXPECT_NEAR(tiltDegrees(gyroFusionTilt(&st, 0)), 0, 0.5);
+
+  // the integral term compensates the bias, except along gravity where it
+  // cannot be observed
+  double g[3] = {0, sin(20 * M_PI / 180), cos(20 * M_PI / 180)};
+  double along = imu.gyroBias[0] * g[0] + imu.gyroBias[1] * g[1];
+  for (int i = 0; i < 3; i++) {
+    EXPECT_NEAR(st.bias[i] * 180 / M_PI / (1 << 24),
+                -(imu.gyroBias[i] - along * g[i]), 0.3);
+  }
+
+  // and the estimate follows moves without lagging
+  double fusedError, lowPassError;
+  imu.gyroBias[0] = 3;
+  rollMoves(&st, imu, -30, 0.2, 1, fusedError, lowPassError);
+  EXPECT_LT(fusedError, 21.0);  // starts from 20 deg
+}
+
+TEST(GyroFusion, linearAcceleration)
+{
+  ImuSimulator imu(3);
+  GyroFusionState st;
+  initFusion(&st, imu);
+
+  int32_t accel[3], gyro[3];
+  double maxError = 0;
+  for (int i = 0; i < 1000000 / SAMPLE_DT; i++) {
+    // 0.5g sideways push during 200ms, without rotation
+    imu.linearAccel[1] = (i >= 50 && i < 100) ? 0.5 : 0;
+    imu.sample(0, 0, accel, gyro);
+    gyroFusionUpdate(&st, accel, gyro, GYRO_SCALE, SAMPLE_DT);
+    maxError = std::max(maxError, fabs(tiltDegrees(gyroFusionTilt(&st, 1))));
+  }
+
+  EXPECT_LT(maxError, 1.0);
+}
+
+TEST(GyroFusion, gyroAxisSignReported)
+{
+  ImuSimulator imu(4);
+  imu.gyroSign[0] = -1;
+
+  GyroFusionState st;
+  initFusion(&st, imu);
+
+  double fusedError, lowPassError;
+  rollMoves(&st, imu, 30, 0.2, 4, fusedError, lowPassError);
+  EXPECT_EQ(gyroFusionInvertedAxes(&st), 1 << 0);
+}
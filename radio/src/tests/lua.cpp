@@ -26,6 +26,7 @@
 
 #include "edgetx.h"
 #include "lua/lua_states.h"
+#include "lua/lua_bytecode_cache.h"
 
 #include <filesystem>
 
@@ -222,6 +223,149 @@ TEST(Lua, testLegacyNames)
 #endif
 }
 
+TEST(Lua, greediestAllocator)
+{
+  extern lua_State * lsScripts;
+  if (!lsScripts) { luaInitMainState(); luaInit(); }
+  ASSERT_NE(nullptr, lsScripts);
+
+  memclear(scriptInternalData, sizeof(scriptInternalData));
+  luaScriptsCount = 3;
+  for (int i = 0; i < luaScriptsCount; i++)
+    scriptInternalData[i].state = SCRIPT_OK;
+
+  // Nothing allocated: no script is stopped
+  EXPECT_EQ(-1, luaGetGreediestAllocator(0));
+
+  // The script whose last call allocated the most, whatever it did before
+  scriptInternalData[0].stats.lastAlloc = 2000;
+  scriptInternalData[0].stats.maxAlloc = 50000;
+  scriptInternalData[1].stats.lastAlloc = 3000;
+  EXPECT_EQ(1, luaGetGreediestAllocator(0));
+
+  // A preempted call counts what it allocated so far
+  uint32_t memUsed = luaGetMemUsed(lsScripts);
+  ASSERT_GT(memUsed, 4000u);
+  ScriptStats & preempted = scriptInternalData[2].stats;
+  preempted.lastAlloc = 100000;
+  preempted.callPreempted = true;
+  preempted.callMemStart = memUsed - 4000;
+  EXPECT_EQ(2, luaGetGreediestAllocator(0));
+  preempted.callMemStart = memUsed;
+  EXPECT_EQ(1, luaGetGreediestAllocator(0));
+
+  // Scripts already stopped are left alone
+  scriptInternalData[1].state = SCRIPT_PANIC;
+  EXPECT_EQ(0, luaGetGreediestAllocator(0));
+
+  // Memory taken by the widgets is not blamed on a script
+  EXPECT_EQ(-1, luaGetGreediestAllocator(3000));
+  EXPECT_EQ(0, luaGetGreediestAllocator(1000));
+
+  memclear(scriptInternalData, sizeof(scriptInternalData));
+  luaScriptsCount = 0;
+}
+
+// Register the function returned by 'chunk' as the run function of a script
+static void luaSetupScript(int idx, uint8_t reference, const char * chunk)
+{
+  extern lua_State * lsScripts;
+  ScriptInternalData & sid = scriptInternalData[idx];
+  ASSERT_EQ(LUA_OK, luaL_dostring(lsScripts, chunk));
+  sid.run = luaL_ref(lsScripts, LUA_REGISTRYINDEX);
+  sid.background = LUA_REFNIL;
+  sid.reference = reference;
+  sid.state = SCRIPT_OK;
+}
+
+// Function script, run on every Lua cycle
+static void luaSetupFunctionScript(int idx, const char * chunk)
+{
+  CustomFunctionData & fn = g_model.customFn[0];
+  memclear(&fn, sizeof(fn));
+  fn.func = FUNC_PLAY_SCRIPT;
+  fn.swtch = SWSRC_ON;
+  fn.active = 1;
+  luaSetupScript(idx, SCRIPT_FUNC_FIRST, chunk);
+}
+
+static void luaClearScripts()
+{
+  memclear(&g_model.customFn[0], sizeof(CustomFunctionData));
+  luaInit();
+  LUA_LOAD_MODEL_SCRIPTS();
+}
+
+TEST(Lua, scheduler)
+{
+  luaInitMainState();
+  luaInit();
+  ASSERT_NE(INTERPRETER_PANIC, luaState);
+
+  // A mix script and a function script far longer than its budget
+  luaSetupScript(0, SCRIPT_MIX_FIRST,
+                 "local n = 0 return function() n = n + 1 return n end");
+  scriptInputsOutputs[0].inputsCount = 0;
+  scriptInputsOutputs[0].outputsCount = 1;
+  luaSetupFunctionScript(
+      1, "return function() local x = 0 for i = 1, 100000 do x = x + i end end");
+  luaScriptsCount = 2;
+
+  // Time does not run: only the budget preempts
+  luaState = INTERPRETER_START_RUNNING;
+  for (int cycle = 1; cycle <= 20; cycle++) {
+    luaTask(false);
+    // The mix script runs on every cycle, the function script being preempted
+    EXPECT_EQ(cycle, (int)scriptInternalData[0].stats.runs);
+    EXPECT_EQ(cycle, scriptInputsOutputs[0].outputs[0].value);
+  }
+
+  const ScriptStats & mix = scriptInternalData[0].stats;
+  EXPECT_EQ(0, mix.preemptions);
+  EXPECT_EQ(0, mix.overruns);
+
+  const ScriptInternalData & busy = scriptInternalData[1];
+  EXPECT_GT(busy.stats.runs, 0u);
+  EXPECT_LT(busy.stats.runs, 20u);
+  EXPECT_GT(busy.stats.preemptions, busy.stats.runs);
+  EXPECT_EQ(0, busy.stats.overruns);
+  EXPECT_GE(busy.stats.instructions, 200000u);
+  EXPECT_GT(busy.instructions, 100);
+
+  luaClearScripts();
+}
+
+TEST(Lua, gcPacer)
+{
+  extern lua_State * lsScripts;
+  luaInitMainState();
+  luaInit();
+  ASSERT_NE(INTERPRETER_PANIC, luaState);
+
+  // ~20KB of garbage per call
+  luaSetupFunctionScript(
+      0, "return function() local t = {} for i = 1, 200 do t[i] = {i} end end");
+  luaScriptsCount = 1;
+
+  // Without the automatic GC, the pacer alone keeps the memory bounded
+  lua_gc(lsScripts, LUA_GCSTOP, 0);
+  uint32_t memStart = luaGetMemUsed(lsScripts);
+  luaState = INTERPRETER_START_RUNNING;
+  uint32_t memMax = 0;
+  for (int cycle = 0; cycle < 500; cycle++) {
+    luaTask(false);
+    memMax = max(memMax, luaGetMemUsed(lsScripts));
+  }
+  lua_gc(lsScripts, LUA_GCRESTART, 0);
+
+  const ScriptStats & stats = scriptInternalData[0].stats;
+  EXPECT_EQ(500u, stats.runs);
+  EXPECT_GT(stats.lastAlloc, 10000u);
+  EXPECT_LT(memMax, memStart + 500 * stats.lastAlloc / 10);
+
+  luaClearScripts();
+}
+
 TEST(Lua, ioSeek)
 {
   const char io_seek_tst[] =
@@ -243,4 +387,74 @@ TEST(Lua, ioSeek)
   std::filesystem::remove(simuFatfsGetRealPath("seek-test.txt"));
 }
 
+#if defined(LUA_COMPILER)
+static int luaCallInteger(lua_State * L)
+{
+  if (lua_pcall(L, 0, 1, 0) != LUA_OK) return -1;
+  int result = lua_tointeger(L, -1);
+  lua_pop(L, 1);
+  return result;
+}
+
+TEST(Lua, bytecodeCache)
+{
+  extern lua_State * lsScripts;
+  if (!lsScripts) { luaInitMainState(); luaInit(); }
+  ASSERT_NE(nullptr, lsScripts);
+
+  const char * cachePath = "bytecode-cache-test.bin";
+  std::filesystem::remove(simuFatfsGetRealPath(cachePath));
+
+  FILINFO source;
+  memclear(&source, sizeof(source));
+  source.fdate = 0x5a21;
+  source.ftime = 0x6000;
+  source.fsize = 42;
+
+  {
+    LuaBytecodeCache cache(cachePath);
+    EXPECT_FALSE(cache.load(lsScripts, "/SCRIPTS/a.lua", source, true));
+
+    ASSERT_EQ(LUA_OK, luaL_loadstring(lsScripts, "return 12"));
+    EXPECT_TRUE(cache.store(lsScripts, "/SCRIPTS/a.lua", source, true));
+    lua_pop(lsScripts, 1);
+    ASSERT_EQ(LUA_OK, luaL_loadstring(lsScripts, "return 34"));
+    EXPECT_TRUE(cache.store(lsScripts, "/SCRIPTS/b.lua", source, true));
+    lua_pop(lsScripts, 1);
+    cache.close();
+  }
+
+  // Entries are found by a new instance, reading the archive from disk
+  LuaBytecodeCache cache(cachePath);
+  int top = lua_gettop(lsScripts);
+  ASSERT_TRUE(cache.load(lsScripts, "/SCRIPTS/a.lua", source, true));
+  EXPECT_EQ(12, luaCallInteger(lsScripts));
+  ASSERT_TRUE(cache.load(lsScripts, "/scripts/B.lua", source, true));
+  EXPECT_EQ(34, luaCallInteger(lsScripts));
+  EXPECT_EQ(2u, cache.size());
+
+  // Changed source, or debug info requested: recompile
+  FILINFO changed = source;
+  changed.fsize = 43;
+  EXPECT_FALSE(cache.load(lsScripts, "/SCRIPTS/a.lua", changed, true));
+  EXPECT_FALSE(cache.load(lsScripts, "/SCRIPTS/a.lua", source, false));
+  EXPECT_FALSE(cache.load(lsScripts, "/SCRIPTS/c.lua", source, true));
+  EXPECT_EQ(top, lua_gettop(lsScripts));
+
+  // Replacing an entry leaves the other one untouched
+  ASSERT_EQ(LUA_OK, luaL_loadstring(lsScripts, "return 56"));
+  EXPECT_TRUE(cache.store(lsScripts, "/SCRIPTS/a.lua", changed, true));
+  lua_pop(lsScripts, 1);
+  EXPECT_GT(cache.staleSize(), 0u);
+  ASSERT_TRUE(cache.load(lsScripts, "/SCRIPTS/a.lua", changed, true));
+  EXPECT_EQ(56, luaCallInteger(lsScripts));
+  ASSERT_TRUE(cache.load(lsScripts, "/SCRIPTS/b.lua", source, true));
+  EXPECT_EQ(34, luaCallInteger(lsScripts));
+  EXPECT_EQ(2u, cache.size());
+  cache.close();
+
+  std::filesystem::remove(simuFatfsGetRealPath(cachePath));
+}
+#endif
+
 #endif   // #if defined(LUA)
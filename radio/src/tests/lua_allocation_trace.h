@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#pragma once
+
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <vector>
+
+#include "lua/lua_states.h"
+#include "lua/slab_allocator.h"
+
+// Synthetic allocation trace of a long session: Lua objects with the sizes
+// they have on target, most of them short lived, arrays growing by realloc.
+struct TraceOp {
+  uint32_t object;
+  uint32_t osize;
+  uint32_t nsize;
+};
+
+inline std::vector<TraceOp> luaAllocationTrace(unsigned frames)
+{
+  std::vector<TraceOp> trace;
+  std::vector<std::pair<uint32_t, uint32_t>> live;  // object, size
+  uint32_t seed = 0x1234567;
+  auto rnd = [&](uint32_t n) {
+    seed = seed * 1103515245u + 12345u;
+    return (seed >> 8) % n;
+  };
+  uint32_t objects = 0;
+
+  for (unsigned frame = 0; frame < frames; frame++) {
+    for (int i = 0; i < 20; i++) {
+      uint32_t size;
+      switch (rnd(6)) {
+        case 0: size = 17 + rnd(32); break;      // short string
+        case 1: size = 32; break;                // table
+        case 2: size = 16 + 4 * rnd(4); break;   // closure
+        case 3: size = 16; break;                // upvalue
+        case 4: size = 76; break;                // prototype
+        default: size = 8; break;                // array part
+      }
+      trace.push_back({objects, 0, size});
+      live.push_back({objects++, size});
+    }
+    // arrays grow, older objects die
+    for (int i = 0; i < 4 && !live.empty(); i++) {
+      auto& obj = live[rnd(live.size())];
+      if (obj.second < 256) {
+        trace.push_back({obj.first, obj.second, obj.second * 2});
+        obj.second *= 2;
+      }
+    }
+    while (live.size() > 300 || (live.size() > 0 && rnd(4) != 0)) {
+      size_t idx = rnd(live.size());
+      trace.push_back({live[idx].first, live[idx].second, 0});
+      live[idx] = live.back();
+      live.pop_back();
+    }
+  }
+  for (auto& obj : live) {
+    trace.push_back({obj.first, obj.second, 0});
+  }
+  return trace;
+}
+
+inline uint32_t traceObjects(const std::vector<TraceOp>& trace)
+{
+  uint32_t objects = 0;
+  for (const auto& op : trace) objects = std::max(objects, op.object + 1);
+  return objects;
+}
+
+inline void replayTrace(const std::vector<TraceOp>& trace, lua_Alloc f,
+                        void* ud, uint32_t objects)
+{
+  std::vector<void*> blocks(objects, nullptr);
+  for (const auto& op : trace) {
+    void*& ptr = blocks[op.object];
+    ptr = f(ud, ptr, ptr ? op.osize : LUA_TSTRING, op.nsize);
+    if (op.nsize) memset(ptr, 0x55, op.nsize);
+  }
+}
+
+// Size classes used on target, and the two bins previously used in front of
+// the heap, in the same arena size
+static constexpr SlabAllocator::ClassDef traceClasses[] = {
+  {16, 128}, {24, 96}, {32, 64}, {48, 32}, {64, 16}, {96, 12},
+};
+static constexpr SlabAllocator::ClassDef traceBins[] = {
+  {32, 172}, {96, 48},
+};
+static_assert(SlabAllocator::arenaSize(traceClasses, 6) ==
+              SlabAllocator::arenaSize(traceBins, 2), "arena sizes differ");
+
+// Requests which went to the heap
+inline uint32_t heapRequests(const SlabAllocator& slab)
+{
+  uint32_t requests = slab.heapStats().large;
+  for (uint8_t i = 0; i < slab.classCount(); i++) {
+    requests += slab.classStats(i).misses;
+  }
+  return requests;
+}
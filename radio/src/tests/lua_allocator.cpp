@@ -0,0 +1,196 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "gtests.h"
+
+#if defined(LUA)
+
+#include "lua/lua_states.h"
+#include "lua/slab_allocator.h"
+#include "lua_allocation_trace.h"
+
+static constexpr SlabAllocator::ClassDef testClasses[] = {
+  {16, 4}, {32, 2}, {64, 1},
+};
+
+struct TestSlab {
+  alignas(SLAB_ALIGN) uint8_t arena[SlabAllocator::arenaSize(testClasses, 3)];
+  SlabAllocator slab;
+  TestSlab() : slab(testClasses, 3, arena) {}
+};
+
+TEST(LuaAllocator, sizeClasses)
+{
+  TestSlab t;
+  SlabAllocator& slab = t.slab;
+  EXPECT_EQ(slab.freeBytes(), 4 * 16 + 2 * 32 + 64u);
+
+  void* a = slab.alloc(nullptr, LUA_TSTRING, 10);
+  void* b = slab.alloc(nullptr, LUA_TTABLE, 20);
+  EXPECT_TRUE(slab.owns(a));
+  EXPECT_TRUE(slab.owns(b));
+  EXPECT_EQ(slab.classStats(0).used, 1);
+  EXPECT_EQ(slab.classStats(1).used, 1);
+  EXPECT_EQ(slab.wastedBytes(), (16u - 10) + (32u - 20));
+
+  // 32 bytes class full: spill into the 64 bytes class
+  void* c = slab.alloc(nullptr, LUA_TTABLE, 32);
+  void* d = slab.alloc(nullptr, LUA_TTABLE, 32);
+  EXPECT_TRUE(slab.owns(d));
+  EXPECT_EQ(slab.classStats(1).spills, 1u);
+  EXPECT_EQ(slab.classStats(2).used, 1);
+
+  // all larger classes full: heap
+  void* e = slab.alloc(nullptr, LUA_TTABLE, 24);
+  EXPECT_FALSE(slab.owns(e));
+  EXPECT_EQ(slab.classStats(1).misses, 1u);
+  EXPECT_EQ(slab.heapStats().blocks, 1u);
+  EXPECT_EQ(slab.heapStats().bytes, 24u);
+
+  void* f = slab.alloc(nullptr, LUA_TTABLE, 100);
+  EXPECT_FALSE(slab.owns(f));
+  EXPECT_EQ(slab.heapStats().large, 1u);
+  EXPECT_EQ(slab.heapStats().maxBytes, 124u);
+
+  slab.alloc(a, 10, 0);
+  slab.alloc(b, 20, 0);
+  slab.alloc(c, 32, 0);
+  slab.alloc(d, 32, 0);
+  slab.alloc(e, 24, 0);
+  slab.alloc(f, 100, 0);
+  for (uint8_t i = 0; i < slab.classCount(); i++) {
+    EXPECT_EQ(slab.classStats(i).used, 0);
+    EXPECT_EQ(slab.classStats(i).requested, 0u);
+  }
+  EXPECT_EQ(slab.classStats(1).maxUsed, 2);
+  EXPECT_EQ(slab.heapStats().blocks, 0u);
+  EXPECT_EQ(slab.heapStats().bytes, 0u);
+  EXPECT_EQ(slab.wastedBytes(), 0u);
+
+  slab.resetStats();
+  EXPECT_EQ(slab.classStats(1).maxUsed, 0);
+  EXPECT_EQ(slab.heapStats().maxBytes, 0u);
+}
+
+TEST(LuaAllocator, realloc)
+{
+  TestSlab t;
+  SlabAllocator& slab = t.slab;
+
+  auto p = (char*)slab.alloc(nullptr, 0, 8);
+  strcpy(p, "edgetx");
+
+  // fits in the slot
+  EXPECT_EQ(slab.alloc(p, 8, 16), p);
+  EXPECT_EQ(slab.classStats(0).requested, 16u);
+
+  // grows into the next classes, then into the heap
+  p = (char*)slab.alloc(p, 16, 30);
+  EXPECT_EQ(slab.classStats(0).used, 0);
+  EXPECT_EQ(slab.classStats(1).used, 1);
+  EXPECT_STREQ(p, "edgetx");
+  p = (char*)slab.alloc(p, 30, 200);
+  EXPECT_FALSE(slab.owns(p));
+  EXPECT_STREQ(p, "edgetx");
+
+  // shrinking heap blocks return to the arena
+  p = (char*)slab.alloc(p, 200, 12);
+  EXPECT_TRUE(slab.owns(p));
+  EXPECT_EQ(slab.classStats(0).used, 1);
+  EXPECT_EQ(slab.heapStats().bytes, 0u);
+  EXPECT_STREQ(p, "edgetx");
+
+  // shrinking slots move to a smaller class with room
+  p = (char*)slab.alloc(p, 12, 60);
+  EXPECT_EQ(slab.classStats(2).used, 1);
+  p = (char*)slab.alloc(p, 60, 10);
+  EXPECT_EQ(slab.classStats(0).used, 1);
+  EXPECT_EQ(slab.classStats(2).used, 0);
+  EXPECT_STREQ(p, "edgetx");
+
+  slab.alloc(p, 10, 0);
+  EXPECT_EQ(slab.usedBytes(), 0u);
+}
+
+TEST(LuaAllocator, luaState)
+{
+  static constexpr SlabAllocator::ClassDef classes[] = {
+    {16, 256}, {32, 256}, {48, 128}, {64, 128}, {96, 64}, {128, 32},
+  };
+  alignas(SLAB_ALIGN) static uint8_t arena[SlabAllocator::arenaSize(classes, 6)];
+  SlabAllocator slab(classes, 6, arena);
+
+  lua_State* L = lua_newstate(SlabAllocator::luaAlloc, &slab);
+  ASSERT_NE(L, nullptr);
+  luaL_openlibs(L);
+  ASSERT_EQ(luaL_dostring(L,
+    "local t = {}\n"
+    "for i = 1, 2000 do\n"
+    "  t[i % 100] = { name = 'item' .. i, f = function() return i end }\n"
+    "end\n"
+    "collectgarbage()\n"
+    "return #t\n"), LUA_OK);
+  EXPECT_EQ(lua_tointeger(L, -1), 99);
+
+  uint32_t allocs = 0;
+  for (uint8_t i = 0; i < slab.classCount(); i++) {
+    allocs += slab.classStats(i).allocs;
+  }
+  EXPECT_GT(allocs, 2000u);
+
+  lua_close(L);
+  EXPECT_EQ(slab.usedBytes(), 0u);
+  EXPECT_EQ(slab.wastedBytes(), 0u);
+  EXPECT_EQ(slab.heapStats().blocks, 0u);
+  EXPECT_EQ(slab.heapStats().bytes, 0u);
+}
+
+TEST(LuaAllocator, trace)
+{
+  auto trace = luaAllocationTrace(5000);
+  uint32_t objects = traceObjects(trace);
+
+  alignas(SLAB_ALIGN) static uint8_t arena[SlabAllocator::arenaSize(traceClasses, 6)];
+
+  SlabAllocator slab(traceClasses, 6, arena);
+  replayTrace(trace, SlabAllocator::luaAlloc, &slab, objects);
+  EXPECT_EQ(slab.usedBytes(), 0u);
+  EXPECT_EQ(slab.heapStats().bytes, 0u);
+
+  SlabAllocator twoBins(traceBins, 2, arena);
+  replayTrace(trace, SlabAllocator::luaAlloc, &twoBins, objects);
+  EXPECT_EQ(twoBins.usedBytes(), 0u);
+  EXPECT_EQ(twoBins.heapStats().bytes, 0u);
+
+  // Every size class is used
+  for (uint8_t i = 0; i < slab.classCount(); i++) {
+    const auto& c = slab.classStats(i);
+    EXPECT_GT(c.allocs, 0u) << "class " << c.size;
+  }
+
+  // Size classes send fewer requests to the heap, and keep more of the small
+  // objects away from it
+  EXPECT_LT(heapRequests(slab), heapRequests(twoBins));
+  EXPECT_LT(slab.heapStats().maxBytes, twoBins.heapStats().maxBytes);
+}
+
+#endif  // LUA
@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "gtests.h"
+
+#if defined(COLORLCD) && defined(LUA)
+
+#include "lua/lua_draw_list.h"
+#include "lua/api_colorlcd.h"
+
+// Fake lcd.* function: x, y, w, h and a value, recorded into 'drawn'
+static std::vector<lua_Integer> drawn;
+
+static int drawBox(lua_State* L)
+{
+  for (int i = 1; i <= lua_gettop(L); i++)
+    drawn.push_back(luaL_checkinteger(L, i));
+  return 0;
+}
+
+static bool boxBounds(const LuaDrawArgs& args, rect_t& rect)
+{
+  rect = {(coord_t)args.integer(1), (coord_t)args.integer(2),
+          (coord_t)args.integer(3), (coord_t)args.integer(4)};
+  return true;
+}
+
+static bool bitmapBounds(const LuaDrawArgs& args, rect_t& rect)
+{
+  const BitmapBuffer* b = args.bitmap(1);
+  if (!b) return false;
+  rect = {0, 0, b->width(), b->height()};
+  return true;
+}
+
+static const LuaDrawOp boxOp = {drawBox, 0, boxBounds, nullptr};
+static const LuaDrawOp bitmapOp = {drawBox, 0, bitmapBounds, nullptr};
+static const LuaDrawOp fullOp = {drawBox, 0, nullptr, nullptr};
+
+class LuaDrawListTest : public testing::Test
+{
+ protected:
+  lua_State* L = nullptr;
+
+  void SetUp() override
+  {
+    L = luaL_newstate();
+    drawn.clear();
+  }
+
+  void TearDown() override { lua_close(L); }
+
+  // Record a call with integer arguments, as an lcd.* function would
+  void record(LuaDrawList& list, const LuaDrawOp& op,
+              std::initializer_list<lua_Integer> args)
+  {
+    lua_settop(L, 0);
+    for (auto arg : args) lua_pushinteger(L, arg);
+    list.record(L, &op);
+    lua_settop(L, 0);
+  }
+};
+
+TEST_F(LuaDrawListTest, Replay)
+{
+  LuaDrawList list;
+  list.beginRecord(L);
+  record(list, boxOp, {1, 2, 3, 4, 5});
+  record(list, boxOp, {6, 7, 8, 9, 10});
+  ASSERT_TRUE(list.endRecord(L));
+  EXPECT_TRUE(list.isValid());
+  EXPECT_EQ(2u, list.size());
+
+  EXPECT_TRUE(list.replay(L));
+  EXPECT_EQ(std::vector<lua_Integer>({1, 2, 3, 4, 5, 6, 7, 8, 9, 10}), drawn);
+  EXPECT_EQ(0, lua_gettop(L));
+  list.clear(L);
+}
+
+TEST_F(LuaDrawListTest, ReplayError)
+{
+  LuaDrawList list;
+  list.beginRecord(L);
+  record(list, boxOp, {1, 2, 3, 4});
+  lua_settop(L, 0);
+  lua_pushinteger(L, 1);
+  lua_pushboolean(L, 1);  // not an integer: raises an error when replayed
+  list.record(L, &boxOp);
+  lua_settop(L, 0);
+  ASSERT_TRUE(list.endRecord(L));
+
+  // The error is caught, the stack left clean
+  EXPECT_FALSE(list.replay(L));
+  EXPECT_EQ(0, lua_gettop(L));
+  list.clear(L);
+}
+
+TEST_F(LuaDrawListTest, Abort)
+{
+  LuaDrawList list;
+  list.beginRecord(L);
+  record(list, boxOp, {1, 2, 3, 4});
+  lua_settop(L, 0);
+  lua_newtable(L);  // tables are not recorded
+  list.record(L, &boxOp);
+  lua_settop(L, 0);
+  EXPECT_FALSE(list.endRecord(L));
+  EXPECT_FALSE(list.isValid());
+}
+
+TEST_F(LuaDrawListTest, BitmapArgument)
+{
+  BitmapBuffer bitmap(BMP_RGB565, 10, 20);
+  LuaDrawList list;
+  list.beginRecord(L);
+
+  // Bitmap object
+  lua_settop(L, 0);
+  *(BitmapBuffer**)lua_newuserdata(L, sizeof(BitmapBuffer*)) = &bitmap;
+  luaL_newmetatable(L, BITMAP_METATABLE);
+  lua_setmetatable(L, -2);
+  list.record(L, &bitmapOp);
+
+  // Any other userdata, or no userdata at all
+  lua_settop(L, 0);
+  *(BitmapBuffer**)lua_newuserdata(L, sizeof(BitmapBuffer*)) = &bitmap;
+  list.record(L, &bitmapOp);
+  lua_settop(L, 0);
+  lua_pushinteger(L, 1);
+  list.record(L, &bitmapOp);
+  lua_settop(L, 0);
+  ASSERT_TRUE(list.endRecord(L));
+
+  rect_t rect;
+  ASSERT_TRUE(list.bounds(0, rect));
+  EXPECT_EQ(10, rect.w);
+  EXPECT_EQ(20, rect.h);
+  EXPECT_FALSE(list.bounds(1, rect));
+  EXPECT_FALSE(list.bounds(2, rect));
+  list.clear(L);
+}
+
+TEST_F(LuaDrawListTest, Diff)
+{
+  LuaDrawList prev, next;
+  rect_t dirty[LUA_DRAW_MAX_DIRTY];
+
+  prev.beginRecord(L);
+  record(prev, boxOp, {0, 0, 10, 10, 1});
+  record(prev, boxOp, {20, 0, 10, 10, 2});
+  prev.endRecord(L);
+
+  // No previous frame: the whole widget is redrawn
+  EXPECT_EQ(-1, prev.diff(next, dirty, LUA_DRAW_MAX_DIRTY));
+
+  // Identical frame
+  next.beginRecord(L);
+  record(next, boxOp, {0, 0, 10, 10, 1});
+  record(next, boxOp, {20, 0, 10, 10, 2});
+  next.endRecord(L);
+  EXPECT_EQ(0, next.diff(prev, dirty, LUA_DRAW_MAX_DIRTY));
+
+  // A moved box: both the old and the new areas
+  next.beginRecord(L);
+  record(next, boxOp, {0, 0, 10, 10, 1});
+  record(next, boxOp, {25, 5, 10, 10, 2});
+  next.endRecord(L);
+  ASSERT_EQ(2, next.diff(prev, dirty, LUA_DRAW_MAX_DIRTY));
+  EXPECT_EQ(20, dirty[0].x);
+  EXPECT_EQ(0, dirty[0].y);
+  EXPECT_EQ(25, dirty[1].x);
+  EXPECT_EQ(5, dirty[1].y);
+
+  // A new call
+  next.beginRecord(L);
+  record(next, boxOp, {0, 0, 10, 10, 1});
+  record(next, boxOp, {20, 0, 10, 10, 2});
+  record(next, boxOp, {40, 0, 5, 5, 3});
+  next.endRecord(L);
+  ASSERT_EQ(1, next.diff(prev, dirty, LUA_DRAW_MAX_DIRTY));
+  EXPECT_EQ(40, dirty[0].x);
+
+  // A call without known bounds redraws the whole widget
+  next.beginRecord(L);
+  record(next, boxOp, {0, 0, 10, 10, 1});
+  record(next, fullOp, {20, 0, 10, 10, 3});
+  next.endRecord(L);
+  EXPECT_EQ(-1, next.diff(prev, dirty, LUA_DRAW_MAX_DIRTY));
+
+  prev.clear(L);
+  next.clear(L);
+}
+
+TEST_F(LuaDrawListTest, DiffMerge)
+{
+  LuaDrawList prev, next;
+  rect_t dirty[LUA_DRAW_MAX_DIRTY];
+
+  prev.beginRecord(L);
+  next.beginRecord(L);
+  for (int i = 0; i < LUA_DRAW_MAX_DIRTY + 2; i++) {
+    record(prev, boxOp, {i * 10, 0, 5, 5, 0});
+    record(next, boxOp, {i * 10, 0, 5, 5, 1});
+  }
+  prev.endRecord(L);
+  next.endRecord(L);
+
+  // The areas above the maximum are merged into the last one
+  ASSERT_EQ(LUA_DRAW_MAX_DIRTY, next.diff(prev, dirty, LUA_DRAW_MAX_DIRTY));
+  const rect_t& last = dirty[LUA_DRAW_MAX_DIRTY - 1];
+  EXPECT_EQ((LUA_DRAW_MAX_DIRTY / 2 - 1) * 10, last.x);
+  EXPECT_EQ((LUA_DRAW_MAX_DIRTY + 1) * 10 + 5, last.right());
+
+  prev.clear(L);
+  next.clear(L);
+}
+
+#endif
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include "gtests.h"
+#include "mixer_scheduler.h"
+
+// Runs the scheduler for 'duration' us, as the scheduler timer would,
+// and records when each module is sent
+struct SchedulerRun {
+  std::vector<uint32_t> sent[NUM_MODULES];
+  uint32_t triggers = 0;
+
+  void run(uint32_t start, uint32_t duration)
+  {
+    uint32_t now = start;
+    while (now - start < duration) {
+      uint16_t delay = mixerSchedulerNextTrigger(now);
+      uint8_t modules = mixerSchedulerGetDueModules();
+      for (uint8_t i = 0; i < NUM_MODULES; i++) {
+        if (modules & (1 << i)) sent[i].push_back(now);
+      }
+      triggers++;
+      now += delay;
+    }
+  }
+
+  // Largest deviation of the intervals between frames from 'period'
+  uint32_t maxIntervalError(uint8_t module, uint16_t period) const
+  {
+    uint32_t error = 0;
+    for (size_t i = 2; i < sent[module].size(); i++) {
+      int32_t interval = sent[module][i] - sent[module][i - 1];
+      error = max<uint32_t>(error, abs(interval - period));
+    }
+    return error;
+  }
+};
+
+class MixerSchedulerTest : public testing::Test
+{
+ protected:
+  void SetUp() override { mixerSchedulerInit(); }
+};
+
+TEST_F(MixerSchedulerTest, defaultPeriod)
+{
+  SchedulerRun run;
+  run.run(1000, 100000);
+
+  // No module scheduled: both are sent on each trigger
+  EXPECT_EQ(run.triggers, 100000 / MIXER_SCHEDULER_DEFAULT_PERIOD_US);
+  EXPECT_EQ(run.sent[INTERNAL_MODULE].size(), run.triggers);
+  EXPECT_EQ(run.sent[EXTERNAL_MODULE].size(), run.triggers);
+}
+
+TEST_F(MixerSchedulerTest, modulesKeepTheirOwnPeriod)
+{
+  mixerSchedulerSetPeriod(INTERNAL_MODULE, 4000);
+  mixerSchedulerSetPeriod(EXTERNAL_MODULE, 7000);
+
+  SchedulerRun run;
+  run.run(12345, 1000000);
+
+  EXPECT_NEAR(run.sent[INTERNAL_MODULE].size(), 1000000 / 4000, 1);
+  EXPECT_NEAR(run.sent[EXTERNAL_MODULE].size(), 1000000 / 7000, 1);
+
+  // Each module is sent on its own slots, at most shifted by the margin
+  // when both slots are served by the same mixer run
+  EXPECT_LE(run.maxIntervalError(INTERNAL_MODULE, 4000),
+            MIXER_SCHEDULER_SLOT_MARGIN_US);
+  EXPECT_LE(run.maxIntervalError(EXTERNAL_MODULE, 7000),
+            MIXER_SCHEDULER_SLOT_MARGIN_US);
+
+  // The mixer only runs when a module needs a frame
+  EXPECT_LE(run.triggers,
+            run.sent[INTERNAL_MODULE].size() + run.sent[EXTERNAL_MODULE].size());
+}
+
+TEST_F(MixerSchedulerTest, unscheduledModuleFollowsTheMixer)
+{
+  mixerSchedulerSetPeriod(EXTERNAL_MODULE, 2000);
+
+  SchedulerRun run;
+  run.run(0, 100000);
+
+  EXPECT_EQ(run.sent[EXTERNAL_MODULE].size(), 100000u / 2000);
+  EXPECT_EQ(run.sent[INTERNAL_MODULE].size(), run.triggers);
+  EXPECT_EQ(run.maxIntervalError(EXTERNAL_MODULE, 2000), 0u);
+}
+
+TEST_F(MixerSchedulerTest, periodChange)
+{
+  mixerSchedulerSetPeriod(EXTERNAL_MODULE, 20000);
+  SchedulerRun run;
+  run.run(0, 100000);
+
+  // A shorter period is applied from the next trigger
+  mixerSchedulerSetPeriod(EXTERNAL_MODULE, 4000);
+  SchedulerRun run2;
+  run2.run(100000 + 2000, 100000);
+  ASSERT_GE(run2.sent[EXTERNAL_MODULE].size(), 2u);
+  EXPECT_LE(run2.sent[EXTERNAL_MODULE][1] - run2.sent[EXTERNAL_MODULE][0],
+            4000u + MIXER_SCHEDULER_SLOT_MARGIN_US);
+  EXPECT_EQ(run2.maxIntervalError(EXTERNAL_MODULE, 4000), 0u);
+}
+
+TEST_F(MixerSchedulerTest, heartbeat)
+{
+  // Heartbeat module: the period is only a timeout
+  mixerSchedulerSetPeriod(INTERNAL_MODULE, 10000);
+  mixerSchedulerNextTrigger(0);
+  EXPECT_TRUE(mixerSchedulerGetDueModules() & (1 << INTERNAL_MODULE));
+
+  mixerSchedulerHeartbeat(INTERNAL_MODULE);
+  EXPECT_EQ(mixerSchedulerNextTrigger(3000), 10000);
+  EXPECT_TRUE(mixerSchedulerGetDueModules() & (1 << INTERNAL_MODULE));
+
+  // Nothing new until the next heartbeat or timeout
+  EXPECT_EQ(mixerSchedulerNextTrigger(5000), 8000);
+  EXPECT_FALSE(mixerSchedulerGetDueModules() & (1 << INTERNAL_MODULE));
+}
+
+TEST_F(MixerSchedulerTest, moduleLatency)
+{
+  ModuleLatency latency;
+  latency.reset();
+  latency.update(800);
+  EXPECT_EQ(latency.average(), 800);
+  for (int i = 0; i < 200; i++) latency.update(400);
+  latency.update(1200);
+
+  EXPECT_EQ(latency.last, 1200);
+  EXPECT_EQ(latency.lowest, 400);
+  EXPECT_EQ(latency.highest, 1200);
+  EXPECT_NEAR(latency.average(), 450, 5);
+  EXPECT_EQ(latency.frames, 202u);
+}
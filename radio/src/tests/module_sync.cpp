@@ -0,0 +1,185 @@
+/*
+ * Copyright (C) EdgeTX
+ *
+ * Based on code named
+ *   opentx - https://github.com/opentx/opentx
+ *   th9x - http://code.google.com/p/th9x
+ *   er9x - http://code.google.com/p/er9x
+ *   gruvin9x - http://code.google.com/p/gruvin9x
+ *
+ * License GPLv2: http://www.gnu.org/licenses/gpl-2.0.html
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License version 2 as
+ * published by the Free Software Foundation.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ */
+
+
+#include <math.h>
+
+#include "gtests.h"
+#include "mixer_scheduler.h"
+#include "telemetry/telemetry.h"
+
+// Frame clock of an RF module, running 'ppm' faster or slower than ours
+struct SimuModuleClock {
+  double period;
+  double phase;
+
+  SimuModuleClock(uint16_t rate, double ppm, double phase) :
+      period(rate * (1.0 - ppm / 1e6)), phase(phase)
+  {
+  }
+
+  // Lag of a frame sent at 't' (positive if the frame is early), in us
+  double lagAt(double t) const
+  {
+    double k = round((t - phase) / period);
+    return phase + k * period - t;
+  }
+};
+
+struct SyncResult {
+  int lockReport = -1;    // report on which the loop locked
+  int slipsAfterLock = 0;
+  double maxLagAfterLock = 0;
+  int32_t periodOffset = 0;
+};
+
+static SyncResult simulateSync(ModuleSyncStatus& status, uint16_t rate,
+                               double ppm, int framesPerReport, int reports)
+{
+  SimuModuleClock module(rate, ppm, rate * 0.37);
+  SyncResult result;
+  double t = 0;
+
+  for (int r = 0; r < reports; r++) {
+    double lag = module.lagAt(t);
+    status.update(rate, (int16_t)lround(lag));
+
+    if (result.lockReport < 0) {
+      if (status.isLocked()) result.lockReport = r;
+    } else {
+      result.maxLagAfterLock = max(result.maxLagAfterLock, fabs(lag));
+      if (fabs(lag) > rate / 2) result.slipsAfterLock++;
+    }
+
+    for (int f = 0; f < framesPerReport; f++) {
+      mixerSchedulerSetPeriod(EXTERNAL_MODULE, status.getAdjustedRefreshRate());
+      t += mixerSchedulerGetPeriod(EXTERNAL_MODULE);
+    }
+  }
+
+  result.periodOffset = status.periodOffset;
+  return result;
+}
+
+class ModuleSyncTest : public testing::Test
+{
+ protected:
+  void SetUp() override
+  {
+    g_tmr10ms = 1000;
+    mixerSchedulerInit();
+  }
+};
+
+TEST_F(ModuleSyncTest, locksOnFastModule)
+{
+  ModuleSyncStatus status;
+  auto result = simulateSync(status, 2000, 200, 10, 100);
+
+  EXPECT_TRUE(status.isValid());
+  EXPECT_TRUE(status.isLocked());
+  EXPECT_GE(result.lockReport, 0);
+  EXPECT_LE(result.lockReport, 16);
+  EXPECT_EQ(result.slipsAfterLock, 0);
+  EXPECT_LE(result.maxLagAfterLock, 2000 / 64);
+
+  // The period offset tracks the frequency difference: -0.4us per frame
+  EXPECT_NEAR(result.periodOffset / 256.0, -0.4, 0.1);
+  EXPECT_NE(status.lockTime, (tmr10ms_t)0);
+}
+
+TEST_F(ModuleSyncTest, locksOnSlowModule)
+{
+  ModuleSyncStatus status;
+  auto result = simulateSync(status, 4000, -500, 5, 100);
+
+  EXPECT_TRUE(status.isLocked());
+  EXPECT_GE(result.lockReport, 0);
+  EXPECT_LE(result.lockReport, 16);
+  EXPECT_EQ(result.slipsAfterLock, 0);
+  EXPECT_LE(result.maxLagAfterLock, 4000 / 64);
+  EXPECT_NEAR(result.periodOffset / 256.0, 2.0, 0.2);
+}
+
+TEST_F(ModuleSyncTest, relocksOnRateChange)
+{
+  ModuleSyncStatus status;
+  simulateSync(status, 4000, 100, 5, 50);
+  ASSERT_TRUE(status.isLocked());
+
+  // New packet rate: the loop restarts from scratch once the scheduler takes
+  // the report
+  status.update(2000, 500);
+  EXPECT_FALSE(status.isLocked());
+  EXPECT_EQ(status.reports, 1);
+  EXPECT_NE(status.periodOffset, 0);
+  status.getAdjustedRefreshRate();
+  EXPECT_EQ(status.periodOffset, 0);
+  EXPECT_EQ(status.loopRate, 2000);
+
+  auto result = simulateSync(status, 2000, 100, 10, 100);
+  EXPECT_TRUE(status.isLocked());
+  EXPECT_LE(result.lockReport, 16);
+}
+
+TEST_F(ModuleSyncTest, expiresWithoutReports)
+{
+  ModuleSyncStatus status;
+  simulateSync(status, 2000, 0, 10, 20);
+  ASSERT_TRUE(status.isLocked());
+
+  g_tmr10ms += 250;
+  EXPECT_FALSE(status.isValid());
+  EXPECT_FALSE(status.isLocked());
+
+  // Counters are kept until reset
+  status.maxLag = 100;
+  status.slips = 2;
+  status.resetStats();
+  EXPECT_EQ(status.maxLag, 0);
+  EXPECT_EQ(status.slips, 0);
+}
+
+TEST_F(ModuleSyncTest, reportIsTakenOnce)
+{
+  ModuleSyncStatus status;
+  simulateSync(status, 4000, 0, 5, 20);
+  ASSERT_TRUE(status.isLocked());
+
+  // A report is only applied by the scheduler, on its next frame
+  int32_t periodOffset = status.periodOffset;
+  status.update(4000, 800);
+  EXPECT_NE(status.pendingReport.load(), 0u);
+  EXPECT_EQ(status.periodOffset, periodOffset);
+
+  EXPECT_GT(status.getAdjustedRefreshRate(), 4000);
+  EXPECT_EQ(status.pendingReport.load(), 0u);
+  EXPECT_GT(status.periodOffset, periodOffset);
+
+  // and only once: the correction is spread over the next frames, then the
+  // period offset alone is left
+  periodOffset = status.periodOffset;
+  for (int f = 0; f < 20; f++) {
+    status.getAdjustedRefreshRate();
+  }
+  EXPECT_EQ(status.phaseCorrection, 0);
+  EXPECT_EQ(status.periodOffset, periodOffset);
+}
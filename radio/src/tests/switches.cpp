@@ -470,3 +470,65 @@ TEST(FunctionSwitches, holdIsNotRepeatedToggle)
   }
 }
 #endif
+
+TEST(SwitchesPosition, changes)
+{
+  SYSTEM_RESET();
+  RADIO_RESET();
+  MODEL_RESET();
+
+  int sw;
+  for (sw = 0; sw < switchGetMaxAllSwitches(); sw += 1)
+    if (g_model.getSwitchType(sw) == SWITCH_3POS)
+      break;
+  int swPos = (sw * 3) + SWSRC_FIRST_SWITCH;
+  uint64_t swBit = (uint64_t)1 << (sw * 3);
+
+  simuSetSwitch(sw, -1);
+  getSwitchesPosition(true);
+  EXPECT_TRUE(getSwitch(swPos, GETSWITCH_MIDPOS_DELAY));
+
+  simuSetSwitch(sw, 1);
+  getSwitchesPosition(false);
+  EXPECT_TRUE(getSwitch(swPos + 2, GETSWITCH_MIDPOS_DELAY));
+  EXPECT_EQ(getSwitchesPositionChanges(), swBit | (swBit << 2));
+
+  getSwitchesPosition(false);
+  EXPECT_TRUE(getSwitch(swPos + 2, GETSWITCH_MIDPOS_DELAY));
+  EXPECT_EQ(getSwitchesPositionChanges(), (uint64_t)0);
+
+  // mid position is only reported after the delay
+  g_eeGeneral.switchesDelay = 0;
+  simuSetSwitch(sw, 0);
+  getSwitchesPosition(false);
+  EXPECT_TRUE(getSwitch(swPos + 2, GETSWITCH_MIDPOS_DELAY));
+  EXPECT_EQ(getSwitchesPositionChanges(), (uint64_t)0);
+
+  g_tmr10ms += SWITCHES_DELAY() + 1;
+  getSwitchesPosition(false);
+  EXPECT_TRUE(getSwitch(swPos + 1, GETSWITCH_MIDPOS_DELAY));
+  EXPECT_EQ(getSwitchesPositionChanges(), (swBit << 1) | (swBit << 2));
+
+  simuSetSwitch(sw, -1);
+  getSwitchesPosition(false);
+  EXPECT_TRUE(getSwitch(swPos, GETSWITCH_MIDPOS_DELAY));
+  EXPECT_EQ(getSwitchesPositionChanges(), swBit | (swBit << 1));
+}
+
+TEST(SwitchesPosition, multiposThresholds)
+{
+  if (adcGetMaxInputs(ADC_INPUT_FLEX) == 0) return;
+
+  g_eeGeneral.potsConfig = FLEX_MULTIPOS;
+  auto offset = adcGetInputOffset(ADC_INPUT_FLEX);
+  const int count = XPOTS_MULTIPOS_COUNT - 1;
+
+  for (int value = -RESX; value <= RESX; value += 7) {
+    anaSetFiltered(offset, value);
+    getSwitchesPosition(true);
+    int expected = min(anaIn(offset) / (2 * RESX / count), count);
+    EXPECT_EQ(expected, getXPotPosition(0)) << "value " << value;
+  }
+
+  g_eeGeneral.potsConfig = 0;
+}
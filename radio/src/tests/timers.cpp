@@ -201,3 +201,61 @@ TEST(Timers, timerThrottleTriggered)
   EXPECT_TRUE(evalTimersForNSecondsAndTest(10,     THR_0, 0, TMR_NEGATIVE,-11));
   EXPECT_TRUE(evalTimersForNSecondsAndTest(100,    THR_0, 0, TMR_STOPPED,-111));
 }
+
+TEST(Timers, configurationChange)
+{
+  initModelTimer(0, TMRMODE_ON, 0);
+  timerReset(0);
+  EXPECT_TRUE(evalTimersForNSecondsAndTest(10, THR_0, 0, TMR_RUNNING, 10));
+
+  // an edited timer runs on its new configuration from the next tick
+  g_model.timers[0].mode = TMRMODE_THR;
+  invalidateTimersConfig();
+  EXPECT_TRUE(evalTimersForNSecondsAndTest(10, THR_0, 0, TMR_RUNNING, 10));
+  EXPECT_TRUE(evalTimersForNSecondsAndTest(10, THR_100, 0, TMR_RUNNING, 20));
+
+  g_model.timers[0].start = 100;
+  invalidateTimersConfig();
+  EXPECT_TRUE(evalTimersForNSecondsAndTest(1, THR_100, 0, TMR_RUNNING, 19));
+
+  // so does a loaded model
+  g_model.timers[0].mode = TMRMODE_ON;
+  g_model.timers[0].start = 0;
+  restoreTimers();
+  EXPECT_TRUE(evalTimersForNSecondsAndTest(1, THR_0, 0, TMR_RUNNING, 20));
+}
+
+TEST(Timers, persistentValuesOnChange)
+{
+  initModelTimer(0, TMRMODE_ON, 0);
+  initModelTimer(1, TMRMODE_OFF, 0);
+  g_model.timers[0].persistent = 1;
+  g_model.timers[1].persistent = 1;
+  timerReset(0);
+  timerSet(1, -5);
+
+  EXPECT_TRUE(evalTimersForNSecondsAndTest(10, THR_0, 0, TMR_RUNNING, 10));
+  EXPECT_TRUE(updatePersistentTimers());
+  EXPECT_EQ(g_model.timers[0].value, 10);
+  EXPECT_EQ(g_model.timers[1].value, -5);
+
+  // only the timers configured as persistent are written
+  g_model.timers[1].persistent = 0;
+  invalidateTimersConfig();
+  timerSet(1, -7);
+  EXPECT_TRUE(evalTimersForNSecondsAndTest(0, THR_0, 0, TMR_RUNNING, 10));
+  EXPECT_FALSE(updatePersistentTimers());
+  EXPECT_EQ(g_model.timers[1].value, -5);
+
+  // unchanged values are not written again
+  EXPECT_FALSE(updatePersistentTimers());
+  storageDirtyMsk = 0;
+  saveTimers();
+  EXPECT_FALSE(storageDirtyMsk & EE_MODEL);
+
+  EXPECT_TRUE(evalTimersForNSecondsAndTest(1, THR_0, 0, TMR_RUNNING, 11));
+  saveTimers();
+  EXPECT_TRUE(storageDirtyMsk & EE_MODEL);
+  EXPECT_EQ(g_model.timers[0].value, 11);
+  storageDirtyMsk = 0;
+}
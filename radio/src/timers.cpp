@@ -33,17 +33,53 @@ volatile tmr10ms_t g_tmr10ms;
 
 TimerState timersStates[TIMERS] = { { 0 } };
 
+// Runtime form of the timers configuration, decoded from TimerData when a
+// timer is reset, when the model is loaded and after its timers are edited,
+// so that the timers never unpack the bit fields of the model on each tick
+struct TimerConfig {
+  tmrmode_t mode;
+  tmrstart_t start;
+  int16_t swtch;
+  bool countdownBeep;
+  bool minuteBeep;
+  bool showElapsed;
+  bool persistent;
+};
+
+static TimerConfig timersConfig[TIMERS];
+static bool timersConfigDirty = false;
+
+static void decodeTimerConfig(uint8_t idx)
+{
+  const TimerData & timer = g_model.timers[idx];
+  TimerConfig & config = timersConfig[idx];
+  config.mode = timer.mode;
+  config.start = timer.start;
+  config.swtch = timer.swtch;
+  config.countdownBeep = timer.countdownBeep && timer.start;
+  config.minuteBeep = timer.minuteBeep;
+  config.showElapsed = timer.showElapsed;
+  config.persistent = timer.persistent;
+}
+
+void invalidateTimersConfig()
+{
+  timersConfigDirty = true;
+}
+
 void timerReset(uint8_t idx)
 {
   TimerState & timerState = timersStates[idx];
+  decodeTimerConfig(idx);
   timerState.state = TMR_OFF; // is changed to RUNNING dep from mode
-  timerState.val = g_model.timers[idx].start;
+  timerState.val = timersConfig[idx].start;
   timerState.val_10ms = 0 ;
 }
 
 void timerSet(int idx, int val)
 {
   TimerState & timerState = timersStates[idx];
+  decodeTimerConfig(idx);
   timerState.state = TMR_OFF; // is changed to RUNNING dep from mode
   timerState.val = val;
   timerState.val_10ms = 0 ;
@@ -52,27 +88,122 @@ void timerSet(int idx, int val)
 void restoreTimers()
 {
   for (uint8_t i=0; i<TIMERS; i++) {
-    if (g_model.timers[i].persistent) {
+    decodeTimerConfig(i);
+    if (timersConfig[i].persistent) {
       timersStates[i].val = g_model.timers[i].value;
     }
   }
 }
 
-void saveTimers()
+bool updatePersistentTimers()
 {
+  bool changed = false;
   for (uint8_t i=0; i<TIMERS; i++) {
-    if (g_model.timers[i].persistent) {
-      TimerState *timerState = &timersStates[i];
-      if (g_model.timers[i].value != (uint16_t)timerState->val) {
-        g_model.timers[i].value = timerState->val;
-        storageDirty(EE_MODEL);
-      }
+    if (timersConfig[i].persistent) {
+      TimerData & timer = g_model.timers[i];
+      int32_t value = timer.value;
+      timer.value = timersStates[i].val;
+      if (timer.value != value) changed = true;
     }
   }
+  return changed;
+}
+
+void saveTimers()
+{
+  if (updatePersistentTimers()) {
+    storageDirty(EE_MODEL);
+  }
 }
 
 #define THR_TRG_TRESHOLD    13      // approximately 10% full throttle
 
+static void startTimer(TimerState * timerState)
+{
+  timerState->state = TMR_RUNNING;
+  timerState->cnt = 0;
+  timerState->sum = 0;
+}
+
+// Called once per second of a running timer
+static void updateTimer(uint8_t i, int16_t throttle)
+{
+  const TimerConfig & config = timersConfig[i];
+  TimerState * timerState = &timersStates[i];
+
+  tmrval_t newTimerVal = timerState->val;
+  if (config.start) newTimerVal = config.start - newTimerVal;
+
+  if (config.mode == TMRMODE_START) {
+    // Start timer based on switch
+    if (getSwitch(config.swtch) && timerState->state == TMR_OFF) {
+      startTimer(timerState);  // start timer running
+    }
+    if (timerState->state != TMR_OFF) {
+      newTimerVal++;
+    }
+  } else if (getSwitch(config.swtch)) {
+
+    // Modes conditional on switch at any time
+    if (config.mode == TMRMODE_ON) {
+      newTimerVal++;
+    } else if (config.mode == TMRMODE_THR) {
+      if (throttle) newTimerVal++;
+    } else if (config.mode == TMRMODE_THR_REL) {
+      // throttle was normalized to 0 to 128 value
+      // (throttle/64*2 (because - range is added as well)
+      if ((timerState->sum / timerState->cnt) >= 128) {
+        newTimerVal++;  // add second used of throttle
+        timerState->sum -= 128 * timerState->cnt;
+      }
+      timerState->cnt = 0;
+    } else if (config.mode == TMRMODE_THR_START) {
+      // we can't rely on (throttle || newTimerVal > 0) as a detection if
+      // timer should be running because having persistent timer brakes
+      // this rule
+      if ((throttle > THR_TRG_TRESHOLD) && timerState->state == TMR_OFF) {
+        startTimer(timerState);  // start timer running
+        // TRACE("Timer[%d] THr triggered", i);
+      }
+      if (timerState->state != TMR_OFF) newTimerVal++;
+    }
+  }
+
+  switch (timerState->state) {
+    case TMR_RUNNING:
+      if (config.start && newTimerVal >= (tmrval_t)config.start) {
+        AUDIO_TIMER_ELAPSED(i);
+        timerState->state = TMR_NEGATIVE;
+        // TRACE("Timer[%d] negative", i);
+      }
+      break;
+    case TMR_NEGATIVE:
+      if (newTimerVal >= (tmrval_t)config.start + MAX_ALERT_TIME) {
+        timerState->state = TMR_STOPPED;
+        // TRACE("Timer[%d] stopped state at %d", i, newTimerVal);
+      }
+      break;
+  }
+
+  // if counting backwards - display backwards
+  if (config.start) newTimerVal = config.start - newTimerVal;
+
+  if (newTimerVal != timerState->val) {
+    timerState->val = newTimerVal;
+    if (timerState->state == TMR_RUNNING) {
+      if (config.countdownBeep) {
+        AUDIO_TIMER_COUNTDOWN(i, newTimerVal);
+      }
+      tmrval_t announceVal = newTimerVal;
+      if (config.showElapsed) announceVal = config.start - newTimerVal;
+      if (config.minuteBeep && (announceVal % 60) == 0) {
+        AUDIO_TIMER_MINUTE(announceVal);
+        // TRACE("Timer[%d] %d minute announcement", i, newTimerVal/60);
+      }
+    }
+  }
+}
+
 void evalTimers(int16_t throttle, uint8_t tick10ms)
 {
 
@@ -80,21 +211,24 @@ void evalTimers(int16_t throttle, uint8_t tick10ms)
   // For surface radio throttle off position is at 0%
   throttle = 2 * abs(throttle - (RESX >> (RESX_SHIFT-6)));
 #endif
+
+  // cleared before decoding: an edit made meanwhile marks it dirty again
+  if (timersConfigDirty) {
+    timersConfigDirty = false;
+    for (uint8_t i=0; i<TIMERS; i++) {
+      decodeTimerConfig(i);
+    }
+  }
+
   for (uint8_t i=0; i<TIMERS; i++) {
-    tmrmode_t timerMode = g_model.timers[i].mode;
-    tmrstart_t timerStart = g_model.timers[i].start;
-    int16_t     timerSwtch = g_model.timers[i].swtch;
+    tmrmode_t timerMode = timersConfig[i].mode;
     TimerState * timerState = &timersStates[i];
-    uint32_t showElapsed = g_model.timers[i].showElapsed;
 
     if (timerMode) {
       if ((timerState->state == TMR_OFF)
           && (timerMode != TMRMODE_THR_START)
           && (timerMode != TMRMODE_START)) {
-       
-        timerState->state = TMR_RUNNING;
-        timerState->cnt = 0;
-        timerState->sum = 0;
+        startTimer(timerState);
       }
 
       if (timerMode == TMRMODE_THR_REL) {
@@ -107,81 +241,7 @@ void evalTimers(int16_t throttle, uint8_t tick10ms)
         if (timerState->val == TIMER_MIN) break;
 
         timerState->val_10ms -= 100;
-        tmrval_t newTimerVal = timerState->val;
-        if (timerStart) newTimerVal = timerStart - newTimerVal;
-
-        if (timerMode == TMRMODE_START) {
-          // Start timer based on switch
-          if (getSwitch(timerSwtch) && timerState->state == TMR_OFF) {
-            timerState->state = TMR_RUNNING;  // start timer running
-            timerState->cnt = 0;
-            timerState->sum = 0;
-          }
-          if (timerState->state != TMR_OFF) {
-            newTimerVal++;
-          } 
-        } else if (getSwitch(timerSwtch)) {
-
-          // Modes conditional on switch at any time
-          if (timerMode == TMRMODE_ON) {
-            newTimerVal++;
-          } else if (timerMode == TMRMODE_THR) {
-            if (throttle) newTimerVal++;
-          } else if (timerMode == TMRMODE_THR_REL) {
-            // throttle was normalized to 0 to 128 value
-            // (throttle/64*2 (because - range is added as well)
-            if ((timerState->sum / timerState->cnt) >= 128) {  
-              newTimerVal++;  // add second used of throttle
-              timerState->sum -= 128 * timerState->cnt;
-            }
-            timerState->cnt = 0;
-          } else if (timerMode == TMRMODE_THR_START) {
-            // we can't rely on (throttle || newTimerVal > 0) as a detection if
-            // timer should be running because having persistent timer brakes
-            // this rule
-            if ((throttle > THR_TRG_TRESHOLD) && timerState->state == TMR_OFF) {
-              timerState->state = TMR_RUNNING;  // start timer running
-              timerState->cnt = 0;
-              timerState->sum = 0;
-              // TRACE("Timer[%d] THr triggered", i);
-            }
-            if (timerState->state != TMR_OFF) newTimerVal++;
-          }
-        }
-
-        switch (timerState->state) {
-          case TMR_RUNNING:
-            if (timerStart && newTimerVal >= (tmrval_t)timerStart) {
-              AUDIO_TIMER_ELAPSED(i);
-              timerState->state = TMR_NEGATIVE;
-              // TRACE("Timer[%d] negative", i);
-            }
-            break;
-          case TMR_NEGATIVE:
-            if (newTimerVal >= (tmrval_t)timerStart + MAX_ALERT_TIME) {
-              timerState->state = TMR_STOPPED;
-              // TRACE("Timer[%d] stopped state at %d", i, newTimerVal);
-            }
-            break;
-        }
-
-        // if counting backwards - display backwards
-        if (timerStart) newTimerVal = timerStart - newTimerVal;
-
-        if (newTimerVal != timerState->val) {
-          timerState->val = newTimerVal;
-          if (timerState->state == TMR_RUNNING) {
-            if (g_model.timers[i].countdownBeep && g_model.timers[i].start) {
-              AUDIO_TIMER_COUNTDOWN(i, newTimerVal);
-            }
-            tmrval_t announceVal = newTimerVal;
-            if (showElapsed) announceVal = timerStart - newTimerVal;
-            if (g_model.timers[i].minuteBeep && (announceVal % 60) == 0) {
-              AUDIO_TIMER_MINUTE(announceVal);
-              // TRACE("Timer[%d] %d minute announcement", i, newTimerVal/60);
-            }
-          }
-        }
+        updateTimer(i, throttle);
       }
     }
   }
@@ -51,6 +51,12 @@ void timerReset(uint8_t idx);
 
 void timerSet(int idx, int val);
 
+// To be called once the timers of the model have been edited
+void invalidateTimersConfig();
+
+// Copy the persistent timer values to the model, returns true if they changed
+bool updatePersistentTimers();
+
 void saveTimers();
 void restoreTimers();
 
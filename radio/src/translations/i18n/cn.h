@@ -538,6 +538,7 @@
 #define TR_STRENGTH                    "强度"
 #define TR_IMU_LABEL                   "IMU"
 #define TR_IMU_OFFSET                  "补偿"
+#define TR_IMU_GYRO_INVERTED           "Gyro inv:"
 #define TR_IMU_MAX                     "最大值"
 #define TR_CONTRAST                    "对比度"
 #define TR_ALARMS_LABEL                "警告"
@@ -621,6 +622,10 @@
 #define TR_MEM_USED_SCRIPT             "脚本(B): "
 #define TR_MEM_USED_WIDGET             "小部件(B): "
 #define TR_MEM_USED_EXTRA              "附加(B): "
+#define TR_LUA_GC                      "GC "
+#define TR_LUA_GC_US                   "GC(us): "
+#define TR_LUA_MAX_US                  "Max(us): "
+#define TR_LUA_OVERRUNS                "Ovr: "
 #define TR_STACK_MIX                   "混控: "
 #define TR_STACK_AUDIO                 "音频: "
 #define TR_GPS_FIX_YES                 "修正: 是"
@@ -676,6 +681,7 @@
 #define TR_MULTI_TELEMETRY             "回传"
 #define TR_MULTI_VIDFREQ               TR("图传频率", "图传频率")
 #define TR_RF_POWER                    "发射功率"
+#define TR_RF_LATENCY                  TR("RF lat.", "RF latency")
 #define TR_MULTI_FIXEDID               TR("固定ID", "固定ID")
 #define TR_MULTI_OPTION                TR("选项值", "选项值")
 #define TR_MULTI_AUTOBIND              TR("对频通道", "通道控制对频")
@@ -1402,6 +1408,8 @@
 #define TR_SIGNAL_OUTPUT          "信号强度输出"
 #define TR_SERIAL_BUS             "串行总线"
 #define TR_SYNC                   "同步"
+#define TR_SYNC_SLIPS             "slips"
+#define TR_SYNC_UNLOCKED          "unlocked"
 
 #define TR_ENABLED_FEATURES       "启用的功能"
 #define TR_RADIO_MENU_TABS        "系统功能选项卡"
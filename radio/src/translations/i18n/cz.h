@@ -540,6 +540,7 @@
 #define TR_STRENGTH                    "Intenzita"
 #define TR_IMU_LABEL                   "IMU"
 #define TR_IMU_OFFSET                  "Offset"
+#define TR_IMU_GYRO_INVERTED           "Gyro inv:"
 #define TR_IMU_MAX                     "Max"
 #define TR_CONTRAST                    "Kontrast LCD"
 #define TR_ALARMS_LABEL                "Alarmy"
@@ -625,6 +626,10 @@
 #define TR_MEM_USED_SCRIPT         "Script(B): "
 #define TR_MEM_USED_WIDGET         "Widget(B): "
 #define TR_MEM_USED_EXTRA          "Extra(B): "
+#define TR_LUA_GC                      "GC "
+#define TR_LUA_GC_US                   "GC(us): "
+#define TR_LUA_MAX_US                  "Max(us): "
+#define TR_LUA_OVERRUNS                "Ovr: "
 #define TR_STACK_MIX                   "Mix: "
 #define TR_STACK_AUDIO                 "Audio: "
 #define TR_GPS_FIX_YES                 "Fix: Yes"
@@ -681,6 +686,7 @@
 #define TR_MULTI_TELEMETRY             "Telemetrie"
 #define TR_MULTI_VIDFREQ               TR("Freq. videa", "Frekvence videa")
 #define TR_RF_POWER                    "Výkon RF"
+#define TR_RF_LATENCY                  TR("RF lat.", "RF latency")
 #define TR_MULTI_FIXEDID               TR("PevnéID", "Pevné ID")
 #define TR_MULTI_OPTION                TR("Možnosti", "Hodnota")
 #define TR_MULTI_AUTOBIND              TR("Bind Ch.","Bind při zapnutí")
@@ -1404,6 +1410,8 @@
 #define TR_SIGNAL_OUTPUT               "Signal výstup"
 #define TR_SERIAL_BUS                  "Serial BUS"
 #define TR_SYNC                        "Synchronizovat"
+#define TR_SYNC_SLIPS                  "slips"
+#define TR_SYNC_UNLOCKED               "unlocked"
 
 #define TR_ENABLED_FEATURES            "Aktivní funkce"
 #define TR_RADIO_MENU_TABS             "Rádiové menu záložky"
@@ -543,6 +543,7 @@
 #define TR_STRENGTH                    "Styrke"
 #define TR_IMU_LABEL                   "IMU"
 #define TR_IMU_OFFSET                  "Offset"
+#define TR_IMU_GYRO_INVERTED           "Gyro inv:"
 #define TR_IMU_MAX                     "Max"
 #define TR_CONTRAST                    "Kontrast"
 #define TR_ALARMS_LABEL                "Alarmer"
@@ -626,6 +627,10 @@
 #define TR_MEM_USED_SCRIPT             "Script(B): "
 #define TR_MEM_USED_WIDGET             "Widget(B): "
 #define TR_MEM_USED_EXTRA              "Extra(B): "
+#define TR_LUA_GC                      "GC "
+#define TR_LUA_GC_US                   "GC(us): "
+#define TR_LUA_MAX_US                  "Max(us): "
+#define TR_LUA_OVERRUNS                "Ovr: "
 #define TR_STACK_MIX                   "Mix: "
 #define TR_STACK_AUDIO                 "Audio: "
 #define TR_GPS_FIX_YES                 "Fix: Ja"
@@ -681,6 +686,7 @@
 #define TR_MULTI_TELEMETRY             "Telemetri"
 #define TR_MULTI_VIDFREQ               TR("Vid. frekv.", "Video frekvens")
 #define TR_RF_POWER                    "RF Strøm"
+#define TR_RF_LATENCY                  TR("RF lat.", "RF latency")
 #define TR_MULTI_FIXEDID               TR("LåstID", "Låst ID")
 #define TR_MULTI_OPTION                TR("Tilvalg", "Tilvalg værdi")
 #define TR_MULTI_AUTOBIND              TR("Tilslut ka.", "Tilslut kanal")
@@ -1409,6 +1415,8 @@
 #define TR_SIGNAL_OUTPUT               "Signal uddata"
 #define TR_SERIAL_BUS                  "Seriel bus"
 #define TR_SYNC                        "Synk"
+#define TR_SYNC_SLIPS                  "slips"
+#define TR_SYNC_UNLOCKED               "unlocked"
 
 #define TR_ENABLED_FEATURES            "Aktiverede funktioner"
 #define TR_RADIO_MENU_TABS             "Radio menu"
@@ -539,6 +539,7 @@
 #define TR_STRENGTH                    "Stärke"
 #define TR_IMU_LABEL                   "IMU"
 #define TR_IMU_OFFSET                  "Offset"
+#define TR_IMU_GYRO_INVERTED           "Gyro inv:"
 #define TR_IMU_MAX                     "Max"
 #define TR_CONTRAST                    "LCD-Kontrast"
 #define TR_ALARMS_LABEL                "Alarme"
@@ -622,6 +623,10 @@
 #define TR_MEM_USED_SCRIPT             "Skript(B): "
 #define TR_MEM_USED_WIDGET             "Widget(B): "
 #define TR_MEM_USED_EXTRA              "Extra(B): "
+#define TR_LUA_GC                      "GC "
+#define TR_LUA_GC_US                   "GC(us): "
+#define TR_LUA_MAX_US                  "Max(us): "
+#define TR_LUA_OVERRUNS                "Ovr: "
 #define TR_STACK_MIX                   "Mix: "
 #define TR_STACK_AUDIO                 "Audio: "
 #define TR_GPS_FIX_YES                 "Fix: Ja"
@@ -676,6 +681,7 @@
 #define TR_MULTI_TELEMETRY             "Telemetrie"
 #define TR_MULTI_VIDFREQ               TR("Vid. Freq.", "Video Frequenz")
 #define TR_RF_POWER                    "RF Leistung"
+#define TR_RF_LATENCY                  TR("RF lat.", "RF latency")
 #define TR_MULTI_FIXEDID               TR("FesteID", "Feste ID")
 #define TR_MULTI_OPTION                TR("Option", "Optionswert")
 #define TR_MULTI_AUTOBIND              TR("Bind Ka.","Bindung an Kanal")
@@ -1400,6 +1406,8 @@
 #define TR_SIGNAL_OUTPUT               "Signal Ausgang"
 #define TR_SERIAL_BUS                  "Serialbus"
 #define TR_SYNC                        "Sync"
+#define TR_SYNC_SLIPS                  "slips"
+#define TR_SYNC_UNLOCKED               "unlocked"
 
 #define TR_ENABLED_FEATURES            "Menüpunkte"
 #define TR_RADIO_MENU_TABS             "Sender-Menüpunkte"
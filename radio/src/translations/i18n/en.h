@@ -539,6 +539,7 @@
 #define TR_STRENGTH                    "Strength"
 #define TR_IMU_LABEL                   "IMU"
 #define TR_IMU_OFFSET                  "Offset"
+#define TR_IMU_GYRO_INVERTED           "Gyro inv:"
 #define TR_IMU_MAX                     "Max"
 #define TR_CONTRAST                    "Contrast"
 #define TR_ALARMS_LABEL                "Alarms"
@@ -622,6 +623,10 @@
 #define TR_MEM_USED_SCRIPT         "Script(B): "
 #define TR_MEM_USED_WIDGET         "Widget(B): "
 #define TR_MEM_USED_EXTRA          "Extra(B): "
+#define TR_LUA_GC                      "GC "
+#define TR_LUA_GC_US                   "GC(us): "
+#define TR_LUA_MAX_US                  "Max(us): "
+#define TR_LUA_OVERRUNS                "Ovr: "
 #define TR_STACK_MIX                   "Mix: "
 #define TR_STACK_AUDIO                 "Audio: "
 #define TR_GPS_FIX_YES                 "Fix: Yes"
@@ -677,6 +682,7 @@
 #define TR_MULTI_TELEMETRY             "Telemetry"
 #define TR_MULTI_VIDFREQ               TR("Vid. freq.", "Video frequency")
 #define TR_RF_POWER                    "RF Power"
+#define TR_RF_LATENCY                  TR("RF lat.", "RF latency")
 #define TR_MULTI_FIXEDID               TR("FixedID", "Fixed ID")
 #define TR_MULTI_OPTION                TR("Option", "Option value")
 #define TR_MULTI_AUTOBIND              TR("Bind Ch.", "Bind on channel")
@@ -1401,6 +1407,8 @@
 #define TR_SIGNAL_OUTPUT          "Signal output"
 #define TR_SERIAL_BUS             "Serial bus"
 #define TR_SYNC                   "Sync"
+#define TR_SYNC_SLIPS             "slips"
+#define TR_SYNC_UNLOCKED          "unlocked"
 
 #define TR_ENABLED_FEATURES       "Enabled Features"
 #define TR_RADIO_MENU_TABS        "Radio Menu"
@@ -541,6 +541,7 @@
 #define TR_STRENGTH                    "Force"
 #define TR_IMU_LABEL                   "IMU"
 #define TR_IMU_OFFSET                  "Décalage"
+#define TR_IMU_GYRO_INVERTED           "Gyro inv:"
 #define TR_IMU_MAX                     "Max"
 #define TR_CONTRAST                    "Contraste"
 #define TR_ALARMS_LABEL                "Alarmes"
@@ -626,6 +627,10 @@
 #define TR_MEM_USED_SCRIPT             "Script(B): "
 #define TR_MEM_USED_WIDGET             "Widget(B): "
 #define TR_MEM_USED_EXTRA              "Extra(B): "
+#define TR_LUA_GC                      "GC "
+#define TR_LUA_GC_US                   "GC(us): "
+#define TR_LUA_MAX_US                  "Max(us): "
+#define TR_LUA_OVERRUNS                "Ovr: "
 #define TR_STACK_MIX                   "Mixeurs: "
 #define TR_STACK_AUDIO                 "Audio: "
 #define TR_GPS_FIX_YES                 "Fix: Oui"
@@ -681,6 +686,7 @@
 #define TR_MULTI_TELEMETRY             "Télémétrie"
 #define TR_MULTI_VIDFREQ               TR("Fréq. vidéo", "Fréquence vidéo")
 #define TR_RF_POWER                     TR("Puiss. RF", "Puissance RF")
+#define TR_RF_LATENCY                   TR("RF lat.", "RF latency")
 #define TR_MULTI_FIXEDID               "ID fixe"
 #define TR_MULTI_OPTION                TR("Option", "Option perso")
 #define TR_MULTI_AUTOBIND              TR("Bind voie", "Bind sur voie")
@@ -1406,6 +1412,8 @@
 #define TR_SIGNAL_OUTPUT          "Sortie Signal"
 #define TR_SERIAL_BUS             "Serial bus"
 #define TR_SYNC                   "Sync"
+#define TR_SYNC_SLIPS             "slips"
+#define TR_SYNC_UNLOCKED          "unlocked"
 
 #define TR_ENABLED_FEATURES       TR("Fonctions activées", "Fonctionnalités activées")
 #define TR_RADIO_MENU_TABS        "Onglets Menu Radio"
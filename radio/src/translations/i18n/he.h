@@ -542,6 +542,7 @@
 #define TR_STRENGTH                    "חוזק"
 #define TR_IMU_LABEL                   "IMU"
 #define TR_IMU_OFFSET                  "Offset"
+#define TR_IMU_GYRO_INVERTED           "Gyro inv:"
 #define TR_IMU_MAX                     "מקס"
 #define TR_CONTRAST                    "ניגודיות"
 #define TR_ALARMS_LABEL                "התראות"
@@ -625,6 +626,10 @@
 #define TR_MEM_USED_SCRIPT             "Script(B): "
 #define TR_MEM_USED_WIDGET             "Widget(B): "
 #define TR_MEM_USED_EXTRA              "Extra(B): "
+#define TR_LUA_GC                      "GC "
+#define TR_LUA_GC_US                   "GC(us): "
+#define TR_LUA_MAX_US                  "Max(us): "
+#define TR_LUA_OVERRUNS                "Ovr: "
 #define TR_STACK_MIX                   "Mix: "
 #define TR_STACK_AUDIO                 "Audio: "
 #define TR_GPS_FIX_YES                 "Fix: Yes"
@@ -679,6 +684,7 @@
 #define TR_MULTI_TELEMETRY             "טלמטריה"
 #define TR_MULTI_VIDFREQ               TR("Vid. freq.", "Video frequency")
 #define TR_RF_POWER                    "עוצמת שידור"
+#define TR_RF_LATENCY                  TR("RF lat.", "RF latency")
 #define TR_MULTI_FIXEDID               TR("FixedID", "Fixed ID")
 #define TR_MULTI_OPTION                TR("Option", "Option value")
 #define TR_MULTI_AUTOBIND              TR("Bind Ch.", "צימוד על ערוץ")
@@ -1403,6 +1409,8 @@
 #define TR_SIGNAL_OUTPUT          "יציאת סיגנל"
 #define TR_SERIAL_BUS             "ערוץ טורי"
 #define TR_SYNC                   "סינכרון"
+#define TR_SYNC_SLIPS             "slips"
+#define TR_SYNC_UNLOCKED          "unlocked"
 
 #define TR_ENABLED_FEATURES       "אפשר יכולות"
 #define TR_RADIO_MENU_TABS        "לשוניות תפריט רדיו"
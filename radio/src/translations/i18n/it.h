@@ -539,6 +539,7 @@
 #define TR_STRENGTH                     "Forza"
 #define TR_IMU_LABEL                    "IMU"
 #define TR_IMU_OFFSET                   "Offset"
+#define TR_IMU_GYRO_INVERTED           "Gyro inv:"
 #define TR_IMU_MAX                      "Max"
 #define TR_CONTRAST                     "Contrasto"
 #define TR_ALARMS_LABEL                 "Allarmi"
@@ -622,6 +623,10 @@
 #define TR_MEM_USED_SCRIPT              "Script(B): "
 #define TR_MEM_USED_WIDGET              "Widget(B): "
 #define TR_MEM_USED_EXTRA               "Extra(B): "
+#define TR_LUA_GC                      "GC "
+#define TR_LUA_GC_US                   "GC(us): "
+#define TR_LUA_MAX_US                  "Max(us): "
+#define TR_LUA_OVERRUNS                "Ovr: "
 #define TR_STACK_MIX                    "Mix: "
 #define TR_STACK_AUDIO                  "Audio: "
 #define TR_GPS_FIX_YES                  "Fix: Sì"
@@ -676,6 +681,7 @@
 #define TR_MULTI_TELEMETRY              "Telemetria"
 #define TR_MULTI_VIDFREQ                TR("Freq. video", "Frequenza video")
 #define TR_RF_POWER                     "Potenza RF"
+#define TR_RF_LATENCY                   TR("RF lat.", "RF latency")
 #define TR_MULTI_FIXEDID                TR("ID fisso", "ID Fisso")
 #define TR_MULTI_OPTION                 TR("Opzione", "Opzione valore")
 #define TR_MULTI_AUTOBIND               TR("Ass. Ch.","Associa al canale")
@@ -1400,6 +1406,8 @@
 #define TR_SIGNAL_OUTPUT               "Segnale d'uscita"
 #define TR_SERIAL_BUS                  "Bus seriale"
 #define TR_SYNC                        "Sincronismo"
+#define TR_SYNC_SLIPS                  "slips"
+#define TR_SYNC_UNLOCKED               "unlocked"
 
 #define TR_ENABLED_FEATURES            "Funzionalità abilitate"
 #define TR_RADIO_MENU_TABS             "Schede del Menu Radio"
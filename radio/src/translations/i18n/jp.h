@@ -538,6 +538,7 @@
 #define TR_STRENGTH                    "強さ"
 #define TR_IMU_LABEL                   "IMU"
 #define TR_IMU_OFFSET                  "オフセット"
+#define TR_IMU_GYRO_INVERTED           "Gyro inv:"
 #define TR_IMU_MAX                     "最大"
 #define TR_CONTRAST                    "コントラスト"
 #define TR_ALARMS_LABEL                "アラーム"
@@ -621,6 +622,10 @@
 #define TR_MEM_USED_SCRIPT             "Script(B): "
 #define TR_MEM_USED_WIDGET             "Widget(B): "
 #define TR_MEM_USED_EXTRA              "Extra(B): "
+#define TR_LUA_GC                      "GC "
+#define TR_LUA_GC_US                   "GC(us): "
+#define TR_LUA_MAX_US                  "Max(us): "
+#define TR_LUA_OVERRUNS                "Ovr: "
 #define TR_STACK_MIX                   "Mix: "
 #define TR_STACK_AUDIO                 "Audio: "
 #define TR_GPS_FIX_YES                 "Fix: Yes"
@@ -675,6 +680,7 @@
 #define TR_MULTI_TELEMETRY             "テレメトリー"
 #define TR_MULTI_VIDFREQ               TR("Vid. freq.", "VTX周波数")
 #define TR_RF_POWER                    "送信出力"
+#define TR_RF_LATENCY                  TR("RF lat.", "RF latency")
 #define TR_MULTI_FIXEDID               TR("FixedID", "固定ID")
 #define TR_MULTI_OPTION                TR("Option", "オプション値")
 #define TR_MULTI_AUTOBIND              TR("Bind Ch.", "チャンネルバインド")
@@ -1399,6 +1405,8 @@
 #define TR_SIGNAL_OUTPUT          "シグナル出力"
 #define TR_SERIAL_BUS             "シリアルバス"
 #define TR_SYNC                   "同期"
+#define TR_SYNC_SLIPS             "slips"
+#define TR_SYNC_UNLOCKED          "unlocked"
 
 #define TR_ENABLED_FEATURES       "有効機能"
 #define TR_RADIO_MENU_TABS        "送信機メニュータブ"
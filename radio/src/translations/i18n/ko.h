@@ -544,6 +544,7 @@
 #define TR_STRENGTH                       "세기"
 #define TR_IMU_LABEL                      "IMU"
 #define TR_IMU_OFFSET                     "오프셋"
+#define TR_IMU_GYRO_INVERTED           "Gyro inv:"
 #define TR_IMU_MAX                        "최대"
 #define TR_CONTRAST                       "명암"
 #define TR_ALARMS_LABEL                   "알람"
@@ -637,6 +638,10 @@
 #define TR_MEM_USED_SCRIPT            "스크립트(B): "
 #define TR_MEM_USED_WIDGET            "위젯(B): "
 #define TR_MEM_USED_EXTRA             "추가(B): "
+#define TR_LUA_GC                      "GC "
+#define TR_LUA_GC_US                   "GC(us): "
+#define TR_LUA_MAX_US                  "Max(us): "
+#define TR_LUA_OVERRUNS                "Ovr: "
 #define TR_STACK_MIX                  "믹스: "
 #define TR_STACK_AUDIO                "오디오: "
 #define TR_GPS_FIX_YES                "위치 고정: 예"
@@ -700,6 +705,7 @@
 #define TR_MULTI_VIDFREQ                TR("영상 주파수", "비디오 송출 주파수")
 
 #define TR_RF_POWER                     "RF 출력"
+#define TR_RF_LATENCY                   TR("RF lat.", "RF latency")
 #define TR_MULTI_FIXEDID                TR("고정ID", "고정 ID")
 #define TR_MULTI_OPTION                 TR("옵션", "옵션 값")
 #define TR_MULTI_AUTOBIND               TR("바인드 채널", "채널에서 자동 바인딩")
@@ -1442,6 +1448,8 @@
 #define TR_SIGNAL_OUTPUT              "신호 출력"
 #define TR_SERIAL_BUS                 "시리얼 버스"
 #define TR_SYNC                       "동기화"
+#define TR_SYNC_SLIPS                 "slips"
+#define TR_SYNC_UNLOCKED              "unlocked"
 #define TR_ENABLED_FEATURES         "활성화된 기능"
 #define TR_RADIO_MENU_TABS          "조종기 메뉴 탭"
 #define TR_MODEL_MENU_TABS          "모델 메뉴 탭"
@@ -538,6 +538,7 @@
 #define TR_STRENGTH            "Siła"
 #define TR_IMU_LABEL           "IMU"
 #define TR_IMU_OFFSET          "Offset"
+#define TR_IMU_GYRO_INVERTED           "Gyro inv:"
 #define TR_IMU_MAX             "Max"
 #define TR_CONTRAST            "Kontrast"
 #define TR_ALARMS_LABEL        "Alarmy"
@@ -621,6 +622,10 @@
 #define TR_MEM_USED_SCRIPT            "Skrypt(B): "
 #define TR_MEM_USED_WIDGET            "Widget(B): "
 #define TR_MEM_USED_EXTRA             "Ekstra(B): "
+#define TR_LUA_GC                      "GC "
+#define TR_LUA_GC_US                   "GC(us): "
+#define TR_LUA_MAX_US                  "Max(us): "
+#define TR_LUA_OVERRUNS                "Ovr: "
 #define TR_STACK_MIX                  "Mix: "
 #define TR_STACK_AUDIO                "Audio: "
 #define TR_GPS_FIX_YES                "Fix: Tak"
@@ -675,6 +680,7 @@
 #define TR_MULTI_TELEMETRY             "Telemetria"
 #define TR_MULTI_VIDFREQ       TR("Vid. freq.", "Video frequency")
 #define TR_RF_POWER       "Moc RF"
+#define TR_RF_LATENCY     TR("RF lat.", "RF latency")
 #define TR_MULTI_FIXEDID               TR("FixedID", "Fixed ID")
 #define TR_MULTI_OPTION        TR("Opcja", "Wartość opcji")
 #define TR_MULTI_AUTOBIND      TR("Bind Ch.","Bind on channel")
@@ -1400,6 +1406,8 @@
 #define TR_SIGNAL_OUTPUT          "Wyj. sygnału"
 #define TR_SERIAL_BUS             "Mag. szereg."
 #define TR_SYNC                   "Synch"
+#define TR_SYNC_SLIPS             "slips"
+#define TR_SYNC_UNLOCKED          "unlocked"
 
 #define TR_ENABLED_FEATURES       "Włączone opcje"
 #define TR_RADIO_MENU_TABS        "Zakładki menu radia"
@@ -541,6 +541,7 @@
 #define TR_STRENGTH                    "Сила"
 #define TR_IMU_LABEL                   "IMU"
 #define TR_IMU_OFFSET                  "Смещение"
+#define TR_IMU_GYRO_INVERTED           "Gyro inv:"
 #define TR_IMU_MAX                     "Макс"
 #define TR_CONTRAST                    "Контраст"
 #define TR_ALARMS_LABEL                "Сигнал тревоги"
@@ -624,6 +625,10 @@
 #define TR_MEM_USED_SCRIPT         "Скрипт(B): "
 #define TR_MEM_USED_WIDGET         "Виджет(B): "
 #define TR_MEM_USED_EXTRA          "Extra(B): "
+#define TR_LUA_GC                      "GC "
+#define TR_LUA_GC_US                   "GC(us): "
+#define TR_LUA_MAX_US                  "Max(us): "
+#define TR_LUA_OVERRUNS                "Ovr: "
 #define TR_STACK_MIX                   "Mix: "
 #define TR_STACK_AUDIO                 "Аудио: "
 #define TR_GPS_FIX_YES                 "Фикс: Да"
@@ -678,6 +683,7 @@
 #define TR_MULTI_TELEMETRY             "Телеметрия"
 #define TR_MULTI_VIDFREQ               TR("Вид частота", "Вид частота")
 #define TR_RF_POWER                    "Мощность RF"
+#define TR_RF_LATENCY                  TR("RF lat.", "RF latency")
 #define TR_MULTI_FIXEDID               TR("Фикс ID", "Фикс ID")
 #define TR_MULTI_OPTION                TR("Опция", "Знач опции")
 #define TR_MULTI_AUTOBIND              TR("Прив к кан", "Прив к кан")
@@ -1402,6 +1408,8 @@
 #define TR_SIGNAL_OUTPUT          "Выход сигнал"
 #define TR_SERIAL_BUS             "Последов шина"
 #define TR_SYNC                   "Синхро"
+#define TR_SYNC_SLIPS             "slips"
+#define TR_SYNC_UNLOCKED          "unlocked"
 
 #define TR_ENABLED_FEATURES       "Включ функции"
 #define TR_RADIO_MENU_TABS        "Вкладки меню пульта"
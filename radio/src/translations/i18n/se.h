@@ -542,6 +542,7 @@
 #define TR_STRENGTH                     "Styrka"
 #define TR_IMU_LABEL                    "IMU"
 #define TR_IMU_OFFSET                   "Offset"
+#define TR_IMU_GYRO_INVERTED           "Gyro inv:"
 #define TR_IMU_MAX                      "Max"
 #define TR_CONTRAST                     "Kontrast"
 #define TR_ALARMS_LABEL                 "Alarm"
@@ -627,6 +628,10 @@
 #define TR_MEM_USED_SCRIPT              "Skript(B): "
 #define TR_MEM_USED_WIDGET              "Widget(B): "
 #define TR_MEM_USED_EXTRA               "Extra(B): "
+#define TR_LUA_GC                      "GC "
+#define TR_LUA_GC_US                   "GC(us): "
+#define TR_LUA_MAX_US                  "Max(us): "
+#define TR_LUA_OVERRUNS                "Ovr: "
 #define TR_STACK_MIX                    "Mix: "
 #define TR_STACK_AUDIO                  "Audio: "
 #define TR_GPS_FIX_YES                  "Fix: Nej"
@@ -681,6 +686,7 @@
 #define TR_MULTI_TELEMETRY              "Telemetri"
 #define TR_MULTI_VIDFREQ                TR("Vid.frekv", "Videofrekvens")
 #define TR_RF_POWER                     "RF styrka"
+#define TR_RF_LATENCY                   TR("RF lat.", "RF latency")
 #define TR_MULTI_FIXEDID                TR("FastID", "Fast ID")
 #define TR_MULTI_OPTION                 TR("Alternativ", "Alternativets värde")
 #define TR_MULTI_AUTOBIND               TR("Bind ka.","Parkoppla via kanal")
@@ -1417,6 +1423,8 @@
 #define TR_SIGNAL_OUTPUT                "Utsignal"
 #define TR_SERIAL_BUS                   "Seriell buss"
 #define TR_SYNC                         "Synk"
+#define TR_SYNC_SLIPS                   "slips"
+#define TR_SYNC_UNLOCKED                "unlocked"
 
 #define TR_ENABLED_FEATURES             "Aktiverade funktioner"
 #define TR_RADIO_MENU_TABS              "Radiomenyflikar"
@@ -536,6 +536,7 @@
 #define TR_STRENGTH                    "強度"
 #define TR_IMU_LABEL                   "IMU"
 #define TR_IMU_OFFSET                  "補償"
+#define TR_IMU_GYRO_INVERTED           "Gyro inv:"
 #define TR_IMU_MAX                     "最大值"
 #define TR_CONTRAST                    "對比度"
 #define TR_ALARMS_LABEL                "警告"
@@ -619,6 +620,10 @@
 #define TR_MEM_USED_SCRIPT             "腳本(B): "
 #define TR_MEM_USED_WIDGET             "小部件(B): "
 #define TR_MEM_USED_EXTRA              "附加(B): "
+#define TR_LUA_GC                      "GC "
+#define TR_LUA_GC_US                   "GC(us): "
+#define TR_LUA_MAX_US                  "Max(us): "
+#define TR_LUA_OVERRUNS                "Ovr: "
 #define TR_STACK_MIX                   "混控: "
 #define TR_STACK_AUDIO                 "音頻: "
 #define TR_GPS_FIX_YES                 "修正: 是"
@@ -673,6 +678,7 @@
 #define TR_MULTI_TELEMETRY             "回傳"
 #define TR_MULTI_VIDFREQ               TR("圖傳頻率", "圖傳頻率")
 #define TR_RF_POWER                    "發射功率"
+#define TR_RF_LATENCY                  TR("RF lat.", "RF latency")
 #define TR_MULTI_FIXEDID               TR("固定ID", "固定ID")
 #define TR_MULTI_OPTION                TR("選項值", "選項值")
 #define TR_MULTI_AUTOBIND              TR("對頻通道", "通道控制對頻")
@@ -1400,6 +1406,8 @@
 #define TR_SIGNAL_OUTPUT          "信號強度輸出"
 #define TR_SERIAL_BUS             "串行總線"
 #define TR_SYNC                   "同步"
+#define TR_SYNC_SLIPS             "slips"
+#define TR_SYNC_UNLOCKED          "unlocked"
 
 #define TR_ENABLED_FEATURES       "啟用的功能"
 #define TR_RADIO_MENU_TABS        "系統功能選項卡"
@@ -540,6 +540,7 @@
 #define TR_STRENGTH                    "Інтенсивність"
 #define TR_IMU_LABEL                   "IMU"		/*need to be clarified by context*/
 #define TR_IMU_OFFSET                  "Зсув"
+#define TR_IMU_GYRO_INVERTED           "Gyro inv:"
 #define TR_IMU_MAX                     "Max"
 #define TR_CONTRAST                    "Контраст"
 #define TR_ALARMS_LABEL                "Тривоги"
@@ -623,6 +624,10 @@
 #define TR_MEM_USED_SCRIPT         "Скрипт(B): "
 #define TR_MEM_USED_WIDGET         "Віджет(B): "
 #define TR_MEM_USED_EXTRA          "Extra(B): "
+#define TR_LUA_GC                      "GC "
+#define TR_LUA_GC_US                   "GC(us): "
+#define TR_LUA_MAX_US                  "Max(us): "
+#define TR_LUA_OVERRUNS                "Ovr: "
 #define TR_STACK_MIX                   "Mix: "
 #define TR_STACK_AUDIO                 "Аудіо: "
 #define TR_GPS_FIX_YES                 "Фіксація: Так"
@@ -677,6 +682,7 @@
 #define TR_MULTI_TELEMETRY             "Телеметрія"
 #define TR_MULTI_VIDFREQ               TR("Від.Част.", "Відео частота")
 #define TR_RF_POWER                    "RF Потужність"
+#define TR_RF_LATENCY                  TR("RF lat.", "RF latency")
 #define TR_MULTI_FIXEDID               TR("FixedID", "Fixed ID")		/* use english */
 #define TR_MULTI_OPTION                TR("Опція", "Значення опції")
 #define TR_MULTI_AUTOBIND              TR("Прив'язка до кан.", "Прив'язка до каналу")
@@ -1401,6 +1407,8 @@
 #define TR_SIGNAL_OUTPUT          "Вихід сигналу"
 #define TR_SERIAL_BUS             "Послід. шина"
 #define TR_SYNC                   "Синхр"
+#define TR_SYNC_SLIPS             "slips"
+#define TR_SYNC_UNLOCKED          "unlocked"
 
 #define TR_ENABLED_FEATURES       "Увімкнені функції"
 #define TR_RADIO_MENU_TABS        "Вкладки меню апаратури"
@@ -276,6 +276,7 @@
 #endif // !COLORLCD
 
 #if defined(IMU)
+#define STR_IMU_GYRO_INVERTED currentLangStrings->STR_IMU_GYRO_INVERTED
 #define STR_IMU_LABEL currentLangStrings->STR_IMU_LABEL
 #define STR_IMU_MAX currentLangStrings->STR_IMU_MAX
 #define STR_IMU_OFFSET currentLangStrings->STR_IMU_OFFSET
@@ -638,6 +639,10 @@
 #define STR_LOGS currentLangStrings->STR_LOGS
 #define STR_LONG_PRESS currentLangStrings->STR_LONG_PRESS
 #define STR_LOWALARM currentLangStrings->STR_LOWALARM
+#define STR_LUA_GC currentLangStrings->STR_LUA_GC
+#define STR_LUA_GC_US currentLangStrings->STR_LUA_GC_US
+#define STR_LUA_MAX_US currentLangStrings->STR_LUA_MAX_US
+#define STR_LUA_OVERRUNS currentLangStrings->STR_LUA_OVERRUNS
 #define STR_LUA_SCRIPTS_LABEL currentLangStrings->STR_LUA_SCRIPTS_LABEL
 #define STR_MAX currentLangStrings->STR_MAX
 #define STR_MAXBAUDRATE currentLangStrings->STR_MAXBAUDRATE
@@ -878,6 +883,7 @@
 #define STR_RESET_TIMER3 currentLangStrings->STR_RESET_TIMER3
 #define STR_RESET currentLangStrings->STR_RESET
 #define STR_RESTORE_MODEL currentLangStrings->STR_RESTORE_MODEL
+#define STR_RF_LATENCY currentLangStrings->STR_RF_LATENCY
 #define STR_RF_POWER currentLangStrings->STR_RF_POWER
 #define STR_RF_PROTOCOL currentLangStrings->STR_RF_PROTOCOL
 #define STR_ROTARY_ENC_MODE currentLangStrings->STR_ROTARY_ENC_MODE
@@ -990,6 +996,8 @@
 #define STR_SWITCHWARN currentLangStrings->STR_SWITCHWARN
 #define STR_SWITCHWARNING currentLangStrings->STR_SWITCHWARNING
 #define STR_SYNC currentLangStrings->STR_SYNC
+#define STR_SYNC_SLIPS currentLangStrings->STR_SYNC_SLIPS
+#define STR_SYNC_UNLOCKED currentLangStrings->STR_SYNC_UNLOCKED
 #define STR_TELEMETRY_DISABLED currentLangStrings->STR_TELEMETRY_DISABLED
 #define STR_TELEMETRY_NEWSENSOR currentLangStrings->STR_TELEMETRY_NEWSENSOR
 #define STR_TELEMETRY_SENSORS currentLangStrings->STR_TELEMETRY_SENSORS
@@ -1117,6 +1125,7 @@
 #define STR_ISRM_RF_PROTOCOLS currentLangStrings->STR_ISRM_RF_PROTOCOLS
 #define STR_JACK_MODES currentLangStrings->STR_JACK_MODES
 #define STR_MMMINV currentLangStrings->STR_MMMINV
+#define STR_MODEL_ADCFILTERS currentLangStrings->STR_MODEL_ADCFILTERS
 #define STR_MODULE_PROTOCOLS currentLangStrings->STR_MODULE_PROTOCOLS
 #define STR_MONTHS currentLangStrings->STR_MONTHS
 #define STR_OFFON currentLangStrings->STR_OFFON
@@ -1132,6 +1141,7 @@
 #define STR_R9M_LITE_FCC_POWER_VALUES currentLangStrings->STR_R9M_LITE_FCC_POWER_VALUES
 #define STR_R9M_LITE_LBT_POWER_VALUES currentLangStrings->STR_R9M_LITE_LBT_POWER_VALUES
 #define STR_R9M_REGION currentLangStrings->STR_R9M_REGION
+#define STR_RADIO_ADCFILTERS currentLangStrings->STR_RADIO_ADCFILTERS
 #define STR_ROTARY_ENC_OPT currentLangStrings->STR_ROTARY_ENC_OPT
 #define STR_SAMPLE_MODES currentLangStrings->STR_SAMPLE_MODES
 #define STR_SBUS_INVERSION_VALUES currentLangStrings->STR_SBUS_INVERSION_VALUES
@@ -275,6 +275,7 @@ STR(RTC_BATT)
 #endif // !COLORLCD
 
 #if defined(IMU)
+STR(IMU_GYRO_INVERTED)
 STR(IMU_LABEL)
 STR(IMU_MAX)
 STR(IMU_OFFSET)
@@ -637,6 +638,10 @@ STR(LOADINGMODEL)
 STR(LOGS)
 STR(LONG_PRESS)
 STR(LOWALARM)
+STR(LUA_GC)
+STR(LUA_GC_US)
+STR(LUA_MAX_US)
+STR(LUA_OVERRUNS)
 STR(LUA_SCRIPTS_LABEL)
 STR(MAX)
 STR(MAXBAUDRATE)
@@ -877,6 +882,7 @@ STR(RESET_TIMER2)
 STR(RESET_TIMER3)
 STR(RESET)
 STR(RESTORE_MODEL)
+STR(RF_LATENCY)
 STR(RF_POWER)
 STR(RF_PROTOCOL)
 STR(ROTARY_ENC_MODE)
@@ -994,6 +1000,8 @@ STR(SWITCHES)
 STR(SWITCHWARN)
 STR(SWITCHWARNING)
 STR(SYNC)
+STR(SYNC_SLIPS)
+STR(SYNC_UNLOCKED)
 STR(TELEMETRY_DISABLED)
 STR(TELEMETRY_NEWSENSOR)
 STR(TELEMETRY_SENSORS)
@@ -1121,6 +1129,7 @@ STRARRAY(GPSFORMAT)
 STRARRAY(ISRM_RF_PROTOCOLS)
 STRARRAY(JACK_MODES)
 STRARRAY(MMMINV)
+STRARRAY(MODEL_ADCFILTERS)
 STRARRAY(MODULE_PROTOCOLS)
 STRARRAY(MONTHS)
 STRARRAY(OFFON)
@@ -1136,6 +1145,7 @@ STRARRAY(R9M_LBT_POWER_VALUES)
 STRARRAY(R9M_LITE_FCC_POWER_VALUES)
 STRARRAY(R9M_LITE_LBT_POWER_VALUES)
 STRARRAY(R9M_REGION)
+STRARRAY(RADIO_ADCFILTERS)
 STRARRAY(ROTARY_ENC_OPT)
 STRARRAY(SAMPLE_MODES)
 STRARRAY(SBUS_INVERSION_VALUES)
@@ -80,6 +80,7 @@
 #define TR_R9M_LBT_POWER_VALUES         "25mW 8CH","25mW 16CH","200mW NoTele","500mW NoTele"
 #define TR_DSM_PROTOCOLS                "LP45","DSM2","DSMX"
 #define TR_PPM_PROTOCOLS                TR("No Telem", "No Telemetry"),"MLink","SPort"
+#define TR_ADCFILTER_TYPES              "MMA","1-Euro","Kalman"
 #define TR_SBUS_PROTOCOLS               TR("No Telem", "No Telemetry"),"SPort"
 #define TR_MULTI_POWER                  "1.6mW","2.0mW","2.5mW","3.2mW","4.0mW","5.0mW","6.3mW","7.9mW","10mW","13mW","16mW","20mW","25mW","32mW","40mW","50mW"
 #define TR_MULTI_WBUS_MODE              "WBUS","PPM"
@@ -185,6 +186,8 @@
 #define TR_JACK_MODES               SA3(TR_COUNTRY_CODES)
 #define TR_VDISPLAYTRIMS            SA3(TR_VDISPLAYTRIMS)
 #define TR_ADCFILTERVALUES          SA3(TR_ADCFILTERVALUES)
+#define TR_MODEL_ADCFILTERS         TR_ADCFILTERVALUES, TR_ADCFILTER_TYPES
+#define TR_RADIO_ADCFILTERS         TR_ADCFILTERVALUES_2, TR_ADCFILTER_TYPES
 #define TR_VMLTPX                   SA3(TR_VMLTPX)
 #if defined(HELI)
 #define TR_CYC_VSRCRAW              SA3(TR_CYC_VSRCRAW)